@@ -0,0 +1,102 @@
+// alloc_tracker.cpp
+#include "alloc_tracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#define KLL_USABLE_SIZE(pointer) _msize(pointer)
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define KLL_USABLE_SIZE(pointer) malloc_size(pointer)
+#else
+#include <malloc.h>
+#define KLL_USABLE_SIZE(pointer) malloc_usable_size(pointer)
+#endif
+
+namespace {
+
+    std::atomic<size_t> allocatedBytes{ 0 };
+    std::atomic<size_t> peakAllocatedBytes{ 0 };
+
+    void* trackedAllocate(size_t size) {
+        void* pointer = std::malloc(size != 0 ? size : 1);
+        if (pointer == nullptr) return nullptr;
+        size_t usable = KLL_USABLE_SIZE(pointer);
+        size_t current = allocatedBytes.fetch_add(usable, std::memory_order_relaxed) + usable;
+        size_t peak = peakAllocatedBytes.load(std::memory_order_relaxed);
+        while (current > peak && !peakAllocatedBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+        }
+        return pointer;
+    }
+
+    void trackedFree(void* pointer) {
+        if (pointer == nullptr) return;
+        allocatedBytes.fetch_sub(KLL_USABLE_SIZE(pointer), std::memory_order_relaxed);
+        std::free(pointer);
+    }
+
+} // namespace
+
+namespace AllocationTracker {
+
+    size_t currentBytes() {
+        return allocatedBytes.load(std::memory_order_relaxed);
+    }
+
+    size_t peakBytes() {
+        return peakAllocatedBytes.load(std::memory_order_relaxed);
+    }
+
+    void resetPeak() {
+        peakAllocatedBytes.store(allocatedBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+} // namespace AllocationTracker
+
+// Выровненные варианты (align_val_t) не заменяются: их выделения не учитываются
+void* operator new(size_t size) {
+    void* pointer = trackedAllocate(size);
+    if (pointer == nullptr) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    void* pointer = trackedAllocate(size);
+    if (pointer == nullptr) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return trackedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return trackedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    trackedFree(pointer);
+}
@@ -0,0 +1,18 @@
+// alloc_tracker.h
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include <cstddef>
+
+// --- Учет динамической памяти программы замеров ---
+// alloc_tracker.cpp заменяет глобальные operator new/delete: каждый блок выделяется через malloc,
+// его фактический размер (malloc_usable_size, _msize) прибавляется к счетчику занятой памяти и
+// вычитается при освобождении. Пик - наибольшее значение счетчика с последнего resetPeak().
+// Счетчики атомарные (relaxed), поэтому учитываются и выделения рабочих потоков интерпретатора.
+namespace AllocationTracker {
+    size_t currentBytes();
+    size_t peakBytes();
+    void resetPeak(); // Пик становится равным текущему значению
+}
+
+#endif // ALLOC_TRACKER_H
@@ -0,0 +1,512 @@
+// bench_main.cpp
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "lexer_bench.h"
+#include "micro_bench.h"
+#include "macro_bench.h"
+#include "compare_bench.h"
+#include "program_generator.h"
+#include "scale_bench.h"
+#include "golden_tests.h"
+#include "differential_fuzz.h"
+
+namespace {
+
+    const char* const USAGE =
+        " [--size=MB] [--repeat=N] [source_file]\n"
+        "       KLL-bench micro [--repeat=N] [--min-time=MS] [--filter=TEXT] [--json=FILE]\n"
+        "       KLL-bench macro [--min-n=N] [--max-n=N] [--max-seconds=S] [--filter=TEXT] [--engines=A,B]\n"
+        "                       [--json=FILE] [--dump=DIR]\n"
+        "       KLL-bench compare --engine=DIALECT=PATH [--engine=DIALECT=PATH ...] [--repeat=N]\n"
+        "                         [--scale=F] [--threshold=PCT] [--filter=TEXT] [--work-dir=DIR] [--json=FILE]\n"
+        "       KLL-bench generate --shape=SHAPE --lines=N [--depth=D] [--seed=S] output_file\n"
+        "       KLL-bench scale [--shapes=A,B] [--min-lines=N] [--max-lines=N] [--depth=D] [--opt=0..3]\n"
+        "                       [--repeat=N] [--max-seconds=S] [--json=FILE]\n"
+        "       KLL-bench golden --engine=PATH [--tests=DIR] [--jobs=N] [--repeat=N] [--threshold=PCT]\n"
+        "                        [--baseline=FILE] [--update-baseline] [--filter=TEXT] [--work-dir=DIR]\n"
+        "       KLL-bench fuzz [--seed=S] [--iterations=N] [--max-seconds=S] [--statements=N] [--engines=A,B]\n"
+        "                      [--no-minimize] [--out-dir=DIR] [--program=FILE]\n"
+        "Shapes: straight, expr, blocks, decls";
+
+    // Режим micro: микрозамеры операций ОПС, стека, таблицы символов и лексера
+    int runMicroMode(int argc, char* argv[]) {
+        MicroBenchOptions options;
+        std::string jsonFileName;
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            try {
+                if (arg.rfind("--repeat=", 0) == 0) {
+                    options.repetitions = std::stoi(arg.substr(9));
+                    if (options.repetitions < 1) throw std::invalid_argument("repeat");
+                }
+                else if (arg.rfind("--min-time=", 0) == 0) {
+                    options.minMilliseconds = std::stod(arg.substr(11));
+                    if (options.minMilliseconds <= 0) throw std::invalid_argument("min-time");
+                }
+                else if (arg.rfind("--filter=", 0) == 0) {
+                    options.filter = arg.substr(9);
+                }
+                else if (arg.rfind("--json=", 0) == 0 && arg.size() > 7) {
+                    jsonFileName = arg.substr(7);
+                }
+                else {
+                    throw std::invalid_argument(arg);
+                }
+            }
+            catch (const std::exception&) {
+                std::cerr << "Usage: " << argv[0] << USAGE << std::endl;
+                return 1;
+            }
+        }
+
+        std::vector<MicroBenchResult> results = runMicroBenchmarks(options);
+        printMicroBenchResults(std::cout, results);
+        if (!jsonFileName.empty()) {
+            std::ofstream jsonFile(jsonFileName);
+            if (!jsonFile.is_open()) {
+                std::cerr << "Error: Could not open file '" << jsonFileName << "'" << std::endl;
+                return 1;
+            }
+            writeMicroBenchJson(jsonFile, results, options);
+        }
+        return 0;
+    }
+
+    // Режим macro: корпус программ KLL, N от --min-n до --max-n степенями 10, все режимы интерпретатора
+    int runMacroMode(int argc, char* argv[]) {
+        MacroBenchOptions options;
+        std::string jsonFileName;
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            try {
+                if (arg.rfind("--min-n=", 0) == 0) {
+                    options.minN = std::stoull(arg.substr(8));
+                    if (options.minN < 10) throw std::invalid_argument("min-n");
+                }
+                else if (arg.rfind("--max-n=", 0) == 0) {
+                    options.maxN = std::stoull(arg.substr(8));
+                }
+                else if (arg.rfind("--max-seconds=", 0) == 0) {
+                    options.maxSeconds = std::stod(arg.substr(14));
+                    if (options.maxSeconds <= 0) throw std::invalid_argument("max-seconds");
+                }
+                else if (arg.rfind("--filter=", 0) == 0) {
+                    options.workloadFilter = arg.substr(9);
+                }
+                else if (arg.rfind("--engines=", 0) == 0) {
+                    options.engines = arg.substr(10);
+                }
+                else if (arg.rfind("--json=", 0) == 0 && arg.size() > 7) {
+                    jsonFileName = arg.substr(7);
+                }
+                else if (arg.rfind("--dump=", 0) == 0 && arg.size() > 7) {
+                    options.dumpDirectory = arg.substr(7);
+                }
+                else {
+                    throw std::invalid_argument(arg);
+                }
+            }
+            catch (const std::exception&) {
+                std::cerr << "Usage: " << argv[0] << USAGE << std::endl;
+                std::cerr << "Workloads:";
+                for (const std::string& name : getMacroWorkloadNames()) std::cerr << " " << name;
+                std::cerr << "\nEngines:";
+                for (const std::string& name : getMacroEngineNames()) std::cerr << " " << name;
+                std::cerr << std::endl;
+                return 1;
+            }
+        }
+        if (options.maxN < options.minN) {
+            std::cerr << "Error: --max-n must not be less than --min-n" << std::endl;
+            return 1;
+        }
+
+        std::vector<MacroBenchResult> results = runMacroBenchmarks(options, std::cout);
+        if (!jsonFileName.empty()) {
+            std::ofstream jsonFile(jsonFileName);
+            if (!jsonFile.is_open()) {
+                std::cerr << "Error: Could not open file '" << jsonFileName << "'" << std::endl;
+                return 1;
+            }
+            writeMacroBenchJson(jsonFile, results);
+        }
+        return 0;
+    }
+
+    // Режим compare: общий корпус в каждой версии KLL (DIALECT - 1.0, 1.1 или 1.2; первая - базовая)
+    int runCompareMode(int argc, char* argv[]) {
+        CompareOptions options;
+        std::string jsonFileName;
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            try {
+                if (arg.rfind("--engine=", 0) == 0) {
+                    std::string spec = arg.substr(9);
+                    size_t separator = spec.find('=');
+                    if (separator == std::string::npos || separator + 1 == spec.size()) throw std::invalid_argument(arg);
+                    CompareEngine engine{ spec.substr(0, separator), spec.substr(0, separator), spec.substr(separator + 1) };
+                    if (!isKnownDialect(engine.dialect)) throw std::invalid_argument(arg);
+                    int sameDialect = 1;
+                    for (const CompareEngine& other : options.engines) sameDialect += (other.dialect == engine.dialect);
+                    if (sameDialect > 1) engine.label += "#" + std::to_string(sameDialect);
+                    options.engines.push_back(engine);
+                }
+                else if (arg.rfind("--repeat=", 0) == 0) {
+                    options.repetitions = std::stoi(arg.substr(9));
+                    if (options.repetitions < 1) throw std::invalid_argument("repeat");
+                }
+                else if (arg.rfind("--scale=", 0) == 0) {
+                    options.scale = std::stod(arg.substr(8));
+                    if (!(options.scale > 0)) throw std::invalid_argument("scale");
+                }
+                else if (arg.rfind("--threshold=", 0) == 0) {
+                    options.thresholdPercent = std::stod(arg.substr(12));
+                    if (options.thresholdPercent < 0) throw std::invalid_argument("threshold");
+                }
+                else if (arg.rfind("--filter=", 0) == 0) {
+                    options.programFilter = arg.substr(9);
+                }
+                else if (arg.rfind("--work-dir=", 0) == 0 && arg.size() > 11) {
+                    options.workDirectory = arg.substr(11);
+                }
+                else if (arg.rfind("--json=", 0) == 0 && arg.size() > 7) {
+                    jsonFileName = arg.substr(7);
+                }
+                else {
+                    throw std::invalid_argument(arg);
+                }
+            }
+            catch (const std::exception&) {
+                options.engines.clear();
+                break;
+            }
+        }
+        if (options.engines.empty()) {
+            std::cerr << "Usage: " << argv[0] << USAGE << std::endl;
+            return 1;
+        }
+
+        std::vector<CompareResult> results = runVersionComparison(options, std::cout);
+        if (results.empty()) return 1;
+        if (!jsonFileName.empty()) {
+            std::ofstream jsonFile(jsonFileName);
+            if (!jsonFile.is_open()) {
+                std::cerr << "Error: Could not open file '" << jsonFileName << "'" << std::endl;
+                return 1;
+            }
+            writeCompareJson(jsonFile, results, options);
+        }
+        return 0;
+    }
+
+    // Режим generate: синтетическая программа заданной формы и размера в файл
+    int runGenerateMode(int argc, char* argv[]) {
+        ProgramGeneratorOptions options;
+        bool haveShape = false;
+        bool haveLines = false;
+        std::string outputFileName;
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            try {
+                if (arg.rfind("--shape=", 0) == 0) {
+                    if (!parseProgramShape(arg.substr(8), options.shape)) throw std::invalid_argument(arg);
+                    haveShape = true;
+                }
+                else if (arg.rfind("--lines=", 0) == 0) {
+                    options.lines = std::stoull(arg.substr(8));
+                    if (options.lines < 1) throw std::invalid_argument("lines");
+                    haveLines = true;
+                }
+                else if (arg.rfind("--depth=", 0) == 0) {
+                    options.depth = std::stoi(arg.substr(8));
+                    if (options.depth < 1) throw std::invalid_argument("depth");
+                }
+                else if (arg.rfind("--seed=", 0) == 0) {
+                    options.seed = std::stoull(arg.substr(7));
+                }
+                else if (outputFileName.empty() && arg.rfind("--", 0) != 0) {
+                    outputFileName = arg;
+                }
+                else {
+                    throw std::invalid_argument(arg);
+                }
+            }
+            catch (const std::exception&) {
+                haveShape = false;
+                break;
+            }
+        }
+        if (!haveShape || !haveLines || outputFileName.empty()) {
+            std::cerr << "Usage: " << argv[0] << USAGE << std::endl;
+            return 1;
+        }
+
+        std::ofstream outputFile(outputFileName, std::ios::binary);
+        if (!outputFile.is_open()) {
+            std::cerr << "Error: Could not open file '" << outputFileName << "'" << std::endl;
+            return 1;
+        }
+        outputFile << generateProgram(options);
+        return 0;
+    }
+
+    // Режим scale: время этапов компиляции и пик памяти в зависимости от размера синтетической программы
+    int runScaleMode(int argc, char* argv[]) {
+        ScaleBenchOptions options;
+        std::string jsonFileName;
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            try {
+                if (arg.rfind("--shapes=", 0) == 0) {
+                    std::stringstream names(arg.substr(9));
+                    std::string name;
+                    while (std::getline(names, name, ',')) {
+                        ProgramShape shape;
+                        if (!parseProgramShape(name, shape)) throw std::invalid_argument(name);
+                        options.shapes.push_back(shape);
+                    }
+                }
+                else if (arg.rfind("--min-lines=", 0) == 0) {
+                    options.minLines = std::stoull(arg.substr(12));
+                    if (options.minLines < 1) throw std::invalid_argument("min-lines");
+                }
+                else if (arg.rfind("--max-lines=", 0) == 0) {
+                    options.maxLines = std::stoull(arg.substr(12));
+                }
+                else if (arg.rfind("--depth=", 0) == 0) {
+                    options.depth = std::stoi(arg.substr(8));
+                    if (options.depth < 1) throw std::invalid_argument("depth");
+                }
+                else if (arg.rfind("--opt=", 0) == 0) {
+                    options.optimizationLevel = std::stoi(arg.substr(6));
+                    if (options.optimizationLevel < 0 || options.optimizationLevel > 3) throw std::invalid_argument("opt");
+                }
+                else if (arg.rfind("--repeat=", 0) == 0) {
+                    options.repetitions = std::stoi(arg.substr(9));
+                    if (options.repetitions < 1) throw std::invalid_argument("repeat");
+                }
+                else if (arg.rfind("--max-seconds=", 0) == 0) {
+                    options.maxSeconds = std::stod(arg.substr(14));
+                    if (options.maxSeconds <= 0) throw std::invalid_argument("max-seconds");
+                }
+                else if (arg.rfind("--json=", 0) == 0 && arg.size() > 7) {
+                    jsonFileName = arg.substr(7);
+                }
+                else {
+                    throw std::invalid_argument(arg);
+                }
+            }
+            catch (const std::exception&) {
+                std::cerr << "Usage: " << argv[0] << USAGE << std::endl;
+                return 1;
+            }
+        }
+        if (options.maxLines < options.minLines) {
+            std::cerr << "Error: --max-lines must not be less than --min-lines" << std::endl;
+            return 1;
+        }
+
+        std::vector<ScaleBenchResult> results = runScaleBenchmark(options, std::cout);
+        if (!jsonFileName.empty()) {
+            std::ofstream jsonFile(jsonFileName);
+            if (!jsonFile.is_open()) {
+                std::cerr << "Error: Could not open file '" << jsonFileName << "'" << std::endl;
+                return 1;
+            }
+            writeScaleBenchJson(jsonFile, results);
+        }
+        return 0;
+    }
+
+    // Режим golden: эталонные тесты KLL 1.2 параллельно, с базовой линией времени и числа операций
+    int runGoldenMode(int argc, char* argv[]) {
+        GoldenTestOptions options;
+        bool valid = true;
+        for (int i = 2; i < argc && valid; ++i) {
+            std::string arg = argv[i];
+            try {
+                if (arg.rfind("--engine=", 0) == 0 && arg.size() > 9) {
+                    options.enginePath = arg.substr(9);
+                }
+                else if (arg.rfind("--tests=", 0) == 0 && arg.size() > 8) {
+                    options.testsDirectory = arg.substr(8);
+                }
+                else if (arg.rfind("--jobs=", 0) == 0) {
+                    options.jobs = std::stoi(arg.substr(7));
+                    if (options.jobs < 1) throw std::invalid_argument("jobs");
+                }
+                else if (arg.rfind("--repeat=", 0) == 0) {
+                    options.repetitions = std::stoi(arg.substr(9));
+                    if (options.repetitions < 1) throw std::invalid_argument("repeat");
+                }
+                else if (arg.rfind("--threshold=", 0) == 0) {
+                    options.thresholdPercent = std::stod(arg.substr(12));
+                    if (options.thresholdPercent < 0) throw std::invalid_argument("threshold");
+                }
+                else if (arg.rfind("--baseline=", 0) == 0 && arg.size() > 11) {
+                    options.baselineFile = arg.substr(11);
+                }
+                else if (arg == "--update-baseline") {
+                    options.updateBaseline = true;
+                }
+                else if (arg.rfind("--filter=", 0) == 0) {
+                    options.filter = arg.substr(9);
+                }
+                else if (arg.rfind("--work-dir=", 0) == 0 && arg.size() > 11) {
+                    options.workDirectory = arg.substr(11);
+                }
+                else {
+                    throw std::invalid_argument(arg);
+                }
+            }
+            catch (const std::exception&) {
+                valid = false;
+            }
+        }
+        if (!valid || options.enginePath.empty()) {
+            std::cerr << "Usage: " << argv[0] << USAGE << std::endl;
+            return 1;
+        }
+
+        std::vector<GoldenTestResult> results = runGoldenTests(options, std::cout);
+        return goldenTestsPassed(results) ? 0 : 1;
+    }
+
+    // Режим fuzz: случайные программы во всех режимах интерпретатора, сравнение с -O0
+    int runFuzzMode(int argc, char* argv[]) {
+        FuzzOptions options;
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            try {
+                if (arg.rfind("--seed=", 0) == 0) {
+                    options.seed = std::stoull(arg.substr(7));
+                }
+                else if (arg.rfind("--iterations=", 0) == 0) {
+                    options.iterations = std::stoull(arg.substr(13));
+                }
+                else if (arg.rfind("--max-seconds=", 0) == 0) {
+                    options.maxSeconds = std::stod(arg.substr(14));
+                    if (options.maxSeconds < 0) throw std::invalid_argument("max-seconds");
+                }
+                else if (arg.rfind("--statements=", 0) == 0) {
+                    options.statements = std::stoull(arg.substr(13));
+                    if (options.statements < 1) throw std::invalid_argument("statements");
+                }
+                else if (arg.rfind("--engines=", 0) == 0) {
+                    options.engines = arg.substr(10);
+                }
+                else if (arg == "--no-minimize") {
+                    options.minimize = false;
+                }
+                else if (arg.rfind("--out-dir=", 0) == 0 && arg.size() > 10) {
+                    options.outputDirectory = arg.substr(10);
+                }
+                else if (arg.rfind("--program=", 0) == 0 && arg.size() > 10) {
+                    options.programFile = arg.substr(10);
+                }
+                else {
+                    throw std::invalid_argument(arg);
+                }
+            }
+            catch (const std::exception&) {
+                std::cerr << "Usage: " << argv[0] << USAGE << std::endl;
+                std::cerr << "Engines:";
+                for (const std::string& name : getFuzzEngineNames()) std::cerr << " " << name;
+                std::cerr << std::endl;
+                return 1;
+            }
+        }
+
+        std::vector<FuzzMismatch> mismatches = runDifferentialFuzz(options, std::cout);
+        return mismatches.empty() ? 0 : 1;
+    }
+
+} // namespace
+
+// Программа замеров производительности компонентов KLL 1.2.
+// Использование: KLL-bench [--size=MB] [--repeat=N] [source_file]
+//                KLL-bench micro [--repeat=N] [--min-time=MS] [--filter=TEXT] [--json=FILE]
+//                KLL-bench macro [--min-n=N] [--max-n=N] [--max-seconds=S] [--filter=TEXT] [--engines=A,B]
+//                                [--json=FILE] [--dump=DIR]
+//                KLL-bench compare --engine=DIALECT=PATH [--engine=DIALECT=PATH ...] [--repeat=N]
+//                                  [--scale=F] [--threshold=PCT] [--filter=TEXT] [--work-dir=DIR] [--json=FILE]
+//                KLL-bench generate --shape=SHAPE --lines=N [--depth=D] [--seed=S] output_file
+//                KLL-bench scale [--shapes=A,B] [--min-lines=N] [--max-lines=N] [--depth=D] [--opt=0..3]
+//                                [--repeat=N] [--max-seconds=S] [--json=FILE]
+//                KLL-bench golden --engine=PATH [--tests=DIR] [--jobs=N] [--repeat=N] [--threshold=PCT]
+//                                 [--baseline=FILE] [--update-baseline] [--filter=TEXT] [--work-dir=DIR]
+//                KLL-bench fuzz [--seed=S] [--iterations=N] [--max-seconds=S] [--statements=N] [--engines=A,B]
+//                               [--no-minimize] [--out-dir=DIR] [--program=FILE]
+// Без source_file лексируется синтетическая программа размером --size мегабайт (по умолчанию 16).
+// micro - микрозамеры (время одной операции); --json сохраняет результаты для сравнения между версиями.
+// macro - корпус программ (сортировка, префиксные суммы, умножение матриц, решето, гистограмма, ДП)
+// на N = 10^3..10^7: время, операций ОПС в секунду и память в каждом режиме интерпретатора.
+// compare - общий корпус в исполняемых файлах разных версий KLL: время фаз и ускорение относительно первой.
+// generate - синтетическая программа формы straight, expr, blocks или decls (program_generator.h).
+// scale - время лексера, разбора, IR, оптимизации, ОПС и пик памяти на синтетических программах
+// от --min-lines до --max-lines строк; сверхлинейный рост этапа отмечается в таблице.
+// golden - эталонные тесты KLL 1.2 (по умолчанию KLL-skript-1.2/tests) исполняемым файлом --engine; код
+// завершения 1, если тест не прошел или время либо число операций выросли больше порога (golden_tests.h).
+// fuzz - дифференциальное тестирование: случайные программы в режимах -O0..-O3, с векторизацией и
+// распараллеливанием; расхождения с -O0 уменьшаются и сохраняются в --out-dir (differential_fuzz.h).
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "micro") return runMicroMode(argc, argv);
+    if (argc > 1 && std::string(argv[1]) == "macro") return runMacroMode(argc, argv);
+    if (argc > 1 && std::string(argv[1]) == "compare") return runCompareMode(argc, argv);
+    if (argc > 1 && std::string(argv[1]) == "generate") return runGenerateMode(argc, argv);
+    if (argc > 1 && std::string(argv[1]) == "scale") return runScaleMode(argc, argv);
+    if (argc > 1 && std::string(argv[1]) == "golden") return runGoldenMode(argc, argv);
+    if (argc > 1 && std::string(argv[1]) == "fuzz") return runFuzzMode(argc, argv);
+
+    size_t sizeMegabytes = 16;
+    int repetitions = 5;
+    std::string sourceFileName;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        try {
+            if (arg.rfind("--size=", 0) == 0) {
+                int value = std::stoi(arg.substr(7));
+                if (value < 1) throw std::invalid_argument("size");
+                sizeMegabytes = static_cast<size_t>(value);
+            }
+            else if (arg.rfind("--repeat=", 0) == 0) {
+                repetitions = std::stoi(arg.substr(9));
+                if (repetitions < 1) throw std::invalid_argument("repeat");
+            }
+            else if (sourceFileName.empty() && arg.rfind("--", 0) != 0) {
+                sourceFileName = arg;
+            }
+            else {
+                throw std::invalid_argument(arg);
+            }
+        }
+        catch (const std::exception&) {
+            std::cerr << "Usage: " << argv[0] << USAGE << std::endl;
+            return 1;
+        }
+    }
+
+    std::string source;
+    std::string sourceName = "generated";
+    if (!sourceFileName.empty()) {
+        std::ifstream sourceFile(sourceFileName, std::ios::binary);
+        if (!sourceFile.is_open()) {
+            std::cerr << "Error: Could not open file '" << sourceFileName << "'" << std::endl;
+            return 1;
+        }
+        std::stringstream buffer;
+        buffer << sourceFile.rdbuf();
+        source = buffer.str();
+        sourceName = sourceFileName;
+    }
+    else {
+        source = generateLexerWorkload(sizeMegabytes * 1024 * 1024);
+    }
+
+    runLexerBenchmark(source, sourceName, repetitions);
+    return 0;
+}
@@ -0,0 +1,373 @@
+// compare_bench.cpp
+#include "compare_bench.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+
+namespace {
+
+    // --- Корпус общего подмножества ---
+    // Записан в синтаксисе 1.2. Строки "begin" и "end" без ';' - только границы программы
+    // (в 1.0 и 1.1 их нет); каждый оператор завершается ';' (в 1.2 это пустой оператор).
+    // Данные генерируются в самой программе (без cin): приглашения ввода у версий разные.
+    // Размер @N@ (и @NN@ = N * N) - baseSize, умноженный на --scale.
+    struct CompareProgram {
+        const char* name;
+        size_t baseSize;
+        const char* source;
+    };
+
+    const CompareProgram PROGRAMS[] = {
+        { "arith_loop", 100000, R"(int i; int x; int s;
+begin
+i = 0; x = 1; s = 0;
+while (i < @N@) begin
+  x = x * 75 + 74;
+  x = x - (x / 65537) * 65537;
+  s = s + x / 1000;
+  i = i + 1;
+end;
+cout(s);
+end
+)" },
+        // Пузырьковая сортировка из test4_array.txt
+        { "bubble_sort", 300, R"(int i; int j; int n; int x; int temp;
+arr int data[@N@];
+begin
+n = @N@; x = 7; i = 0;
+while (i < n) begin
+  x = x * 75 + 74;
+  x = x - (x / 65537) * 65537;
+  data[i] = x;
+  i = i + 1;
+end;
+i = 0;
+while (i < n - 1) begin
+  j = 0;
+  while (j < n - i - 1) begin
+    if (data[j] > data[j + 1]) begin
+      temp = data[j];
+      data[j] = data[j + 1];
+      data[j + 1] = temp;
+    end;
+    j = j + 1;
+  end;
+  i = i + 1;
+end;
+cout(data[0]); cout(data[n - 1]);
+end
+)" },
+        { "sieve", 100000, R"(int n; int i; int j; int count;
+arr int s[@N@];
+begin
+n = @N@; i = 2;
+while (i * i < n) begin
+  if (s[i] ~ 0) begin
+    j = i * i;
+    while (j < n) begin s[j] = 1; j = j + i; end;
+  end;
+  i = i + 1;
+end;
+count = 0; i = 2;
+while (i < n) begin
+  if (s[i] ~ 0) begin count = count + 1; end;
+  i = i + 1;
+end;
+cout(count);
+end
+)" },
+        { "prefix_sum", 50000, R"(int n; int i; int total;
+arr int a[@N@]; arr int p[@N@];
+begin
+n = @N@; i = 0;
+while (i < n) begin a[i] = i - (i / 100) * 100; i = i + 1; end;
+p[0] = a[0]; i = 1;
+while (i < n) begin p[i] = p[i - 1] + a[i]; i = i + 1; end;
+total = 0; i = 0;
+while (i + 10 < n) begin total = total + (p[i + 10] - p[i]) / 10; i = i + 1; end;
+cout(p[n - 1]); cout(total);
+end
+)" },
+        { "matmul", 40, R"(int m; int i; int j; int k; int s;
+arr int a[@NN@]; arr int b[@NN@]; arr int c[@NN@];
+begin
+m = @N@; i = 0;
+while (i < m * m) begin a[i] = i - (i / 7) * 7; b[i] = i - (i / 5) * 5; i = i + 1; end;
+i = 0;
+while (i < m) begin
+  j = 0;
+  while (j < m) begin
+    s = 0; k = 0;
+    while (k < m) begin s = s + a[i * m + k] * b[k * m + j]; k = k + 1; end;
+    c[i * m + j] = s;
+    j = j + 1;
+  end;
+  i = i + 1;
+end;
+cout(c[0]); cout(c[m * m - 1]);
+end
+)" },
+        // Ветвления: классификация чисел по остаткам
+        { "branches", 60000, R"(int i; int r; int a; int b; int c;
+begin
+i = 0; a = 0; b = 0; c = 0;
+while (i < @N@) begin
+  r = i - (i / 6) * 6;
+  if (r ~ 0) begin a = a + 1; end
+  else begin
+    if (r < 3) begin b = b + r; end
+    else begin
+      if (r ! 4) begin c = c + 1; end else begin c = c - 1; end;
+    end;
+  end;
+  i = i + 1;
+end;
+cout(a); cout(b); cout(c);
+end
+)" }
+    };
+
+    std::string replaceAll(std::string text, const std::string& placeholder, const std::string& value) {
+        for (size_t position = text.find(placeholder); position != std::string::npos;
+            position = text.find(placeholder, position + value.size())) {
+            text.replace(position, placeholder.size(), value);
+        }
+        return text;
+    }
+
+    std::string instantiate(const CompareProgram& program, double scale) {
+        size_t size = std::max<size_t>(2, static_cast<size_t>(std::llround(static_cast<double>(program.baseSize) * scale)));
+        std::string source = replaceAll(program.source, "@NN@", std::to_string(size * size));
+        return replaceAll(source, "@N@", std::to_string(size));
+    }
+
+    std::string translateToDialect(const std::string& source, const std::string& dialect) {
+        if (dialect == "1.2") return source;
+        std::istringstream lines(source);
+        std::string line;
+        std::string result;
+        while (std::getline(lines, line)) {
+            if (line == "begin" || line == "end") continue; // Границы программы
+            for (size_t position = line.find("arr int "); position != std::string::npos;
+                position = line.find("arr int ", position + 1)) {
+                line.replace(position, 8, dialect == "1.1" ? "int arr " : "arr ");
+            }
+            result += line;
+            result += '\n';
+        }
+        return result;
+    }
+
+    const char* const NULL_DEVICE =
+#ifdef _WIN32
+        "NUL";
+#else
+        "/dev/null";
+#endif
+
+    // Время фазы из вывода --metrics=json (поле wall_ms объекта с данным name)
+    std::optional<double> findPhaseMilliseconds(const std::string& json, const std::string& phase) {
+        std::string key = "{\"name\":\"" + phase + "\",\"wall_ms\":";
+        size_t position = json.find(key);
+        if (position == std::string::npos) return std::nullopt;
+        return std::strtod(json.c_str() + position + key.size(), nullptr);
+    }
+
+    struct RunSample {
+        bool success;
+        double totalMilliseconds;
+        std::optional<double> parseMilliseconds;
+        std::optional<double> executeMilliseconds;
+    };
+
+    RunSample runEngine(const CompareEngine& engine, const std::string& programFile, const std::string& metricsFile,
+        bool withMetrics) {
+        std::remove(metricsFile.c_str());
+        std::string command = "\"" + engine.path + "\"";
+        if (withMetrics) command += " --metrics=json:\"" + metricsFile + "\"";
+        command += " \"" + programFile + "\" < " + NULL_DEVICE + " > " + NULL_DEVICE + " 2>&1";
+#ifdef _WIN32
+        command = "\"" + command + "\""; // cmd /c снимает внешние кавычки
+#endif
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        int exitCode = std::system(command.c_str());
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        RunSample sample{ exitCode == 0, elapsed, std::nullopt, std::nullopt };
+        if (withMetrics) {
+            std::ifstream metrics(metricsFile);
+            std::stringstream buffer;
+            buffer << metrics.rdbuf();
+            sample.parseMilliseconds = findPhaseMilliseconds(buffer.str(), "parse");
+            sample.executeMilliseconds = findPhaseMilliseconds(buffer.str(), "execute");
+        }
+        return sample;
+    }
+
+    double median(std::vector<double> values) {
+        if (values.empty()) return -1.0;
+        std::sort(values.begin(), values.end());
+        size_t middle = values.size() / 2;
+        return (values.size() % 2 == 1) ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+    }
+
+    // Ускорение относительно базовой версии (> 1 - быстрее); 0 - нет данных
+    double speedup(double baseline, double value) {
+        return (baseline > 0 && value > 0) ? baseline / value : 0.0;
+    }
+
+    std::string formatSpeedup(double value, double thresholdPercent) {
+        if (value <= 0) return "-";
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(2) << value << "x";
+        if (value < 1.0 / (1.0 + thresholdPercent / 100.0)) text << " REGRESSION";
+        return text.str();
+    }
+
+} // namespace
+
+bool isKnownDialect(const std::string& dialect) {
+    return dialect == "1.0" || dialect == "1.1" || dialect == "1.2";
+}
+
+std::vector<std::string> getComparePrograms() {
+    std::vector<std::string> names;
+    for (const CompareProgram& program : PROGRAMS) names.push_back(program.name);
+    return names;
+}
+
+std::vector<CompareResult> runVersionComparison(const CompareOptions& requested, std::ostream& out) {
+    std::vector<CompareResult> results;
+    std::error_code error;
+    CompareOptions options = requested;
+    if (options.workDirectory.empty()) {
+        std::filesystem::path temporary = std::filesystem::temp_directory_path(error);
+        options.workDirectory = ((error ? std::filesystem::path(".") : temporary) / "kll-compare").string();
+    }
+    std::filesystem::create_directories(options.workDirectory, error);
+    if (error) {
+        std::cerr << "Error: Could not create directory '" << options.workDirectory << "': " << error.message() << std::endl;
+        return results;
+    }
+    std::string metricsFile = options.workDirectory + "/metrics.json";
+
+    // Поддержка --metrics=json проверяется первым запуском каждой версии
+    std::vector<bool> reportsPhases(options.engines.size(), true);
+    std::vector<bool> probed(options.engines.size(), false);
+
+    std::ios_base::fmtflags savedFlags = out.flags();
+    std::streamsize savedPrecision = out.precision();
+    out << std::fixed << std::setprecision(2);
+    out << std::left << std::setw(13) << "program" << std::setw(8) << "engine" << std::setw(8) << "status" << std::right
+        << std::setw(10) << "total ms" << std::setw(10) << "parse ms" << std::setw(12) << "execute ms" << "  "
+        << "speedup vs " << options.engines.front().label << " (total / parse / execute)" << std::endl;
+
+    for (const CompareProgram& program : PROGRAMS) {
+        if (!options.programFilter.empty() && std::string(program.name).find(options.programFilter) == std::string::npos) continue;
+        size_t baselineIndex = results.size(); // Результат первой версии для этой программы
+        for (size_t e = 0; e < options.engines.size(); ++e) {
+            const CompareEngine& engine = options.engines[e];
+            std::string programFile = options.workDirectory + "/" + program.name + "." + engine.dialect + ".kll";
+            std::ofstream(programFile) << translateToDialect(instantiate(program, options.scale), engine.dialect);
+
+            if (!probed[e]) {
+                probed[e] = true;
+                RunSample probe = runEngine(engine, programFile, metricsFile, true);
+                reportsPhases[e] = probe.parseMilliseconds.has_value();
+            }
+
+            CompareResult result{ program.name, engine.label, "ok", -1.0, -1.0, -1.0 };
+            std::vector<double> totals, parses, executes;
+            for (int r = 0; r < options.repetitions; ++r) {
+                RunSample sample = runEngine(engine, programFile, metricsFile, reportsPhases[e]);
+                if (!sample.success) result.status = "failed";
+                totals.push_back(sample.totalMilliseconds);
+                if (sample.parseMilliseconds) parses.push_back(*sample.parseMilliseconds);
+                if (sample.executeMilliseconds) executes.push_back(*sample.executeMilliseconds);
+            }
+            result.totalMilliseconds = median(totals);
+            result.parseMilliseconds = median(parses);
+            result.executeMilliseconds = median(executes);
+            results.push_back(result);
+            const CompareResult& reference = results[baselineIndex];
+
+            out << std::left << std::setw(13) << result.program << std::setw(8) << result.engine
+                << std::setw(8) << result.status << std::right << std::setw(10) << result.totalMilliseconds;
+            if (result.parseMilliseconds >= 0) out << std::setw(10) << result.parseMilliseconds;
+            else out << std::setw(10) << "-";
+            if (result.executeMilliseconds >= 0) out << std::setw(12) << result.executeMilliseconds;
+            else out << std::setw(12) << "-";
+            if (e > 0 && reference.status == "ok" && result.status == "ok") {
+                out << "  " << formatSpeedup(speedup(reference.totalMilliseconds, result.totalMilliseconds), options.thresholdPercent)
+                    << " / " << formatSpeedup(speedup(reference.parseMilliseconds, result.parseMilliseconds), options.thresholdPercent)
+                    << " / " << formatSpeedup(speedup(reference.executeMilliseconds, result.executeMilliseconds), options.thresholdPercent);
+            }
+            out << std::endl;
+        }
+    }
+
+    // Сводка: среднее геометрическое ускорений по программам, где обе версии отработали
+    out << "\nGeometric mean speedup vs " << options.engines.front().label << " (total / parse / execute):" << std::endl;
+    size_t engineCount = options.engines.size();
+    for (size_t e = 1; e < engineCount; ++e) {
+        double logSums[3] = { 0.0, 0.0, 0.0 };
+        int counts[3] = { 0, 0, 0 };
+        for (size_t base = 0; base + engineCount <= results.size(); base += engineCount) {
+            const CompareResult& reference = results[base];
+            const CompareResult& result = results[base + e];
+            if (reference.status != "ok" || result.status != "ok") continue;
+            double values[3] = {
+                speedup(reference.totalMilliseconds, result.totalMilliseconds),
+                speedup(reference.parseMilliseconds, result.parseMilliseconds),
+                speedup(reference.executeMilliseconds, result.executeMilliseconds)
+            };
+            for (int phase = 0; phase < 3; ++phase) {
+                if (values[phase] <= 0) continue;
+                logSums[phase] += std::log(values[phase]);
+                counts[phase]++;
+            }
+        }
+        out << "  " << std::left << std::setw(8) << options.engines[e].label << std::right;
+        for (int phase = 0; phase < 3; ++phase) {
+            if (phase > 0) out << " / ";
+            out << (counts[phase] ? formatSpeedup(std::exp(logSums[phase] / counts[phase]), options.thresholdPercent) : "-");
+        }
+        out << std::endl;
+    }
+    out.flags(savedFlags);
+    out.precision(savedPrecision);
+    std::remove(metricsFile.c_str());
+    return results;
+}
+
+void writeCompareJson(std::ostream& out, const std::vector<CompareResult>& results, const CompareOptions& options) {
+    std::ios_base::fmtflags savedFlags = out.flags();
+    std::streamsize savedPrecision = out.precision();
+    out << std::fixed << std::setprecision(3);
+    out << "{\"baseline\":\"" << options.engines.front().label << "\",\"repetitions\":" << options.repetitions
+        << ",\"engines\":[";
+    for (size_t e = 0; e < options.engines.size(); ++e) {
+        out << (e > 0 ? "," : "") << "{\"label\":\"" << options.engines[e].label << "\",\"dialect\":\""
+            << options.engines[e].dialect << "\"}";
+    }
+    out << "],\"results\":[";
+    for (size_t k = 0; k < results.size(); ++k) {
+        const CompareResult& result = results[k];
+        out << (k > 0 ? ",\n  " : "\n  ") << "{\"program\":\"" << result.program << "\",\"engine\":\"" << result.engine
+            << "\",\"status\":\"" << result.status << "\",\"total_ms\":" << result.totalMilliseconds;
+        if (result.parseMilliseconds >= 0) out << ",\"parse_ms\":" << result.parseMilliseconds;
+        if (result.executeMilliseconds >= 0) out << ",\"execute_ms\":" << result.executeMilliseconds;
+        out << "}";
+    }
+    out << "\n]}" << std::endl;
+    out.flags(savedFlags);
+    out.precision(savedPrecision);
+}
@@ -0,0 +1,58 @@
+// compare_bench.h
+#ifndef COMPARE_BENCH_H
+#define COMPARE_BENCH_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+// --- Сравнение версий KLL (1.0, 1.1, 1.2) на общем подмножестве языка ---
+// Версии нельзя собрать в одну программу (одинаковые имена классов; 1.0 и 1.1 завершают процесс
+// через exit() при любой ошибке), поэтому каждая версия запускается своим исполняемым файлом
+// в отдельном процессе. Программы корпуса используют только то, что есть во всех версиях
+// (int, массивы int, while, if/else, cout) и переписываются в синтаксис каждой версии:
+//   1.2: объявления; begin ... end;   arr int a[N]
+//   1.1: объявления и операторы без begin/end программы;   int arr a[N]
+//   1.0: то же;   arr a[N]
+// Время процесса замеряется всегда; время фаз (parse - лексер и разбор, execute) берется из
+// --metrics=json:FILE, если версия его поддерживает (проверяется первым запуском; 1.0 его не поддерживает,
+// для нее сравнивается только время процесса).
+// Ускорение считается относительно первой версии в списке (базовой) по программам, где обе версии
+// завершились успешно; фаза, медленнее базовой больше чем на threshold процентов, отмечается как регрессия.
+
+struct CompareEngine {
+    std::string label;   // Подпись в отчете (диалект, при повторе - с номером)
+    std::string dialect; // "1.0", "1.1" или "1.2"
+    std::string path;    // Исполняемый файл версии
+};
+
+struct CompareOptions {
+    std::vector<CompareEngine> engines;
+    int repetitions = 5;
+    double thresholdPercent = 10.0;
+    double scale = 1.0; // Множитель размеров программ (1.0 останавливает выполнение после 100 операций ОПС
+                        // на каждую операцию кода, поэтому для сравнения с 1.0 нужен масштаб около 0.001)
+    std::string workDirectory;                 // Программы в диалектах версий и файл метрик
+                                               // (пусто - <временный каталог>/kll-compare)
+    std::string programFilter;                 // Подстрока имени программы (пусто - все)
+};
+
+struct CompareResult {
+    std::string program;
+    std::string engine;
+    std::string status;        // "ok" или "failed" (ненулевой код завершения)
+    double totalMilliseconds;  // Медиана времени процесса
+    double parseMilliseconds;  // Медиана фазы parse (< 0 - версия не сообщает фазы)
+    double executeMilliseconds;
+};
+
+// "1.0", "1.1", "1.2"; false - неизвестный диалект
+bool isKnownDialect(const std::string& dialect);
+std::vector<std::string> getComparePrograms();
+
+// Печатает таблицу и сводку по версиям в out; возвращает результаты (пусто - ошибка подготовки)
+std::vector<CompareResult> runVersionComparison(const CompareOptions& options, std::ostream& out);
+
+void writeCompareJson(std::ostream& out, const std::vector<CompareResult>& results, const CompareOptions& options);
+
+#endif // COMPARE_BENCH_H
@@ -0,0 +1,564 @@
+// differential_fuzz.cpp
+#include "differential_fuzz.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+
+#include "lexer.h"
+#include "token_buffer.h"
+#include "parser.h"
+#include "symbol_table.h"
+#include "error_handler.h"
+#include "interpreter.h"
+#include "vector_kernels.h"
+
+namespace {
+
+    // --- Генератор случайных программ ---
+    // Целые значения переменных s*, массивов A* и выражений по модулю не больше BOUND: листья (константы,
+    // счетчик цикла, переменные, элементы) ограничены BOUND, а каждая форма выражения не увеличивает
+    // модуль (сумма делится на 2, произведение двух значений - на BOUND). Промежуточные значения не больше
+    // BOUND * BOUND = 2^30. Суммы по массивам записываются в r* и g*, которые в выражениях не участвуют.
+    const int BOUND = 32768;
+    const int INT_SCALARS = 4;   // s0..s3
+    const int FLOAT_SCALARS = 2; // f0, f1
+    const int INT_ARRAYS = 3;    // A0..A2
+    const int FLOAT_ARRAYS = 2;  // F0, F1
+    const int ARRAY_SIZES[] = { 5, 17, 64, 300, 4000, 20000 }; // 20000 - объем для автоматического распараллеливания
+    // Последняя строка тела выводит все скаляры, поэтому их значения сравниваются по выводу и тогда, когда
+    // -O1 и выше не поддерживают их значения в таблице символов (см. snapshotSymbols). При уменьшении не удаляется.
+    const char* const FINAL_OUTPUT_LINE =
+        "cout(s0); cout(s1); cout(s2); cout(s3); cout(r0); cout(r1); cout(i0); cout(f0); cout(f1); cout(g0)";
+
+    class FuzzProgramBuilder {
+    public:
+        FuzzProgramBuilder(std::uint64_t seed, size_t statements)
+            : state(seed * 0x9E3779B97F4A7C15ull + 1), statementCount(statements) {
+            arraySize = ARRAY_SIZES[next(sizeof(ARRAY_SIZES) / sizeof(ARRAY_SIZES[0]))];
+        }
+
+        // Каждый оператор тела - одна строка, заканчивающаяся ';' (пустой оператор перед end допустим),
+        // поэтому удаление любой строки тела при уменьшении сохраняет синтаксис
+        std::string build() {
+            std::string source;
+            for (const char* name : { "s0", "s1", "s2", "s3", "r0", "r1", "i0" }) source += std::string("int ") + name + ";\n";
+            for (const char* name : { "f0", "f1", "g0" }) source += std::string("float ") + name + ";\n";
+            for (int k = 0; k < INT_ARRAYS; ++k) source += "arr int A" + std::to_string(k) + "[" + size() + "];\n";
+            for (int k = 0; k < FLOAT_ARRAYS; ++k) source += "arr float F" + std::to_string(k) + "[" + size() + "];\n";
+            source += "begin\n";
+            for (int k = 0; k < INT_SCALARS; ++k) source += "s" + std::to_string(k) + " = " + std::to_string(next(100)) + ";\n";
+            for (int k = 0; k < FLOAT_SCALARS; ++k) source += "f" + std::to_string(k) + " = " + floatConstant() + ";\n";
+            source += "r0 = 0;\nr1 = 0;\ng0 = 0.0;\n";
+            for (int k = 0; k < INT_ARRAYS; ++k) {
+                source += "i0 = 0; while (i0 < " + size() + ") begin A" + std::to_string(k) + "[i0] = (i0 * "
+                    + std::to_string(1 + next(3)) + ") / 4 - " + std::to_string(next(100)) + "; i0 = i0 + 1 end;\n";
+            }
+            for (int k = 0; k < FLOAT_ARRAYS; ++k) {
+                source += "i0 = 0; while (i0 < " + size() + ") begin F" + std::to_string(k) + "[i0] = i0 * "
+                    + floatConstant() + " - " + floatConstant() + "; i0 = i0 + 1 end;\n";
+            }
+            for (size_t k = 0; k < statementCount; ++k) source += statement() + ";\n";
+            source += std::string(FINAL_OUTPUT_LINE) + "\nend\n";
+            return source;
+        }
+
+    private:
+        std::uint64_t state;
+        size_t statementCount;
+        int arraySize;
+
+        unsigned next(unsigned limit) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            return static_cast<unsigned>((state >> 33) % limit);
+        }
+        bool chance(unsigned percent) { return next(100) < percent; }
+
+        std::string size() const { return std::to_string(arraySize); }
+        std::string intScalar() { return "s" + std::to_string(next(INT_SCALARS)); }
+        std::string floatScalar() { return "f" + std::to_string(next(FLOAT_SCALARS)); }
+        std::string intArray() { return "A" + std::to_string(next(INT_ARRAYS)); }
+        std::string floatArray() { return "F" + std::to_string(next(FLOAT_ARRAYS)); }
+        std::string floatConstant() { return std::to_string(next(20)) + "." + std::to_string(next(4) * 25); }
+
+        // inLoop - внутри цикла по i0 (элементы с индексом i0); scalars - можно ли читать s*
+        std::string intLeaf(bool inLoop, bool scalars) {
+            switch (next(inLoop ? 5 : 3)) {
+            case 0: return std::to_string(next(100));
+            case 1: return scalars ? intScalar() : std::to_string(next(100));
+            case 2: return intArray() + "[" + std::to_string(next(static_cast<unsigned>(arraySize))) + "]";
+            case 3: return "i0";
+            default: return intArray() + "[i0]";
+            }
+        }
+
+        std::string intExpression(int depth, bool inLoop, bool scalars = true) {
+            if (depth == 0 || chance(25)) return intLeaf(inLoop, scalars);
+            std::string x = intExpression(depth - 1, inLoop, scalars);
+            switch (next(6)) {
+            case 0: return "(" + x + " + " + intExpression(depth - 1, inLoop, scalars) + ") / 2";
+            case 1: return "(" + x + " - " + intExpression(depth - 1, inLoop, scalars) + ") / 2";
+            case 2: return x + " * " + std::to_string(1 + next(3)) + " / 4";
+            case 3: return x + " / " + std::to_string(1 + next(9));
+            case 4: return "(" + x + " * " + intExpression(depth - 1, inLoop, scalars) + ") / " + std::to_string(BOUND);
+            default: return "-" + (x.find(' ') == std::string::npos ? x : "(" + x + ")");
+            }
+        }
+
+        std::string floatLeaf(bool inLoop, bool scalars) {
+            switch (next(inLoop ? 4 : 3)) {
+            case 0: return floatConstant();
+            case 1: return scalars ? floatScalar() : floatConstant();
+            case 2: return inLoop && chance(50) ? intArray() + "[i0]" : floatArray() + "[" + std::to_string(next(static_cast<unsigned>(arraySize))) + "]";
+            default: return floatArray() + "[i0]";
+            }
+        }
+
+        std::string floatExpression(int depth, bool inLoop, bool scalars = true) {
+            if (depth == 0 || chance(25)) return floatLeaf(inLoop, scalars);
+            std::string x = floatExpression(depth - 1, inLoop, scalars);
+            switch (next(4)) {
+            case 0: return "(" + x + " + " + floatExpression(depth - 1, inLoop, scalars) + ") * 0.5";
+            case 1: return "(" + x + " - " + intExpression(depth - 1, inLoop, scalars) + ") * 0.5";
+            case 2: return x + " * 0.75";
+            default: return x + " / 2.5";
+            }
+        }
+
+        std::string condition(bool inLoop) {
+            static const char* const comparisons[] = { " < ", " > ", " ~ ", " ! " };
+            return intExpression(1, inLoop) + comparisons[next(4)] + intExpression(1, inLoop);
+        }
+
+        std::string loopHeader() { return "i0 = 0; while (i0 < " + size() + ") begin "; }
+
+        // Выражение над массивами целиком: массивы длины arraySize и скаляры-константы
+        std::string wholeArrayExpression(int depth) {
+            if (depth == 0 || chance(30)) return intArray();
+            std::string x = wholeArrayExpression(depth - 1);
+            switch (next(3)) {
+            case 0: return "(" + x + " + " + wholeArrayExpression(depth - 1) + ") / 2";
+            case 1: return "(" + x + " - " + std::to_string(next(100)) + ") * " + std::to_string(1 + next(3)) + " / 4";
+            default: return x + " / " + std::to_string(1 + next(9));
+            }
+        }
+
+        // Редко (и намеренно) - ошибки времени выполнения, которые все движки должны выдать одинаково
+        std::string faultingStatement() {
+            switch (next(3)) {
+            case 0: return intScalar() + " = " + intScalar() + " / (" + intLeaf(false, true) + " - " + intLeaf(false, true) + ")";
+            case 1: return intScalar() + " = " + intArray() + "[" + std::to_string(arraySize + static_cast<int>(next(3))) + "]";
+            default: return loopHeader() + intArray() + "[i0] = " + intArray() + "[i0] / (" + intArray() + "[i0] - "
+                + std::to_string(next(50)) + "); i0 = i0 + 1 end";
+            }
+        }
+
+        std::string loopBody() {
+            std::string body = intArray() + "[i0] = " + intExpression(3, true);
+            if (chance(40)) body += "; " + floatArray() + "[i0] = " + floatExpression(2, true);
+            if (chance(30)) body += "; if (" + condition(true) + ") " + intScalar() + " = " + intExpression(2, true);
+            return body;
+        }
+
+        std::string statement() {
+            unsigned kind = next(100);
+            if (kind < 5) return faultingStatement();
+            if (kind < 20) return intScalar() + " = " + intExpression(3, false);
+            if (kind < 30) return floatScalar() + " = " + floatExpression(3, false);
+            if (kind < 40) {
+                std::string elsePart = chance(50) ? " else " + floatScalar() + " = " + floatExpression(2, false) : "";
+                return "if (" + condition(false) + ") " + intScalar() + " = " + intExpression(2, false) + elsePart;
+            }
+            if (kind < 55) {
+                std::string loop = loopHeader() + loopBody() + "; i0 = i0 + 1 end";
+                return chance(15) ? "if (" + condition(false) + ") begin " + loop + " end" : loop;
+            }
+            if (kind < 63) {
+                std::string target = chance(50) ? "r0" : "r1";
+                return target + " = 0; " + loopHeader() + target + " = " + target + " + " + intArray() + "[i0]; i0 = i0 + 1 end";
+            }
+            if (kind < 73) return intArray() + " = " + wholeArrayExpression(2);
+            if (kind < 80) {
+                return chance(50) ? "r1 = sum(" + intArray() + " + " + intArray() + ")"
+                    : "g0 = sum(" + floatArray() + " * 0.5)";
+            }
+            if (kind < 85) {
+                // Скаляр сначала читается, потом записывается: значение переносится между итерациями,
+                // и цикл нельзя распараллелить, хотя r* в нем - обычная сумма
+                std::string scalar = intScalar();
+                std::string target = chance(50) ? "r0" : "r1";
+                return target + " = 0; " + loopHeader() + target + " = " + target + " + " + scalar + "; " + scalar + " = ("
+                    + scalar + " + " + intExpression(2, true, false) + ") / 2; " + intArray() + "[i0] = " + scalar + "; i0 = i0 + 1 end";
+            }
+            if (kind < 95) {
+                // Канонический параллельный цикл: пишется только элемент [i0], читаются элементы [i0] и s*
+                std::string target = intArray();
+                std::string value = intExpression(3, true);
+                if (value.find(target + "[") != std::string::npos) value = std::to_string(next(100));
+                if (chance(50)) {
+                    return "r0 = 0; i0 = 0; parallel reduce(+ r0) while (i0 < " + size() + ") begin " + target + "[i0] = "
+                        + value + "; r0 = r0 + " + target + "[i0]; i0 = i0 + 1 end";
+                }
+                return "i0 = 0; parallel while (i0 < " + size() + ") begin " + target + "[i0] = " + value + "; i0 = i0 + 1 end";
+            }
+            switch (next(3)) {
+            case 0: return "cout(" + intExpression(2, false) + ")";
+            case 1: return "cout(" + floatExpression(2, false) + ")";
+            default: return "cout(" + intArray() + "[" + std::to_string(next(static_cast<unsigned>(arraySize))) + "])";
+            }
+        }
+    };
+
+    // --- Движки ---
+    struct FuzzEngine {
+        const char* name;
+        int optimizationLevel;
+        bool vectorize;
+        bool autoParallel;
+        size_t threads;
+        bool pretokenize;
+        InstructionSet instructionSet;
+    };
+
+    const FuzzEngine ENGINES[] = {
+        { "O0",               0, false, false, 1, false, InstructionSet::SCALAR }, // Эталон
+        { "O1",               1, false, false, 1, false, InstructionSet::SCALAR },
+        { "O2",               2, false, false, 1, false, InstructionSet::SCALAR },
+        { "O3",               3, false, false, 1, true,  InstructionSet::SCALAR },
+        { "O0-vec",           0, true,  false, 1, false, InstructionSet::SCALAR },
+        { "O2-vec-scalar",    2, true,  false, 1, false, InstructionSet::SCALAR },
+        { "O2-vec-sse2",      2, true,  false, 1, false, InstructionSet::SSE2 },
+        { "O3-vec-avx2",      3, true,  false, 1, false, InstructionSet::AVX2 },
+        { "O2-par4",          2, false, true,  4, false, InstructionSet::AVX2 },
+        { "O3-vec-par2",      3, true,  true,  2, true,  InstructionSet::AVX2 },
+    };
+    const size_t ENGINE_COUNT = sizeof(ENGINES) / sizeof(ENGINES[0]);
+
+    struct FuzzOutcome {
+        bool compiled = false;
+        std::vector<std::string> errors; // Тип и текст без позиции и адреса ОПС
+        std::string output;
+        std::vector<std::string> state;  // "имя = значение", "имя[i] = значение"
+        bool scalarState = false;        // В state есть переменные (не только элементы массивов)
+    };
+
+    std::string errorTypeName(ErrorInfo::ErrorType type) {
+        switch (type) {
+        case ErrorInfo::ErrorType::LEXICAL: return "Lexical";
+        case ErrorInfo::ErrorType::SYNTAX: return "Syntax";
+        case ErrorInfo::ErrorType::SEMANTIC: return "Semantic";
+        default: return "Runtime";
+        }
+    }
+
+    // "RPN[12]: Division by zero." -> "Division by zero." (адреса ОПС зависят от оптимизаций)
+    std::string normalizeErrorMessage(const std::string& message) {
+        if (message.rfind("RPN[", 0) == 0) {
+            size_t end = message.find("]: ");
+            if (end != std::string::npos) return message.substr(end + 3);
+        }
+        return message;
+    }
+
+    std::string formatStoredValue(const std::optional<StoredValue>& value) {
+        if (!value || std::holds_alternative<std::monostate>(*value)) return "<uninitialized>";
+        std::ostringstream text;
+        if (std::holds_alternative<int>(*value)) text << std::get<int>(*value);
+        else text << std::showpoint << std::setprecision(9) << std::get<float>(*value); // Точка - признак float для sameValueText
+        return text.str();
+    }
+
+    // Переменные включаются только без оптимизаций: с -O1 и выше SCCP и удаление мертвых записей убирают
+    // присваивания, значение которых распространено в места чтения, и в таблице остается старое значение
+    // или ни одного. Переменные при этом проверяются по итоговому выводу, элементы массивов - всегда.
+    std::vector<std::string> snapshotSymbols(const SymbolTable& symbolTable, bool includeScalars) {
+        std::vector<std::string> state;
+        for (size_t index = 0; index < symbolTable.getTableSize(); ++index) {
+            const std::string& name = symbolTable.getSymbolName(index);
+            SymbolType type = symbolTable.getSymbolType(index);
+            if (type == SymbolType::VARIABLE_INT || type == SymbolType::VARIABLE_FLOAT) {
+                if (includeScalars) state.push_back(name + " = " + formatStoredValue(symbolTable.getVariableValue(index)));
+                continue;
+            }
+            size_t size = symbolTable.getArrayDeclaredSize(index).value_or(0);
+            for (size_t element = 0; element < size; ++element) {
+                state.push_back(name + "[" + std::to_string(element) + "] = "
+                    + formatStoredValue(symbolTable.getArrayElementValue(index, element)));
+            }
+        }
+        return state;
+    }
+
+    FuzzOutcome runEngine(const FuzzEngine& engine, const std::string& source) {
+        FuzzOutcome outcome;
+        std::ostringstream output;
+        std::istringstream input;
+        std::streambuf* savedOutput = std::cout.rdbuf(output.rdbuf());
+        std::streambuf* savedInput = std::cin.rdbuf(input.rdbuf());
+        VectorKernels::setInstructionSet(engine.instructionSet);
+
+        ErrorHandler errorHandler;
+        SymbolTable symbolTable(errorHandler);
+        Lexer lexer(source, symbolTable, errorHandler);
+        TokenBuffer tokens;
+        if (engine.pretokenize) tokens = TokenBuffer::tokenize(lexer, source);
+        Parser parser = engine.pretokenize ? Parser(tokens, symbolTable, errorHandler) : Parser(lexer, symbolTable, errorHandler);
+        parser.setOptimizationLevel(engine.optimizationLevel);
+        parser.setLoopVectorization(engine.vectorize);
+        parser.setAutoParallelization(engine.autoParallel);
+        outcome.compiled = parser.parse() && !errorHandler.hasErrors();
+        if (outcome.compiled) {
+            Interpreter interpreter(parser.getRPNCode(), symbolTable, errorHandler, &parser.getVectorLoops(), &parser.getParallelLoops());
+            interpreter.setThreadCount(engine.threads);
+            interpreter.setInstructionLimit(Interpreter::MAX_INSTRUCTION_LIMIT);
+            interpreter.execute();
+        }
+
+        std::cout.rdbuf(savedOutput);
+        std::cin.rdbuf(savedInput);
+        std::cout.clear();
+        std::cin.clear();
+
+        for (const ErrorInfo& error : errorHandler.getErrors()) {
+            outcome.errors.push_back(errorTypeName(error.type) + ": " + normalizeErrorMessage(error.message));
+        }
+        outcome.output = output.str();
+        outcome.scalarState = engine.optimizationLevel == 0;
+        if (outcome.compiled && !errorHandler.hasErrors()) outcome.state = snapshotSymbols(symbolTable, outcome.scalarState);
+        return outcome;
+    }
+
+    // Числа совпадают точно (int) или с допуском (float: сумма может считаться в другом порядке, и ошибка
+    // последовательного сложения float растет как число слагаемых * FLT_EPSILON - для 20000 элементов ~2e-3)
+    const double FLOAT_RELATIVE_TOLERANCE = 20000 * FLT_EPSILON;
+
+    bool sameValueText(const std::string& expected, const std::string& actual) {
+        if (expected == actual) return true;
+        char* expectedEnd = nullptr;
+        char* actualEnd = nullptr;
+        double x = std::strtod(expected.c_str(), &expectedEnd);
+        double y = std::strtod(actual.c_str(), &actualEnd);
+        if (*expectedEnd != '\0' || *actualEnd != '\0' || expected.find_first_of(".e") == std::string::npos) return false;
+        return std::fabs(x - y) <= 1e-3 + FLOAT_RELATIVE_TOLERANCE * std::max(std::fabs(x), std::fabs(y));
+    }
+
+    std::vector<std::string> splitWords(const std::string& text) {
+        std::vector<std::string> words;
+        std::istringstream stream(text);
+        std::string word;
+        while (stream >> word) words.push_back(word);
+        return words;
+    }
+
+    std::string quoteText(const std::string& text) {
+        return "'" + text + "'";
+    }
+
+    // Пустая строка - результаты совпадают; иначе описание первого расхождения
+    std::string compareOutcomes(const FuzzOutcome& reference, const FuzzOutcome& outcome) {
+        if (reference.compiled != outcome.compiled) {
+            return std::string("compilation ") + (outcome.compiled ? "succeeded" : "failed") + ", reference "
+                + (reference.compiled ? "succeeded" : "failed") + (outcome.errors.empty() ? "" : ": " + outcome.errors.front());
+        }
+        for (size_t k = 0; k < std::max(reference.errors.size(), outcome.errors.size()); ++k) {
+            std::string expected = k < reference.errors.size() ? reference.errors[k] : "<no error>";
+            std::string actual = k < outcome.errors.size() ? outcome.errors[k] : "<no error>";
+            if (expected != actual) return "error " + std::to_string(k + 1) + ": expected " + quoteText(expected) + ", got " + quoteText(actual);
+        }
+        std::vector<std::string> expectedOutput = splitWords(reference.output);
+        std::vector<std::string> actualOutput = splitWords(outcome.output);
+        for (size_t k = 0; k < std::max(expectedOutput.size(), actualOutput.size()); ++k) {
+            std::string expected = k < expectedOutput.size() ? expectedOutput[k] : "<end of output>";
+            std::string actual = k < actualOutput.size() ? actualOutput[k] : "<end of output>";
+            if (!sameValueText(expected, actual)) {
+                return "output word " + std::to_string(k + 1) + ": expected " + quoteText(expected) + ", got " + quoteText(actual);
+            }
+        }
+        std::vector<std::string> expectedState;
+        for (const std::string& entry : reference.state) {
+            bool scalar = entry.find('[') == std::string::npos;
+            if (!scalar || outcome.scalarState) expectedState.push_back(entry);
+        }
+        for (size_t k = 0; k < std::max(expectedState.size(), outcome.state.size()); ++k) {
+            std::string expected = k < expectedState.size() ? expectedState[k] : "<missing>";
+            std::string actual = k < outcome.state.size() ? outcome.state[k] : "<missing>";
+            size_t expectedSplit = expected.find(" = ");
+            size_t actualSplit = actual.find(" = ");
+            bool same = expectedSplit != std::string::npos && actualSplit != std::string::npos
+                && expected.compare(0, expectedSplit, actual, 0, actualSplit) == 0
+                && sameValueText(expected.substr(expectedSplit + 3), actual.substr(actualSplit + 3));
+            if (!same) return "final state: expected " + quoteText(expected) + ", got " + quoteText(actual);
+        }
+        return "";
+    }
+
+    std::string differenceWith(const FuzzEngine& engine, const std::string& source) {
+        return compareOutcomes(runEngine(ENGINES[0], source), runEngine(engine, source));
+    }
+
+    // Удаляет группы строк (от половины программы до одной строки), пока расхождение с движком сохраняется.
+    // Строки begin, end и итоговый вывод не удаляются.
+    std::string minimizeProgram(const FuzzEngine& engine, const std::string& source) {
+        std::vector<std::string> lines;
+        std::istringstream stream(source);
+        for (std::string line; std::getline(stream, line);) lines.push_back(line);
+        auto join = [](const std::vector<std::string>& parts) {
+            std::string text;
+            for (const std::string& part : parts) text += part + "\n";
+            return text;
+        };
+
+        size_t chunk = std::max<size_t>(1, lines.size() / 2);
+        while (true) {
+            bool reduced = false;
+            for (size_t start = 0; start < lines.size();) {
+                size_t end = std::min(lines.size(), start + chunk);
+                bool keepsFrame = std::any_of(lines.begin() + start, lines.begin() + end,
+                    [](const std::string& line) { return line == "begin" || line == "end" || line == FINAL_OUTPUT_LINE; });
+                std::vector<std::string> candidate(lines.begin(), lines.begin() + start);
+                candidate.insert(candidate.end(), lines.begin() + end, lines.end());
+                if (!keepsFrame && !differenceWith(engine, join(candidate)).empty()) {
+                    lines = candidate;
+                    reduced = true;
+                }
+                else {
+                    start = end;
+                }
+            }
+            if (!reduced) {
+                if (chunk == 1) break;
+                chunk /= 2;
+            }
+        }
+        return join(lines);
+    }
+
+    bool selected(const std::string& list, const std::string& name) {
+        if (list.empty()) return true;
+        std::stringstream names(list);
+        std::string item;
+        while (std::getline(names, item, ',')) {
+            if (item == name) return true;
+        }
+        return false;
+    }
+
+    // Проверяет программу во всех выбранных движках; расхождения добавляются в mismatches
+    void checkProgram(const FuzzOptions& options, std::uint64_t seed, const std::string& source,
+        std::vector<FuzzMismatch>& mismatches, std::ostream& out) {
+        FuzzOutcome reference = runEngine(ENGINES[0], source);
+        for (size_t e = 1; e < ENGINE_COUNT; ++e) {
+            const FuzzEngine& engine = ENGINES[e];
+            if (!selected(options.engines, engine.name)) continue;
+            std::string difference = compareOutcomes(reference, runEngine(engine, source));
+            if (difference.empty()) continue;
+
+            FuzzMismatch mismatch{ seed, engine.name, difference, source };
+            if (options.minimize) {
+                mismatch.program = minimizeProgram(engine, source);
+                mismatch.difference = differenceWith(engine, mismatch.program);
+            }
+            std::string baseName = options.outputDirectory + "/mismatch_" + (seed != 0 ? std::to_string(seed) : std::string("file"))
+                + "_" + engine.name;
+            std::ofstream(baseName + ".kll") << mismatch.program;
+            std::ofstream(baseName + ".txt") << "engine: " << engine.name << "\nreference: " << ENGINES[0].name
+                << "\nseed: " << seed << "\n" << mismatch.difference << "\n";
+            out << "MISMATCH seed " << seed << ", engine " << engine.name << ": " << mismatch.difference
+                << " (" << baseName << ".kll)" << std::endl;
+            mismatches.push_back(mismatch);
+        }
+    }
+
+} // namespace
+
+std::vector<std::string> getFuzzEngineNames() {
+    std::vector<std::string> names;
+    for (const FuzzEngine& engine : ENGINES) names.push_back(engine.name);
+    return names;
+}
+
+std::string generateFuzzProgram(std::uint64_t seed, size_t statements) {
+    return FuzzProgramBuilder(seed, statements).build();
+}
+
+std::vector<FuzzMismatch> runDifferentialFuzz(const FuzzOptions& requested, std::ostream& out) {
+    std::vector<FuzzMismatch> mismatches;
+    std::error_code error;
+    FuzzOptions options = requested;
+    if (options.outputDirectory.empty()) {
+        std::filesystem::path temporary = std::filesystem::temp_directory_path(error);
+        options.outputDirectory = ((error ? std::filesystem::path(".") : temporary) / "kll-fuzz").string();
+    }
+    std::filesystem::create_directories(options.outputDirectory, error);
+    if (error) {
+        std::cerr << "Error: Could not create directory '" << options.outputDirectory << "': " << error.message() << std::endl;
+        return mismatches;
+    }
+    InstructionSet savedInstructionSet = VectorKernels::getInstructionSet();
+
+    if (!options.programFile.empty()) {
+        std::ifstream programFile(options.programFile, std::ios::binary);
+        if (!programFile.is_open()) {
+            std::cerr << "Error: Could not open file '" << options.programFile << "'" << std::endl;
+            return mismatches;
+        }
+        std::stringstream buffer;
+        buffer << programFile.rdbuf();
+        checkProgram(options, 0, buffer.str(), mismatches, out);
+        out << (mismatches.empty() ? "No mismatches" : std::to_string(mismatches.size()) + " mismatch(es)") << std::endl;
+        VectorKernels::setInstructionSet(savedInstructionSet);
+        return mismatches;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t programs = 0;
+    size_t invalid = 0;
+    for (size_t iteration = 0; iteration < options.iterations; ++iteration) {
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (options.maxSeconds > 0 && elapsed > options.maxSeconds) break;
+        std::uint64_t seed = options.seed + iteration;
+        std::string source = generateFuzzProgram(seed, options.statements);
+        ++programs;
+        if (!runEngine(ENGINES[0], source).compiled) {
+            // Ошибка генератора: эталон не компилирует программу
+            ++invalid;
+            std::ofstream(options.outputDirectory + "/invalid_" + std::to_string(seed) + ".kll") << source;
+            continue;
+        }
+        checkProgram(options, seed, source, mismatches, out);
+        if ((iteration + 1) % 100 == 0) {
+            out << programs << " programs, " << mismatches.size() << " mismatch(es)" << std::endl;
+        }
+    }
+    out << programs << " programs (seeds " << options.seed << ".." << options.seed + programs - 1 << "), "
+        << mismatches.size() << " mismatch(es), " << invalid << " invalid" << std::endl;
+    VectorKernels::setInstructionSet(savedInstructionSet);
+    return mismatches;
+}
+
+#ifdef KLL_LIBFUZZER
+// Точка входа libFuzzer: первые 8 байт входа - затравка генератора; расхождение завершает процесс
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, size_t size) {
+    std::uint64_t seed = 0;
+    for (size_t k = 0; k < size && k < sizeof(seed); ++k) seed |= static_cast<std::uint64_t>(data[k]) << (8 * k);
+    std::string source = generateFuzzProgram(seed, 24);
+    FuzzOutcome reference = runEngine(ENGINES[0], source);
+    if (!reference.compiled) return 0;
+    for (size_t e = 1; e < ENGINE_COUNT; ++e) {
+        std::string difference = compareOutcomes(reference, runEngine(ENGINES[e], source));
+        if (!difference.empty()) {
+            std::cerr << "Mismatch with " << ENGINES[e].name << ": " << difference << "\n" << source << std::endl;
+            std::abort();
+        }
+    }
+    return 0;
+}
+#endif
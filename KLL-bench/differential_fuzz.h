@@ -0,0 +1,53 @@
+// differential_fuzz.h
+#ifndef DIFFERENTIAL_FUZZ_H
+#define DIFFERENTIAL_FUZZ_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+
+// --- Дифференциальное тестирование режимов интерпретатора KLL 1.2 ---
+// Случайная программа (затравка seed) компилируется и выполняется в каждом режиме ("движке"):
+// уровни оптимизации -O0..-O3, векторизация циклов с наборами инструкций scalar/SSE2/AVX2,
+// распараллеливание с разным числом потоков, разбор из лексера и из TokenBuffer. Эталон - первый
+// движок (-O0 без векторизации и распараллеливания). С эталоном сравниваются вывод программы (числа
+// float - с допуском, сумма векторизованного цикла может складываться в другом порядке), ошибки
+// (тип и текст без адреса ОПС и позиции) и, если ошибок нет, итоговые значения всех переменных
+// и элементов массивов в таблице символов.
+// Программа, на которой движок разошелся с эталоном, уменьшается: строки удаляются, пока
+// расхождение с тем же движком сохраняется. Уменьшенная программа и описание расхождения
+// сохраняются в outputDirectory.
+// Генератор строит программы без переполнения int (значения ограничены по построению) и с
+// конечными циклами; деление на ноль и выход за границы массива появляются редко и намеренно.
+// Все выполняется в одном процессе без сети. Для сборки с libFuzzer (-fsanitize=fuzzer) без
+// bench_main.cpp определите KLL_LIBFUZZER: входные байты станут затравкой генератора.
+
+struct FuzzOptions {
+    std::uint64_t seed = 1;        // Затравка первой программы (следующие - seed + 1, ...)
+    size_t iterations = 1000;
+    double maxSeconds = 0.0;       // 0 - без ограничения времени
+    size_t statements = 24;        // Операторов в теле программы
+    bool minimize = true;
+    std::string outputDirectory;   // Пусто - <временный каталог>/kll-fuzz
+    std::string programFile;       // Если задан: проверить этот файл вместо случайных программ
+    std::string engines;           // Имена движков через запятую (пусто - все); эталон выполняется всегда
+};
+
+struct FuzzMismatch {
+    std::uint64_t seed;            // 0 - программа из файла
+    std::string engine;
+    std::string difference;        // Первое расхождение с эталоном
+    std::string program;           // Уменьшенная программа
+};
+
+std::vector<std::string> getFuzzEngineNames();
+
+// Случайная корректная программа KLL 1.2 (то же seed - тот же текст)
+std::string generateFuzzProgram(std::uint64_t seed, size_t statements);
+
+// Печатает ход и расхождения в out; возвращает найденные расхождения
+std::vector<FuzzMismatch> runDifferentialFuzz(const FuzzOptions& options, std::ostream& out);
+
+#endif // DIFFERENTIAL_FUZZ_H
@@ -0,0 +1,397 @@
+// golden_tests.cpp
+#include "golden_tests.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/wait.h> // WIFEXITED, WEXITSTATUS для кода std::system
+#endif
+
+namespace {
+
+    const char* const OUTPUT_SEPARATOR = "---------------------"; // Рамка вывода программы в Main.cpp
+
+    struct GoldenTestCase {
+        std::string name;
+        std::string sourceFile;
+        std::string inputFile;                   // Пусто - без входных данных
+        std::string arguments;                   // Содержимое .args без переводов строк
+        std::optional<std::string> expected;     // Содержимое .expected
+        std::optional<std::string> expectedErr;  // Содержимое .expected_err
+    };
+
+    struct BaselineEntry {
+        long long instructions;
+        double executeMilliseconds;
+        double milliseconds;
+    };
+
+    std::optional<std::string> readFile(const std::string& fileName) {
+        std::ifstream file(fileName, std::ios::binary);
+        if (!file.is_open()) return std::nullopt;
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    }
+
+    // Строки без '\r' и завершающих пробелов; пустые строки в конце отбрасываются
+    std::vector<std::string> splitLines(const std::string& text) {
+        std::vector<std::string> lines;
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line)) {
+            size_t end = line.find_last_not_of(" \t\r");
+            lines.push_back(end == std::string::npos ? std::string() : line.substr(0, end + 1));
+        }
+        while (!lines.empty() && lines.back().empty()) lines.pop_back();
+        return lines;
+    }
+
+    // Вывод программы - строки между первым и вторым разделителем (весь stdout, если разделителей нет)
+    std::vector<std::string> programOutput(const std::string& standardOutput) {
+        std::vector<std::string> lines = splitLines(standardOutput);
+        std::vector<std::string>::iterator first = std::find(lines.begin(), lines.end(), OUTPUT_SEPARATOR);
+        if (first == lines.end()) return lines;
+        std::vector<std::string>::iterator second = std::find(first + 1, lines.end(), OUTPUT_SEPARATOR);
+        return std::vector<std::string>(first + 1, second);
+    }
+
+    // Строка целиком соответствует образцу; "..." в образце - любой текст
+    bool matchesPattern(const std::string& line, const std::string& pattern) {
+        std::vector<std::string> parts;
+        size_t start = 0;
+        for (size_t position = pattern.find("..."); position != std::string::npos; position = pattern.find("...", start)) {
+            parts.push_back(pattern.substr(start, position - start));
+            start = position + 3;
+        }
+        parts.push_back(pattern.substr(start));
+        if (parts.size() == 1) return line == pattern;
+
+        if (line.compare(0, parts.front().size(), parts.front()) != 0) return false;
+        size_t position = parts.front().size();
+        for (size_t k = 1; k + 1 < parts.size(); ++k) {
+            position = line.find(parts[k], position);
+            if (position == std::string::npos) return false;
+            position += parts[k].size();
+        }
+        const std::string& last = parts.back();
+        return line.size() >= position + last.size() && line.compare(line.size() - last.size(), last.size(), last) == 0;
+    }
+
+    // Пустая строка - вывод совпал; иначе описание первого расхождения
+    std::string compareOutput(const GoldenTestCase& test, int exitCode, const std::string& standardOutput,
+        const std::string& standardError) {
+        if (test.expectedErr) {
+            if (exitCode == 0) return "expected failure, exit code 0";
+            std::vector<std::string> errorLines = splitLines(standardError);
+            for (const std::string& pattern : splitLines(*test.expectedErr)) {
+                if (pattern.empty()) continue;
+                bool found = std::any_of(errorLines.begin(), errorLines.end(),
+                    [&pattern](const std::string& line) { return matchesPattern(line, pattern); });
+                if (!found) return "stderr lacks: " + pattern;
+            }
+            return "";
+        }
+        if (exitCode != 0) {
+            std::vector<std::string> errorLines = splitLines(standardError);
+            return "exit code " + std::to_string(exitCode) + (errorLines.empty() ? "" : ": " + errorLines.front());
+        }
+        if (test.expected) {
+            std::vector<std::string> actual = programOutput(standardOutput);
+            std::vector<std::string> expected = splitLines(*test.expected);
+            for (size_t k = 0; k < std::max(actual.size(), expected.size()); ++k) {
+                std::string actualLine = k < actual.size() ? actual[k] : "<end of output>";
+                std::string expectedLine = k < expected.size() ? expected[k] : "<end of output>";
+                if (actualLine != expectedLine) {
+                    return "line " + std::to_string(k + 1) + ": expected '" + expectedLine + "', got '" + actualLine + "'";
+                }
+            }
+        }
+        return "";
+    }
+
+    std::vector<GoldenTestCase> findTests(const GoldenTestOptions& options) {
+        std::vector<GoldenTestCase> tests;
+        std::error_code error;
+        for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(options.testsDirectory, error)) {
+            if (!entry.is_regular_file() || entry.path().extension() != ".kll") continue;
+            std::string name = entry.path().stem().string();
+            if (!options.filter.empty() && name.find(options.filter) == std::string::npos) continue;
+            std::string baseName = options.testsDirectory + "/" + name;
+            GoldenTestCase test{ name, baseName + ".kll", "", "", readFile(baseName + ".expected"), readFile(baseName + ".expected_err") };
+            if (std::filesystem::exists(baseName + ".input")) test.inputFile = baseName + ".input";
+            for (const std::string& line : splitLines(readFile(baseName + ".args").value_or(""))) {
+                if (!line.empty()) test.arguments += " " + line;
+            }
+            tests.push_back(test);
+        }
+        std::sort(tests.begin(), tests.end(),
+            [](const GoldenTestCase& a, const GoldenTestCase& b) { return a.name < b.name; });
+        return tests;
+    }
+
+    std::optional<double> findPhaseMilliseconds(const std::string& json, const std::string& phase) {
+        std::string key = "{\"name\":\"" + phase + "\",\"wall_ms\":";
+        size_t position = json.find(key);
+        if (position == std::string::npos) return std::nullopt;
+        return std::strtod(json.c_str() + position + key.size(), nullptr);
+    }
+
+    std::optional<long long> findInstructions(const std::string& json) {
+        const std::string key = "\"instructions_executed\":";
+        size_t position = json.find(key);
+        if (position == std::string::npos) return std::nullopt;
+        return std::strtoll(json.c_str() + position + key.size(), nullptr, 10);
+    }
+
+    // Код завершения процесса по значению std::system (-1 - завершен сигналом)
+    int exitCodeOf(int systemResult) {
+#ifdef _WIN32
+        return systemResult;
+#else
+        return WIFEXITED(systemResult) ? WEXITSTATUS(systemResult) : -1;
+#endif
+    }
+
+    std::string quotedCommand(const std::string& command) {
+#ifdef _WIN32
+        return "\"" + command + "\""; // cmd /c снимает внешние кавычки
+#else
+        return command;
+#endif
+    }
+
+    // Пустая строка - исполняемый файл есть и выполняет простейшую программу; иначе описание проблемы.
+    // Без этой проверки отсутствующий файл выглядел бы как провал каждого теста ("exit code 127").
+    std::string checkEngine(const GoldenTestOptions& options) {
+        std::error_code error;
+        if (!std::filesystem::is_regular_file(options.enginePath, error)) return "engine '" + options.enginePath + "' not found";
+        std::string sourceFile = options.workDirectory + "/engine_probe.kll";
+        std::string outputFile = options.workDirectory + "/engine_probe.out";
+        std::ofstream(sourceFile) << "int x;\nbegin\n    x = 1\nend\n";
+        std::string command = "\"" + options.enginePath + "\" \"" + sourceFile + "\" > \"" + outputFile + "\" 2>&1";
+        int exitCode = exitCodeOf(std::system(quotedCommand(command).c_str()));
+        if (exitCode == 0) return "";
+        std::vector<std::string> lines = splitLines(readFile(outputFile).value_or(""));
+        return "engine '" + options.enginePath + "' failed to run a trivial program (exit code " + std::to_string(exitCode) + ")"
+            + (lines.empty() ? "" : ": " + lines.front());
+    }
+
+    // Поддерживает ли исполняемый файл --metrics=json:FILE
+    bool probeMetricsSupport(const GoldenTestOptions& options) {
+        std::string sourceFile = options.workDirectory + "/engine_probe.kll"; // Записан checkEngine
+        std::string metricsFile = options.workDirectory + "/metrics_probe.json";
+        std::remove(metricsFile.c_str());
+        std::string command = "\"" + options.enginePath + "\" --metrics=json:\"" + metricsFile + "\" \"" + sourceFile + "\" > \""
+            + options.workDirectory + "/metrics_probe.out\" 2>&1";
+        std::system(quotedCommand(command).c_str());
+        return readFile(metricsFile).value_or("").find("\"phases\"") != std::string::npos;
+    }
+
+    double median(std::vector<double> values) {
+        if (values.empty()) return -1.0;
+        std::sort(values.begin(), values.end());
+        size_t middle = values.size() / 2;
+        return (values.size() % 2 == 1) ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+    }
+
+    GoldenTestResult runTest(const GoldenTestCase& test, const GoldenTestOptions& options, bool withMetrics) {
+        GoldenTestResult result{ test.name, "pass", "", -1.0, -1.0, -1, "-" };
+        std::string baseName = options.workDirectory + "/" + test.name;
+        std::string outputFile = baseName + ".out";
+        std::string errorFile = baseName + ".err";
+        std::string metricsFile = baseName + ".metrics.json";
+        std::string command = "\"" + options.enginePath + "\"";
+        if (withMetrics) command += " --metrics=json:\"" + metricsFile + "\"";
+        command += test.arguments + " \"" + test.sourceFile + "\"";
+        if (!test.inputFile.empty()) command += " < \"" + test.inputFile + "\"";
+        command += " > \"" + outputFile + "\" 2> \"" + errorFile + "\"";
+        command = quotedCommand(command);
+
+        std::vector<double> times;
+        std::vector<double> executeTimes;
+        for (int repetition = 0; repetition < options.repetitions; ++repetition) {
+            std::remove(metricsFile.c_str());
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            int exitCode = exitCodeOf(std::system(command.c_str()));
+            times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+            if (repetition == 0) {
+                result.message = compareOutput(test, exitCode, readFile(outputFile).value_or(""), readFile(errorFile).value_or(""));
+                if (!result.message.empty()) {
+                    result.status = "fail";
+                    break;
+                }
+            }
+            std::string metrics = readFile(metricsFile).value_or("");
+            if (std::optional<double> execute = findPhaseMilliseconds(metrics, "execute")) executeTimes.push_back(*execute);
+            if (std::optional<long long> instructions = findInstructions(metrics)) result.instructions = *instructions;
+        }
+        result.milliseconds = median(times);
+        result.executeMilliseconds = median(executeTimes);
+        return result;
+    }
+
+    std::map<std::string, BaselineEntry> readBaseline(const std::string& fileName) {
+        std::map<std::string, BaselineEntry> baseline;
+        std::ifstream file(fileName);
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream fields(line);
+            std::string name;
+            BaselineEntry entry{ -1, -1.0, -1.0 };
+            if (fields >> name >> entry.instructions >> entry.executeMilliseconds >> entry.milliseconds) baseline[name] = entry;
+        }
+        return baseline;
+    }
+
+    bool writeBaseline(const std::string& fileName, const std::vector<GoldenTestResult>& results) {
+        std::ofstream file(fileName);
+        if (!file.is_open()) return false;
+        file << "# KLL-bench golden: test instructions execute_ms total_ms (-1 - no data)\n";
+        file << std::fixed << std::setprecision(3);
+        for (const GoldenTestResult& result : results) {
+            if (result.status != "pass") continue;
+            file << result.name << ' ' << result.instructions << ' ' << result.executeMilliseconds << ' '
+                << result.milliseconds << '\n';
+        }
+        return true;
+    }
+
+    // Рост больше чем на thresholdPercent процентов (и больше чем на slack в абсолютных единицах)
+    bool exceeds(double baseline, double value, double thresholdPercent, double slack) {
+        return baseline >= 0 && value >= 0 && value > baseline * (1.0 + thresholdPercent / 100.0) && value - baseline > slack;
+    }
+
+    // Регрессия по числу операций или времени (execute, если оно есть в обоих замерах, иначе время процесса)
+    std::string checkPerformance(const GoldenTestResult& result, const BaselineEntry& baseline, const GoldenTestOptions& options) {
+        std::string reasons;
+        if (exceeds(static_cast<double>(baseline.instructions), static_cast<double>(result.instructions), options.thresholdPercent, 0.0)) {
+            reasons = "instructions " + std::to_string(baseline.instructions) + " -> " + std::to_string(result.instructions);
+        }
+        bool haveExecute = baseline.executeMilliseconds >= 0 && result.executeMilliseconds >= 0;
+        double before = haveExecute ? baseline.executeMilliseconds : baseline.milliseconds;
+        double after = haveExecute ? result.executeMilliseconds : result.milliseconds;
+        if (exceeds(before, after, options.thresholdPercent, options.timeSlackMilliseconds)) {
+            std::ostringstream text;
+            text << std::fixed << std::setprecision(2) << (haveExecute ? "execute " : "time ") << before << " ms -> " << after << " ms";
+            reasons += (reasons.empty() ? "" : "; ") + text.str();
+        }
+        return reasons;
+    }
+
+} // namespace
+
+std::vector<GoldenTestResult> runGoldenTests(const GoldenTestOptions& requested, std::ostream& out) {
+    std::vector<GoldenTestResult> results;
+    std::error_code error;
+    GoldenTestOptions options = requested;
+    if (options.workDirectory.empty()) {
+        // Временный каталог, а не текущий: запуск из корня репозитория не должен оставлять в нем файлов
+        std::filesystem::path temporary = std::filesystem::temp_directory_path(error);
+        options.workDirectory = ((error ? std::filesystem::path(".") : temporary) / "kll-golden").string();
+    }
+    std::vector<GoldenTestCase> tests = findTests(options);
+    if (tests.empty()) {
+        std::cerr << "Error: No tests (*.kll) found in '" << options.testsDirectory << "'" << std::endl;
+        return results;
+    }
+    std::filesystem::create_directories(options.workDirectory, error);
+    if (error) {
+        std::cerr << "Error: Could not create directory '" << options.workDirectory << "': " << error.message() << std::endl;
+        return results;
+    }
+
+    std::string engineProblem = checkEngine(options);
+    if (!engineProblem.empty()) {
+        std::cerr << "Error: " << engineProblem << std::endl;
+        return results;
+    }
+    bool withMetrics = probeMetricsSupport(options);
+    if (!withMetrics) out << "Note: " << options.enginePath << " does not support --metrics; only process time is recorded" << std::endl;
+
+    // Каждый поток берет следующий тест по общему счетчику; результат пишется в свою ячейку
+    results.resize(tests.size());
+    std::atomic<size_t> nextTest{ 0 };
+    unsigned jobs = options.jobs > 0 ? static_cast<unsigned>(options.jobs) : std::max(1u, std::thread::hardware_concurrency());
+    jobs = std::min<unsigned>(jobs, static_cast<unsigned>(tests.size()));
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < jobs; ++w) {
+        workers.emplace_back([&]() {
+            for (size_t k = nextTest++; k < tests.size(); k = nextTest++) results[k] = runTest(tests[k], options, withMetrics);
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+
+    std::string baselineFile = options.baselineFile.empty() ? options.testsDirectory + "/perf_baseline.txt" : options.baselineFile;
+    bool recordBaseline = options.updateBaseline || !std::filesystem::exists(baselineFile);
+    std::map<std::string, BaselineEntry> baseline = recordBaseline ? std::map<std::string, BaselineEntry>() : readBaseline(baselineFile);
+
+    size_t passed = 0;
+    size_t regressions = 0;
+    std::ios_base::fmtflags savedFlags = out.flags();
+    std::streamsize savedPrecision = out.precision();
+    out << std::left << std::setw(32) << "test" << std::setw(6) << "status" << std::right << std::setw(11) << "total ms"
+        << std::setw(12) << "execute ms" << std::setw(14) << "instructions" << "  " << std::left << "performance" << std::endl;
+    for (GoldenTestResult& result : results) {
+        std::string details = result.message;
+        if (result.status == "pass") {
+            ++passed;
+            std::map<std::string, BaselineEntry>::const_iterator entry = baseline.find(result.name);
+            if (recordBaseline) {
+                result.performance = "ok";
+            }
+            else if (entry == baseline.end()) {
+                result.performance = "new";
+            }
+            else {
+                details = checkPerformance(result, entry->second, options);
+                result.performance = details.empty() ? "ok" : "regression";
+                if (!details.empty()) ++regressions;
+            }
+        }
+        out << std::left << std::setw(32) << result.name << std::setw(6) << result.status << std::right << std::fixed
+            << std::setprecision(2) << std::setw(11) << result.milliseconds << std::setw(12);
+        if (result.executeMilliseconds >= 0) out << result.executeMilliseconds; else out << "-";
+        out << std::setw(14);
+        if (result.instructions >= 0) out << result.instructions; else out << "-";
+        out << "  " << std::left << result.performance;
+        if (!details.empty()) out << "  " << details;
+        out << std::right << std::endl;
+    }
+    out << "\n" << passed << " of " << results.size() << " tests passed, " << regressions << " performance regression(s)"
+        << " (threshold " << std::setprecision(1) << options.thresholdPercent << "%)" << std::endl;
+
+    // Новая базовая линия без явного --update-baseline записывается, только если прошли все тесты: иначе
+    // первый же запуск со сломанной сборкой закрепил бы неполный набор. Явное обновление требует хотя бы
+    // одного прошедшего теста (не прошедшие в файл не попадают).
+    bool canRecord = options.updateBaseline ? passed > 0 : passed == results.size();
+    if (recordBaseline && !canRecord) {
+        out << "Baseline not written: " << (passed == 0 ? "no tests passed" : "not all tests passed") << std::endl;
+    }
+    else if (recordBaseline) {
+        if (writeBaseline(baselineFile, results)) out << "Baseline written to " << baselineFile << std::endl;
+        else std::cerr << "Error: Could not write baseline '" << baselineFile << "'" << std::endl;
+    }
+    out.flags(savedFlags);
+    out.precision(savedPrecision);
+    return results;
+}
+
+bool goldenTestsPassed(const std::vector<GoldenTestResult>& results) {
+    if (results.empty()) return false;
+    return std::all_of(results.begin(), results.end(),
+        [](const GoldenTestResult& result) { return result.status == "pass" && result.performance != "regression"; });
+}
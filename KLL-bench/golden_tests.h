@@ -0,0 +1,54 @@
+// golden_tests.h
+#ifndef GOLDEN_TESTS_H
+#define GOLDEN_TESTS_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+// --- Эталонные тесты KLL 1.2 (KLL-skript-1.2/tests) с контролем производительности ---
+// Тест - файл имя.kll и необязательные имя.input (подается в cin), имя.expected (ожидаемый вывод
+// программы: строки между разделителями "---------------------" в stdout, вместе с приглашениями cin),
+// имя.expected_err (строки, которые должны встретиться в stderr; "..." соответствует любому тексту),
+// имя.args (дополнительные ключи исполняемого файла, например --threads=4).
+// Тест с .expected_err должен завершиться с ненулевым кодом, остальные - с нулевым.
+// Тесты выполняются параллельно (jobs потоков, каждый запускает исполняемый файл версии в отдельном
+// процессе). Для каждого теста берется медиана времени по repetitions запускам и число выполненных
+// операций ОПС из --metrics=json. Эти значения сравниваются с файлом базовой линии: рост числа операций
+// или времени больше чем на threshold процентов - регрессия (для времени еще и больше чем на timeSlack мс,
+// чтобы не реагировать на шум коротких тестов). Файл базовой линии создается, если его нет и все тесты
+// прошли, и перезаписывается при updateBaseline (если прошел хотя бы один тест).
+// Тесты KLL 1.0 (KLL-script/tests) этим режимом не запускаются: в 1.0 нет begin/end вокруг операторов
+// программы, а исходники 1.0 сейчас не собираются. Перед тестами проверяется, что --engine существует
+// и выполняет простейшую программу KLL 1.2.
+
+struct GoldenTestOptions {
+    std::string enginePath;                        // Исполняемый файл KLL 1.2
+    std::string testsDirectory = "KLL-skript-1.2/tests";
+    std::string baselineFile;                      // Пусто - <testsDirectory>/perf_baseline.txt
+    std::string workDirectory;                     // Вывод и метрики запусков (пусто - <временный каталог>/kll-golden)
+    std::string filter;                            // Подстрока имени теста (пусто - все)
+    int jobs = 0;                                  // 0 - по числу аппаратных потоков
+    int repetitions = 3;
+    double thresholdPercent = 10.0;
+    double timeSlackMilliseconds = 2.0;
+    bool updateBaseline = false;
+};
+
+struct GoldenTestResult {
+    std::string name;
+    std::string status;        // "pass" или "fail"
+    std::string message;       // Причина провала (первое расхождение)
+    double milliseconds;       // Медиана времени процесса
+    double executeMilliseconds; // Медиана фазы execute (< 0 - нет метрик)
+    long long instructions;    // Выполненные операции ОПС (< 0 - нет метрик)
+    std::string performance;   // "ok", "new" (нет в базовой линии), "regression", "-" (тест не прошел)
+};
+
+// Печатает результаты и сводку в out; возвращает результаты (пусто - ошибка подготовки).
+// Код завершения режима - 0, только если все тесты прошли и регрессий нет.
+std::vector<GoldenTestResult> runGoldenTests(const GoldenTestOptions& options, std::ostream& out);
+
+bool goldenTestsPassed(const std::vector<GoldenTestResult>& results);
+
+#endif // GOLDEN_TESTS_H
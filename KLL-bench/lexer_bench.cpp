@@ -0,0 +1,128 @@
+// lexer_bench.cpp
+#include "lexer_bench.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+#include "lexer.h"
+#include "symbol_table.h"
+#include "error_handler.h"
+#include "vector_kernels.h"
+
+namespace {
+
+    struct LexerBenchMode {
+        const char* name;
+        bool bulkScanning;
+        InstructionSet instructionSet;
+    };
+
+    // Один полный проход лексера; возвращает число токенов (без T_EOF)
+    size_t lexWholeSource(const std::string& source, bool bulkScanning) {
+        ErrorHandler errorHandler;
+        SymbolTable symbolTable(errorHandler);
+        Lexer lexer(source, symbolTable, errorHandler);
+        lexer.setBulkScanning(bulkScanning);
+        size_t tokenCount = 0;
+        while (lexer.getNextToken().type != TokenType::T_EOF) {
+            ++tokenCount;
+        }
+        return tokenCount;
+    }
+
+} // namespace
+
+std::string generateLexerWorkload(size_t targetBytes) {
+    static const char* const names[] = {
+        "accumulatorTotal", "elementBuffer", "indexPosition", "limitValue",
+        "temporaryResult", "rowOffset", "columnCount", "scaleFactor"
+    };
+    const size_t nameCount = sizeof(names) / sizeof(names[0]);
+
+    std::string source;
+    source.reserve(targetBytes + 256);
+    for (size_t i = 0; i < nameCount; ++i) {
+        source += (i == 1) ? "arr int " : "int ";
+        source += names[i];
+        source += (i == 1) ? "[1000];\n" : ";\n";
+    }
+    source += "begin\n";
+    // Простой линейный конгруэнтный генератор: нагрузка одинакова при каждом запуске
+    unsigned state = 12345u;
+    auto next = [&state](unsigned bound) {
+        state = state * 1103515245u + 12345u;
+        return (state >> 16) % bound;
+    };
+    while (source.size() < targetBytes) {
+        source.append(4 + 4 * next(3), ' ');
+        switch (next(4)) {
+        case 0:
+            source += names[next(nameCount)];
+            source += " = ";
+            source += names[next(nameCount)];
+            source += " + elementBuffer[indexPosition] * ";
+            source += std::to_string(next(1000000));
+            break;
+        case 1:
+            source += "if (";
+            source += names[next(nameCount)];
+            source += " < limitValue) temporaryResult = temporaryResult - ";
+            source += std::to_string(next(1000)) + "." + std::to_string(next(100000));
+            break;
+        case 2:
+            source += "elementBuffer[";
+            source += std::to_string(next(1000));
+            source += "] = (rowOffset + columnCount) / ";
+            source += std::to_string(1 + next(97));
+            break;
+        default:
+            source += "while (indexPosition < limitValue) begin indexPosition = indexPosition + 1 end";
+            break;
+        }
+        source += ";\n";
+    }
+    source += "    scaleFactor = 0\nend\n";
+    return source;
+}
+
+void runLexerBenchmark(const std::string& source, const std::string& sourceName, int repetitions) {
+    const LexerBenchMode modes[] = {
+        { "dfa",         false, InstructionSet::SCALAR },
+        { "bulk-scalar", true,  InstructionSet::SCALAR },
+        { "bulk-sse2",   true,  InstructionSet::SSE2 } // spanCharClass использует SSE2 и при AVX2
+    };
+    const InstructionSet initialSet = VectorKernels::getInstructionSet();
+    const double megabytes = static_cast<double>(source.size()) / (1024.0 * 1024.0);
+
+    size_t tokenCount = lexWholeSource(source, true); // Заодно прогрев кэшей и страниц источника
+    std::cout << "Lexer throughput (" << sourceName << ", " << std::fixed << std::setprecision(1) << megabytes
+        << " MB, " << tokenCount << " tokens, " << repetitions << " repetitions)" << std::endl;
+    std::cout << "  " << std::left << std::setw(14) << "mode" << std::right << std::setw(12) << "best MB/s"
+        << std::setw(14) << "median MB/s" << std::endl;
+
+    for (const LexerBenchMode& mode : modes) {
+        VectorKernels::setInstructionSet(mode.instructionSet);
+        if (VectorKernels::getInstructionSet() != mode.instructionSet) {
+            std::cout << "  " << std::left << std::setw(14) << mode.name << std::right
+                << "  (not supported by this CPU)" << std::endl;
+            continue;
+        }
+        std::vector<double> throughputs;
+        for (int r = 0; r < repetitions; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            size_t count = lexWholeSource(source, mode.bulkScanning);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (count != tokenCount) {
+                std::cerr << "Error: mode '" << mode.name << "' produced " << count << " tokens instead of " << tokenCount << std::endl;
+            }
+            throughputs.push_back(megabytes / std::max(elapsed.count(), 1e-9));
+        }
+        std::sort(throughputs.begin(), throughputs.end());
+        std::cout << "  " << std::left << std::setw(14) << mode.name << std::right << std::setprecision(1)
+            << std::setw(12) << throughputs.back() << std::setw(14) << throughputs[throughputs.size() / 2] << std::endl;
+    }
+    VectorKernels::setInstructionSet(initialSet);
+}
@@ -0,0 +1,21 @@
+// lexer_bench.h
+#ifndef LEXER_BENCH_H
+#define LEXER_BENCH_H
+
+#include <string>
+#include <cstddef>
+
+// --- Замер пропускной способности лексера (МБ/с) ---
+// Исходный код лексируется целиком (до T_EOF) несколько раз в каждом режиме:
+// табличный КА без быстрого пропуска и КА с пропуском однородных участков
+// на скалярном коде и SSE2 (при AVX2 лексер использует то же ядро SSE2; набор, не поддерживаемый
+// процессором, пропускается).
+
+// Синтетическая программа KLL примерно из targetBytes байт: отступы, длинные идентификаторы,
+// числа и выражения в пропорциях, типичных для сгенерированных скриптов
+std::string generateLexerWorkload(size_t targetBytes);
+
+// Печатает таблицу результатов в std::cout. sourceName - подпись источника (имя файла или "generated").
+void runLexerBenchmark(const std::string& source, const std::string& sourceName, int repetitions);
+
+#endif // LEXER_BENCH_H
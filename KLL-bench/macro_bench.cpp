@@ -0,0 +1,451 @@
+// macro_bench.cpp
+#include "macro_bench.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <streambuf>
+
+#include "lexer.h"
+#include "parser.h"
+#include "symbol_table.h"
+#include "error_handler.h"
+#include "interpreter.h"
+
+namespace {
+
+    // --- Корпус программ ---
+    // Тексты программ - шаблоны: @N@, @M@, @W@ и т.п. заменяются числами, зависящими от размера N.
+    // Условия KLL: ~ - равно, ! - не равно (операций <= и >= нет).
+
+    // Сортировка слиянием снизу вверх (развитие test4_array.txt: там пузырек на 5 элементах)
+    const char* const SORT_SOURCE = R"(int n; int i; int width; int lo; int mid; int hi; int l; int r; int k; int bad;
+arr int a[@N@]; arr int t[@N@];
+begin
+n = @N@;
+i = 0;
+while (i < n) begin cin(a[i]); i = i + 1 end;
+width = 1;
+while (width < n) begin
+  lo = 0;
+  while (lo < n) begin
+    mid = lo + width;
+    if (mid > n) mid = n;
+    hi = mid + width;
+    if (hi > n) hi = n;
+    l = lo; r = mid; k = lo;
+    while (k < hi) begin
+      if (l < mid) begin
+        if (r < hi) begin
+          if (a[r] < a[l]) begin t[k] = a[r]; r = r + 1 end
+          else begin t[k] = a[l]; l = l + 1 end
+        end
+        else begin t[k] = a[l]; l = l + 1 end
+      end
+      else begin t[k] = a[r]; r = r + 1 end;
+      k = k + 1
+    end;
+    lo = hi
+  end;
+  a = t;
+  width = width * 2
+end;
+bad = 0;
+i = 1;
+while (i < n) begin if (a[i] < a[i - 1]) bad = bad + 1; i = i + 1 end;
+cout(bad); cout(a[0]); cout(a[n - 1])
+end
+)";
+
+    // Префиксные суммы и скользящее среднее по ним (окно W)
+    const char* const PREFIX_SUM_SOURCE = R"(int n; int w; int i; int total; int check;
+arr int a[@N@]; arr int p[@N@];
+begin
+n = @N@; w = @W@;
+i = 0;
+while (i < n) begin cin(a[i]); i = i + 1 end;
+p[0] = a[0];
+i = 1;
+while (i < n) begin p[i] = p[i - 1] + a[i]; i = i + 1 end;
+check = sum(a);
+total = 0;
+i = 0;
+while (i + w < n) begin total = total + (p[i + w] - p[i]) / w; i = i + 1 end;
+cout(p[n - 1]); cout(check); cout(total)
+end
+)";
+
+    // Умножение матриц M x M, хранящихся построчно в одномерных массивах (N ~ M * M)
+    const char* const MATMUL_SOURCE = R"(int m; int i; int j; int k; int s; int row;
+arr int a[@MM@]; arr int b[@MM@]; arr int c[@MM@];
+begin
+m = @M@;
+i = 0;
+while (i < @MM@) begin cin(a[i]); i = i + 1 end;
+i = 0;
+while (i < @MM@) begin cin(b[i]); i = i + 1 end;
+i = 0;
+while (i < m) begin
+  row = i * m;
+  j = 0;
+  while (j < m) begin
+    s = 0;
+    k = 0;
+    while (k < m) begin s = s + a[row + k] * b[k * m + j]; k = k + 1 end;
+    c[row + j] = s;
+    j = j + 1
+  end;
+  i = i + 1
+end;
+cout(c[0]); cout(c[@MM@ / 2]); cout(c[@MM@ - 1])
+end
+)";
+
+    // Решето Эратосфена
+    const char* const SIEVE_SOURCE = R"(int n; int i; int j; int count;
+arr int s[@N@];
+begin
+n = @N@;
+s = 0;
+i = 2;
+while (i * i < n) begin
+  if (s[i] ~ 0) begin
+    j = i * i;
+    while (j < n) begin s[j] = 1; j = j + i end
+  end;
+  i = i + 1
+end;
+count = 0;
+i = 2;
+while (i < n) begin if (s[i] ~ 0) count = count + 1; i = i + 1 end;
+cout(count)
+end
+)";
+
+    // Гистограмма значений 0..255 и ее мода
+    const char* const HISTOGRAM_SOURCE = R"(int n; int i; int v; int maxc; int maxv;
+arr int h[256]; arr int x[@N@];
+begin
+n = @N@;
+i = 0;
+while (i < n) begin cin(x[i]); i = i + 1 end;
+i = 0;
+while (i < n) begin v = x[i]; h[v] = h[v] + 1; i = i + 1 end;
+maxc = 0; maxv = 0;
+i = 0;
+while (i < 256) begin if (h[i] > maxc) begin maxc = h[i]; maxv = i end; i = i + 1 end;
+cout(sum(h)); cout(maxv); cout(maxc)
+end
+)";
+
+    // Динамическое программирование во вложенных циклах: длина наибольшей общей подпоследовательности
+    // двух последовательностей длины M; таблица (M + 1) x (M + 1) построчно в одном массиве (N ~ M * M)
+    const char* const LCS_SOURCE = R"(int m; int w; int i; int j; int up; int left; int best;
+arr int x[@M@]; arr int y[@M@]; arr int d[@WW@];
+begin
+m = @M@; w = m + 1;
+i = 0;
+while (i < m) begin cin(x[i]); i = i + 1 end;
+i = 0;
+while (i < m) begin cin(y[i]); i = i + 1 end;
+i = 1;
+while (i < w) begin
+  j = 1;
+  while (j < w) begin
+    if (x[i - 1] ~ y[j - 1]) best = d[(i - 1) * w + j - 1] + 1
+    else begin
+      up = d[(i - 1) * w + j];
+      left = d[i * w + j - 1];
+      if (up > left) best = up else best = left
+    end;
+    d[i * w + j] = best;
+    j = j + 1
+  end;
+  i = i + 1
+end;
+cout(d[@WW@ - 1])
+end
+)";
+
+    std::string substitute(std::string text, const std::map<std::string, size_t>& values) {
+        for (const auto& entry : values) {
+            std::string placeholder = "@" + entry.first + "@";
+            std::string value = std::to_string(entry.second);
+            for (size_t position = text.find(placeholder); position != std::string::npos;
+                position = text.find(placeholder, position + value.size())) {
+                text.replace(position, placeholder.size(), value);
+            }
+        }
+        return text;
+    }
+
+    // Сторона квадратной таблицы с примерно n элементами
+    size_t squareSide(size_t n) {
+        return std::max<size_t>(2, static_cast<size_t>(std::sqrt(static_cast<double>(n))));
+    }
+
+    // Входные данные: count чисел из [0, bound), по одному в строке (cin читает строку на значение).
+    // 64-битный линейный конгруэнтный генератор (старшие биты) с затравкой seed: данные одинаковы при каждом запуске.
+    std::string generateInput(size_t count, unsigned bound, std::uint64_t seed, bool triangular = false) {
+        std::string input;
+        input.reserve(count * 6);
+        std::uint64_t state = seed;
+        auto next = [&state](unsigned limit) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            return static_cast<unsigned>((state >> 33) % limit);
+        };
+        for (size_t i = 0; i < count; ++i) {
+            unsigned value = triangular ? (next(bound) + next(bound)) / 2 : next(bound);
+            input += std::to_string(value);
+            input += '\n';
+        }
+        return input;
+    }
+
+    struct MacroWorkload {
+        const char* name;
+        std::function<std::string(size_t)> source;
+        std::function<std::string(size_t)> input;
+    };
+
+    std::vector<MacroWorkload> makeWorkloads() {
+        return {
+            { "sort",
+                [](size_t n) { return substitute(SORT_SOURCE, { { "N", n } }); },
+                [](size_t n) { return generateInput(n, 1000000, 1u); } },
+            { "prefix_sum",
+                [](size_t n) { return substitute(PREFIX_SUM_SOURCE, { { "N", n }, { "W", std::max<size_t>(1, n / 10) } }); },
+                [](size_t n) { return generateInput(n, 100, 2u); } },
+            { "matmul",
+                [](size_t n) { size_t m = squareSide(n); return substitute(MATMUL_SOURCE, { { "M", m }, { "MM", m * m } }); },
+                [](size_t n) { size_t m = squareSide(n); return generateInput(2 * m * m, 10, 3u); } },
+            { "sieve",
+                [](size_t n) { return substitute(SIEVE_SOURCE, { { "N", n } }); },
+                [](size_t) { return std::string(); } },
+            { "histogram",
+                [](size_t n) { return substitute(HISTOGRAM_SOURCE, { { "N", n } }); },
+                [](size_t n) { return generateInput(n, 256, 5u, true); } },
+            { "lcs_dp",
+                [](size_t n) { size_t m = squareSide(n) - 1; return substitute(LCS_SOURCE, { { "M", m }, { "WW", (m + 1) * (m + 1) } }); },
+                [](size_t n) { return generateInput(2 * (squareSide(n) - 1), 4, 6u); } }
+        };
+    }
+
+    // --- Движки: режимы компиляции и выполнения KLL 1.2 ---
+    struct MacroEngine {
+        const char* name;
+        int optimizationLevel;
+        bool vectorize;
+        bool autoParallel;
+        size_t threads; // 0 - по умолчанию (число ядер)
+    };
+
+    const MacroEngine ENGINES[] = {
+        { "O0", 0, false, false, 1 },
+        { "O2", 2, false, false, 1 },
+        { "O2-vec", 2, true, false, 1 },
+        { "O2-vec-par", 2, true, true, 0 }
+    };
+
+    // Приемник вывода программы: вместо хранения (при больших N это десятки мегабайт
+    // приглашений cin) считается FNV-1a хеш
+    class HashingStreamBuffer : public std::streambuf {
+    public:
+        std::uint64_t getHash() const { return hash; }
+
+    protected:
+        int_type overflow(int_type c) override {
+            if (!traits_type::eq_int_type(c, traits_type::eof())) add(traits_type::to_char_type(c));
+            return traits_type::not_eof(c);
+        }
+        std::streamsize xsputn(const char* text, std::streamsize count) override {
+            for (std::streamsize k = 0; k < count; ++k) add(text[k]);
+            return count;
+        }
+
+    private:
+        std::uint64_t hash = 14695981039346656037ull;
+        void add(char c) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+    };
+
+    // Подменяет буферы std::cin и std::cout на время запуска
+    class StandardStreamsRedirect {
+    public:
+        StandardStreamsRedirect(std::streambuf* input, std::streambuf* output)
+            : savedInput(std::cin.rdbuf(input)), savedOutput(std::cout.rdbuf(output)) {
+        }
+        ~StandardStreamsRedirect() {
+            std::cin.rdbuf(savedInput);
+            std::cout.rdbuf(savedOutput);
+            std::cin.clear();
+            std::cout.clear();
+        }
+
+    private:
+        std::streambuf* savedInput;
+        std::streambuf* savedOutput;
+    };
+
+    MacroBenchResult runOnce(const MacroWorkload& workload, const MacroEngine& engine, size_t n,
+        const std::string& source, const std::string& input) {
+        using Clock = std::chrono::steady_clock;
+        auto millisecondsSince = [](Clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        };
+
+        MacroBenchResult result{ workload.name, engine.name, n, "ok", 0.0, 0.0, 0, 0, 0 };
+        std::istringstream inputStream(input);
+        HashingStreamBuffer output;
+        StandardStreamsRedirect redirect(inputStream.rdbuf(), &output);
+
+        ErrorHandler errorHandler;
+        SymbolTable symbolTable(errorHandler);
+        Lexer lexer(source, symbolTable, errorHandler);
+        Parser parser(lexer, symbolTable, errorHandler);
+        parser.setLoopVectorization(engine.vectorize);
+        parser.setAutoParallelization(engine.autoParallel);
+        parser.setOptimizationLevel(engine.optimizationLevel);
+
+        Clock::time_point start = Clock::now();
+        bool parseSuccess = parser.parse();
+        result.compileMilliseconds = millisecondsSince(start);
+        if (!parseSuccess || errorHandler.hasErrors()) {
+            result.status = "compile_error";
+            return result;
+        }
+
+        const std::vector<RPNOperation>& rpnCode = parser.getRPNCode();
+        Interpreter interpreter(rpnCode, symbolTable, errorHandler, &parser.getVectorLoops(), &parser.getParallelLoops());
+        if (engine.threads != 0) interpreter.setThreadCount(engine.threads);
+        interpreter.setInstructionLimit(Interpreter::MAX_INSTRUCTION_LIMIT);
+        start = Clock::now();
+        interpreter.execute();
+        result.executeMilliseconds = millisecondsSince(start);
+        result.instructions = interpreter.getExecutedCount();
+        result.outputHash = output.getHash();
+        if (errorHandler.hasErrors()) result.status = "runtime_error";
+
+        result.memoryBytes = rpnCode.size() * sizeof(RPNOperation);
+        for (size_t i = 0; i < symbolTable.getTableSize(); ++i) {
+            if (std::optional<ArrayMemoryStats> stats = symbolTable.getArrayMemoryStats(i)) {
+                result.memoryBytes += stats->residentBytes;
+            }
+        }
+        return result;
+    }
+
+    bool containsName(const std::string& list, const std::string& name) {
+        std::stringstream items(list);
+        std::string item;
+        while (std::getline(items, item, ',')) {
+            if (item == name) return true;
+        }
+        return false;
+    }
+
+    void printResultRow(std::ostream& out, const MacroBenchResult& result) {
+        std::ios_base::fmtflags savedFlags = out.flags();
+        std::streamsize savedPrecision = out.precision();
+        double instructionsPerSecond = result.executeMilliseconds > 0
+            ? static_cast<double>(result.instructions) / result.executeMilliseconds / 1000.0 : 0.0;
+        out << std::left << std::setw(12) << result.workload << std::right << std::setw(10) << result.n << "  "
+            << std::left << std::setw(12) << result.engine << std::setw(16) << result.status << std::right
+            << std::fixed << std::setprecision(2) << std::setw(11) << result.compileMilliseconds
+            << std::setw(12) << result.executeMilliseconds << std::setw(12) << result.instructions
+            << std::setprecision(1) << std::setw(10) << instructionsPerSecond
+            << std::setw(11) << static_cast<double>(result.memoryBytes) / 1024.0 << std::endl;
+        out.flags(savedFlags);
+        out.precision(savedPrecision);
+    }
+
+} // namespace
+
+std::vector<std::string> getMacroWorkloadNames() {
+    std::vector<std::string> names;
+    for (const MacroWorkload& workload : makeWorkloads()) names.push_back(workload.name);
+    return names;
+}
+
+std::vector<std::string> getMacroEngineNames() {
+    std::vector<std::string> names;
+    for (const MacroEngine& engine : ENGINES) names.push_back(engine.name);
+    return names;
+}
+
+std::vector<MacroBenchResult> runMacroBenchmarks(const MacroBenchOptions& options, std::ostream& progress) {
+    std::vector<MacroBenchResult> results;
+    progress << std::left << std::setw(12) << "workload" << std::right << std::setw(10) << "N" << "  "
+        << std::left << std::setw(12) << "engine" << std::setw(16) << "status" << std::right
+        << std::setw(11) << "compile ms" << std::setw(12) << "execute ms" << std::setw(12) << "RPN ops"
+        << std::setw(10) << "Mops/s" << std::setw(11) << "memory KB" << std::endl;
+
+    for (const MacroWorkload& workload : makeWorkloads()) {
+        if (!options.workloadFilter.empty() && std::string(workload.name).find(options.workloadFilter) == std::string::npos) continue;
+        std::vector<bool> stopped(sizeof(ENGINES) / sizeof(ENGINES[0]), false);
+        for (size_t n = options.minN; n <= options.maxN; n *= 10) {
+            std::string source = workload.source(n);
+            std::string input = workload.input(n);
+            if (!options.dumpDirectory.empty()) {
+                std::string baseName = options.dumpDirectory + "/" + workload.name + "_" + std::to_string(n);
+                std::ofstream(baseName + ".kll") << source;
+                std::ofstream(baseName + ".input") << input;
+            }
+
+            bool haveReference = false;
+            std::uint64_t referenceHash = 0;
+            for (size_t e = 0; e < stopped.size(); ++e) {
+                const MacroEngine& engine = ENGINES[e];
+                if (stopped[e] || (!options.engines.empty() && !containsName(options.engines, engine.name))) continue;
+                MacroBenchResult result = runOnce(workload, engine, n, source, input);
+                if (result.status == "ok") {
+                    if (!haveReference) {
+                        haveReference = true;
+                        referenceHash = result.outputHash;
+                    }
+                    else if (result.outputHash != referenceHash) {
+                        result.status = "output_mismatch";
+                    }
+                }
+                // Следующий N для этого движка выполнялся бы примерно в 10 (и более) раз дольше
+                if (result.status != "ok" ||
+                    (result.compileMilliseconds + result.executeMilliseconds) / 1000.0 > options.maxSeconds) {
+                    stopped[e] = true;
+                }
+                printResultRow(progress, result);
+                results.push_back(result);
+            }
+            if (n > options.maxN / 10) break; // Без переполнения n *= 10
+        }
+    }
+    return results;
+}
+
+void writeMacroBenchJson(std::ostream& out, const std::vector<MacroBenchResult>& results) {
+    std::ios_base::fmtflags savedFlags = out.flags();
+    std::streamsize savedPrecision = out.precision();
+    out << std::fixed << std::setprecision(3);
+    out << "{\"runs\":[";
+    for (size_t k = 0; k < results.size(); ++k) {
+        const MacroBenchResult& result = results[k];
+        double instructionsPerSecond = result.executeMilliseconds > 0
+            ? static_cast<double>(result.instructions) * 1000.0 / result.executeMilliseconds : 0.0;
+        out << (k > 0 ? ",\n  " : "\n  ") << "{\"workload\":\"" << result.workload << "\",\"engine\":\"" << result.engine
+            << "\",\"n\":" << result.n << ",\"status\":\"" << result.status
+            << "\",\"compile_ms\":" << result.compileMilliseconds << ",\"execute_ms\":" << result.executeMilliseconds
+            << ",\"instructions\":" << result.instructions << ",\"instructions_per_second\":" << instructionsPerSecond
+            << ",\"memory_bytes\":" << result.memoryBytes << ",\"output_hash\":\"" << std::hex << result.outputHash
+            << std::dec << "\"}";
+    }
+    out << "\n]}" << std::endl;
+    out.flags(savedFlags);
+    out.precision(savedPrecision);
+}
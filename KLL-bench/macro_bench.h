@@ -0,0 +1,49 @@
+// macro_bench.h
+#ifndef MACRO_BENCH_H
+#define MACRO_BENCH_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+
+// --- Макрозамеры: корпус типичных вычислительных программ KLL с масштабируемым размером N ---
+// Для каждой программы корпуса текст (размеры массивов) и входные данные (для cin) генерируются по N.
+// Программа компилируется и выполняется в каждом режиме интерпретатора ("движке"): -O0 без векторизации,
+// -O2, -O2 с векторизацией, -O2 с векторизацией и распараллеливанием. N перебирается степенями 10
+// от minN до maxN. Лимит выполненных операций поднимается до Interpreter::MAX_INSTRUCTION_LIMIT;
+// если запуск длился дольше maxSeconds (или упал), большие N для этой пары программа/движок пропускаются.
+// Вывод программ сравнивается между движками по контрольной сумме.
+
+struct MacroBenchOptions {
+    size_t minN = 1000;
+    size_t maxN = 10000000;
+    double maxSeconds = 5.0;     // Порог времени одного запуска для перехода к следующему N
+    std::string workloadFilter;  // Подстрока имени программы (пусто - все)
+    std::string engines;         // Имена движков через запятую (пусто - все)
+    std::string dumpDirectory;   // Если задан: сохранить программы и входные данные (имя_N.kll, имя_N.input)
+};
+
+struct MacroBenchResult {
+    std::string workload;
+    std::string engine;
+    size_t n;
+    std::string status;          // "ok", "compile_error", "runtime_error", "output_mismatch"
+    double compileMilliseconds;  // Лексер, разбор, IR, оптимизация, ОПС
+    double executeMilliseconds;  // Включая чтение входных данных через cin
+    long long instructions;      // Выполненные операции ОПС
+    size_t memoryBytes;          // Занятая память массивов и код ОПС
+    std::uint64_t outputHash;    // Контрольная сумма вывода программы
+};
+
+// Имена программ корпуса и движков (для справки в сообщении об использовании)
+std::vector<std::string> getMacroWorkloadNames();
+std::vector<std::string> getMacroEngineNames();
+
+// Печатает строки таблицы в progress по мере выполнения; возвращает все результаты
+std::vector<MacroBenchResult> runMacroBenchmarks(const MacroBenchOptions& options, std::ostream& progress);
+
+void writeMacroBenchJson(std::ostream& out, const std::vector<MacroBenchResult>& results);
+
+#endif // MACRO_BENCH_H
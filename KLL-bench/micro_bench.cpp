@@ -0,0 +1,361 @@
+// micro_bench.cpp
+#include "micro_bench.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "lexer.h"
+#include "lexer_bench.h"
+#include "symbol_table.h"
+#include "error_handler.h"
+#include "interpreter.h"
+#include "rpn_op.h"
+
+namespace {
+
+    // Результаты замеров складываются сюда, чтобы компилятор не удалил вычисления
+    volatile std::uint64_t benchmarkSink = 0;
+
+    // Число повторений ядра в прямолинейном коде ОПС
+    const size_t KERNEL_COPIES = 2000;
+    const size_t ARRAY_SIZE = 1024;
+
+    struct MicroBenchmark {
+        std::string group;
+        std::string name;
+        size_t operationsPerCall;
+        size_t rpnOpsPerOperation;
+        std::function<std::uint64_t()> call; // Возвращает контрольное значение
+    };
+
+    MicroBenchResult measure(const MicroBenchmark& benchmark, const MicroBenchOptions& options) {
+        using Clock = std::chrono::steady_clock;
+        auto secondsSince = [](Clock::time_point start) {
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        };
+
+        // Прогрев и калибровка: число вызовов удваивается, пока серия не займет заметное время
+        size_t calls = 1;
+        double seconds = 0.0;
+        double target = options.minMilliseconds / 1000.0;
+        while (true) {
+            Clock::time_point start = Clock::now();
+            for (size_t k = 0; k < calls; ++k) benchmarkSink = benchmarkSink + benchmark.call();
+            seconds = secondsSince(start);
+            if (seconds >= target / 4 || calls >= (size_t(1) << 30)) break;
+            calls *= 2;
+        }
+        if (seconds > 0) {
+            calls = std::max<size_t>(1, static_cast<size_t>(static_cast<double>(calls) * target / seconds));
+        }
+
+        std::vector<double> samples; // Наносекунды на операцию
+        for (int r = 0; r < options.repetitions; ++r) {
+            Clock::time_point start = Clock::now();
+            for (size_t k = 0; k < calls; ++k) benchmarkSink = benchmarkSink + benchmark.call();
+            double elapsed = secondsSince(start);
+            samples.push_back(elapsed * 1e9 / static_cast<double>(calls * benchmark.operationsPerCall));
+        }
+        std::sort(samples.begin(), samples.end());
+
+        MicroBenchResult result;
+        result.group = benchmark.group;
+        result.name = benchmark.name;
+        result.operationsPerCall = benchmark.operationsPerCall;
+        result.rpnOpsPerOperation = benchmark.rpnOpsPerOperation;
+        result.repetitions = options.repetitions;
+        size_t middle = samples.size() / 2;
+        result.medianNs = (samples.size() % 2 == 1) ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2;
+        result.minNs = samples.front();
+        double sum = 0.0;
+        for (double sample : samples) sum += sample;
+        result.meanNs = sum / static_cast<double>(samples.size());
+        double squares = 0.0;
+        for (double sample : samples) squares += (sample - result.meanNs) * (sample - result.meanNs);
+        result.stddevNs = samples.size() > 1 ? std::sqrt(squares / static_cast<double>(samples.size() - 1)) : 0.0;
+        return result;
+    }
+
+    // --- Окружение для выполнения ОПС: переменные и массивы с известными значениями ---
+    struct RpnFixture {
+        ErrorHandler errorHandler;
+        SymbolTable symbolTable;
+        size_t a, b, x, zero;       // int: a = 7, b = 3, zero = 0
+        size_t fa, fb, fx;          // float: fa = 2.5, fb = 1.25
+        size_t ints, ints2, floats; // Массивы из ARRAY_SIZE элементов
+
+        RpnFixture() : symbolTable(errorHandler) {
+            a = addVariable("a", SymbolType::VARIABLE_INT, 7);
+            b = addVariable("b", SymbolType::VARIABLE_INT, 3);
+            x = addVariable("x", SymbolType::VARIABLE_INT, 0);
+            zero = addVariable("zero", SymbolType::VARIABLE_INT, 0);
+            fa = addVariable("fa", SymbolType::VARIABLE_FLOAT, 2.5f);
+            fb = addVariable("fb", SymbolType::VARIABLE_FLOAT, 1.25f);
+            fx = addVariable("fx", SymbolType::VARIABLE_FLOAT, 0.0f);
+            ints = symbolTable.addArray(symbolTable.internIdentifier("ints"), SymbolType::ARRAY_INT, 0, ARRAY_SIZE).value();
+            ints2 = symbolTable.addArray(symbolTable.internIdentifier("ints2"), SymbolType::ARRAY_INT, 0, ARRAY_SIZE).value();
+            floats = symbolTable.addArray(symbolTable.internIdentifier("floats"), SymbolType::ARRAY_FLOAT, 0, ARRAY_SIZE).value();
+            for (size_t i = 0; i < ARRAY_SIZE; ++i) {
+                symbolTable.setArrayElementValue(ints, i, StoredValue(static_cast<int>(i)));
+                symbolTable.setArrayElementValue(ints2, i, StoredValue(static_cast<int>(3 * i + 1)));
+            }
+        }
+
+        template <typename T>
+        size_t addVariable(const char* name, SymbolType type, T value) {
+            size_t index = symbolTable.addVariable(symbolTable.internIdentifier(name), type, 0).value();
+            symbolTable.setVariableValue(index, StoredValue(value));
+            return index;
+        }
+    };
+
+    RPNOperation var(size_t index) { return RPNOperation(RPNOpCode::PUSH_VAR_ADDR, index); }
+    RPNOperation array(size_t index) { return RPNOperation(RPNOpCode::PUSH_ARRAY_ADDR, index); }
+    RPNOperation op(RPNOpCode code) { return RPNOperation(code); }
+
+    // Ядро ОПС, повторенное KERNEL_COPIES раз; переходы ядра ведут на следующую копию
+    // (jumpTarget ядра задается относительно его начала и сдвигается для каждой копии)
+    std::vector<RPNOperation> repeatKernel(const std::vector<RPNOperation>& kernel) {
+        std::vector<RPNOperation> code;
+        code.reserve(kernel.size() * KERNEL_COPIES);
+        for (size_t copy = 0; copy < KERNEL_COPIES; ++copy) {
+            int base = static_cast<int>(code.size());
+            for (RPNOperation operation : kernel) {
+                if (operation.jumpTarget) operation.jumpTarget = base + operation.jumpTarget.value();
+                code.push_back(operation);
+            }
+        }
+        return code;
+    }
+
+    void addRpnBenchmark(std::vector<MicroBenchmark>& benchmarks, const std::shared_ptr<RpnFixture>& fixture,
+        const std::string& name, const std::vector<RPNOperation>& kernel) {
+        auto code = std::make_shared<std::vector<RPNOperation>>(repeatKernel(kernel));
+        auto interpreter = std::make_shared<Interpreter>(*code, fixture->symbolTable, fixture->errorHandler);
+        interpreter->setThreadCount(1);
+        benchmarks.push_back({ "rpn", name, KERNEL_COPIES, kernel.size(),
+            [fixture, code, interpreter]() -> std::uint64_t {
+                interpreter->execute();
+                if (fixture->errorHandler.hasErrors()) {
+                    fixture->errorHandler.printErrors();
+                    fixture->errorHandler.clearErrors();
+                }
+                return static_cast<std::uint64_t>(interpreter->getExecutedCount());
+            } });
+    }
+
+    void addRpnBenchmarks(std::vector<MicroBenchmark>& benchmarks) {
+        auto f = std::make_shared<RpnFixture>();
+        RPNOperation jumpNext(RPNOpCode::JUMP, 1, true);            // На следующую операцию
+        RPNOperation jumpFalseNext(RPNOpCode::JUMP_FALSE, 2, true); // На операцию после перехода
+        // x = a, x = 5 - база: загрузка адресов и присваивание
+        addRpnBenchmark(benchmarks, f, "assign (x = a)", { var(f->x), var(f->a), op(RPNOpCode::ASSIGN) });
+        addRpnBenchmark(benchmarks, f, "PUSH_CONST_INT (x = 5)",
+            { var(f->x), RPNOperation(RPNOpCode::PUSH_CONST_INT, 5), op(RPNOpCode::ASSIGN) });
+        addRpnBenchmark(benchmarks, f, "PUSH_CONST_FLOAT (fx = 0.5)",
+            { var(f->fx), RPNOperation(RPNOpCode::PUSH_CONST_FLOAT, 0.5f), op(RPNOpCode::ASSIGN) });
+        const struct { const char* name; RPNOpCode code; } binaryOps[] = {
+            { "ADD", RPNOpCode::ADD }, { "SUB", RPNOpCode::SUB }, { "MUL", RPNOpCode::MUL }, { "DIV", RPNOpCode::DIV },
+            { "CMP_EQ", RPNOpCode::CMP_EQ }, { "CMP_NE", RPNOpCode::CMP_NE },
+            { "CMP_GT", RPNOpCode::CMP_GT }, { "CMP_LT", RPNOpCode::CMP_LT }
+        };
+        for (const auto& binary : binaryOps) {
+            addRpnBenchmark(benchmarks, f, std::string(binary.name) + " int (x = a op b)",
+                { var(f->x), var(f->a), var(f->b), op(binary.code), op(RPNOpCode::ASSIGN) });
+        }
+        for (const auto& binary : binaryOps) {
+            bool comparison = binary.code >= RPNOpCode::CMP_EQ;
+            addRpnBenchmark(benchmarks, f, std::string(binary.name) + " float (" + (comparison ? "x" : "fx") + " = fa op fb)",
+                { var(comparison ? f->x : f->fx), var(f->fa), var(f->fb), op(binary.code), op(RPNOpCode::ASSIGN) });
+        }
+        addRpnBenchmark(benchmarks, f, "ADD mixed (fx = a + fb)",
+            { var(f->fx), var(f->a), var(f->fb), op(RPNOpCode::ADD), op(RPNOpCode::ASSIGN) });
+        addRpnBenchmark(benchmarks, f, "CONVERT_TO_FLOAT (fx = float(a))",
+            { var(f->fx), var(f->a), op(RPNOpCode::CONVERT_TO_FLOAT), op(RPNOpCode::ASSIGN) });
+        addRpnBenchmark(benchmarks, f, "CONVERT_TO_INT (x = int(fa))",
+            { var(f->x), var(f->fa), op(RPNOpCode::CONVERT_TO_INT), op(RPNOpCode::ASSIGN) });
+        addRpnBenchmark(benchmarks, f, "INDEX load (x = ints[a])",
+            { var(f->x), array(f->ints), var(f->a), op(RPNOpCode::INDEX), op(RPNOpCode::ASSIGN) });
+        addRpnBenchmark(benchmarks, f, "INDEX store (ints[a] = b)",
+            { array(f->ints), var(f->a), op(RPNOpCode::INDEX), var(f->b), op(RPNOpCode::ASSIGN) });
+        addRpnBenchmark(benchmarks, f, "JUMP", { jumpNext });
+        addRpnBenchmark(benchmarks, f, "JUMP_FALSE not taken (a)", { var(f->a), jumpFalseNext });
+        addRpnBenchmark(benchmarks, f, "JUMP_FALSE taken (zero)", { var(f->zero), jumpFalseNext });
+        addRpnBenchmark(benchmarks, f, "VEC_ADD int x1024 (ints2 = ints + ints2)",
+            { array(f->ints2), array(f->ints), array(f->ints2), op(RPNOpCode::VEC_ADD), op(RPNOpCode::VEC_ASSIGN) });
+        addRpnBenchmark(benchmarks, f, "VEC_SUM int x1024 (x = sum(ints))",
+            { var(f->x), array(f->ints), op(RPNOpCode::VEC_SUM), op(RPNOpCode::ASSIGN) });
+    }
+
+    void addStackBenchmarks(std::vector<MicroBenchmark>& benchmarks) {
+        const size_t pairs = 4096;
+        auto stack = std::make_shared<RuntimeStack>();
+        benchmarks.push_back({ "stack", "push/pop int", pairs, 0, [stack, pairs]() -> std::uint64_t {
+            std::uint64_t total = 0;
+            for (size_t i = 0; i < pairs; ++i) {
+                stack->push(RuntimeStackItem(static_cast<int>(i)));
+                total += static_cast<std::uint64_t>(std::get<int>(stack->pop().value));
+            }
+            return total;
+        } });
+        benchmarks.push_back({ "stack", "push/pop address", pairs, 0, [stack, pairs]() -> std::uint64_t {
+            std::uint64_t total = 0;
+            for (size_t i = 0; i < pairs; ++i) {
+                stack->push(RuntimeStackItem(VarAddress{ i }));
+                total += std::get<VarAddress>(stack->pop().value).table_index;
+            }
+            return total;
+        } });
+    }
+
+    void addSymbolTableBenchmarks(std::vector<MicroBenchmark>& benchmarks) {
+        const size_t calls = 4096;
+        auto f = std::make_shared<RpnFixture>();
+        benchmarks.push_back({ "symbols", "getVariableValue", calls, 0, [f, calls]() -> std::uint64_t {
+            std::uint64_t total = 0;
+            for (size_t i = 0; i < calls; ++i) {
+                std::optional<StoredValue> value = f->symbolTable.getVariableValue((i & 1) ? f->a : f->b);
+                total += static_cast<std::uint64_t>(std::get<int>(*value));
+            }
+            return total;
+        } });
+        benchmarks.push_back({ "symbols", "setVariableValue", calls, 0, [f, calls]() -> std::uint64_t {
+            for (size_t i = 0; i < calls; ++i) f->symbolTable.setVariableValue(f->x, StoredValue(static_cast<int>(i)));
+            return calls;
+        } });
+        benchmarks.push_back({ "symbols", "getArrayElementValue", calls, 0, [f, calls]() -> std::uint64_t {
+            std::uint64_t total = 0;
+            for (size_t i = 0; i < calls; ++i) {
+                std::optional<StoredValue> value = f->symbolTable.getArrayElementValue(f->ints, i & (ARRAY_SIZE - 1));
+                total += static_cast<std::uint64_t>(std::get<int>(*value));
+            }
+            return total;
+        } });
+        benchmarks.push_back({ "symbols", "setArrayElementValue int", calls, 0, [f, calls]() -> std::uint64_t {
+            for (size_t i = 0; i < calls; ++i) {
+                f->symbolTable.setArrayElementValue(f->ints2, i & (ARRAY_SIZE - 1), StoredValue(static_cast<int>(i)));
+            }
+            return calls;
+        } });
+        benchmarks.push_back({ "symbols", "setArrayElementValue float", calls, 0, [f, calls]() -> std::uint64_t {
+            for (size_t i = 0; i < calls; ++i) {
+                f->symbolTable.setArrayElementValue(f->floats, i & (ARRAY_SIZE - 1), StoredValue(static_cast<float>(i)));
+            }
+            return calls;
+        } });
+    }
+
+    // Текст из одинаковых фрагментов (около 64 КБ)
+    std::string repeatFragment(const std::string& fragment) {
+        std::string source;
+        while (source.size() < 64 * 1024) source += fragment;
+        return source;
+    }
+
+    void addLexerBenchmarks(std::vector<MicroBenchmark>& benchmarks) {
+        const struct { const char* name; std::string source; } mixes[] = {
+            { "identifiers", repeatFragment("alpha beta gammaDelta counterValue i j k\n") },
+            { "numbers", repeatFragment("12345 7 0.25 3.14159 1000000 42\n") },
+            { "operators", repeatFragment("( ) [ ] + - * / = == != < > ;\n") },
+            { "keywords", repeatFragment("begin while if else end cin cout int float\n") },
+            { "generated program", generateLexerWorkload(64 * 1024) }
+        };
+        for (const auto& mix : mixes) {
+            auto source = std::make_shared<std::string>(mix.source);
+            // Число токенов известно заранее: время считается на токен
+            size_t tokenCount = 0;
+            {
+                ErrorHandler errorHandler;
+                SymbolTable symbolTable(errorHandler);
+                Lexer lexer(*source, symbolTable, errorHandler);
+                while (lexer.getNextToken().type != TokenType::T_EOF) ++tokenCount;
+            }
+            benchmarks.push_back({ "lexer", std::string("getNextToken ") + mix.name, tokenCount, 0,
+                [source]() -> std::uint64_t {
+                    ErrorHandler errorHandler;
+                    SymbolTable symbolTable(errorHandler);
+                    Lexer lexer(*source, symbolTable, errorHandler);
+                    std::uint64_t count = 0;
+                    while (lexer.getNextToken().type != TokenType::T_EOF) ++count;
+                    return count;
+                } });
+        }
+    }
+
+    void writeJsonString(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') out << '\\';
+            out << c;
+        }
+        out << '"';
+    }
+
+} // namespace
+
+std::vector<MicroBenchResult> runMicroBenchmarks(const MicroBenchOptions& options) {
+    std::vector<MicroBenchmark> benchmarks;
+    addRpnBenchmarks(benchmarks);
+    addStackBenchmarks(benchmarks);
+    addSymbolTableBenchmarks(benchmarks);
+    addLexerBenchmarks(benchmarks);
+
+    std::vector<MicroBenchResult> results;
+    for (const MicroBenchmark& benchmark : benchmarks) {
+        std::string fullName = benchmark.group + "/" + benchmark.name;
+        if (!options.filter.empty() && fullName.find(options.filter) == std::string::npos) continue;
+        results.push_back(measure(benchmark, options));
+    }
+    return results;
+}
+
+void printMicroBenchResults(std::ostream& out, const std::vector<MicroBenchResult>& results) {
+    std::ios_base::fmtflags savedFlags = out.flags();
+    std::streamsize savedPrecision = out.precision();
+    out << std::left << std::setw(54) << "benchmark" << std::right << std::setw(12) << "median ns"
+        << std::setw(10) << "min ns" << std::setw(9) << "+-%" << std::setw(12) << "ns/RPN op" << std::endl;
+    out << std::fixed;
+    for (const MicroBenchResult& result : results) {
+        double relative = result.meanNs > 0 ? 100.0 * result.stddevNs / result.meanNs : 0.0;
+        out << std::left << std::setw(54) << (result.group + "/" + result.name) << std::right
+            << std::setprecision(2) << std::setw(12) << result.medianNs << std::setw(10) << result.minNs
+            << std::setprecision(1) << std::setw(9) << relative;
+        if (result.rpnOpsPerOperation > 0) {
+            out << std::setprecision(2) << std::setw(12) << result.medianNs / static_cast<double>(result.rpnOpsPerOperation);
+        }
+        out << std::endl;
+    }
+    out.flags(savedFlags);
+    out.precision(savedPrecision);
+}
+
+void writeMicroBenchJson(std::ostream& out, const std::vector<MicroBenchResult>& results, const MicroBenchOptions& options) {
+    std::ios_base::fmtflags savedFlags = out.flags();
+    std::streamsize savedPrecision = out.precision();
+    out << std::fixed << std::setprecision(4);
+    out << "{\"repetitions\":" << options.repetitions << ",\"min_time_ms\":" << options.minMilliseconds
+        << ",\"benchmarks\":[";
+    for (size_t k = 0; k < results.size(); ++k) {
+        const MicroBenchResult& result = results[k];
+        out << (k > 0 ? ",\n  " : "\n  ") << "{\"group\":";
+        writeJsonString(out, result.group);
+        out << ",\"name\":";
+        writeJsonString(out, result.name);
+        out << ",\"ns_per_op\":" << result.medianNs << ",\"min_ns\":" << result.minNs << ",\"mean_ns\":" << result.meanNs
+            << ",\"stddev_ns\":" << result.stddevNs << ",\"ops_per_call\":" << result.operationsPerCall;
+        if (result.rpnOpsPerOperation > 0) {
+            out << ",\"rpn_ops_per_op\":" << result.rpnOpsPerOperation
+                << ",\"ns_per_rpn_op\":" << result.medianNs / static_cast<double>(result.rpnOpsPerOperation);
+        }
+        out << "}";
+    }
+    out << "\n]}" << std::endl;
+    out.flags(savedFlags);
+    out.precision(savedPrecision);
+}
@@ -0,0 +1,44 @@
+// micro_bench.h
+#ifndef MICRO_BENCH_H
+#define MICRO_BENCH_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstddef>
+
+// --- Микрозамеры интерпретатора, стека, таблицы символов и лексера ---
+// Каждый замер - функция, выполняющая известное число операций. Сначала она прогревается
+// (и калибруется число вызовов на повторение так, чтобы повторение длилось около minMilliseconds),
+// затем выполняется repetitions повторений; по ним считаются медиана, минимум, среднее
+// и стандартное отклонение времени одной операции.
+//
+// Операции ОПС замеряются на прямолинейном коде: оператор-ядро (например, x = a + b) повторяется
+// много раз и выполняется интерпретатором целиком. Время дается на одно ядро и на одну операцию ОПС;
+// ядро "assign" (x = a) - база для вычитания стоимости загрузки и присваивания.
+
+struct MicroBenchOptions {
+    int repetitions = 7;
+    double minMilliseconds = 20.0; // Длительность одного повторения
+    std::string filter;            // Подстрока имени замера (пусто - все)
+};
+
+struct MicroBenchResult {
+    std::string group;   // "rpn", "stack", "symbols", "lexer"
+    std::string name;
+    size_t operationsPerCall;  // Операций (ядер, пар push/pop, токенов) за один вызов
+    size_t rpnOpsPerOperation; // Операций ОПС в ядре (0 - не ОПС)
+    double medianNs;     // Время одной операции
+    double minNs;
+    double meanNs;
+    double stddevNs;
+    int repetitions;
+};
+
+std::vector<MicroBenchResult> runMicroBenchmarks(const MicroBenchOptions& options);
+
+void printMicroBenchResults(std::ostream& out, const std::vector<MicroBenchResult>& results);
+// Один объект JSON: {"benchmarks":[{"group":...,"name":...,"ns_per_op":...}, ...]}
+void writeMicroBenchJson(std::ostream& out, const std::vector<MicroBenchResult>& results, const MicroBenchOptions& options);
+
+#endif // MICRO_BENCH_H
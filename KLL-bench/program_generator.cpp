@@ -0,0 +1,218 @@
+// program_generator.cpp
+#include "program_generator.h"
+
+#include <algorithm>
+
+namespace {
+
+    const unsigned VARIABLE_COUNT = 64; // Переменные v0..v63
+    const unsigned ARRAY_SIZE = 256;    // Массив a
+
+    // 64-битный линейный конгруэнтный генератор (старшие биты)
+    class GeneratorRandom {
+    public:
+        explicit GeneratorRandom(std::uint64_t seed) : state(seed) {}
+        unsigned next(unsigned limit) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            return static_cast<unsigned>((state >> 33) % limit);
+        }
+    private:
+        std::uint64_t state;
+    };
+
+    struct ProgramShapeInfo {
+        ProgramShape shape;
+        const char* name;
+        int defaultDepth;
+    };
+
+    const ProgramShapeInfo SHAPES[] = {
+        { ProgramShape::Straight, "straight", 0 },
+        { ProgramShape::Expression, "expr", 16 },
+        { ProgramShape::Blocks, "blocks", 8 },
+        { ProgramShape::Declarations, "decls", 0 },
+    };
+
+    std::string variable(GeneratorRandom& random) {
+        return "v" + std::to_string(random.next(VARIABLE_COUNT));
+    }
+
+    void appendCommonDeclarations(std::string& source, int whileCounters) {
+        for (unsigned i = 0; i < VARIABLE_COUNT; ++i) source += "int v" + std::to_string(i) + ";\n";
+        for (int i = 0; i < whileCounters; ++i) source += "int w" + std::to_string(i) + ";\n";
+        source += "int i;\narr int a[" + std::to_string(ARRAY_SIZE) + "];\n";
+    }
+
+    // Начальные значения: чтение неинициализированной переменной - ошибка времени выполнения
+    void appendInitialization(std::string& source, int whileCounters) {
+        for (unsigned i = 0; i < VARIABLE_COUNT; ++i) source += "  v" + std::to_string(i) + " = " + std::to_string(i) + ";\n";
+        for (int i = 0; i < whileCounters; ++i) source += "  w" + std::to_string(i) + " = 0;\n";
+        source += "  i = 0;\n  while (i < " + std::to_string(ARRAY_SIZE) + ") begin a[i] = i; i = i + 1 end;\n";
+    }
+
+    // Простое присваивание. Значения переменных и элементов a остаются ограниченными:
+    // прибавление константы растет линейно с длиной программы, остальные формы не увеличивают модуль.
+    std::string simpleStatement(GeneratorRandom& random) {
+        switch (random.next(5)) {
+        case 0:
+            return variable(random) + " = " + variable(random) + " + " + std::to_string(random.next(100));
+        case 1:
+            return variable(random) + " = (" + variable(random) + " - " + variable(random) + ") / 2";
+        case 2:
+            return "a[" + std::to_string(random.next(ARRAY_SIZE)) + "] = " + variable(random) + " - "
+                + std::to_string(random.next(100));
+        case 3:
+            return variable(random) + " = a[" + std::to_string(random.next(ARRAY_SIZE)) + "] / "
+                + std::to_string(1 + random.next(9));
+        default:
+            return variable(random) + " = " + variable(random) + " * 3 / 4";
+        }
+    }
+
+    std::string expressionLeaf(GeneratorRandom& random) {
+        switch (random.next(3)) {
+        case 0: return std::to_string(random.next(100));
+        case 1: return "a[" + std::to_string(random.next(ARRAY_SIZE)) + "]";
+        default: return variable(random);
+        }
+    }
+
+    // Выражение со вложенностью скобок depth из depth + 1 листьев, операции + и -
+    std::string nestedExpression(GeneratorRandom& random, int depth) {
+        if (depth == 0) return expressionLeaf(random);
+        std::string inner = nestedExpression(random, depth - 1);
+        const char* operation = random.next(2) == 0 ? " + " : " - ";
+        if (random.next(2) == 0) return "(" + inner + operation + expressionLeaf(random) + ")";
+        return "(" + expressionLeaf(random) + operation + inner + ")";
+    }
+
+    void appendLine(std::string& body, size_t& lines, int indent, const std::string& text) {
+        body.append(static_cast<size_t>(indent) * 2, ' ');
+        body += text;
+        body += '\n';
+        ++lines;
+    }
+
+    // Уровень вложенного блока: на четных уровнях if/else, на нечетных while с одним проходом (счетчик wL).
+    // Операторы списка разделяются ';' - в конце каждой строки, кроме последней в списке.
+    void appendNestedBlock(std::string& body, size_t& lines, GeneratorRandom& random, int level, int depth, bool last) {
+        int indent = level + 1;
+        const char* separator = last ? "" : ";";
+        if (level == depth) {
+            appendLine(body, lines, indent, simpleStatement(random) + ";");
+            appendLine(body, lines, indent, simpleStatement(random) + separator);
+            return;
+        }
+        if (level % 2 == 0) {
+            appendLine(body, lines, indent, "if (" + variable(random) + " < " + std::to_string(random.next(100)) + ") begin");
+            appendLine(body, lines, indent + 1, simpleStatement(random) + ";");
+            appendNestedBlock(body, lines, random, level + 1, depth, true);
+            appendLine(body, lines, indent, "end");
+            appendLine(body, lines, indent, "else " + simpleStatement(random) + separator);
+        }
+        else {
+            std::string counter = "w" + std::to_string(level);
+            appendLine(body, lines, indent, counter + " = 0;");
+            appendLine(body, lines, indent, "while (" + counter + " < 1) begin");
+            appendLine(body, lines, indent + 1, counter + " = " + counter + " + 1;");
+            appendNestedBlock(body, lines, random, level + 1, depth, true);
+            appendLine(body, lines, indent, std::string("end") + separator);
+        }
+    }
+
+    std::string generateDeclarations(size_t count, GeneratorRandom& random) {
+        std::string source;
+        source.reserve(count * 16 + 256);
+        std::string body;
+        size_t step = std::max<size_t>(1, count / 16); // Тело обращается примерно к 16 объявленным именам
+        for (size_t i = 0; i < count; ++i) {
+            std::string index = std::to_string(i);
+            bool used = (i % step == 0) || i + 1 == count;
+            switch (i % 4) {
+            case 0:
+                source += "int d" + index + ";\n";
+                if (used) body += "  d" + index + " = " + std::to_string(random.next(100)) + ";\n";
+                break;
+            case 1:
+                source += "float f" + index + ";\n";
+                if (used) body += "  f" + index + " = " + std::to_string(random.next(100)) + ".5;\n";
+                break;
+            case 2:
+                source += "arr int a" + index + "[8];\n";
+                if (used) body += "  a" + index + "[" + std::to_string(random.next(8)) + "] = "
+                    + std::to_string(random.next(100)) + ";\n";
+                break;
+            default:
+                source += "arr float g" + index + "[4];\n";
+                if (used) body += "  g" + index + "[" + std::to_string(random.next(4)) + "] = 0.25;\n";
+                break;
+            }
+        }
+        source += "begin\n" + body + "  cout(0)\nend\n";
+        return source;
+    }
+
+} // namespace
+
+bool parseProgramShape(const std::string& name, ProgramShape& shape) {
+    for (const ProgramShapeInfo& info : SHAPES) {
+        if (name == info.name) {
+            shape = info.shape;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* getProgramShapeName(ProgramShape shape) {
+    for (const ProgramShapeInfo& info : SHAPES) {
+        if (info.shape == shape) return info.name;
+    }
+    return "unknown";
+}
+
+std::vector<ProgramShape> getProgramShapes() {
+    std::vector<ProgramShape> shapes;
+    for (const ProgramShapeInfo& info : SHAPES) shapes.push_back(info.shape);
+    return shapes;
+}
+
+int getDefaultDepth(ProgramShape shape) {
+    for (const ProgramShapeInfo& info : SHAPES) {
+        if (info.shape == shape) return info.defaultDepth;
+    }
+    return 0;
+}
+
+std::string generateProgram(const ProgramGeneratorOptions& options) {
+    GeneratorRandom random(options.seed);
+    size_t targetLines = std::max<size_t>(1, options.lines);
+    int depth = options.depth > 0 ? options.depth : getDefaultDepth(options.shape);
+    if (options.shape == ProgramShape::Declarations) return generateDeclarations(targetLines, random);
+
+    std::string source;
+    appendCommonDeclarations(source, options.shape == ProgramShape::Blocks ? depth : 0);
+    source += "begin\n";
+    appendInitialization(source, options.shape == ProgramShape::Blocks ? depth : 0);
+    std::string body;
+    size_t lines = 0;
+    while (lines < targetLines) {
+        switch (options.shape) {
+        case ProgramShape::Expression:
+            // Сумма depth + 1 листьев, деленная на depth + 1, по модулю не больше наибольшего листа
+            appendLine(body, lines, 1, variable(random) + " = " + nestedExpression(random, depth) + " / "
+                + std::to_string(depth + 1) + ";");
+            break;
+        case ProgramShape::Blocks:
+            appendNestedBlock(body, lines, random, 0, depth, false);
+            break;
+        default:
+            appendLine(body, lines, 1, simpleStatement(random) + ";");
+            break;
+        }
+    }
+    source.reserve(source.size() + body.size() + 32);
+    source += body;
+    source += "  cout(v0)\nend\n";
+    return source;
+}
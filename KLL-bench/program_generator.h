@@ -0,0 +1,37 @@
+// program_generator.h
+#ifndef PROGRAM_GENERATOR_H
+#define PROGRAM_GENERATOR_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// --- Генератор синтетических программ KLL для замеров масштабируемости компилятора ---
+// Программа заданной формы и размера (строк тела между begin и end, не считая начальной инициализации
+// переменных) корректна: она проходит разбор и выполняется без ошибок времени выполнения (нет деления
+// на ноль, выхода за границы массива, циклы конечны). Формы нагружают разные части компилятора:
+//   straight - длинный линейный код из простых присваиваний (IR и проходы на одном большом блоке);
+//   expr     - каждое присваивание - выражение со вложенностью скобок depth (рекурсия разбора, регистры IR);
+//   blocks   - вложенные на depth уровней if/else и while (число блоков и переходов, граф потока управления);
+//   decls    - объявления переменных и массивов, тело из нескольких операторов (таблица символов).
+// Содержимое определяется затравкой seed, поэтому одинаково при каждом запуске.
+
+enum class ProgramShape { Straight, Expression, Blocks, Declarations };
+
+struct ProgramGeneratorOptions {
+    ProgramShape shape = ProgramShape::Straight;
+    size_t lines = 1000;         // Примерное число строк тела (для decls - число объявлений)
+    int depth = 0;               // Вложенность для expr и blocks (0 - по умолчанию для формы)
+    std::uint64_t seed = 1;
+};
+
+// "straight", "expr", "blocks", "decls"; false - неизвестное имя
+bool parseProgramShape(const std::string& name, ProgramShape& shape);
+const char* getProgramShapeName(ProgramShape shape);
+std::vector<ProgramShape> getProgramShapes();
+int getDefaultDepth(ProgramShape shape);
+
+std::string generateProgram(const ProgramGeneratorOptions& options);
+
+#endif // PROGRAM_GENERATOR_H
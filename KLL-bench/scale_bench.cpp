@@ -0,0 +1,199 @@
+// scale_bench.cpp
+#include "scale_bench.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "alloc_tracker.h"
+#include "lexer.h"
+#include "token_buffer.h"
+#include "parser.h"
+#include "symbol_table.h"
+#include "error_handler.h"
+
+namespace {
+
+    const char* const PHASE_NAMES[] = { "lex", "syntax", "ir", "optimize", "rpn", "loops" };
+    const size_t PHASE_COUNT = sizeof(PHASE_NAMES) / sizeof(PHASE_NAMES[0]);
+
+    double phaseMilliseconds(const ScaleBenchResult& result, size_t phase) {
+        switch (phase) {
+        case 0: return result.lexMilliseconds;
+        case 1: return result.syntaxMilliseconds;
+        case 2: return result.irBuildMilliseconds;
+        case 3: return result.optimizeMilliseconds;
+        case 4: return result.rpnMilliseconds;
+        default: return result.loopAnalysisMilliseconds;
+        }
+    }
+
+    double totalMilliseconds(const ScaleBenchResult& result) {
+        double total = 0.0;
+        for (size_t phase = 0; phase < PHASE_COUNT; ++phase) total += phaseMilliseconds(result, phase);
+        return total;
+    }
+
+    // Один прогон лексера и разбора; время этапов заменяется меньшим из прежнего и нового
+    bool compileOnce(const std::string& source, int optimizationLevel, ScaleBenchResult& result, bool first) {
+        using Clock = std::chrono::steady_clock;
+        size_t baseBytes = AllocationTracker::currentBytes();
+        AllocationTracker::resetPeak();
+
+        ErrorHandler errorHandler;
+        SymbolTable symbolTable(errorHandler);
+        Lexer lexer(source, symbolTable, errorHandler);
+        Clock::time_point start = Clock::now();
+        TokenBuffer tokens = TokenBuffer::tokenize(lexer, source);
+        double lexMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        size_t lexPeakBytes = AllocationTracker::peakBytes() - baseBytes;
+
+        size_t parseBaseBytes = AllocationTracker::currentBytes();
+        AllocationTracker::resetPeak();
+        bool success;
+        ParsePhaseTimes times;
+        {
+            Parser parser(tokens, symbolTable, errorHandler);
+            parser.setOptimizationLevel(optimizationLevel);
+            success = parser.parse() && !errorHandler.hasErrors();
+            times = parser.getPhaseTimes();
+        }
+        size_t parsePeakBytes = AllocationTracker::peakBytes() - parseBaseBytes;
+
+        if (first) {
+            result.tokens = tokens.size() - 1;
+            result.lexMilliseconds = lexMilliseconds;
+            result.syntaxMilliseconds = times.syntax;
+            result.irBuildMilliseconds = times.irBuild;
+            result.optimizeMilliseconds = times.optimize;
+            result.rpnMilliseconds = times.rpnEmission;
+            result.loopAnalysisMilliseconds = times.loopAnalysis;
+            result.lexPeakBytes = lexPeakBytes;
+            result.parsePeakBytes = parsePeakBytes;
+        }
+        else {
+            result.lexMilliseconds = std::min(result.lexMilliseconds, lexMilliseconds);
+            result.syntaxMilliseconds = std::min(result.syntaxMilliseconds, times.syntax);
+            result.irBuildMilliseconds = std::min(result.irBuildMilliseconds, times.irBuild);
+            result.optimizeMilliseconds = std::min(result.optimizeMilliseconds, times.optimize);
+            result.rpnMilliseconds = std::min(result.rpnMilliseconds, times.rpnEmission);
+            result.loopAnalysisMilliseconds = std::min(result.loopAnalysisMilliseconds, times.loopAnalysis);
+        }
+        return success;
+    }
+
+    void printHeader(std::ostream& out) {
+        out << std::left << std::setw(10) << "shape" << std::right << std::setw(9) << "lines" << std::setw(6) << "depth"
+            << std::setw(11) << "source KB" << std::setw(10) << "tokens";
+        for (const char* phase : PHASE_NAMES) out << std::setw(12) << (std::string(phase) + " ms");
+        out << std::setw(12) << "lex peak MB" << std::setw(14) << "parse peak MB" << std::endl;
+    }
+
+    void printResultRow(std::ostream& out, const ScaleBenchResult& result) {
+        out << std::left << std::setw(10) << result.shape << std::right << std::setw(9) << result.lines
+            << std::setw(6) << result.depth << std::fixed << std::setprecision(1)
+            << std::setw(11) << static_cast<double>(result.sourceBytes) / 1024.0 << std::setw(10) << result.tokens;
+        if (result.status != "ok") {
+            out << "  " << result.status << std::endl;
+            return;
+        }
+        out << std::setprecision(2);
+        for (size_t phase = 0; phase < PHASE_COUNT; ++phase) out << std::setw(12) << phaseMilliseconds(result, phase);
+        out << std::setw(12) << static_cast<double>(result.lexPeakBytes) / (1024.0 * 1024.0)
+            << std::setw(14) << static_cast<double>(result.parsePeakBytes) / (1024.0 * 1024.0) << std::endl;
+    }
+
+    // Показатели роста этапов относительно предыдущего размера той же формы
+    void printGrowthRow(std::ostream& out, const ScaleBenchResult& previous, const ScaleBenchResult& current,
+        double superlinearExponent) {
+        double sizeRatio = std::log(static_cast<double>(current.lines) / static_cast<double>(previous.lines));
+        out << std::left << std::setw(46) << "  growth exponent" << std::right << std::fixed << std::setprecision(2);
+        std::string superlinear;
+        for (size_t phase = 0; phase < PHASE_COUNT; ++phase) {
+            double before = phaseMilliseconds(previous, phase);
+            double after = phaseMilliseconds(current, phase);
+            if (before < 1.0 || after < 1.0) {
+                out << std::setw(12) << "-"; // Слишком короткие замеры
+                continue;
+            }
+            double exponent = std::log(after / before) / sizeRatio;
+            out << std::setw(12) << exponent;
+            if (exponent > superlinearExponent) superlinear += std::string(superlinear.empty() ? "" : ", ") + PHASE_NAMES[phase];
+        }
+        double memoryBefore = static_cast<double>(previous.parsePeakBytes);
+        double memoryAfter = static_cast<double>(current.parsePeakBytes);
+        double memoryExponent = memoryBefore > 0 ? std::log(memoryAfter / memoryBefore) / sizeRatio : 0.0;
+        out << std::setw(12) << "" << std::setw(14) << memoryExponent;
+        if (memoryExponent > superlinearExponent) superlinear += std::string(superlinear.empty() ? "" : ", ") + "memory";
+        if (!superlinear.empty()) out << "  SUPERLINEAR: " << superlinear;
+        out << std::endl;
+    }
+
+} // namespace
+
+std::vector<ScaleBenchResult> runScaleBenchmark(const ScaleBenchOptions& options, std::ostream& out) {
+    std::vector<ScaleBenchResult> results;
+    std::ios_base::fmtflags savedFlags = out.flags();
+    std::streamsize savedPrecision = out.precision();
+    printHeader(out);
+
+    std::vector<ProgramShape> shapes = options.shapes.empty() ? getProgramShapes() : options.shapes;
+    for (ProgramShape shape : shapes) {
+        bool havePrevious = false;
+        ScaleBenchResult previous{};
+        for (size_t lines = options.minLines; lines <= options.maxLines; lines *= 10) {
+            ProgramGeneratorOptions generatorOptions;
+            generatorOptions.shape = shape;
+            generatorOptions.lines = lines;
+            generatorOptions.depth = options.depth;
+            std::string source = generateProgram(generatorOptions);
+
+            ScaleBenchResult result{};
+            result.shape = getProgramShapeName(shape);
+            result.lines = lines;
+            result.depth = options.depth > 0 ? options.depth : getDefaultDepth(shape);
+            result.status = "ok";
+            result.sourceBytes = source.size();
+            for (int repetition = 0; repetition < options.repetitions; ++repetition) {
+                if (!compileOnce(source, options.optimizationLevel, result, repetition == 0)) {
+                    result.status = "compile_error";
+                    break;
+                }
+            }
+            printResultRow(out, result);
+            if (result.status == "ok" && havePrevious) printGrowthRow(out, previous, result, options.superlinearExponent);
+            results.push_back(result);
+
+            // Следующий размер разбирался бы примерно в 10 (и более) раз дольше
+            if (result.status != "ok" || totalMilliseconds(result) / 1000.0 > options.maxSeconds) break;
+            previous = result;
+            havePrevious = true;
+            if (lines > options.maxLines / 10) break; // Без переполнения lines *= 10
+        }
+    }
+    out.flags(savedFlags);
+    out.precision(savedPrecision);
+    return results;
+}
+
+void writeScaleBenchJson(std::ostream& out, const std::vector<ScaleBenchResult>& results) {
+    std::ios_base::fmtflags savedFlags = out.flags();
+    std::streamsize savedPrecision = out.precision();
+    out << std::fixed << std::setprecision(3);
+    out << "{\"runs\":[";
+    for (size_t k = 0; k < results.size(); ++k) {
+        const ScaleBenchResult& result = results[k];
+        out << (k > 0 ? ",\n  " : "\n  ") << "{\"shape\":\"" << result.shape << "\",\"lines\":" << result.lines
+            << ",\"depth\":" << result.depth << ",\"status\":\"" << result.status << "\",\"source_bytes\":" << result.sourceBytes
+            << ",\"tokens\":" << result.tokens;
+        for (size_t phase = 0; phase < PHASE_COUNT; ++phase) {
+            out << ",\"" << PHASE_NAMES[phase] << "_ms\":" << phaseMilliseconds(result, phase);
+        }
+        out << ",\"lex_peak_bytes\":" << result.lexPeakBytes << ",\"parse_peak_bytes\":" << result.parsePeakBytes << "}";
+    }
+    out << "\n]}" << std::endl;
+    out.flags(savedFlags);
+    out.precision(savedPrecision);
+}
@@ -0,0 +1,53 @@
+// scale_bench.h
+#ifndef SCALE_BENCH_H
+#define SCALE_BENCH_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstddef>
+
+#include "program_generator.h"
+
+// --- Масштабируемость компилятора KLL 1.2 на синтетических программах (program_generator.h) ---
+// Для каждой формы программы размер (строк) перебирается степенями 10 от minLines до maxLines.
+// Замеряются этапы: лексер (TokenBuffer::tokenize), разбор, построение IR, оптимизация, генерация ОПС,
+// анализ циклов (Parser::getPhaseTimes) и пик динамической памяти лексера и всего разбора
+// (alloc_tracker.h). Время - минимум по repetitions повторам. Для каждого этапа считается показатель
+// роста log(t2/t1) / log(n2/n1) относительно предыдущего размера: около 1 - линейный рост, заметно
+// больше - сверхлинейный (отмечается, если больше superlinearExponent и оба времени не меньше 1 мс).
+
+struct ScaleBenchOptions {
+    std::vector<ProgramShape> shapes; // Пусто - все формы
+    size_t minLines = 1000;
+    size_t maxLines = 1000000;
+    int depth = 0;                    // 0 - по умолчанию для формы
+    int optimizationLevel = 2;
+    int repetitions = 3;
+    double maxSeconds = 10.0;         // Если разбор длился дольше, большие размеры формы пропускаются
+    double superlinearExponent = 1.2;
+};
+
+struct ScaleBenchResult {
+    std::string shape;
+    size_t lines;
+    int depth;
+    std::string status;             // "ok" или "compile_error"
+    size_t sourceBytes;
+    size_t tokens;                  // Без T_EOF
+    double lexMilliseconds;
+    double syntaxMilliseconds;
+    double irBuildMilliseconds;
+    double optimizeMilliseconds;
+    double rpnMilliseconds;
+    double loopAnalysisMilliseconds;
+    size_t lexPeakBytes;            // Пик сверх памяти до начала лексера (буфер токенов, таблица символов)
+    size_t parsePeakBytes;          // Пик сверх памяти до начала разбора (дерево, IR, ОПС)
+};
+
+// Печатает таблицу и показатели роста в out по мере выполнения; возвращает все результаты
+std::vector<ScaleBenchResult> runScaleBenchmark(const ScaleBenchOptions& options, std::ostream& out);
+
+void writeScaleBenchJson(std::ostream& out, const std::vector<ScaleBenchResult>& results);
+
+#endif // SCALE_BENCH_H
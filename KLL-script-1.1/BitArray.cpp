@@ -0,0 +1,76 @@
+#include "BitArray.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace {
+
+    // Число единичных битов слова. GCC/Clang выбирают лучшую реализацию сами (инструкция popcnt,
+    // если она разрешена флагами компиляции). MSVC __popcnt64 всегда генерирует popcnt без проверки
+    // процессора, поэтому для него - переносимый подсчет сложением битовых полей (SWAR).
+    inline size_t popCount(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_popcountll(word));
+#else
+        word = word - ((word >> 1) & 0x5555555555555555ull);
+        word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+        word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return static_cast<size_t>((word * 0x0101010101010101ull) >> 56);
+#endif
+    }
+
+} // namespace
+
+BitArray::BitArray(size_t size, bool value) {
+    assign(size, value);
+}
+
+void BitArray::assign(size_t size, bool value) {
+    bitCount = size;
+    words.assign((size + BITS_PER_WORD - 1) / BITS_PER_WORD, value ? ~std::uint64_t(0) : 0);
+    clearUnusedBits();
+}
+
+void BitArray::clearUnusedBits() {
+    size_t usedBits = bitCount % BITS_PER_WORD;
+    if (usedBits != 0) {
+        words.back() &= (std::uint64_t(1) << usedBits) - 1;
+    }
+}
+
+size_t BitArray::count() const {
+    // Четыре независимых суммы, чтобы подсчеты соседних слов не ждали друг друга
+    size_t sums[4] = { 0, 0, 0, 0 };
+    size_t i = 0;
+    for (; i + 4 <= words.size(); i += 4) {
+        sums[0] += popCount(words[i]);
+        sums[1] += popCount(words[i + 1]);
+        sums[2] += popCount(words[i + 2]);
+        sums[3] += popCount(words[i + 3]);
+    }
+    for (; i < words.size(); ++i) sums[0] += popCount(words[i]);
+    return sums[0] + sums[1] + sums[2] + sums[3];
+}
+
+void BitArray::fill(bool value) {
+    assign(bitCount, value);
+}
+
+// Циклы по словам без ветвлений компилятор векторизует (SSE2/AVX2) сам
+bool BitArray::andWith(const BitArray& other) {
+    if (other.bitCount != bitCount) return false;
+    for (size_t i = 0; i < words.size(); ++i) words[i] &= other.words[i];
+    return true;
+}
+
+bool BitArray::orWith(const BitArray& other) {
+    if (other.bitCount != bitCount) return false;
+    for (size_t i = 0; i < words.size(); ++i) words[i] |= other.words[i];
+    return true;
+}
+
+void BitArray::invert() {
+    for (std::uint64_t& word : words) word = ~word;
+    clearUnusedBits();
+}
@@ -0,0 +1,52 @@
+#ifndef BIT_ARRAY_H
+#define BIT_ARRAY_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// --- Упакованный массив bool (для arr bool) ---
+// Элемент занимает один бит в 64-битном слове вместо SymbolValue (variant, ~16 байт на элемент).
+// Массовые операции (подсчет, заполнение, &, | и not целых массивов) работают сразу со словами.
+// Инвариант: биты последнего слова за пределами size() всегда нулевые, поэтому count()
+// не требует маскирования, а invert() восстанавливает инвариант сам.
+class BitArray {
+private:
+    std::vector<std::uint64_t> words;
+    size_t bitCount = 0;
+
+    static const size_t BITS_PER_WORD = 64;
+
+    void clearUnusedBits(); // Обнуляет биты последнего слова за пределами bitCount
+
+public:
+    BitArray() = default;
+    BitArray(size_t size, bool value);
+
+    // Выделяет size элементов, все равны value (старые данные пропадают)
+    void assign(size_t size, bool value);
+    size_t size() const { return bitCount; }
+
+    // Доступ к элементу; индекс проверяет вызывающий код (SymbolTable)
+    bool get(size_t index) const {
+        return ((words[index / BITS_PER_WORD] >> (index % BITS_PER_WORD)) & 1u) != 0;
+    }
+    void set(size_t index, bool value) {
+        std::uint64_t mask = std::uint64_t(1) << (index % BITS_PER_WORD);
+        if (value) words[index / BITS_PER_WORD] |= mask;
+        else words[index / BITS_PER_WORD] &= ~mask;
+    }
+
+    // --- Массовые операции ---
+    size_t count() const;                 // Число элементов true
+    void fill(bool value);
+    // Поэлементные операции с массивом того же размера (false - размеры различаются, массив не изменен)
+    bool andWith(const BitArray& other);
+    bool orWith(const BitArray& other);
+    void invert();
+
+    // Размер данных в байтах (для диагностики расхода памяти)
+    size_t getStorageBytes() const { return words.size() * sizeof(std::uint64_t); }
+};
+
+#endif // BIT_ARRAY_H
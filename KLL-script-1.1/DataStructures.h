@@ -7,46 +7,47 @@
 #include <stack>
 #include <iostream>
 #include <optional>
-#include <utility> //  std::move
+#include <utility> // Для std::move
 
 #include "definitions.h"
+#include "BitArray.h"
 
-// ---     () ---
+// --- Структура для представления Токена (Лексемы) ---
 struct Token {
     TokenType type = TokenType::T_UNKNOWN;
-    std::string text = "";      //  ( ,  )
-    int intValue = 0;           //   T_NUMBER_INT
-    double floatValue = 0.0;    //   T_NUMBER_FLOAT ()
-    bool boolValue = false;     //   T_KW_TRUE / T_KW_FALSE ()
+    std::string text = "";      // Текст (для идентификаторов, ключевых слов)
+    int intValue = 0;           // Значение для T_NUMBER_INT
+    double floatValue = 0.0;    // Значение для T_NUMBER_FLOAT (Добавлено)
+    bool boolValue = false;     // Значение для T_KW_TRUE / T_KW_FALSE (Добавлено)
     int line = 0;
     int column = 0;
 
     Token() = default;
 
-    //     
-    Token(TokenType t, int l, int c) : type(t), line(l), column(c) {} //   
-    Token(TokenType t, std::string txt, int l, int c) : type(t), text(std::move(txt)), line(l), column(c) {} //  / 
-    Token(TokenType t, int val, int l, int c) : type(t), intValue(val), line(l), column(c) {} //  int
-    Token(TokenType t, double val, int l, int c) : type(t), floatValue(val), line(l), column(c) {} //  float
-    Token(TokenType t, bool val, int l, int c) : type(t), boolValue(val), line(l), column(c) {} //  bool (true/false)
+    // Конструкторы для разных типов токенов
+    Token(TokenType t, int l, int c) : type(t), line(l), column(c) {} // Для простых токенов
+    Token(TokenType t, std::string txt, int l, int c) : type(t), text(std::move(txt)), line(l), column(c) {} // Для идентификаторов/ключевых слов
+    Token(TokenType t, int val, int l, int c) : type(t), intValue(val), line(l), column(c) {} // Для int
+    Token(TokenType t, double val, int l, int c) : type(t), floatValue(val), line(l), column(c) {} // Для float
+    Token(TokenType t, bool val, int l, int c) : type(t), boolValue(val), line(l), column(c) {} // Для bool (true/false)
 };
 
-// ---        ---
-//  variant   float  bool
+// --- Тип для хранения значения переменной или константы ---
+// Расширяем variant для поддержки float и bool
 using SymbolValue = std::variant<int, double, bool>;
 
-// ---     ---
-//    float  bool
+// --- Запись в таблице символов ---
+// Добавляем типы для float и bool
 enum class SymbolType {
     VARIABLE_INT,
-    VARIABLE_FLOAT, // 
-    VARIABLE_BOOL,  // 
+    VARIABLE_FLOAT, // Добавлено
+    VARIABLE_BOOL,  // Добавлено
     ARRAY_INT,
-    ARRAY_FLOAT,    // 
-    ARRAY_BOOL      // 
+    ARRAY_FLOAT,    // Добавлено
+    ARRAY_BOOL      // Добавлено
 };
 
-//         SymbolType
+// Функция для получения типа значения по умолчанию для SymbolType
 inline SymbolValue getDefaultValueForType(SymbolType type) {
     switch (type) {
     case SymbolType::VARIABLE_INT:
@@ -55,7 +56,7 @@ inline SymbolValue getDefaultValueForType(SymbolType type) {
     case SymbolType::ARRAY_FLOAT:  return SymbolValue(0.0);
     case SymbolType::VARIABLE_BOOL:
     case SymbolType::ARRAY_BOOL:   return SymbolValue(false);
-    default:                       return SymbolValue(0); //  
+    default:                       return SymbolValue(0); // Или ошибка
     }
 }
 
@@ -65,10 +66,11 @@ struct SymbolInfo {
     SymbolType type;
     int declarationLine = 0;
 
-    //       
-    SymbolValue value; //   
+    // Инициализируем значением по умолчанию для данного типа
+    SymbolValue value; // Значение для переменных
 
-    std::vector<SymbolValue> arrayData; //   
+    std::vector<SymbolValue> arrayData; // Данные для массивов int и float
+    BitArray boolArrayData;             // Данные для arr bool - по биту на элемент (arrayData пуст)
     size_t arraySize = 0;
 
     SymbolInfo(std::string n, SymbolType t, int line)
@@ -77,13 +79,13 @@ struct SymbolInfo {
 };
 
 
-// ---     (RPN) ---
+// --- Структура для элемента ОПС (RPN) ---
 struct RPNOperation {
     RPNOpCode opCode;
-    // Operand    int, double  bool
+    // Operand теперь может хранить int, double или bool
     std::optional<SymbolValue> operand;
     std::optional<int> symbolIndex;
-    std::optional<int> jumpTarget = -1; //  optional  -1  
+    std::optional<int> jumpTarget = -1; // Используем optional вместо -1 для ясности
 
     RPNOperation(RPNOpCode code) : opCode(code) {}
 
@@ -91,16 +93,16 @@ struct RPNOperation {
 
     RPNOperation(RPNOpCode code, int symIdx) : opCode(code), symbolIndex(symIdx) {}
 
-    //   
+    // Конструктор для переходов
     RPNOperation(RPNOpCode code, bool isJumpPlaceholder) : opCode(code) {
-        if (code == RPNOpCode::JUMP || code == RPNOpCode::JUMP_FALSE) {
-            jumpTarget = std::nullopt; //  nullopt  -1
+        if (code == RPNOpCode::JUMP || code == RPNOpCode::JUMP_FALSE || code == RPNOpCode::JUMP_TRUE) {
+            jumpTarget = std::nullopt; // Используем nullopt вместо -1
         }
     }
 };
 
 
-// ---    ---
+// --- Элемент стека интерпретатора ---
 
 struct SymbolAddress {
     int tableIndex;
@@ -114,21 +116,21 @@ struct ArrayElementAddress {
 struct StackValue {
     enum class Type {
         INT_VALUE,
-        FLOAT_VALUE,        // 
-        BOOL_VALUE,         // 
-        SYMBOL_ADDRESS,     //  
-        ARRAY_ELEMENT_ADDRESS //   
+        FLOAT_VALUE,        // Добавлено
+        BOOL_VALUE,         // Добавлено
+        SYMBOL_ADDRESS,     // Адрес переменной
+        ARRAY_ELEMENT_ADDRESS // Адрес элемента массива
     } type;
 
-    //  variant     
+    // Расширяем variant для хранения новых типов значений
     std::variant<int, double, bool, SymbolAddress, ArrayElementAddress> value;
 
-    // 
+    // Конструкторы
     StackValue(int val) : type(Type::INT_VALUE), value(val) {}
-    StackValue(double val) : type(Type::FLOAT_VALUE), value(val) {} // 
-    StackValue(bool val) : type(Type::BOOL_VALUE), value(val) {}   // 
+    StackValue(double val) : type(Type::FLOAT_VALUE), value(val) {} // Добавлено
+    StackValue(bool val) : type(Type::BOOL_VALUE), value(val) {}   // Добавлено
 
-    //    
+    // Конструктор для адреса переменной
     StackValue(int symIndex, Type t) : type(t) {
         if (t == Type::SYMBOL_ADDRESS) {
             value = SymbolAddress{ symIndex };
@@ -138,13 +140,13 @@ struct StackValue {
             exit(EXIT_FAILURE);
         }
     }
-    //     
+    // Конструктор для адреса элемента массива
     StackValue(int tblIdx, int elmIdx) : type(Type::ARRAY_ELEMENT_ADDRESS), value(ArrayElementAddress{ tblIdx, elmIdx }) {}
 };
 
 
-// ---    ---
-// ( ,       StackValue)
+// --- Класс Стека Интерпретатора ---
+// (Без изменений, но теперь будет работать с расширенным StackValue)
 class RuntimeStack {
 private:
     std::stack<StackValue> stck;
@@ -1,13 +1,13 @@
 #include "Lexer.h"
 #include <iostream>
 #include <cstring>
-#include <cctype>    //  isprint, isdigit, isalpha
-#include <cstdlib>   //  std::strtod
-#include <sstream>   //  createErrorToken
+#include <cctype>    // Для isprint, isdigit, isalpha
+#include <cstdlib>   // Для std::strtod
+#include <sstream>   // Для createErrorToken
 
-// ---    ---
+// --- Обновленные статические таблицы ---
 
-// : 0:a-z(excl 'e'), 1:0-9, 2:'+', 3:'-', 4:'=', 5:'*', 6:'/', 7:space/cr/tab,
+// Категории: 0:a-z(excl 'e'), 1:0-9, 2:'+', 3:'-', 4:'=', 5:'*', 6:'/', 7:space/cr/tab,
 //            8:'(', 9:')', 10:'[', 11:']', 12:'~', 13:'>', 14:'<', 15:'!', 16:';',
 //            17:'\n', 18:'.', 19:'e'/'E', 20:'&', 21:'|', 22:other/$
 const int Lexer::asciiCategoryTable[128] = {
@@ -29,73 +29,73 @@ const int Lexer::asciiCategoryTable[128] = {
 };
 
 
-//   
-// : ... 19:e/E, 20:'&', 21:'|', 22:other/$
-// : START(0)..EXP_DIGIT(7), AND1(8), OR1(9)
-//  ,    10x23 ( 0-22)
-// : 99 - Error state
-const int Lexer::stateTransitionTable[10][23] = { //    23 
+// Таблица переходов КА
+// Столбцы: ... 19:e/E, 20:'&', 21:'|', 22:other/$
+// Состояния: START(0)..EXP_DIGIT(7), AND1(8), OR1(9)
+// Добавляем состояния, но таблица остается 10x23 (столбцы 0-22)
+// Ошибки: 99 - Error state
+const int Lexer::stateTransitionTable[10][23] = { // Увеличили размер до 23 столбцов
     //    a-z 0-9  +  -  =  *  / sp  (  )  [  ]  ~  >  <  !  ; \n  . e/E  &  | oth/$
     //     0   1   2  3  4  5  6  7  8  9 10 11 12 13 14 15 16  17 18  19 20 21   22
-    /*S 0*/{ 1,  2,100 + '+',100 + '-',100 + '=',100 + '*',100 + '/', 8,100 + '(',100 + ')',100 + '[',100 + ']',100 + '~',100 + '>',100 + '<',100 + '!',100 + ';', 18,  3,  1, 30, 31, 99},// 30: &, 31: |
-    /*ID 1*/{ 1,  1,122,122,122,122,122,122,122,122,122,122,122,122,122,122,122,123,122,  1,122,122,122},// '.'  ID
+    /*S 0*/{ 1,  2,100 + '+',100 + '-',100 + '=',100 + '*',100 + '/', 8,100 + '(',100 + ')',100 + '[',100 + ']',100 + '~',100 + '>',100 + '<',100 + '!',100 + ';', 18,  3,  1, 30, 31, 99},// 30:увидели &, 31:увидели |
+    /*ID 1*/{ 1,  1,122,122,122,122,122,122,122,122,122,122,122,122,122,122,122,123,122,  1,122,122,122},// '.' завершает ID
     /*INT 2*/{99,  2,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,129,  3,  4,128,128,128},
     /*DOT 3*/{99,  4, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99},
     /*FRA 4*/{99,  4,130,130,130,130,130,130,130,130,130,130,130,130,130,130,130,131, 99,  5,130,130,130},
     /*EXP 5*/{99,  7, 99, 6, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99},
     /*SGN 6*/{99,  7, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99},
     /*DIG 7*/{99,  7,130,130,130,130,130,130,130,130,130,130,130,130,130,130,130,131, 99, 99,130,130,130},
-    /*AND1 8*/{99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 32, 99, 99},// 32:   '&'
-    /*OR1 9*/{99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 33, 99}, // 33:   '|'
+    /*AND1 8*/{99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 32, 99, 99},// 32: увидели второй '&'
+    /*OR1 9*/{99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 33, 99}, // 33: увидели второй '|'
 };
-//   :
-// 30:   '&',    AND1(8)
-// 31:   '|',    OR1(9)
-// 32:   '&',   ->  T_OP_AND
-// 33:   '|',   ->  T_OP_OR
+// Новые семантические программы:
+// 30: Увидели первый '&', переход в состояние AND1(8)
+// 31: Увидели первый '|', переход в состояние OR1(9)
+// 32: Увидели второй '&', конечное состояние -> вернуть T_OP_AND
+// 33: Увидели второй '|', конечное состояние -> вернуть T_OP_OR
 
-//   ():
-// <100:  
-// 1:  
-// 2:   
-// 3:   ( float)
-// 4:    ( FRAC)
-// 5:  'e'/'E' ( )
-// 6:   +/-  'e'/'E'
-// 7:   'e'/'E'   
-// 8:  //CR
-// 18:    LF
-// 21:  
-// 27:   
-// >=100:  ,   ( =  - 100)
-// 122:   ( //e)
-// 123:   ( \n)
-// 128:    ( ,  '.',  'e')
-// 129:    ( \n)
-// 130:  float (    )
-// 131:  float ( \n)
-// 99: 
+// Семантические программы (действия):
+// <100: внутренние действия
+// 1: Начать идентификатор
+// 2: Начать целое число
+// 3: Увидели точку (возможно float)
+// 4: Цифра после точки (состояние FRAC)
+// 5: Увидели 'e'/'E' (возможно экспонента)
+// 6: Увидели знак +/- после 'e'/'E'
+// 7: Цифра после 'e'/'E' или после знака
+// 8: Пропуск пробела/табуляции/CR
+// 18: Пропуск перевода строки LF
+// 21: Продолжить идентификатор
+// 27: Продолжить целое число
+// >=100: Конечное состояние, вернуть токен (код = действие - 100)
+// 122: Конец идентификатора (не буква/цифра/e)
+// 123: Конец идентификатора (перед \n)
+// 128: Конец целого числа (не цифра, не '.', не 'e')
+// 129: Конец целого числа (перед \n)
+// 130: Конец float (после дробной части или экспоненты)
+// 131: Конец float (перед \n)
+// 99: Ошибка
 
-// ---  ---
+// --- Конструктор ---
 Lexer::Lexer(const std::string& source, SymbolTable& symTable)
     : sourceCode(source), currentPos(0), currentLine(1), lineStartPos(0),
     symbolTable(symTable) {
 }
 
-// ---   --- ( )
+// --- Вспомогательные методы --- (без изменений)
 char Lexer::peekNextChar() const { /* ... */ }
 char Lexer::consumeChar() { /* ... */ }
 int Lexer::getCurrentColumn() const { /* ... */ }
 
-// ---   --- ( float, bool)
+// --- Создание токенов --- (добавлены float, bool)
 Token Lexer::createToken(TokenType type) { /* ... */ }
 Token Lexer::createToken(TokenType type, const std::string& text) { /* ... */ }
 Token Lexer::createToken(TokenType type, int value) { /* ... */ }
-Token Lexer::createToken(TokenType type, double value) { // 
-    return Token(type, value, currentLine, getCurrentColumn()); //  
+Token Lexer::createToken(TokenType type, double value) { // Новый
+    return Token(type, value, currentLine, getCurrentColumn()); // Позиция примерная
 }
-Token Lexer::createToken(TokenType type, bool value) { // 
-    return Token(type, value, currentLine, getCurrentColumn()); //  
+Token Lexer::createToken(TokenType type, bool value) { // Новый
+    return Token(type, value, currentLine, getCurrentColumn()); // Позиция примерная
 }
 
 Token Lexer::createErrorToken(const std::string& message) {
@@ -116,16 +116,16 @@ Token Lexer::createErrorToken(const std::string& message) {
 }
 
 
-// ---  /  ---
+// --- Обработка идентификаторов/ключевых слов ---
 Token Lexer::handleIdentifierOrKeyword(std::string& lexeme) {
-    //    bool 
+    // Проверяем сначала на bool литералы
     if (lexeme == "true") {
         return createToken(TokenType::T_KW_TRUE, true);
     }
     if (lexeme == "false") {
         return createToken(TokenType::T_KW_FALSE, false);
     }
-    //     
+    // Затем на другие ключевые слова
     if (auto kwType = symbolTable.getKeywordType(lexeme); kwType.has_value()) {
         return createToken(kwType.value(), lexeme);
     }
@@ -134,62 +134,62 @@ Token Lexer::handleIdentifierOrKeyword(std::string& lexeme) {
     }
 }
 
-// ---  :    ---
+// --- Основной метод: получить следующий токен ---
 Token Lexer::getNextToken() {
     LexerState currentState = LexerState::START;
     std::string currentLexeme = "";
 
     while (true) {
         char currentChar = peekNextChar();
-        int category = 22; // other  
+        int category = 22; // other по умолчанию
 
         if (currentPos >= sourceCode.length()) {
-            category = 22; //   'other'  EOF
+            category = 22; // Используем категорию 'other' для EOF
         }
         else if (currentChar >= 0 && currentChar < 128) {
             category = asciiCategoryTable[static_cast<unsigned char>(currentChar)];
         }
 
-        int action = 99; //   
+        int action = 99; // Ошибка по умолчанию
         if (static_cast<int>(currentState) < 10) {
-            //   
-            if (category < 0 || category >= 23) { //  23  
-                category = 22; //   ,  'other'
+            // Проверяем границы категории
+            if (category < 0 || category >= 23) { // Используем 23 как размер
+                category = 22; // Если категория некорректна, считаем 'other'
             }
             action = stateTransitionTable[static_cast<int>(currentState)][category];
         }
 
-        // ---  EOF   START ---
+        // --- Обработка EOF в состоянии START ---
         if (currentState == LexerState::START && currentPos >= sourceCode.length()) {
-            return createToken(TokenType::T_EOF); //   EOF
+            return createToken(TokenType::T_EOF); // Явно возвращаем EOF
         }
-        // ---   EOF ---
+        // --- Конец обработки EOF ---
 
 
         if (action == 99) {
-            //     AND1  OR1    ,  
+            // Если мы в состоянии AND1 или OR1 и встретили не то, это ошибка
             if (currentState == LexerState::OP_AND_1 || currentState == LexerState::OP_OR_1) {
-                consumeChar(); //  ,  
+                consumeChar(); // Потребляем символ, вызвавший ошибку
                 return createErrorToken("Incomplete operator: expected '&' or '|'");
             }
-            //  -  
+            // Иначе - общая ошибка
             consumeChar();
             return createErrorToken("Invalid character or state");
         }
 
-        //    (>= 100)
+        // Обработка конечных состояний (>= 100)
         if (action >= 100) {
             TokenType finalType = static_cast<TokenType>(action - 100);
-            // ... ( T_IDENTIFIER, T_NUMBER_INT, T_NUMBER_FLOAT  ) ...
-            // ... ( std::stoi  std::strtod  try-catch) ...
-            if (finalType == TokenType::T_IDENTIFIER) { //   (122)
+            // ... (обработка T_IDENTIFIER, T_NUMBER_INT, T_NUMBER_FLOAT как раньше) ...
+            // ... (используем std::stoi и std::strtod с try-catch) ...
+            if (finalType == TokenType::T_IDENTIFIER) { // Конец идентификатора (122)
                 return handleIdentifierOrKeyword(currentLexeme);
             }
-            else if (finalType == TokenType::T_NUMBER_INT) { //   (128)
+            else if (finalType == TokenType::T_NUMBER_INT) { // Конец целого (128)
                 try {
                     size_t processedChars = 0;
                     int val = std::stoi(currentLexeme, &processedChars);
-                    //  ,      (    )
+                    // Дополнительная проверка, что вся строка была числом (на случай ошибок в КА)
                     if (processedChars != currentLexeme.length()) {
                         return createErrorToken("Invalid integer literal format (stray characters)");
                     }
@@ -202,100 +202,100 @@ Token Lexer::getNextToken() {
                     return createErrorToken("Integer literal out of range");
                 }
             }
-            else if (finalType == TokenType::T_NUMBER_FLOAT) { //  float (130)
+            else if (finalType == TokenType::T_NUMBER_FLOAT) { // Конец float (130)
                 try {
                     char* endPtr;
                     double val = std::strtod(currentLexeme.c_str(), &endPtr);
-                    // ,     
+                    // Проверяем, что вся строка была разобрана
                     if (endPtr != currentLexeme.c_str() + currentLexeme.length()) {
                         return createErrorToken("Invalid float literal format (stray characters)");
                     }
-                    //   INF / NAN (strtod  ,     )
-                    if (!std::isfinite(val)) { //  #include <cmath>
+                    // Проверка на INF / NAN (strtod их возвращает, но нам они не нужны)
+                    if (!std::isfinite(val)) { // Нужно #include <cmath>
                         return createErrorToken("Floating point literal results in infinity or NaN");
                     }
                     return createToken(TokenType::T_NUMBER_FLOAT, val);
                 }
-                catch (...) { //    
+                catch (...) { // Ловим другие возможные проблемы
                     return createErrorToken("Invalid float literal format");
                 }
             }
-            else { //  
+            else { // Односимвольные токены
                 consumeChar();
                 return createToken(finalType);
             }
         }
 
-        //    (< 100)
+        // Обработка семантических программ (< 100)
         switch (action) {
-            // ... (case 1-7, 8, 18, 21, 27  ) ...
-        case 1: //  
+            // ... (case 1-7, 8, 18, 21, 27 как раньше) ...
+        case 1: // Начать идентификатор
             currentState = LexerState::IDENTIFIER;
             currentLexeme += consumeChar();
             break;
-        case 2: //   
+        case 2: // Начать целое число
             currentState = LexerState::NUMBER_INT;
             currentLexeme += consumeChar();
             break;
-        case 3: //  
+        case 3: // Увидели точку
             currentState = LexerState::NUMBER_FLOAT_DOT;
             currentLexeme += consumeChar();
             break;
-        case 4: //    -> FRAC
+        case 4: // Цифра после точки -> FRAC
             currentState = LexerState::NUMBER_FLOAT_FRAC;
             currentLexeme += consumeChar();
             break;
-        case 5: //  'e'/'E' -> EXP
+        case 5: // Увидели 'e'/'E' -> EXP
             currentState = LexerState::NUMBER_FLOAT_EXP;
             currentLexeme += consumeChar();
             break;
-        case 6: //  +/-  'e'/'E' -> EXP_SIGN
+        case 6: // Знак +/- после 'e'/'E' -> EXP_SIGN
             currentState = LexerState::NUMBER_FLOAT_EXP_SIGN;
             currentLexeme += consumeChar();
             break;
-        case 7: //   'e',       -> EXP_DIGIT
+        case 7: // Цифра после 'e', знака или другая цифра в экспоненте -> EXP_DIGIT
             currentState = LexerState::NUMBER_FLOAT_EXP_DIGIT;
             currentLexeme += consumeChar();
             break;
-        case 8: //  //CR
+        case 8: // Пропуск пробела/табуляции/CR
             consumeChar();
-            // currentState = LexerState::START; //   !   START
+            // currentState = LexerState::START; // Не меняем состояние! Остаемся в START
             break;
-        case 18: //    LF
+        case 18: // Пропуск перевода строки LF
             consumeChar();
-            // currentState = LexerState::START; //   !   START
+            // currentState = LexerState::START; // Не меняем состояние! Остаемся в START
             break;
-        case 21: //  
+        case 21: // Продолжить идентификатор
             currentLexeme += consumeChar();
             break;
-        case 27: //   
+        case 27: // Продолжить целое число
             currentLexeme += consumeChar();
             break;
 
-            // ---    &&  || ---
-        case 30: //   '&'
+            // --- Новые действия для && и || ---
+        case 30: // Увидели первый '&'
             currentState = LexerState::OP_AND_1;
-            consumeChar(); //   '&'
-            //    lexeme, ..     &&
+            consumeChar(); // Потребляем первый '&'
+            // Не добавляем в lexeme, т.к. нам нужен сам токен &&
             break;
-        case 31: //   '|'
+        case 31: // Увидели первый '|'
             currentState = LexerState::OP_OR_1;
-            consumeChar(); //   '|'
+            consumeChar(); // Потребляем первый '|'
             break;
-        case 32: //   '&'
-            consumeChar(); //   '&'
-            return createToken(TokenType::T_OP_AND); //   &&
-        case 33: //   '|'
-            consumeChar(); //   '|'
-            return createToken(TokenType::T_OP_OR); //   ||
+        case 32: // Увидели второй '&'
+            consumeChar(); // Потребляем второй '&'
+            return createToken(TokenType::T_OP_AND); // Возвращаем токен &&
+        case 33: // Увидели второй '|'
+            consumeChar(); // Потребляем второй '|'
+            return createToken(TokenType::T_OP_OR); // Возвращаем токен ||
 
-            //    \n ( 123, 129, 131)
-        case 123: //    \n
+            // Обработка завершения на \n (действия 123, 129, 131)
+        case 123: // Конец идентификатора перед \n
             return handleIdentifierOrKeyword(currentLexeme);
-        case 129: //    \n
+        case 129: // Конец целого перед \n
             try { /* ... stoi ... */ }
             catch (...) { /* ... */ }
-        case 131: //  float  \n
+        case 131: // Конец float перед \n
             try { /* ... strtod ... */ }
             catch (...) { /* ... */ }
 
@@ -304,6 +304,6 @@ Token Lexer::getNextToken() {
             return createErrorToken("Internal Lexer Error - Unexpected action: " + std::to_string(action));
         }
     }
-    //    
+    // Сюда не должны дойти
     return createErrorToken("Internal Lexer Error - Lexer loop exited unexpectedly");
 }
\ No newline at end of file
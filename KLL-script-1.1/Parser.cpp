@@ -5,7 +5,7 @@
 
 // --- Конструктор и базовые методы --- (без существенных изменений)
 Parser::Parser(Lexer& lex, SymbolTable& symTab)
-    : lexer(lex), symbolTable(symTab), declarationPhase(true) {
+    : lexer(lex), symbolTable(symTab), declarationPhase(true), expressionDepth(0) {
     nextToken();
 }
 void Parser::nextToken() { /* ... как раньше ... */ }
@@ -33,6 +33,10 @@ void Parser::emit(RPNOpCode opCode, int symbolIndex) { rpnCode.emplace_back(opCo
 int Parser::emitPlaceholder(RPNOpCode jumpType) { /* ... как раньше ... */ }
 void Parser::patchJump(int placeholderIndex) { /* ... как раньше ... */ }
 void Parser::patchJumpTo(int placeholderIndex, int targetAddress) { /* ... как раньше ... */ }
+// Направляет все переходы списка на текущий адрес
+void Parser::patchJumps(const std::vector<int>& placeholderIndices) {
+    for (int placeholderIndex : placeholderIndices) patchJump(placeholderIndex);
+}
 int Parser::getCurrentRPNAddress() const { return static_cast<int>(rpnCode.size()); }
 
 // Генерация операции приведения типа, если необходимо
@@ -254,26 +258,37 @@ std::optional<SymbolType> Parser::parseArrayIndexOpt(int identifierIndex, Symbol
 void Parser::parseIfStatement() {
     match(TokenType::T_KW_IF);
     match(TokenType::T_LPAREN);
-    if (!ensureBooleanOrInt(parseCondition(), "if condition")) return; // Проверка типа условия
+    std::vector<int> falseJumps; // Переходы на else (или за if)
+    if (!parseCondition("if condition", falseJumps)) return;
     match(TokenType::T_RPAREN);
-    int jumpFalsePlaceholder = emitPlaceholder(RPNOpCode::JUMP_FALSE);
     parseStatement();
-    parseElseClauseOpt(jumpFalsePlaceholder);
+    parseElseClauseOpt(falseJumps);
 }
 
-void Parser::parseElseClauseOpt(int jumpFalsePlaceholder) { /* ... как раньше ... */ }
+void Parser::parseElseClauseOpt(const std::vector<int>& falseJumps) {
+    if (currentToken.type == TokenType::T_KW_ELSE) {
+        nextToken();
+        int jumpAfterElsePlaceholder = emitPlaceholder(RPNOpCode::JUMP); // then-ветка обходит else
+        patchJumps(falseJumps);
+        parseStatement();
+        patchJump(jumpAfterElsePlaceholder);
+    }
+    else {
+        patchJumps(falseJumps);
+    }
+}
 
 void Parser::parseWhileStatement() {
     match(TokenType::T_KW_WHILE);
     int conditionStartAddress = getCurrentRPNAddress();
     match(TokenType::T_LPAREN);
-    if (!ensureBooleanOrInt(parseCondition(), "while condition")) return; // Проверка типа условия
+    std::vector<int> exitJumps; // Переходы за цикл
+    if (!parseCondition("while condition", exitJumps)) return;
     match(TokenType::T_RPAREN);
-    int jumpFalsePlaceholder = emitPlaceholder(RPNOpCode::JUMP_FALSE);
     parseStatement();
     emit(RPNOpCode::JUMP);
     patchJumpTo(getCurrentRPNAddress() - 1, conditionStartAddress);
-    patchJump(jumpFalsePlaceholder);
+    patchJumps(exitJumps);
 }
 
 // --- Разбор cin/cout --- (обновлены для типов)
@@ -350,221 +365,213 @@ void Parser::parseCoutStatement() {
 
 // --- Разбор Условий и Выражений (переделано для возврата типов) ---
 
-// <Condition> → <Expression> (должно быть bool или int)
-std::optional<SymbolType> Parser::parseCondition() {
-    // Просто разбираем выражение, тип проверится в if/while
-    return parseExpression();
-}
-
-// <Expression> → <LogicalOrExpr>
-std::optional<SymbolType> Parser::parseExpression() {
-    return parseLogicalOrExpr();
-}
-
-// <LogicalOrExpr> → <LogicalAndExpr> <LogicalOrExprPrime>
-std::optional<SymbolType> Parser::parseLogicalOrExpr() {
-    std::optional<SymbolType> leftType = parseLogicalAndExpr();
-    if (!leftType) return std::nullopt;
-    return parseLogicalOrExprPrime(leftType.value());
-}
-
-// <LogicalOrExprPrime> → || <LogicalAndExpr> <LogicalOrExprPrime> | λ
-std::optional<SymbolType> Parser::parseLogicalOrExprPrime(SymbolType leftType) {
-    if (currentToken.type == TokenType::T_OP_OR) {
-        nextToken(); // Съели ||
-        std::optional<SymbolType> rightTypeOpt = parseLogicalAndExpr();
-        if (!rightTypeOpt) return std::nullopt;
-        SymbolType resultType = checkLogicalOp(leftType, rightTypeOpt.value(), "||");
-        emit(RPNOpCode::OR);
-        return parseLogicalOrExprPrime(resultType); // Хвостовая рекурсия
+// <Condition> → <AndCondition> { || <AndCondition> },  <AndCondition> → <Operand> { && <Operand> }
+// Условие if/while компилируется в переходы, без значения на стеке: после каждого операнда
+// (выражения без && и ||, bool или int) - JUMP_FALSE или JUMP_TRUE, поэтому следующие операнды
+// не вычисляются, когда результат уже известен: в `i < n && a[i] > 0` a[i] не читается при i >= n.
+// Истинное условие проходит насквозь в тело; переходы по лжи добавляются в falseJumps.
+bool Parser::parseCondition(const std::string& context, std::vector<int>& falseJumps) {
+    std::vector<int> trueJumps;      // Из операндов перед || - в тело
+    std::vector<int> termFalseJumps; // Из текущего слагаемого && - к следующему слагаемому ||
+    while (true) {
+        if (!ensureBooleanOrInt(parseBinaryExpr(getBinaryPrecedence(TokenType::T_OP_AND) + 1), context)) return false;
+        if (currentToken.type == TokenType::T_OP_AND) {
+            termFalseJumps.push_back(emitPlaceholder(RPNOpCode::JUMP_FALSE));
+        }
+        else if (currentToken.type == TokenType::T_OP_OR) {
+            trueJumps.push_back(emitPlaceholder(RPNOpCode::JUMP_TRUE));
+            patchJumps(termFalseJumps);
+            termFalseJumps.clear();
+        }
+        else {
+            termFalseJumps.push_back(emitPlaceholder(RPNOpCode::JUMP_FALSE));
+            break;
+        }
+        nextToken();
     }
-    return leftType; // λ
-}
-
-// <LogicalAndExpr> → <EqualityExpr> <LogicalAndExprPrime>
-std::optional<SymbolType> Parser::parseLogicalAndExpr() {
-    std::optional<SymbolType> leftType = parseEqualityExpr();
-    if (!leftType) return std::nullopt;
-    return parseLogicalAndExprPrime(leftType.value());
+    falseJumps.insert(falseJumps.end(), termFalseJumps.begin(), termFalseJumps.end());
+    patchJumps(trueJumps);
+    return true;
 }
 
-// <LogicalAndExprPrime> → && <EqualityExpr> <LogicalAndExprPrime> | λ
-std::optional<SymbolType> Parser::parseLogicalAndExprPrime(SymbolType leftType) {
-    if (currentToken.type == TokenType::T_OP_AND) {
-        nextToken(); // Съели &&
-        std::optional<SymbolType> rightTypeOpt = parseEqualityExpr();
-        if (!rightTypeOpt) return std::nullopt;
-        SymbolType resultType = checkLogicalOp(leftType, rightTypeOpt.value(), "&&");
-        emit(RPNOpCode::AND);
-        return parseLogicalAndExprPrime(resultType); // Хвостовая рекурсия
+// <Expression> → <UnaryExpr> { <BinaryOp> <UnaryExpr> }
+// Бинарные операции разбираются методом предшествования (precedence climbing) по таблице
+// getBinaryPrecedence. ОПС: левый операнд, правый операнд, приведения, операция.
+std::optional<SymbolType> Parser::parseExpression() {
+    // Вложенность растет только на скобках и индексах массивов; ограничиваем ее,
+    // чтобы сгенерированные выражения не переполняли стек вызовов
+    if (expressionDepth >= MAX_EXPRESSION_DEPTH) {
+        syntaxError("Expression is nested too deeply (limit " + std::to_string(MAX_EXPRESSION_DEPTH) + ")");
+        return std::nullopt;
     }
-    return leftType; // λ
+    ++expressionDepth;
+    std::optional<SymbolType> resultType = parseBinaryExpr(1);
+    --expressionDepth;
+    return resultType;
 }
 
-// <EqualityExpr> → <RelationalExpr> <EqualityExprPrime>
-std::optional<SymbolType> Parser::parseEqualityExpr() {
-    std::optional<SymbolType> leftType = parseRelationalExpr();
+// Приоритет бинарной операции (чем больше, тем сильнее связывает); 0 - токен не является бинарной операцией.
+// Все бинарные операции левоассоциативны.
+int Parser::getBinaryPrecedence(TokenType type) {
+    switch (type) {
+    case TokenType::T_OP_OR:     return 1; // ||
+    case TokenType::T_OP_AND:    return 2; // &&
+    case TokenType::T_EQUAL:
+    case TokenType::T_NOT_EQUAL: return 3; // ~ !
+    case TokenType::T_LESS:
+    case TokenType::T_GREATER:   return 4; // < >
+    case TokenType::T_PLUS:
+    case TokenType::T_MINUS:     return 5; // + -
+    case TokenType::T_MULTIPLY:
+    case TokenType::T_DIVIDE:    return 6; // * /
+    default:                     return 0;
+    }
+}
+
+// Разбирает выражение из операций с приоритетом не ниже minPrecedence.
+// Цепочки операций одного уровня обрабатываются циклом, поэтому глубина рекурсии
+// ограничена числом уровней приоритета, а не длиной выражения.
+std::optional<SymbolType> Parser::parseBinaryExpr(int minPrecedence) {
+    std::optional<SymbolType> leftType = parseUnaryExpr();
     if (!leftType) return std::nullopt;
-    return parseEqualityExprPrime(leftType.value());
-}
 
-// <EqualityExprPrime> → (~ | !) <RelationalExpr> <EqualityExprPrime> | λ
-std::optional<SymbolType> Parser::parseEqualityExprPrime(SymbolType leftType) {
-    if (currentToken.type == TokenType::T_EQUAL || currentToken.type == TokenType::T_NOT_EQUAL) {
+    int precedence = getBinaryPrecedence(currentToken.type);
+    while (precedence >= minPrecedence && precedence > 0) {
         TokenType op = currentToken.type;
+        if (op == TokenType::T_OP_AND || op == TokenType::T_OP_OR) {
+            leftType = parseLogicalChain(op, leftType.value(), precedence);
+            if (!leftType) return std::nullopt;
+            precedence = getBinaryPrecedence(currentToken.type);
+            continue;
+        }
         nextToken();
-        std::optional<SymbolType> rightTypeOpt = parseRelationalExpr();
-        if (!rightTypeOpt) return std::nullopt;
-
-        SymbolType resultType = checkEqualityOp(leftType, rightTypeOpt.value(), op == TokenType::T_EQUAL ? "~" : "!");
-
+        // Правый операнд связывает только более приоритетные операции (левая ассоциативность)
+        std::optional<SymbolType> rightType = parseBinaryExpr(precedence + 1);
+        if (!rightType) return std::nullopt;
+        leftType = emitBinaryOperation(op, leftType.value(), rightType.value());
+        precedence = getBinaryPrecedence(currentToken.type);
+    }
+    return leftType;
+}
+
+// Цепочка a && b && ... (или a || b || ...) в выражении, значение которого нужно на стеке
+// (присваивание, cout, операнд другой операции). Левый операнд уже сгенерирован. Вычисление
+// сокращенное: после каждого операнда, кроме последнего, переход к общему выходу, который кладет
+// false (для &&) или true (для ||); иначе результатом остается значение последнего операнда.
+std::optional<SymbolType> Parser::parseLogicalChain(TokenType op, SymbolType leftType, int precedence) {
+    const std::string opText = (op == TokenType::T_OP_AND) ? "&&" : "||";
+    RPNOpCode exitJump = (op == TokenType::T_OP_AND) ? RPNOpCode::JUMP_FALSE : RPNOpCode::JUMP_TRUE;
+    std::vector<int> exitJumps;
+    SymbolType operandType = leftType;
+    while (currentToken.type == op) {
+        nextToken();
+        if (!ensureLogicalOperand(operandType, opText)) return std::nullopt;
+        exitJumps.push_back(emitPlaceholder(exitJump));
+        std::optional<SymbolType> rightType = parseBinaryExpr(precedence + 1);
+        if (!rightType) return std::nullopt;
+        operandType = rightType.value();
+    }
+    if (!ensureLogicalOperand(operandType, opText)) return std::nullopt;
+    int jumpEndPlaceholder = emitPlaceholder(RPNOpCode::JUMP);
+    patchJumps(exitJumps);
+    emit(RPNOpCode::PUSH_CONST_BOOL, SymbolValue(op == TokenType::T_OP_OR));
+    patchJump(jumpEndPlaceholder);
+    return SymbolType::VARIABLE_BOOL;
+}
+
+// Проверяет типы операндов, генерирует приведения и код операции; возвращает тип результата.
+// && и || разбираются отдельно (parseLogicalChain, parseCondition).
+SymbolType Parser::emitBinaryOperation(TokenType op, SymbolType leftType, SymbolType rightType) {
+    switch (op) {
+    case TokenType::T_EQUAL:
+    case TokenType::T_NOT_EQUAL: {
+        SymbolType operandType = checkEqualityOp(leftType, rightType, op == TokenType::T_EQUAL ? "~" : "!");
         // Определяем, какую операцию сравнения генерировать
         RPNOpCode compareOp;
-        if (resultType == SymbolType::VARIABLE_FLOAT) { // Сравнение float (после приведения)
+        if (operandType == SymbolType::VARIABLE_FLOAT) { // Сравнение float (после приведения)
             compareOp = (op == TokenType::T_EQUAL) ? RPNOpCode::CMP_EQ_F : RPNOpCode::CMP_NE_F;
         }
-        else if (resultType == SymbolType::VARIABLE_INT) { // Сравнение int
+        else if (operandType == SymbolType::VARIABLE_INT) { // Сравнение int
             compareOp = (op == TokenType::T_EQUAL) ? RPNOpCode::CMP_EQ_I : RPNOpCode::CMP_NE_I;
         }
         else { // Сравнение bool
             compareOp = (op == TokenType::T_EQUAL) ? RPNOpCode::CMP_EQ_B : RPNOpCode::CMP_NE_B;
         }
         emit(compareOp);
-        return parseEqualityExprPrime(SymbolType::VARIABLE_BOOL); // Результат всегда bool
+        return SymbolType::VARIABLE_BOOL; // Результат всегда bool
     }
-    return leftType; // λ
-}
-
-// <RelationalExpr> → <AdditiveExpr> <RelationalExprPrime>
-std::optional<SymbolType> Parser::parseRelationalExpr() {
-    std::optional<SymbolType> leftType = parseAdditiveExpr();
-    if (!leftType) return std::nullopt;
-    return parseRelationalExprPrime(leftType.value());
-}
-
-// <RelationalExprPrime> → (< | >) <AdditiveExpr> <RelationalExprPrime> | λ
-std::optional<SymbolType> Parser::parseRelationalExprPrime(SymbolType leftType) {
-    if (currentToken.type == TokenType::T_LESS || currentToken.type == TokenType::T_GREATER) {
-        TokenType op = currentToken.type;
-        nextToken();
-        std::optional<SymbolType> rightTypeOpt = parseAdditiveExpr();
-        if (!rightTypeOpt) return std::nullopt;
-
-        SymbolType resultType = checkComparisonOp(leftType, rightTypeOpt.value(), op == TokenType::T_LESS ? "<" : ">");
-
-        RPNOpCode compareOp;
-        if (resultType == SymbolType::VARIABLE_FLOAT) { // Сравнение float
-            compareOp = (op == TokenType::T_LESS) ? RPNOpCode::CMP_LT_F : RPNOpCode::CMP_GT_F;
+    case TokenType::T_LESS:
+    case TokenType::T_GREATER: {
+        SymbolType operandType = checkComparisonOp(leftType, rightType, op == TokenType::T_LESS ? "<" : ">");
+        if (operandType == SymbolType::VARIABLE_FLOAT) { // Сравнение float
+            emit((op == TokenType::T_LESS) ? RPNOpCode::CMP_LT_F : RPNOpCode::CMP_GT_F);
         }
         else { // Сравнение int
-            compareOp = (op == TokenType::T_LESS) ? RPNOpCode::CMP_LT_I : RPNOpCode::CMP_GT_I;
+            emit((op == TokenType::T_LESS) ? RPNOpCode::CMP_LT_I : RPNOpCode::CMP_GT_I);
         }
-        emit(compareOp);
-        return parseRelationalExprPrime(SymbolType::VARIABLE_BOOL); // Результат bool
-    }
-    return leftType; // λ
-}
-
-
-// <AdditiveExpr> → <MultiplicativeExpr> <AdditiveExprPrime>
-std::optional<SymbolType> Parser::parseAdditiveExpr() {
-    std::optional<SymbolType> leftType = parseMultiplicativeExpr();
-    if (!leftType) return std::nullopt;
-    return parseAdditiveExprPrime(leftType.value());
-}
-
-// <AdditiveExprPrime> → (+ | -) <MultiplicativeExpr> <AdditiveExprPrime> | λ
-std::optional<SymbolType> Parser::parseAdditiveExprPrime(SymbolType leftType) {
-    if (currentToken.type == TokenType::T_PLUS || currentToken.type == TokenType::T_MINUS) {
-        TokenType op = currentToken.type;
-        nextToken();
-        std::optional<SymbolType> rightTypeOpt = parseMultiplicativeExpr();
-        if (!rightTypeOpt) return std::nullopt;
-
-        RPNOpCode opCodeInt = (op == TokenType::T_PLUS) ? RPNOpCode::ADD_I : RPNOpCode::SUB_I;
-        RPNOpCode opCodeFloat = (op == TokenType::T_PLUS) ? RPNOpCode::ADD_F : RPNOpCode::SUB_F;
-
-        SymbolType resultType = promoteTypes(leftType, rightTypeOpt.value(), opCodeInt, opCodeFloat);
+        return SymbolType::VARIABLE_BOOL; // Результат bool
+    }
+    default: { // + - * /
+        RPNOpCode opCodeInt, opCodeFloat;
+        switch (op) {
+        case TokenType::T_PLUS:     opCodeInt = RPNOpCode::ADD_I; opCodeFloat = RPNOpCode::ADD_F; break;
+        case TokenType::T_MINUS:    opCodeInt = RPNOpCode::SUB_I; opCodeFloat = RPNOpCode::SUB_F; break;
+        case TokenType::T_MULTIPLY: opCodeInt = RPNOpCode::MUL_I; opCodeFloat = RPNOpCode::MUL_F; break;
+        default:                    opCodeInt = RPNOpCode::DIV_I; opCodeFloat = RPNOpCode::DIV_F; break;
+        }
+        SymbolType resultType = promoteTypes(leftType, rightType, opCodeInt, opCodeFloat);
         emit((resultType == SymbolType::VARIABLE_FLOAT) ? opCodeFloat : opCodeInt);
-
-        return parseAdditiveExprPrime(resultType); // Хвостовая рекурсия
+        return resultType;
     }
-    return leftType; // λ
-}
-
-// <MultiplicativeExpr> → <UnaryExpr> <MultiplicativeExprPrime>
-std::optional<SymbolType> Parser::parseMultiplicativeExpr() {
-    std::optional<SymbolType> leftType = parseUnaryExpr();
-    if (!leftType) return std::nullopt;
-    return parseMultiplicativeExprPrime(leftType.value());
-}
-
-// <MultiplicativeExprPrime> → (* | /) <UnaryExpr> <MultiplicativeExprPrime> | λ
-std::optional<SymbolType> Parser::parseMultiplicativeExprPrime(SymbolType leftType) {
-    if (currentToken.type == TokenType::T_MULTIPLY || currentToken.type == TokenType::T_DIVIDE) {
-        TokenType op = currentToken.type;
-        nextToken();
-        std::optional<SymbolType> rightTypeOpt = parseUnaryExpr();
-        if (!rightTypeOpt) return std::nullopt;
-
-        RPNOpCode opCodeInt = (op == TokenType::T_MULTIPLY) ? RPNOpCode::MUL_I : RPNOpCode::DIV_I;
-        RPNOpCode opCodeFloat = (op == TokenType::T_MULTIPLY) ? RPNOpCode::MUL_F : RPNOpCode::DIV_F;
-
-        SymbolType resultType = promoteTypes(leftType, rightTypeOpt.value(), opCodeInt, opCodeFloat);
-        emit((resultType == SymbolType::VARIABLE_FLOAT) ? opCodeFloat : opCodeInt);
-
-        return parseMultiplicativeExprPrime(resultType); // Хвостовая рекурсия
     }
-    return leftType; // λ
 }
 
 // <UnaryExpr> → + <UnaryExpr> | - <UnaryExpr> | not <UnaryExpr> | <PrimaryExpr>
+// Префиксные операции собираются циклом и применяются к операнду от ближней к дальней.
 std::optional<SymbolType> Parser::parseUnaryExpr() {
-    if (currentToken.type == TokenType::T_PLUS) { // Унарный плюс - игнорируем
-        nextToken();
-        return parseUnaryExpr(); // Просто разбираем дальше
-    }
-    else if (currentToken.type == TokenType::T_MINUS) { // Унарный минус
-        nextToken();
-        std::optional<SymbolType> typeOpt = parseUnaryExpr();
-        if (!typeOpt) return std::nullopt;
-        SymbolType type = typeOpt.value();
-        if (type == SymbolType::VARIABLE_INT || type == SymbolType::ARRAY_INT) {
-            emit(RPNOpCode::NEG_I); // Генерируем NEG_I
-            return SymbolType::VARIABLE_INT;
+    std::vector<TokenType> prefixOps; // Не выделяет память, пока префиксных операций нет
+    while (currentToken.type == TokenType::T_PLUS || currentToken.type == TokenType::T_MINUS ||
+        currentToken.type == TokenType::T_KW_NOT) {
+        if (currentToken.type != TokenType::T_PLUS) { // Унарный плюс - игнорируем
+            prefixOps.push_back(currentToken.type);
         }
-        else if (type == SymbolType::VARIABLE_FLOAT || type == SymbolType::ARRAY_FLOAT) {
-            emit(RPNOpCode::NEG_F); // Генерируем NEG_F
-            return SymbolType::VARIABLE_FLOAT;
-        }
-        else {
-            semanticError("Unary minus cannot be applied to non-numeric type.");
-            return std::nullopt;
-        }
-    }
-    else if (currentToken.type == TokenType::T_KW_NOT) { // Логическое НЕ
         nextToken();
-        std::optional<SymbolType> typeOpt = parseUnaryExpr();
-        if (!typeOpt) return std::nullopt;
+    }
+
+    std::optional<SymbolType> typeOpt = parsePrimaryExpr();
+    for (auto it = prefixOps.rbegin(); typeOpt && it != prefixOps.rend(); ++it) {
         SymbolType type = typeOpt.value();
-        // Применяем правило: not bool -> bool, not int -> bool
-        if (type == SymbolType::VARIABLE_BOOL || type == SymbolType::ARRAY_BOOL) {
-            emit(RPNOpCode::NOT);
-            return SymbolType::VARIABLE_BOOL;
-        }
-        else if (type == SymbolType::VARIABLE_INT || type == SymbolType::ARRAY_INT) {
-            emitCast(type, SymbolType::VARIABLE_BOOL); // Приводим int к bool
-            emit(RPNOpCode::NOT);
-            return SymbolType::VARIABLE_BOOL;
+        if (*it == TokenType::T_MINUS) { // Унарный минус
+            if (type == SymbolType::VARIABLE_INT || type == SymbolType::ARRAY_INT) {
+                emit(RPNOpCode::NEG_I); // Генерируем NEG_I
+                typeOpt = SymbolType::VARIABLE_INT;
+            }
+            else if (type == SymbolType::VARIABLE_FLOAT || type == SymbolType::ARRAY_FLOAT) {
+                emit(RPNOpCode::NEG_F); // Генерируем NEG_F
+                typeOpt = SymbolType::VARIABLE_FLOAT;
+            }
+            else {
+                semanticError("Unary minus cannot be applied to non-numeric type.");
+                return std::nullopt;
+            }
         }
-        else {
-            semanticError("'not' operator requires boolean or integer operand.");
-            return std::nullopt;
+        else { // Логическое НЕ
+            // Применяем правило: not bool -> bool, not int -> bool
+            if (type == SymbolType::VARIABLE_BOOL || type == SymbolType::ARRAY_BOOL) {
+                emit(RPNOpCode::NOT);
+            }
+            else if (type == SymbolType::VARIABLE_INT || type == SymbolType::ARRAY_INT) {
+                emitCast(type, SymbolType::VARIABLE_BOOL); // Приводим int к bool
+                emit(RPNOpCode::NOT);
+            }
+            else {
+                semanticError("'not' operator requires boolean or integer operand.");
+                return std::nullopt;
+            }
+            typeOpt = SymbolType::VARIABLE_BOOL;
         }
     }
-    else { // <PrimaryExpr>
-        return parsePrimaryExpr();
-    }
+    return typeOpt;
 }
 
 // <PrimaryExpr> → (G) | aH | k | <FLOAT_CONST> | <BOOL_CONST>
@@ -687,18 +694,14 @@ SymbolType Parser::promoteTypes(SymbolType type1, SymbolType type2, RPNOpCode& o
 }
 
 
-// Проверка типов для логических операций &&, ||
-SymbolType Parser::checkLogicalOp(SymbolType left, SymbolType right, const std::string& op) {
-    bool leftOk = (left == SymbolType::VARIABLE_BOOL || left == SymbolType::VARIABLE_INT);
-    bool rightOk = (right == SymbolType::VARIABLE_BOOL || right == SymbolType::VARIABLE_INT);
-    if (!leftOk || !rightOk) {
+// Проверка типа операнда логической операции &&, || (на вершине стека); int приводится к bool
+bool Parser::ensureLogicalOperand(SymbolType type, const std::string& op) {
+    if (type != SymbolType::VARIABLE_BOOL && type != SymbolType::VARIABLE_INT) {
         semanticError("Operands for '" + op + "' must be boolean or integer.");
-        return SymbolType::VARIABLE_BOOL; // Dummy
+        return false;
     }
-    // Генерируем приведение int к bool, если нужно
-    emitCast(left, SymbolType::VARIABLE_BOOL);
-    emitCast(right, SymbolType::VARIABLE_BOOL);
-    return SymbolType::VARIABLE_BOOL; // Результат всегда bool
+    emitCast(type, SymbolType::VARIABLE_BOOL);
+    return true;
 }
 
 // Проверка типов для операций сравнения <, >
@@ -790,6 +793,10 @@ void Parser::printRPN() const {
             std::cout << "JUMP_FALSE\t";
             if (op.jumpTarget) std::cout << op.jumpTarget.value(); else std::cout << "(?)";
             break;
+        case RPNOpCode::JUMP_TRUE:
+            std::cout << "JUMP_TRUE \t";
+            if (op.jumpTarget) std::cout << op.jumpTarget.value(); else std::cout << "(?)";
+            break;
         case RPNOpCode::CAST_I2F: std::cout << "CAST_I2F"; break;
         case RPNOpCode::CAST_I2B: std::cout << "CAST_I2B"; break;
         case RPNOpCode::LABEL: std::cout << "LABEL (addr)"; break; // Не генерируется
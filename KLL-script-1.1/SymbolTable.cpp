@@ -1,13 +1,13 @@
 #include "SymbolTable.h"
 #include <iostream>
-#include <stdexcept> //  std::visit
+#include <stdexcept> // Для std::visit
 
-// 
+// Конструктор
 SymbolTable::SymbolTable() {
     keywordMap["int"] = TokenType::T_KW_INT;
     keywordMap["arr"] = TokenType::T_KW_ARR;
-    keywordMap["float"] = TokenType::T_KW_FLOAT; // 
-    keywordMap["bool"] = TokenType::T_KW_BOOL;   // 
+    keywordMap["float"] = TokenType::T_KW_FLOAT; // Добавлено
+    keywordMap["bool"] = TokenType::T_KW_BOOL;   // Добавлено
     keywordMap["if"] = TokenType::T_KW_IF;
     keywordMap["else"] = TokenType::T_KW_ELSE;
     keywordMap["while"] = TokenType::T_KW_WHILE;
@@ -15,12 +15,12 @@ SymbolTable::SymbolTable() {
     keywordMap["end"] = TokenType::T_KW_END;
     keywordMap["cin"] = TokenType::T_KW_CIN;
     keywordMap["cout"] = TokenType::T_KW_COUT;
-    keywordMap["true"] = TokenType::T_KW_TRUE;   //  ( ,   )
-    keywordMap["false"] = TokenType::T_KW_FALSE; //  ( ,   )
-    keywordMap["not"] = TokenType::T_KW_NOT;     // 
+    keywordMap["true"] = TokenType::T_KW_TRUE;   // Добавлено (как токен, но проверяем здесь)
+    keywordMap["false"] = TokenType::T_KW_FALSE; // Добавлено (как токен, но проверяем здесь)
+    keywordMap["not"] = TokenType::T_KW_NOT;     // Добавлено
 }
 
-// ---    ---
+// --- Вспомогательные статические функции ---
 bool SymbolTable::isVariableType(SymbolType type) {
     return type == SymbolType::VARIABLE_INT ||
         type == SymbolType::VARIABLE_FLOAT ||
@@ -37,12 +37,12 @@ SymbolType SymbolTable::getArrayElementType(SymbolType arrayType) {
     if (arrayType == SymbolType::ARRAY_INT) return SymbolType::VARIABLE_INT;
     if (arrayType == SymbolType::ARRAY_FLOAT) return SymbolType::VARIABLE_FLOAT;
     if (arrayType == SymbolType::ARRAY_BOOL) return SymbolType::VARIABLE_BOOL;
-    //    ,  arrayType   
+    // Сюда не должны попасть, если arrayType действительно тип массива
     throw std::runtime_error("Internal Error: Invalid array type in getArrayElementType.");
 }
 
 
-// ,     
+// Проверка, является ли имя ключевым словом
 std::optional<TokenType> SymbolTable::getKeywordType(const std::string& name) const {
     auto it = keywordMap.find(name);
     if (it != keywordMap.end()) {
@@ -51,7 +51,7 @@ std::optional<TokenType> SymbolTable::getKeywordType(const std::string& name) co
     return std::nullopt;
 }
 
-//    
+// Поиск символа по имени
 std::optional<size_t> SymbolTable::findSymbol(const std::string& name) const {
     auto it = nameToIndexMap.find(name);
     if (it != nameToIndexMap.end()) {
@@ -60,22 +60,22 @@ std::optional<size_t> SymbolTable::findSymbol(const std::string& name) const {
     return std::nullopt;
 }
 
-//   (  )
+// Добавление символа (переменной или массива)
 std::optional<size_t> SymbolTable::addSymbol(const std::string& name, SymbolType type, int declarationLine) {
     if (findSymbol(name).has_value() || getKeywordType(name).has_value()) {
-        // TODO:   ErrorHandler
+        // TODO: Интегрировать с ErrorHandler
         // std::cerr << "Error line " << declarationLine << ": Symbol '" << name << "' already defined or is a keyword." << std::endl;
         return std::nullopt;
     }
 
     size_t newIndex = symbols.size();
-    //   SymbolInfo,     
+    // Используем конструктор SymbolInfo, который установит значение по умолчанию
     symbols.emplace_back(name, type, declarationLine);
     nameToIndexMap[name] = newIndex;
     return newIndex;
 }
 
-// //   ( ,  )
+// // Старые методы (можно раскомментировать, если нужны)
 // std::optional<size_t> SymbolTable::addVariable(const std::string& name, SymbolType type, int declarationLine) {
 //      if (!isVariableType(type)) {
 //           // TODO: Error
@@ -92,7 +92,7 @@ std::optional<size_t> SymbolTable::addSymbol(const std::string& name, SymbolType
 // }
 
 
-//  SymbolInfo  
+// Получение SymbolInfo по индексу
 const SymbolInfo& SymbolTable::getSymbolInfo(size_t index) const {
     if (index >= symbols.size()) {
         std::cerr << "Internal Error: Symbol index " << index << " out of bounds." << std::endl;
@@ -108,83 +108,89 @@ SymbolInfo& SymbolTable::getSymbolInfo(size_t index) {
     return symbols[index];
 }
 
-//     
+// Получение типа символа по индексу
 SymbolType SymbolTable::getSymbolType(size_t index) const {
     return getSymbolInfo(index).type;
 }
 
-//     
+// Получение имени символа по индексу
 const std::string& SymbolTable::getSymbolName(size_t index) const {
     return getSymbolInfo(index).name;
 }
 
-// ,    
+// Проверка, является ли символ массивом
 bool SymbolTable::isArray(size_t index) const {
     return isArrayType(getSymbolType(index));
 }
 
-// ,     ( )
+// Проверка, является ли символ переменной (не массивом)
 bool SymbolTable::isVariable(size_t index) const {
     return isVariableType(getSymbolType(index));
 }
 
-//   
+// Установка значения переменной
 bool SymbolTable::setVariableValue(size_t index, const SymbolValue& value) {
     SymbolInfo& info = getSymbolInfo(index);
     if (!isVariable(index)) {
-        // TODO:  -    
+        // TODO: Ошибка - попытка присвоить значение массиву
         std::cerr << "Runtime Error: Cannot assign value directly to array '" << info.name << "'." << std::endl;
         return false;
     }
     if (!checkAssignmentTypeCompatibility(info.type, value)) {
-        // TODO:  -  
-        //         checkAssignmentTypeCompatibility
+        // TODO: Ошибка - несовместимость типов
+        // Сообщение об ошибке может быть более детальным в checkAssignmentTypeCompatibility
         std::cerr << "Runtime Error: Type mismatch assigning to variable '" << info.name << "'." << std::endl;
         return false;
     }
 
-    //       int  float
+    // Выполняем присваивание с возможным неявным приведением int к float
     if (info.type == SymbolType::VARIABLE_FLOAT && std::holds_alternative<int>(value)) {
-        info.value = static_cast<double>(std::get<int>(value)); //  int  double
+        info.value = static_cast<double>(std::get<int>(value)); // Приводим int к double
     }
     else {
-        info.value = value; //    value  float/bool
+        info.value = value; // Типы совпадают или value уже float/bool
     }
     return true;
 }
 
-//   
+// Получение значения переменной
 std::optional<SymbolValue> SymbolTable::getVariableValue(size_t index) const {
     const SymbolInfo& info = getSymbolInfo(index);
     if (!isVariable(index)) {
-        // TODO:  -    
+        // TODO: Ошибка - попытка получить значение массива
         std::cerr << "Runtime Error: Cannot get single value from array '" << info.name << "'." << std::endl;
         return std::nullopt;
     }
     return info.value;
 }
 
-//  ( )  
+// Инициализация (выделение памяти) для массива
 bool SymbolTable::resizeArray(size_t index, size_t size) {
     SymbolInfo& info = getSymbolInfo(index);
     if (!isArray(index)) {
-        // TODO: 
+        // TODO: Ошибка
         std::cerr << "Runtime Error: Cannot resize non-array symbol '" << info.name << "'." << std::endl;
         return false;
     }
-    if (info.arraySize > 0 && info.arrayData.size() == info.arraySize) {
-        //   :   ?
-        //  ,   
+    bool isBoolArray = (info.type == SymbolType::ARRAY_BOOL);
+    size_t allocatedSize = isBoolArray ? info.boolArrayData.size() : info.arrayData.size();
+    if (info.arraySize > 0 && allocatedSize == info.arraySize) {
+        // Предупреждение или ошибка: повторное определение размера?
+        // Пока разрешим, старые данные пропадут
         std::cerr << "Warning: Resizing already allocated array '" << info.name << "'." << std::endl;
     }
     info.arraySize = size;
-    //       
+    if (isBoolArray) {
+        info.boolArrayData.assign(size, false); // Упакованно, по биту на элемент
+        return true;
+    }
+    // Получаем значение по умолчанию для типа элемента
     SymbolValue defaultValue = getDefaultValueForType(getArrayElementType(info.type));
-    info.arrayData.assign(size, defaultValue); //    
+    info.arrayData.assign(size, defaultValue); // Заполняем значениями по умолчанию
     return true;
 }
 
-//   
+// Получение размера массива
 std::optional<size_t> SymbolTable::getArraySize(size_t index) const {
     const SymbolInfo& info = getSymbolInfo(index);
     if (!isArray(index)) {
@@ -193,7 +199,7 @@ std::optional<size_t> SymbolTable::getArraySize(size_t index) const {
     return info.arraySize;
 }
 
-//    
+// Установка значения элемента массива
 bool SymbolTable::setArrayElementValue(size_t arrayIndex, size_t elementIndex, const SymbolValue& value) {
     SymbolInfo& info = getSymbolInfo(arrayIndex);
     if (!isArray(arrayIndex)) {
@@ -212,8 +218,11 @@ bool SymbolTable::setArrayElementValue(size_t arrayIndex, size_t elementIndex, c
         return false;
     }
 
-    //       int  float
-    if (elementType == SymbolType::VARIABLE_FLOAT && std::holds_alternative<int>(value)) {
+    // Выполняем присваивание с возможным неявным приведением int к float
+    if (elementType == SymbolType::VARIABLE_BOOL) {
+        info.boolArrayData.set(elementIndex, std::get<bool>(value));
+    }
+    else if (elementType == SymbolType::VARIABLE_FLOAT && std::holds_alternative<int>(value)) {
         info.arrayData[elementIndex] = static_cast<double>(std::get<int>(value));
     }
     else {
@@ -222,7 +231,7 @@ bool SymbolTable::setArrayElementValue(size_t arrayIndex, size_t elementIndex, c
     return true;
 }
 
-//    
+// Получение значения элемента массива
 std::optional<SymbolValue> SymbolTable::getArrayElementValue(size_t arrayIndex, size_t elementIndex) const {
     const SymbolInfo& info = getSymbolInfo(arrayIndex);
     if (!isArray(arrayIndex)) {
@@ -234,15 +243,80 @@ std::optional<SymbolValue> SymbolTable::getArrayElementValue(size_t arrayIndex,
             << "' (index: " << elementIndex << ", size: " << info.arraySize << ")." << std::endl;
         return std::nullopt;
     }
+    if (info.type == SymbolType::ARRAY_BOOL) {
+        return SymbolValue(info.boolArrayData.get(elementIndex));
+    }
     return info.arrayData[elementIndex];
 }
 
-//      (target = value)
+// Поиск упакованных данных arr bool
+BitArray* SymbolTable::findBoolArray(size_t index) {
+    return const_cast<BitArray*>(static_cast<const SymbolTable*>(this)->findBoolArray(index));
+}
+const BitArray* SymbolTable::findBoolArray(size_t index) const {
+    const SymbolInfo& info = getSymbolInfo(index);
+    if (info.type != SymbolType::ARRAY_BOOL) {
+        std::cerr << "Runtime Error: Symbol '" << info.name << "' is not a bool array." << std::endl;
+        return nullptr;
+    }
+    return &info.boolArrayData;
+}
+
+// Количество элементов true в arr bool
+std::optional<size_t> SymbolTable::countTrueElements(size_t arrayIndex) const {
+    const BitArray* bits = findBoolArray(arrayIndex);
+    if (!bits) return std::nullopt;
+    return bits->count();
+}
+
+// Присваивание значения всем элементам arr bool
+bool SymbolTable::fillBoolArray(size_t arrayIndex, bool value) {
+    BitArray* bits = findBoolArray(arrayIndex);
+    if (!bits) return false;
+    bits->fill(value);
+    return true;
+}
+
+// Поэлементное "и" двух arr bool одного размера, результат - в targetIndex
+bool SymbolTable::andBoolArrays(size_t targetIndex, size_t sourceIndex) {
+    BitArray* target = findBoolArray(targetIndex);
+    const BitArray* source = findBoolArray(sourceIndex);
+    if (!target || !source) return false;
+    if (!target->andWith(*source)) {
+        std::cerr << "Runtime Error: Size mismatch of bool arrays '" << getSymbolName(targetIndex)
+            << "' and '" << getSymbolName(sourceIndex) << "'." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Поэлементное "или" двух arr bool одного размера, результат - в targetIndex
+bool SymbolTable::orBoolArrays(size_t targetIndex, size_t sourceIndex) {
+    BitArray* target = findBoolArray(targetIndex);
+    const BitArray* source = findBoolArray(sourceIndex);
+    if (!target || !source) return false;
+    if (!target->orWith(*source)) {
+        std::cerr << "Runtime Error: Size mismatch of bool arrays '" << getSymbolName(targetIndex)
+            << "' and '" << getSymbolName(sourceIndex) << "'." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Поэлементное отрицание arr bool
+bool SymbolTable::invertBoolArray(size_t arrayIndex) {
+    BitArray* bits = findBoolArray(arrayIndex);
+    if (!bits) return false;
+    bits->invert();
+    return true;
+}
+
+// Проверка совместимости типов при присваивании (target = value)
 bool SymbolTable::checkAssignmentTypeCompatibility(SymbolType targetType, const SymbolValue& value) const {
-    //  std::visit     variant   ()
+    // Используем std::visit для проверки типа в variant без исключений (почти)
     bool compatible = false;
     std::visit([targetType, &compatible](auto&& arg) {
-        using T = std::decay_t<decltype(arg)>; //    variant (int, double, bool)
+        using T = std::decay_t<decltype(arg)>; // Определяем тип внутри variant (int, double, bool)
         switch (targetType) {
         case SymbolType::VARIABLE_INT:
         case SymbolType::ARRAY_INT:
@@ -260,21 +334,21 @@ bool SymbolTable::checkAssignmentTypeCompatibility(SymbolType targetType, const
         }, value);
     return compatible;
 }
-//      SymbolType
+// Перегрузка для проверки совместимости двух SymbolType
 bool SymbolTable::checkAssignmentTypeCompatibility(SymbolType targetType, SymbolType valueType) const {
-    if (targetType == valueType) return true; //  
+    if (targetType == valueType) return true; // Типы совпадают
 
-    //   int  float  
+    // Неявное приведение int к float при присваивании
     if ((targetType == SymbolType::VARIABLE_FLOAT || targetType == SymbolType::ARRAY_FLOAT) &&
         (valueType == SymbolType::VARIABLE_INT || valueType == SymbolType::ARRAY_INT)) {
         return true;
     }
-    //     
+    // Все остальные несовпадения типов запрещены
     return false;
 }
 
 
-//      
+// Получение текущего количества символов в таблице
 size_t SymbolTable::getTableSize() const {
     return symbols.size();
 }   
\ No newline at end of file
@@ -7,11 +7,11 @@
 #include <stack>
 #include <iostream>
 #include <optional>
-#include <utility> //  std::move
+#include <utility> // Для std::move
 
 #include "definitions.h"
 
-// ---     () ---
+// --- Структура для представления Токена (Лексемы) ---
 struct Token {
     TokenType type = TokenType::T_UNKNOWN;
     std::string text = "";
@@ -29,10 +29,10 @@ struct Token {
     Token(TokenType t, int val, int l, int c) : type(t), intValue(val), line(l), column(c) {}
 };
 
-// ---        ---
+// --- Тип для хранения значения переменной или константы ---
 using SymbolValue = std::variant<int /*, double*/>;
 
-// ---     ---
+// --- Запись в таблице символов ---
 enum class SymbolType {
     VARIABLE_INT,
     // VARIABLE_FLOAT,
@@ -54,7 +54,7 @@ struct SymbolInfo {
 };
 
 
-// ---     (RPN) ---
+// --- Структура для элемента ОПС (RPN) ---
 struct RPNOperation {
     RPNOpCode opCode;
     std::optional<SymbolValue> operand;
@@ -67,66 +67,66 @@ struct RPNOperation {
 
     RPNOperation(RPNOpCode code, int symIdx) : opCode(code), symbolIndex(symIdx) {}
 
-    //   ,   ,   
-    //          RPNOpCode
+    // Конструктор для переходов, который ЯВНО указывает, что это переход
+    // чтобы можно было отличить от других конструкторов с одним RPNOpCode
     RPNOperation(RPNOpCode code, bool isJumpPlaceholder) : opCode(code) {
         if (code == RPNOpCode::JUMP || code == RPNOpCode::JUMP_FALSE) {
-            jumpTarget = -1; //    
+            jumpTarget = -1; // Инициализируем цель для переходов
         }
         else {
-            //       ,
-            //       JUMP/JUMP_FALSE
+            // Можно добавить проверку или сообщение об ошибке,
+            // если этот конструктор вызван не для JUMP/JUMP_FALSE
         }
     }
 };
 
 
-// ---    ---
+// --- Элемент стека интерпретатора ---
 
-//     ()    
+// Отдельная структура для адреса (индекса) переменной в таблице символов
 struct SymbolAddress {
     int tableIndex;
 };
 
-//      
+// Отдельная структура для адреса элемента массива
 struct ArrayElementAddress {
-    int tableIndex;   //     
-    int elementIndex; //    
+    int tableIndex;   // Индекс массива в таблице символов
+    int elementIndex; // Индекс элемента внутри массива
 };
 
 struct StackValue {
-    // ,    
+    // Определяем, что хранится в элементе
     enum class Type {
-        INT_VALUE,          //   int
+        INT_VALUE,          // Непосредственно значение int
         // FLOAT_VALUE,
-        SYMBOL_ADDRESS,     //   (  )
-        ARRAY_ELEMENT_ADDRESS //   
+        SYMBOL_ADDRESS,     // Адрес переменной (индекс в таблице)
+        ARRAY_ELEMENT_ADDRESS // Адрес элемента массива
     } type;
 
-    //    variant 
+    // Делаем типы в variant уникальными
     std::variant<int, /* double */ SymbolAddress, ArrayElementAddress> value;
 
-    // 
+    // Конструкторы
     StackValue(int val) : type(Type::INT_VALUE), value(val) {}
     // StackValue(double val) : type(Type::FLOAT_VALUE), value(val) {}
 
-    //    
+    // Конструктор для адреса переменной
     StackValue(int symIndex, Type t) : type(t) {
         if (t == Type::SYMBOL_ADDRESS) {
-            value = SymbolAddress{ symIndex }; //   
+            value = SymbolAddress{ symIndex }; // Используем новую структуру
         }
         else {
-            //    , ..   
+            // Генерируем ошибку или исключение, т.к. конструктор вызван некорректно
             std::cerr << "Internal Error: Invalid usage of StackValue symbol index constructor." << std::endl;
             exit(EXIT_FAILURE);
         }
     }
-    //     
+    // Конструктор для адреса элемента массива
     StackValue(int tblIdx, int elmIdx) : type(Type::ARRAY_ELEMENT_ADDRESS), value(ArrayElementAddress{ tblIdx, elmIdx }) {}
 };
 
 
-// ---    ---
+// --- Класс Стека Интерпретатора ---
 class RuntimeStack {
 private:
     std::stack<StackValue> stck;
@@ -1,19 +1,19 @@
     #include "Interpreter.h"
-#include <iostream> //  /  
-#include <stdexcept> //  std::get<>    variant
-#include <cmath>     //    
+#include <iostream> // Для ввода/вывода и ошибок
+#include <stdexcept> // Для std::get<> при работе с variant
+#include <cmath>     // Для деления на ноль
 
-// 
+// Конструктор
 Interpreter::Interpreter(const std::vector<RPNOperation>& code, SymbolTable& symTab /*, ErrorHandler& errHandler*/)
     : rpnCode(code), symbolTable(symTab) /*, errorHandler(errHandler)*/, instructionPointer(0) {
 }
 
-// ---   ---
+// --- Вспомогательные методы ---
 
 void Interpreter::runtimeError(const std::string& message) {
-    // TODO:  ErrorHandler
+    // TODO: Использовать ErrorHandler
     std::cerr << "Runtime Error (at RPN address " << instructionPointer << "): " << message << std::endl;
-    // ,      
+    // Возможно, стоит вывести состояние стека и переменных
     exit(EXIT_FAILURE);
 }
 
@@ -39,7 +39,7 @@ SymbolAddress Interpreter::popSymbolAddress() {
     }
     catch (const std::bad_variant_access& e) {
         runtimeError("Internal error accessing symbol address from stack value.");
-        //  ,    ,     
+        // Добавим возврат, чтобы компилятор не ругался, хотя сюда не должны дойти
         return SymbolAddress{ -1 };
     }
 }
@@ -54,12 +54,12 @@ ArrayElementAddress Interpreter::popArrayElementAddress() {
     }
     catch (const std::bad_variant_access& e) {
         runtimeError("Internal error accessing array element address from stack value.");
-        //  
+        // Добавим возврат
         return ArrayElementAddress{ -1, -1 };
     }
 }
 
-//    StackValue (  int)
+// Получение значения из StackValue (пока только int)
 SymbolValue Interpreter::getValueFromStackValue(const StackValue& sv) {
     switch (sv.type) {
     case StackValue::Type::INT_VALUE:
@@ -68,7 +68,7 @@ SymbolValue Interpreter::getValueFromStackValue(const StackValue& sv) {
         }
         catch (const std::bad_variant_access& e) {
             runtimeError("Internal error accessing int value from stack value.");
-            return 0; //  
+            return 0; // Для компилятора
         }
     case StackValue::Type::SYMBOL_ADDRESS: {
         try {
@@ -76,13 +76,13 @@ SymbolValue Interpreter::getValueFromStackValue(const StackValue& sv) {
             auto valueOpt = symbolTable.getVariableValue(symbolIndex);
             if (!valueOpt) {
                 runtimeError("Failed to get value for variable " + symbolTable.getSymbolName(symbolIndex) + ".");
-                return 0; //  
+                return 0; // Для компилятора
             }
             return valueOpt.value();
         }
         catch (const std::bad_variant_access& e) {
             runtimeError("Internal error accessing symbol address from stack value.");
-            return 0; //  
+            return 0; // Для компилятора
         }
     }
     case StackValue::Type::ARRAY_ELEMENT_ADDRESS: {
@@ -90,40 +90,40 @@ SymbolValue Interpreter::getValueFromStackValue(const StackValue& sv) {
             auto addr = std::get<ArrayElementAddress>(sv.value);
             auto valueOpt = symbolTable.getArrayElementValue(addr.tableIndex, addr.elementIndex);
             if (!valueOpt) {
-                //  (  )       getArrayElementValue
-                runtimeError("Failed to get value for array element."); // . 
-                return 0; //  
+                // Ошибка (выход за границы) уже должна была быть выведена в getArrayElementValue
+                runtimeError("Failed to get value for array element."); // Доп. сообщение
+                return 0; // Для компилятора
             }
             return valueOpt.value();
         }
         catch (const std::bad_variant_access& e) {
             runtimeError("Internal error accessing array element address from stack value.");
-            return 0; //  
+            return 0; // Для компилятора
         }
     }
-                                                //   float, bool
+                                                // Добавить обработку float, bool
     default:
         runtimeError("Unsupported stack value type for getValue operation.");
-        return 0; //  
+        return 0; // Для компилятора
     }
 }
 
 int Interpreter::getIntValueFromStackValue(const StackValue& sv) {
     SymbolValue val = getValueFromStackValue(sv);
     try {
-        return std::get<int>(val); //    int
+        return std::get<int>(val); // Пока поддерживаем только int
     }
     catch (const std::bad_variant_access& e) {
         runtimeError("Type mismatch: Expected an integer value but found another type.");
-        return 0; //  
+        return 0; // Для компилятора
     }
 }
 
 
-// ---    ---
+// --- Запуск выполнения ОПС ---
 void Interpreter::execute() {
     instructionPointer = 0;
-    int maxInstructions = rpnCode.size() * 100; //    
+    int maxInstructions = rpnCode.size() * 100; // Защита от бесконечного цикла
     int executedCount = 0;
 
     while (instructionPointer < rpnCode.size() && executedCount < maxInstructions) {
@@ -132,33 +132,33 @@ void Interpreter::execute() {
             break;
         }
         const RPNOperation& op = rpnCode[instructionPointer];
-        int currentIP = instructionPointer; //  IP   
-        instructionPointer++; //     
+        int currentIP = instructionPointer; // Сохраняем IP до возможного перехода
+        instructionPointer++; // По умолчанию переходим к следующей
         executedCount++;
 
-        try { //     try-catch  std::get
+        try { // Обернем обработку операции в try-catch для std::get
             switch (op.opCode) {
-                // ---  ---
+                // --- Операнды ---
             case RPNOpCode::PUSH_CONST_INT:
                 if (!op.operand) runtimeError("PUSH_CONST operation missing operand.");
-                stack.push(StackValue(std::get<int>(op.operand.value()))); //  
+                stack.push(StackValue(std::get<int>(op.operand.value()))); // Кладем значение
                 break;
             case RPNOpCode::PUSH_VAR:
                 if (!op.symbolIndex) runtimeError("PUSH_VAR operation missing symbol index.");
-                //   ()   
+                // Кладем адрес (индекс) переменной в таблице
                 stack.push(StackValue(op.symbolIndex.value(), StackValue::Type::SYMBOL_ADDRESS));
                 break;
             case RPNOpCode::PUSH_ARRAY:
                 if (!op.symbolIndex) runtimeError("PUSH_ARRAY operation missing symbol index.");
-                //   ()   
-                // :   PUSH_VAR,     StackValue,
-                //       INDEX,     SYMBOL_ADDRESS
-                //   StackValue::Type::ARRAY_BASE_ADDRESS
+                // Кладем адрес (индекс) массива в таблице
+                // ВНИМАНИЕ: отличается от PUSH_VAR, нужен другой тип в StackValue,
+                // но мы его используем только в INDEX, так что пока оставим SYMBOL_ADDRESS
+                // Лучше добавить StackValue::Type::ARRAY_BASE_ADDRESS
                 stack.push(StackValue(op.symbolIndex.value(), StackValue::Type::SYMBOL_ADDRESS));
                 break;
 
 
-                // ---  ---
+                // --- Арифметика ---
             case RPNOpCode::ADD:
             case RPNOpCode::SUB:
             case RPNOpCode::MUL:
@@ -171,13 +171,13 @@ void Interpreter::execute() {
                 else if (op.opCode == RPNOpCode::MUL) result = leftOperand * rightOperand;
                 else if (op.opCode == RPNOpCode::DIV) {
                     if (rightOperand == 0) runtimeError("Division by zero.");
-                    result = leftOperand / rightOperand; //  
+                    result = leftOperand / rightOperand; // Целочисленное деление
                 }
-                stack.push(StackValue(result)); //  
+                stack.push(StackValue(result)); // Кладем результат
                 break;
             }
 
-                               // ---  ---
+                               // --- Сравнение ---
             case RPNOpCode::CMP_EQ:
             case RPNOpCode::CMP_NE:
             case RPNOpCode::CMP_GT:
@@ -189,14 +189,14 @@ void Interpreter::execute() {
                 else if (op.opCode == RPNOpCode::CMP_NE) result = (leftOperand != rightOperand);
                 else if (op.opCode == RPNOpCode::CMP_GT) result = (leftOperand > rightOperand);
                 else if (op.opCode == RPNOpCode::CMP_LT) result = (leftOperand < rightOperand);
-                stack.push(StackValue(result ? 1 : 0)); //   (1 - true, 0 - false)
+                stack.push(StackValue(result ? 1 : 0)); // Результат сравнения (1 - true, 0 - false)
                 break;
             }
 
-                                  // ---  ---
+                                  // --- Присваивание ---
             case RPNOpCode::ASSIGN: {
-                SymbolValue valueToAssign = getValueFromStackValue(popValue()); // 
-                StackValue target = popValue(); //  (   )
+                SymbolValue valueToAssign = getValueFromStackValue(popValue()); // Значение
+                StackValue target = popValue(); // Адрес (переменная или элемент массива)
 
                 if (target.type == StackValue::Type::SYMBOL_ADDRESS) {
                     int targetIndex = std::get<SymbolAddress>(target.value).tableIndex;
@@ -207,7 +207,7 @@ void Interpreter::execute() {
                 else if (target.type == StackValue::Type::ARRAY_ELEMENT_ADDRESS) {
                     auto addr = std::get<ArrayElementAddress>(target.value);
                     if (!symbolTable.setArrayElementValue(addr.tableIndex, addr.elementIndex, valueToAssign)) {
-                        //     setArrayElementValue
+                        // Ошибка уже выведена в setArrayElementValue
                         runtimeError("Failed to assign value to array element.");
                     }
                 }
@@ -217,40 +217,40 @@ void Interpreter::execute() {
                 break;
             }
 
-                                  // ---  ---
+                                  // --- Индексация ---
             case RPNOpCode::INDEX: {
-                int elementIdxValue = popIntValue(); //  
-                StackValue arrayBase = popValue(); //  () 
+                int elementIdxValue = popIntValue(); // Индекс элемента
+                StackValue arrayBase = popValue(); // Адрес (индекс) массива
 
                 if (arrayBase.type != StackValue::Type::SYMBOL_ADDRESS) {
                     runtimeError("Expected array base address for indexing.");
                 }
                 int arrayTableIndex = std::get<SymbolAddress>(arrayBase.value).tableIndex;
 
-                //    
+                // Проверка на отрицательный индекс
                 if (elementIdxValue < 0) {
                     runtimeError("Array index cannot be negative.");
                 }
 
-                //      
+                // Кладем в стек адрес элемента массива
                 stack.push(StackValue(arrayTableIndex, elementIdxValue));
                 break;
             }
 
-                                 // --- / ---
+                                 // --- Ввод/Вывод ---
             case RPNOpCode::READ: {
-                StackValue target = popValue(); // ,  
+                StackValue target = popValue(); // Адрес, куда читать
                 int valueRead = 0;
-                std::cout << "? "; //   
+                std::cout << "? "; // Приглашение к вводу
                 std::cin >> valueRead;
                 if (std::cin.fail()) {
                     runtimeError("Invalid input. Please enter an integer.");
-                    //    cin
+                    // Очистка состояния ошибки cin
                     std::cin.clear();
                     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
                 }
 
-                SymbolValue symValueToSet = valueRead; //   int
+                SymbolValue symValueToSet = valueRead; // Пока только int
 
                 if (target.type == StackValue::Type::SYMBOL_ADDRESS) {
                     int targetIndex = std::get<SymbolAddress>(target.value).tableIndex;
@@ -270,27 +270,27 @@ void Interpreter::execute() {
                 break;
             }
             case RPNOpCode::WRITE: {
-                int valueToWrite = popIntValue(); //   
+                int valueToWrite = popIntValue(); // Значение для вывода
                 std::cout << valueToWrite << std::endl;
                 break;
             }
 
-                                 // ---  ---
+                                 // --- Переходы ---
             case RPNOpCode::JUMP:
                 if (!op.jumpTarget.has_value() || op.jumpTarget.value() < 0) {
                     runtimeError("JUMP target address not set.");
                 }
-                instructionPointer = op.jumpTarget.value(); //  IP
+                instructionPointer = op.jumpTarget.value(); // Устанавливаем IP
                 break;
             case RPNOpCode::JUMP_FALSE: {
-                int condition = popIntValue(); //   (0  1)
+                int condition = popIntValue(); // Результат условия (0 или 1)
                 if (!op.jumpTarget.has_value() || op.jumpTarget.value() < 0) {
                     runtimeError("JUMP_FALSE target address not set.");
                 }
-                if (condition == 0) { //   
-                    instructionPointer = op.jumpTarget.value(); //  IP
+                if (condition == 0) { // Если условие ложно
+                    instructionPointer = op.jumpTarget.value(); // Устанавливаем IP
                 }
-                //  , IP  
+                // Если истинно, IP уже инкрементирован
                 break;
             }
             default:
@@ -313,7 +313,7 @@ void Interpreter::execute() {
         runtimeError("Maximum instruction limit exceeded. Possible infinite loop.");
     }
 
-    //       ()
+    // Проверка на пустой стек в конце (опционально)
     // if (!stack.isEmpty()) {
     //     std::cerr << "Warning: Stack is not empty at the end of execution." << std::endl;
     // }
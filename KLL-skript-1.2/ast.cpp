@@ -0,0 +1,48 @@
+// ast.cpp
+#include "ast.h"
+
+#include <cstdint>
+
+void* AstArena::allocateBytes(size_t size, size_t alignment) {
+    size_t padding = (alignment - reinterpret_cast<std::uintptr_t>(cursor) % alignment) % alignment;
+    if (!cursor || padding + size > remaining) {
+        blocks.emplace_back(new unsigned char[BLOCK_SIZE]);
+        cursor = blocks.back().get();
+        remaining = BLOCK_SIZE;
+        padding = (alignment - reinterpret_cast<std::uintptr_t>(cursor) % alignment) % alignment;
+    }
+    void* result = cursor + padding;
+    cursor += padding + size;
+    remaining -= padding + size;
+    ++nodeCount;
+    return result;
+}
+
+AstExpr* AstArena::newExpr(AstExprKind kind, SymbolType type, int line, int column) {
+    AstExpr* expr = allocate<AstExpr>();
+    expr->kind = kind;
+    expr->type = type;
+    expr->op = RPNOpCode::ADD;
+    expr->line = line;
+    expr->column = column;
+    expr->symbolIndex = 0;
+    expr->intValue = 0;
+    expr->left = nullptr;
+    expr->right = nullptr;
+    return expr;
+}
+
+AstStmt* AstArena::newStmt(AstStmtKind kind, int line, int column) {
+    AstStmt* stmt = allocate<AstStmt>();
+    stmt->kind = kind;
+    stmt->line = line;
+    stmt->column = column;
+    stmt->symbolIndex = 0;
+    stmt->parallelLoopIndex = AstStmt::NOT_PARALLEL;
+    stmt->index = nullptr;
+    stmt->value = nullptr;
+    stmt->body = nullptr;
+    stmt->elseBody = nullptr;
+    stmt->next = nullptr;
+    return stmt;
+}
@@ -0,0 +1,115 @@
+// ast.h
+#ifndef AST_H
+#define AST_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#include "definitions.h" // SymbolType, RPNOpCode
+
+// --- Типизированное абстрактное синтаксическое дерево ---
+// Парсер строит дерево вместо прямой генерации ОПС: все проверки типов выполняются при разборе,
+// а неявные приведения записываются в дерево явными узлами CONVERT (в том числе для левого операнда).
+// Узлы простые (тривиально уничтожаемые) и размещаются в AstArena; связи - обычные указатели.
+
+enum class AstExprKind : unsigned char {
+    CONST_INT,     // intValue
+    CONST_FLOAT,   // floatValue
+    VARIABLE,      // Значение скалярной переменной symbolIndex
+    ARRAY_ELEMENT, // symbolIndex[left]
+    WHOLE_ARRAY,   // Массив symbolIndex целиком (операнд векторного выражения)
+    BINARY,        // left op right; op - ADD/SUB/MUL/DIV, CMP_*, VEC_ADD/SUB/MUL/DIV
+    CONVERT,       // op(left); op - CONVERT_TO_INT или CONVERT_TO_FLOAT
+    SUM            // sum(left) - сумма элементов векторного выражения
+};
+
+struct AstExpr {
+    AstExprKind kind;
+    // VARIABLE_INT/VARIABLE_FLOAT - скаляр, ARRAY_INT/ARRAY_FLOAT - векторное значение
+    SymbolType type;
+    RPNOpCode op;
+    int line;
+    int column;
+    size_t symbolIndex;
+    union {
+        int intValue;
+        float floatValue;
+    };
+    AstExpr* left;
+    AstExpr* right;
+
+    bool isVector() const { return type == SymbolType::ARRAY_INT || type == SymbolType::ARRAY_FLOAT; }
+};
+
+enum class AstStmtKind : unsigned char {
+    ASSIGN,         // symbolIndex = value (скалярная переменная)
+    ASSIGN_ELEMENT, // symbolIndex[index] = value
+    VECTOR_ASSIGN,  // symbolIndex = value (массив целиком; value - векторное или скалярное выражение)
+    IF,             // if (value) body else elseBody
+    WHILE,          // while (value) body; parallelLoopIndex - номер описателя цикла parallel
+    CIN,            // cin(symbolIndex) или cin(symbolIndex[index])
+    COUT,           // cout(value)
+    BLOCK           // begin body ... end
+};
+
+struct AstStmt {
+    static constexpr size_t NOT_PARALLEL = static_cast<size_t>(-1);
+
+    AstStmtKind kind;
+    int line;
+    int column;
+    size_t symbolIndex;
+    size_t parallelLoopIndex;
+    AstExpr* index;     // Индекс элемента (ASSIGN_ELEMENT, CIN) или nullptr
+    AstExpr* value;     // Правая часть, условие или выводимое выражение
+    AstStmt* body;      // Первый оператор тела then/while/блока
+    AstStmt* elseBody;  // Первый оператор ветви else
+    AstStmt* next;      // Следующий оператор того же списка
+};
+
+// Список операторов, собираемый при разборе (first - начало связного списка)
+struct AstStmtList {
+    AstStmt* first = nullptr;
+    AstStmt* last = nullptr;
+
+    void append(AstStmt* stmt) {
+        if (!stmt) return;
+        if (last) last->next = stmt;
+        else first = stmt;
+        last = stmt;
+    }
+};
+
+// --- Арена узлов дерева ---
+// Узлы выделяются последовательно из крупных блоков и освобождаются все сразу вместе с ареной.
+class AstArena {
+public:
+    AstArena() : cursor(nullptr), remaining(0), nodeCount(0) {}
+    AstArena(const AstArena&) = delete;
+    AstArena& operator=(const AstArena&) = delete;
+
+    AstExpr* newExpr(AstExprKind kind, SymbolType type, int line, int column);
+    AstStmt* newStmt(AstStmtKind kind, int line, int column);
+
+    size_t getNodeCount() const { return nodeCount; }
+
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    std::vector<std::unique_ptr<unsigned char[]>> blocks;
+    unsigned char* cursor;
+    size_t remaining;
+    size_t nodeCount;
+
+    template <typename T>
+    T* allocate() {
+        static_assert(std::is_trivially_destructible<T>::value, "AST nodes are never destroyed individually");
+        return new (allocateBytes(sizeof(T), alignof(T))) T();
+    }
+    void* allocateBytes(size_t size, size_t alignment);
+};
+
+#endif // AST_H
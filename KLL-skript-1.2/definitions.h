@@ -4,28 +4,28 @@
 
 #include <string> 
 
-// ---    ---
-//  enum class       
+// --- Состояния Лексического Анализатора ---
+// Используем enum class для большей типобезопасности и избежания конфликтов имен
 enum class LexerState {
-    START,                  // 0:  
-    IDENTIFIER,             // 1:  / 
-    NUMBER_INT,             // 2:    
-    NUMBER_FLOAT_DECIMAL,   // 3:     ( )
-    NUMBER_FLOAT_EXP        // 4:    (  )
-    //          ,
-    //     getNextToken    
+    START,                  // 0: Начальное состояние
+    IDENTIFIER,             // 1: Чтение идентификатора/ключевого слова
+    NUMBER_INT,             // 2: Чтение целой части числа
+    NUMBER_FLOAT_DECIMAL,   // 3: Чтение дробной части числа (после точки)
+    NUMBER_FLOAT_EXP        // 4: Чтение экспоненциальной части (пока не используется)
+    // Ошибка и финальное состояние не нужны как явные состояния КА,
+    // они определяются логикой внутри getNextToken на основе семантических действий
 };
 
 
-// ---   () ---
-// ... (  definitions.h  ) ...
+// --- Типы Лексем (Токенов) ---
+// ... (остальной код definitions.h без изменений) ...
 enum class TokenType {
-    //   
-    T_IDENTIFIER,   // 
-    T_NUMBER_INT,   //  
-    T_NUMBER_FLOAT, //  
+    // Литералы и идентификаторы
+    T_IDENTIFIER,   // Идентификатор
+    T_NUMBER_INT,   // Целочисленная константа
+    T_NUMBER_FLOAT, // Вещественная константа
 
-    //  
+    // Ключевые слова
     T_KW_INT,       // int
     T_KW_FLOAT,     // float
     T_KW_ARR,       // arr 
@@ -37,7 +37,10 @@ enum class TokenType {
     T_KW_CIN,       // cin
     T_KW_COUT,      // cout
 
-    //   
+    // Строковый литерал
+    T_STRING,       // Строка в кавычках (путь к файлу в объявлении массива)
+
+    // Операторы и разделители
     T_ASSIGN = '=',
     T_PLUS = '+',
     T_MINUS = '-',
@@ -50,20 +53,20 @@ enum class TokenType {
     T_SEMICOLON = ';',
     T_COMMA = ',',
 
-    //  
+    // Операторы сравнения
     T_EQUAL = '~',
     T_GREATER = '>',
     T_LESS = '<',
     T_NOT_EQUAL = '!',
 
-    //  
+    // Специальные токены
     T_EOF,
     T_ERROR,
     T_UNKNOWN
 };
 
-// ---    (RPN - Reverse Polish Notation) ---
-// ... (  definitions.h  ) ...
+// --- Типы операций ОПС (RPN - Reverse Polish Notation) ---
+// ... (остальной код definitions.h без изменений) ...
 enum class RPNOpCode {
     PUSH_VAR_ADDR,
     PUSH_ARRAY_ADDR,
@@ -93,12 +96,23 @@ enum class RPNOpCode {
     JUMP_FALSE,
 
     CONVERT_TO_FLOAT,
-    CONVERT_TO_INT
+    CONVERT_TO_INT,
+
+    // Векторные операции над целыми массивами (c = a + b * 2; s = sum(a);)
+    // Операнды - массивы, векторные временные значения или скаляры (размножаются на всю длину)
+    VEC_ADD,
+    VEC_SUB,
+    VEC_MUL,
+    VEC_DIV,
+    VEC_ASSIGN,  // Стек: ... ArrayAddress Value -> поэлементное присваивание (скаляр заполняет массив)
+    VEC_SUM,     // Стек: ... Vector -> скаляр (сумма элементов)
+
+    PARALLEL_LOOP // Вход в параллельный цикл (operandValue - номер описателя ParallelLoopInfo)
 };
 
 
-// ---      ---
-// ... (  definitions.h  ) ...
+// --- Типы символов в таблице символов ---
+// ... (остальной код definitions.h без изменений) ...
 enum class SymbolType {
     VARIABLE_INT,
     VARIABLE_FLOAT,
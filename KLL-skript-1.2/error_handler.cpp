@@ -16,8 +16,8 @@ void ErrorHandler::logSemanticError(const std::string& message, int line, int co
     errorOccurred = true;
 }
 
-void ErrorHandler::logRuntimeError(const std::string& message) {
-    errors.emplace_back(ErrorInfo::ErrorType::RUNTIME, message); // /   
+void ErrorHandler::logRuntimeError(const std::string& message, int line, int column) {
+    errors.emplace_back(ErrorInfo::ErrorType::RUNTIME, message, line, column);
     errorOccurred = true;
 }
 
@@ -29,6 +29,10 @@ size_t ErrorHandler::getErrorCount() const {
     return errors.size();
 }
 
+const std::vector<ErrorInfo>& ErrorHandler::getErrors() const {
+    return errors;
+}
+
 void ErrorHandler::printErrors() const {
     if (errors.empty()) {
         std::cout << "No errors reported." << std::endl;
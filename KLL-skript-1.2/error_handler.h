@@ -4,15 +4,15 @@
 
 #include <vector>
 #include <string>
-#include <iostream> //     
+#include <iostream> // Для вывода ошибок по умолчанию
 
-//      
+// Структура для хранения информации об ошибке
 struct ErrorInfo {
     enum class ErrorType {
         LEXICAL,
         SYNTAX,
-        SEMANTIC, // ,  /  (,  )
-        RUNTIME   //    (,   )
+        SEMANTIC, // Ошибки, выявляемые парсером/таблицей символов (например, необъявленная переменная)
+        RUNTIME   // Ошибки времени выполнения (например, деление на ноль)
     } type;
 
     std::string message;
@@ -23,7 +23,7 @@ struct ErrorInfo {
         : type(t), message(std::move(msg)), line(l), column(c) {
     }
 
-    //       
+    // Метод для форматированного вывода информации об ошибке
     void print() const {
         std::cerr << "Error";
         if (line > 0) {
@@ -45,7 +45,7 @@ struct ErrorInfo {
     }
 };
 
-//     
+// Класс для централизованной обработки ошибок
 class ErrorHandler {
 private:
     std::vector<ErrorInfo> errors;
@@ -54,22 +54,25 @@ private:
 public:
     ErrorHandler() : errorOccurred(false) {}
 
-    //      
+    // Методы для регистрации ошибок разного типа
     void logLexicalError(const std::string& message, int line, int column);
     void logSyntaxError(const std::string& message, int line, int column);
-    void logSemanticError(const std::string& message, int line = 0, int column = 0); //         
-    void logRuntimeError(const std::string& message); //         /  
+    void logSemanticError(const std::string& message, int line = 0, int column = 0); // Семантические ошибки могут не всегда иметь точную позицию символа
+    void logRuntimeError(const std::string& message, int line = 0, int column = 0); // Позиция известна, если интерпретатору передана таблица позиций ОПС
 
-    // ,    
+    // Проверка, были ли зарегистрированы ошибки
     bool hasErrors() const;
 
-    //   
+    // Получение количества ошибок
     size_t getErrorCount() const;
 
-    //    
+    // Доступ к накопленным ошибкам (например, для переноса ошибок рабочего потока в общий обработчик)
+    const std::vector<ErrorInfo>& getErrors() const;
+
+    // Вывод всех зарегистрированных ошибок
     void printErrors() const;
 
-    //    (      )
+    // Очистка списка ошибок (может понадобиться для интерактивного режима или тестов)
     void clearErrors();
 };
 
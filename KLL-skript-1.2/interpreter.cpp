@@ -1,24 +1,27 @@
 // interpreter.cpp
 #include "interpreter.h"
-#include <iostream> //  cin/cout  
+#include <iostream> // Для cin/cout и отладки
 #include <iomanip>  
-#include <limits>   //  std::numeric_limits ( cin)
-#include <cmath>    //  std::floor (  float  int)
+#include <limits>   // Для std::numeric_limits (очистка cin)
+#include <cmath>    // Для std::floor (при конвертации float в int)
+#include <algorithm> // Для std::copy (векторное присваивание)
+#include <atomic>    // Для std::atomic (первая ошибка в параллельном цикле)
 
-// ---  RuntimeStack ---
+// --- Реализация RuntimeStack ---
 void RuntimeStack::push(const RuntimeStackItem& item) {
     if (stck.size() >= MAX_STACK_SIZE) {
-        //       Interpreter  runtimeError
+        // Эту ошибку должен поймать и обработать Interpreter через runtimeError
         throw std::runtime_error("Runtime Stack overflow.");
     }
     stck.push(item);
+    highWater = std::max(highWater, stck.size());
 }
 
 RuntimeStackItem RuntimeStack::pop() {
     //std::cout << "DEBUG: RuntimeStack::pop() called. Stack size before pop: " << stck.size() << std::endl;
     if (stck.empty()) {
-        //std::cout << "ERROR DEBUG: Attempt to pop from empty stack!" << std::endl; // 
-        //       Interpreter  runtimeError
+        //std::cout << "ERROR DEBUG: Attempt to pop from empty stack!" << std::endl; // Отладка
+        // Эту ошибку должен поймать и обработать Interpreter через runtimeError
         throw std::runtime_error("Runtime Stack underflow.");
     }
     RuntimeStackItem topItem = stck.top();
@@ -38,29 +41,49 @@ void RuntimeStack::clear() {
     while (!stck.empty()) {
         stck.pop();
     }
+    highWater = 0;
 }
 
-// ---  Interpreter ---
+// --- Реализация Interpreter ---
 
-Interpreter::Interpreter(const std::vector<RPNOperation>& code, SymbolTable& symTab, ErrorHandler& errHandler)
-    : rpnCode(code), symbolTable(symTab), errorHandler(errHandler), instructionPointer(0) {
+Interpreter::Interpreter(const std::vector<RPNOperation>& code, SymbolTable& symTab, ErrorHandler& errHandler,
+    const std::vector<VectorLoopInfo>* loops, const std::vector<ParallelLoopInfo>* parLoops)
+    : rpnCode(code), symbolTable(symTab), errorHandler(errHandler), instructionPointer(0), vectorLoops(loops),
+    parallelLoops(parLoops), instructionLimit(MAX_EXECUTED_INSTRUCTIONS), executedCounter(0), vectorTempDepth(0), vectorWindowOffset(0),
+    threadCount(std::max(1u, std::thread::hardware_concurrency())), isParallelWorker(false),
+    sourceLocations(nullptr), instrumented(false), profiler(nullptr), profiledAddress(-1), profiledStart(0),
+    sampledAddress(nullptr) {
+}
+
+void Interpreter::setThreadCount(size_t count) {
+    threadCount = (count == 0) ? 1 : count;
+    threadPool.reset();
+}
+
+void Interpreter::setInstructionLimit(int limit) {
+    instructionLimit = std::max(1, std::min(limit, MAX_INSTRUCTION_LIMIT));
 }
 
 void Interpreter::runtimeError(const std::string& message) {
-    errorHandler.logRuntimeError("RPN[" + std::to_string(instructionPointer - 1) + "]: " + message); // -1 .. IP  
-    //      ,   execute()
+    int address = instructionPointer - 1; // -1 т.к. IP уже инкрементирован
+    SourceLocation location;
+    if (sourceLocations && address >= 0) {
+        location = sourceLocations->lookup(static_cast<size_t>(address)).value_or(SourceLocation());
+    }
+    errorHandler.logRuntimeError("RPN[" + std::to_string(address) + "]: " + message, location.line, location.column);
+    // Для фатальных ошибок можно бросать исключение, чтобы прервать execute()
     throw std::runtime_error("Fatal runtime error occurred.");
 }
 
-// ---         ---
+// --- Вспомогательные методы для работы со стеком и значениями ---
 
 RuntimeStackItem Interpreter::popStack() {
     try {
         return stack.pop();
     }
-    catch (const std::runtime_error& e) { //  stack underflow  RuntimeStack
-        runtimeError(e.what()); //     ErrorHandler
-        //   ,    ,  throw  
+    catch (const std::runtime_error& e) { // Ловим stack underflow из RuntimeStack
+        runtimeError(e.what()); // Передаем ошибку в наш ErrorHandler
+        // Возвращаем фиктивное значение, чтобы компилятор был доволен, но throw уже был
         return RuntimeStackItem(0);
     }
 }
@@ -71,10 +94,10 @@ int Interpreter::popInt() {
         return std::get<int>(item.value);
     }
     else if (item.type == RuntimeStackItem::ItemType::FLOAT_VALUE) {
-        //   float  int    int
-        //   ,    
+        // Неявное усечение float до int при извлечении как int
+        // Можно добавить предупреждение, если это нежелательное поведение
         // errorHandler.logRuntimeError("Warning: Implicit conversion from float to int during popInt. Value truncated.");
-        return static_cast<int>(std::floor(std::get<float>(item.value))); //    (  C)
+        return static_cast<int>(std::floor(std::get<float>(item.value))); // Усечение к меньшему (как в C)
     }
     else if (item.type == RuntimeStackItem::ItemType::VAR_ADDRESS || item.type == RuntimeStackItem::ItemType::ARRAY_ELEMENT_ADDRESS) {
         StoredValue storedVal = getValueFromStackItem(item);
@@ -88,7 +111,7 @@ int Interpreter::popInt() {
         }
     }
     runtimeError("Type mismatch on stack: Expected integer or address of integer.");
-    return 0; //  - runtimeError
+    return 0; // Недостижимо из-за runtimeError
 }
 
 float Interpreter::popFloat() {
@@ -97,7 +120,7 @@ float Interpreter::popFloat() {
         return std::get<float>(item.value);
     }
     else if (item.type == RuntimeStackItem::ItemType::INT_VALUE) {
-        //   int  float
+        // Неявное преобразование int во float
         return static_cast<float>(std::get<int>(item.value));
     }
     else if (item.type == RuntimeStackItem::ItemType::VAR_ADDRESS || item.type == RuntimeStackItem::ItemType::ARRAY_ELEMENT_ADDRESS) {
@@ -109,7 +132,7 @@ float Interpreter::popFloat() {
         }
     }
     runtimeError("Type mismatch on stack: Expected float or address of float.");
-    return 0.0f; // 
+    return 0.0f; // Недостижимо
 }
 
 VarAddress Interpreter::popVarAddress() {
@@ -118,7 +141,7 @@ VarAddress Interpreter::popVarAddress() {
         return std::get<VarAddress>(item.value);
     }
     runtimeError("Type mismatch on stack: Expected variable address.");
-    return VarAddress{ 0 }; // 
+    return VarAddress{ 0 }; // Недостижимо
 }
 
 ArrayElementAddress Interpreter::popArrayElementAddress() {
@@ -127,7 +150,7 @@ ArrayElementAddress Interpreter::popArrayElementAddress() {
         return std::get<ArrayElementAddress>(item.value);
     }
     runtimeError("Type mismatch on stack: Expected array element address.");
-    return ArrayElementAddress{ 0,0 }; // 
+    return ArrayElementAddress{ 0,0 }; // Недостижимо
 }
 
 
@@ -140,21 +163,28 @@ StoredValue Interpreter::getValueFromStackItem(const RuntimeStackItem& item) {
     }
     else if (item.type == RuntimeStackItem::ItemType::VAR_ADDRESS) {
         size_t varIndex = std::get<VarAddress>(item.value).table_index;
-        auto optVal = symbolTable.getVariableValue(varIndex);
-        if (!optVal) { // symbolTable.getVariableValue      errorHandler  
+        if (isPrivateScalar(varIndex)) {
+            const StoredValue& privateValue = privateValues[varIndex];
+            if (std::holds_alternative<std::monostate>(privateValue)) {
+                errorHandler.logRuntimeError("Variable '" + symbolTable.getSymbolName(varIndex) + "' used before initialization.");
+            }
+            return privateValue;
+        }
+        auto optVal = symbolTable.getVariableValue(varIndex, &errorHandler);
+        if (!optVal) { // symbolTable.getVariableValue должен был бы сам вызвать errorHandler при ошибке
             runtimeError("Failed to retrieve value for variable (index: " + std::to_string(varIndex) + ").");
             return std::monostate{};
         }
         if (std::holds_alternative<std::monostate>(optVal.value())) {
-            //    ,     (,  )
+            // Не фатальная ошибка здесь, пусть вызывающий код решает (например, арифметическая операция)
             // errorHandler.logRuntimeError("Variable '" + symbolTable.getSymbolName(varIndex) + "' used before initialization.");
         }
         return optVal.value();
     }
     else if (item.type == RuntimeStackItem::ItemType::ARRAY_ELEMENT_ADDRESS) {
         const auto& addr = std::get<ArrayElementAddress>(item.value);
-        auto optVal = symbolTable.getArrayElementValue(addr.array_table_index, static_cast<size_t>(addr.element_runtime_index));
-        if (!optVal) { // getArrayElementValue      
+        auto optVal = symbolTable.getArrayElementValue(addr.array_table_index, static_cast<size_t>(addr.element_runtime_index), &errorHandler);
+        if (!optVal) { // getArrayElementValue сам логирует ошибку выхода за границы
             runtimeError("Failed to retrieve value for array element '" +
                 symbolTable.getSymbolName(addr.array_table_index) +
                 "[" + std::to_string(addr.element_runtime_index) + "]'.");
@@ -167,21 +197,36 @@ StoredValue Interpreter::getValueFromStackItem(const RuntimeStackItem& item) {
         return optVal.value();
     }
     runtimeError("Invalid stack item type for getValue operation.");
-    return std::monostate{}; // 
+    return std::monostate{}; // Недостижимо
 }
 
 void Interpreter::setValueAtStackItemAddress(const RuntimeStackItem& addressItem, const StoredValue& valueToSet) {
     if (addressItem.type == RuntimeStackItem::ItemType::VAR_ADDRESS) {
         size_t varIndex = std::get<VarAddress>(addressItem.value).table_index;
-        if (!symbolTable.setVariableValue(varIndex, valueToSet)) {
-            // symbolTable.setVariableValue    errorHandler
+        if (isPrivateScalar(varIndex)) {
+            // Приведение к типу переменной, как в SymbolTable::setVariableValue
+            bool isIntVariable = symbolTable.getSymbolType(varIndex) == SymbolType::VARIABLE_INT;
+            if (std::holds_alternative<int>(valueToSet)) {
+                privateValues[varIndex] = isIntVariable ? valueToSet : StoredValue(static_cast<float>(std::get<int>(valueToSet)));
+            }
+            else if (std::holds_alternative<float>(valueToSet)) {
+                privateValues[varIndex] = isIntVariable ? StoredValue(static_cast<int>(std::get<float>(valueToSet))) : valueToSet;
+            }
+            else {
+                runtimeError("Invalid value type for variable '" + symbolTable.getSymbolName(varIndex) + "'.");
+            }
+            privateWritten[varIndex] = 1;
+            return;
+        }
+        if (!symbolTable.setVariableValue(varIndex, valueToSet, &errorHandler)) {
+            // symbolTable.setVariableValue должен был вызвать errorHandler
             runtimeError("Failed to set value for variable (index: " + std::to_string(varIndex) + ").");
         }
     }
     else if (addressItem.type == RuntimeStackItem::ItemType::ARRAY_ELEMENT_ADDRESS) {
         const auto& addr = std::get<ArrayElementAddress>(addressItem.value);
-        if (!symbolTable.setArrayElementValue(addr.array_table_index, static_cast<size_t>(addr.element_runtime_index), valueToSet)) {
-            // symbolTable.setArrayElementValue    errorHandler
+        if (!symbolTable.setArrayElementValue(addr.array_table_index, static_cast<size_t>(addr.element_runtime_index), valueToSet, &errorHandler)) {
+            // symbolTable.setArrayElementValue должен был вызвать errorHandler
             runtimeError("Failed to set value for array element '" +
                 symbolTable.getSymbolName(addr.array_table_index) +
                 "[" + std::to_string(addr.element_runtime_index) + "]'.");
@@ -192,30 +237,503 @@ void Interpreter::setValueAtStackItemAddress(const RuntimeStackItem& addressItem
     }
 }
 
-//  execute()    
-// interpreter.cpp ()
-// ... ( RuntimeStack,  Interpreter,     1) ...
+// --- Векторные операции ---
+
+VectorOperand Interpreter::popVectorOperand() {
+    RuntimeStackItem item = popStack();
+    VectorOperand operand;
+
+    if (item.type == RuntimeStackItem::ItemType::VECTOR_TEMP) {
+        size_t slot = std::get<VectorTempAddress>(item.value).slot;
+        if (slot >= vectorTempDepth) {
+            runtimeError("Internal: Invalid vector temporary on stack.");
+        }
+        const VectorBuffer& buffer = vectorTemps[slot];
+        operand.isVector = true;
+        operand.isFloat = buffer.isFloat;
+        operand.length = buffer.length;
+        operand.ints = buffer.ints.data();
+        operand.floats = buffer.floats.data();
+        operand.tempSlot = slot;
+        return operand;
+    }
+
+    if (item.type == RuntimeStackItem::ItemType::VAR_ADDRESS) {
+        size_t index = std::get<VarAddress>(item.value).table_index;
+        SymbolType type = symbolTable.getSymbolType(index);
+        if (type == SymbolType::ARRAY_INT || type == SymbolType::ARRAY_FLOAT) {
+            operand.isVector = true;
+            operand.isFloat = (type == SymbolType::ARRAY_FLOAT);
+            operand.length = symbolTable.getArrayDeclaredSize(index).value_or(0);
+            operand.ints = symbolTable.getArrayIntData(index);
+            operand.floats = symbolTable.getArrayFloatData(index);
+            if (vectorWindowLength) { // Границы окна проверены в tryVectorLoop
+                if (operand.ints) operand.ints += vectorWindowOffset;
+                if (operand.floats) operand.floats += vectorWindowOffset;
+                operand.length = vectorWindowLength.value();
+            }
+            return operand;
+        }
+    }
+
+    // Скаляр: будет размножен на всю длину вектора
+    StoredValue value = getValueFromStackItem(item);
+    if (std::holds_alternative<int>(value)) {
+        operand.intScalar = std::get<int>(value);
+        operand.floatScalar = static_cast<float>(operand.intScalar);
+    }
+    else if (std::holds_alternative<float>(value)) {
+        operand.isFloat = true;
+        operand.floatScalar = std::get<float>(value);
+        operand.intScalar = static_cast<int>(std::floor(operand.floatScalar));
+    }
+    else {
+        runtimeError("Attempted to use uninitialized variable or array element in vector operation.");
+    }
+    return operand;
+}
+
+size_t Interpreter::acquireVectorTemp(bool isFloat, size_t length) {
+    size_t slot = vectorTempDepth++;
+    if (slot >= vectorTemps.size()) {
+        vectorTemps.emplace_back();
+    }
+    VectorBuffer& buffer = vectorTemps[slot];
+    buffer.isFloat = isFloat;
+    buffer.length = length;
+    if (isFloat) buffer.floats.resize(length);
+    else buffer.ints.resize(length);
+    return slot;
+}
+
+void Interpreter::releaseVectorOperands(const VectorOperand& a, const VectorOperand& b) {
+    // Временные значения всегда лежат на вершине пула (выражение вычисляется стеково),
+    // поэтому достаточно опустить вершину до наименьшего освобождаемого буфера.
+    if (a.tempSlot && a.tempSlot.value() < vectorTempDepth) vectorTempDepth = a.tempSlot.value();
+    if (b.tempSlot && b.tempSlot.value() < vectorTempDepth) vectorTempDepth = b.tempSlot.value();
+}
+
+const float* Interpreter::promoteToFloat(const VectorOperand& operand, std::vector<float>& scratch) {
+    if (operand.isFloat) return operand.floats;
+    scratch.resize(operand.length);
+    VectorKernels::convertIntToFloat(scratch.data(), operand.ints, operand.length);
+    return scratch.data();
+}
+
+void Interpreter::executeVectorBinary(VectorKernelOp op) {
+    VectorOperand right = popVectorOperand();
+    VectorOperand left = popVectorOperand();
+
+    if (!left.isVector && !right.isVector) {
+        // Инвариантная скалярная часть выражения векторизованного цикла (k * 2): делитель - ненулевая константа
+        VectorOperand result;
+        result.isFloat = left.isFloat || right.isFloat;
+        if (result.isFloat) {
+            VectorKernels::binaryFloat(op, &result.floatScalar, nullptr, left.floatScalar, nullptr, right.floatScalar, 1);
+            stack.push(RuntimeStackItem(result.floatScalar));
+        }
+        else {
+            VectorKernels::binaryInt(op, &result.intScalar, nullptr, left.intScalar, nullptr, right.intScalar, 1);
+            stack.push(RuntimeStackItem(result.intScalar));
+        }
+        return;
+    }
+    if (left.isVector && right.isVector && left.length != right.length) {
+        runtimeError("Vector length mismatch: " + std::to_string(left.length) + " and " + std::to_string(right.length) + ".");
+    }
+    size_t length = left.isVector ? left.length : right.length;
+    bool resultIsFloat = left.isFloat || right.isFloat;
+
+    // Указатели на данные операндов остаются действительными после выделения буфера результата:
+    // буфер результата либо новый, либо совпадает с освобожденным операндом той же длины.
+    const float* leftFloats = nullptr;
+    const float* rightFloats = nullptr;
+    if (resultIsFloat) {
+        if (left.isVector) leftFloats = promoteToFloat(left, conversionScratchLeft);
+        if (right.isVector) rightFloats = promoteToFloat(right, conversionScratchRight);
+    }
+
+    if (op == VectorKernelOp::DIV) {
+        bool hasZero;
+        if (resultIsFloat) {
+            hasZero = right.isVector ? VectorKernels::findZeroFloat(rightFloats, length) < length
+                : std::abs(right.floatScalar) < 1e-9;
+        }
+        else {
+            hasZero = right.isVector ? VectorKernels::findZeroInt(right.ints, length) < length
+                : right.intScalar == 0;
+        }
+        if (hasZero) runtimeError("Division by zero.");
+    }
+
+    releaseVectorOperands(left, right);
+    size_t slot = acquireVectorTemp(resultIsFloat, length);
+    VectorBuffer& result = vectorTemps[slot];
+
+    if (resultIsFloat) {
+        VectorKernels::binaryFloat(op, result.floats.data(), leftFloats, left.floatScalar, rightFloats, right.floatScalar, length);
+    }
+    else {
+        VectorKernels::binaryInt(op, result.ints.data(),
+            left.isVector ? left.ints : nullptr, left.intScalar,
+            right.isVector ? right.ints : nullptr, right.intScalar, length);
+    }
+    stack.push(RuntimeStackItem(VectorTempAddress{ slot }));
+}
+
+void Interpreter::executeVectorAssign() {
+    // На стеке: ... ArrayAddress(VarAddress) Value(вектор или скаляр)
+    VectorOperand source = popVectorOperand();
+    RuntimeStackItem targetItem = popStack();
+    if (targetItem.type != RuntimeStackItem::ItemType::VAR_ADDRESS) {
+        runtimeError("Internal: Expected array address for VEC_ASSIGN operation.");
+    }
+    size_t arrayIndex = std::get<VarAddress>(targetItem.value).table_index;
+    size_t length = symbolTable.getArrayDeclaredSize(arrayIndex).value_or(0);
+    size_t offset = 0;
+    if (vectorWindowLength) {
+        offset = vectorWindowOffset;
+        length = vectorWindowLength.value();
+    }
+
+    if (source.isVector && source.length != length) {
+        runtimeError("Vector length mismatch in assignment to '" + symbolTable.getSymbolName(arrayIndex) + "': " +
+            std::to_string(source.length) + " elements for array of size " + std::to_string(length) + ".");
+    }
+
+    if (int* dst = symbolTable.getArrayIntData(arrayIndex)) {
+        dst += offset;
+        if (!source.isVector) VectorKernels::fillInt(dst, source.intScalar, length);
+        else if (source.isFloat) VectorKernels::convertFloatToInt(dst, source.floats, length); // Усечение к меньшему, как CONVERT_TO_INT
+        else if (source.ints != dst) std::copy(source.ints, source.ints + length, dst);
+    }
+    else if (float* dst = symbolTable.getArrayFloatData(arrayIndex)) {
+        dst += offset;
+        if (!source.isVector) VectorKernels::fillFloat(dst, source.floatScalar, length);
+        else if (!source.isFloat) VectorKernels::convertIntToFloat(dst, source.ints, length);
+        else if (source.floats != dst) std::copy(source.floats, source.floats + length, dst);
+    }
+    else {
+        runtimeError("Internal: VEC_ASSIGN target '" + symbolTable.getSymbolName(arrayIndex) + "' is not an array.");
+    }
+    releaseVectorOperands(source, VectorOperand());
+}
+
+void Interpreter::executeVectorSum() {
+    VectorOperand source = popVectorOperand();
+    releaseVectorOperands(source, VectorOperand());
+    if (!source.isVector) { // sum от скаляра - сам скаляр
+        if (source.isFloat) stack.push(RuntimeStackItem(source.floatScalar));
+        else stack.push(RuntimeStackItem(source.intScalar));
+    }
+    else if (source.isFloat) {
+        stack.push(RuntimeStackItem(VectorKernels::sumFloat(source.floats, source.length)));
+    }
+    else {
+        stack.push(RuntimeStackItem(VectorKernels::sumInt(source.ints, source.length)));
+    }
+}
+
+std::optional<int> Interpreter::peekIntVariable(size_t index) const {
+    // Чтение без сообщений об ошибках: неинициализированная переменная - просто отказ от оптимизации
+    const SymbolInfo* info = symbolTable.getSymbolInfo(index);
+    if (!info || !std::holds_alternative<int>(info->value)) return std::nullopt;
+    return std::get<int>(info->value);
+}
+
+bool Interpreter::tryVectorLoop(const VectorLoopInfo& loop) {
+    // Все проверки выполняются до изменения состояния. Если векторное выполнение невозможно
+    // (неинициализированные переменные, выход за границы, лимит операций), работает обычный
+    // скалярный цикл - он и сообщит об ошибке на той же итерации и с тем же адресом ОПС.
+    std::optional<int> start = peekIntVariable(loop.inductionVarIndex);
+    std::optional<int> bound = loop.boundVarIndex ? peekIntVariable(loop.boundVarIndex.value()) : std::optional<int>(loop.boundConst);
+    if (!start || !bound || start.value() < 0 || start.value() >= bound.value()) return false;
+
+    for (size_t scalarIndex : loop.invariantScalars) {
+        const SymbolInfo* info = symbolTable.getSymbolInfo(scalarIndex);
+        if (!info || std::holds_alternative<std::monostate>(info->value)) return false;
+    }
+    for (const VectorLoopStatement& statement : loop.statements) {
+        if (statement.kind != VectorLoopStatement::Kind::ARRAY_STORE && !peekIntVariable(statement.targetIndex)) return false;
+    }
+
+    // Число итераций, в которых все обращения a[i] находятся в границах массивов
+    long long count = static_cast<long long>(bound.value()) - start.value();
+    for (size_t arrayIndex : loop.accessedArrays) {
+        long long size = static_cast<long long>(symbolTable.getArrayDeclaredSize(arrayIndex).value_or(0));
+        count = std::min(count, size - start.value());
+    }
+    // Скалярный цикл не смог бы выполнить больше итераций, чем позволяет лимит операций
+    long long budget = (static_cast<long long>(instructionLimit) - executedCounter) / loop.scalarOpsPerIteration;
+    count = std::min(count, budget);
+    if (count <= 0) return false;
+
+    vectorWindowOffset = static_cast<size_t>(start.value());
+    vectorWindowLength = static_cast<size_t>(count);
+    for (const VectorLoopStatement& statement : loop.statements) {
+        if (statement.kind == VectorLoopStatement::Kind::ARRAY_STORE) {
+            stack.push(RuntimeStackItem(VarAddress{ statement.targetIndex }));
+        }
+        for (const RPNOperation& op : statement.valueCode) {
+            switch (op.opCode) {
+            case RPNOpCode::PUSH_CONST_INT:   stack.push(RuntimeStackItem(std::get<int>(op.operandValue))); break;
+            case RPNOpCode::PUSH_CONST_FLOAT: stack.push(RuntimeStackItem(std::get<float>(op.operandValue))); break;
+            case RPNOpCode::PUSH_VAR_ADDR:
+            case RPNOpCode::PUSH_ARRAY_ADDR:  stack.push(RuntimeStackItem(VarAddress{ op.symbolIndex.value() })); break;
+            case RPNOpCode::VEC_ADD: executeVectorBinary(VectorKernelOp::ADD); break;
+            case RPNOpCode::VEC_SUB: executeVectorBinary(VectorKernelOp::SUB); break;
+            case RPNOpCode::VEC_MUL: executeVectorBinary(VectorKernelOp::MUL); break;
+            case RPNOpCode::VEC_DIV: executeVectorBinary(VectorKernelOp::DIV); break;
+            default:
+                runtimeError("Internal: Unsupported operation in vectorized loop body.");
+                break;
+            }
+        }
+        if (statement.kind == VectorLoopStatement::Kind::ARRAY_STORE) {
+            executeVectorAssign();
+        }
+        else {
+            executeVectorSum();
+            unsigned total = static_cast<unsigned>(popInt());
+            unsigned accumulator = static_cast<unsigned>(peekIntVariable(statement.targetIndex).value());
+            accumulator = (statement.kind == VectorLoopStatement::Kind::SUM_ADD) ? accumulator + total : accumulator - total;
+            symbolTable.setVariableValue(statement.targetIndex, StoredValue(static_cast<int>(accumulator)), &errorHandler);
+        }
+    }
+    vectorWindowLength.reset();
+
+    // Счетчик как после count скалярных итераций (операция заголовка текущей итерации уже учтена)
+    executedCounter += static_cast<int>(count * loop.scalarOpsPerIteration - 1);
+    if (!opcodeCounts.empty()) {
+        // Тело векторизованного цикла без ветвлений: каждая операция заголовка, тела и обратного перехода - count раз
+        for (int address = loop.headerAddress; address < loop.headerAddress + loop.scalarOpsPerIteration; ++address) {
+            opcodeCounts[static_cast<size_t>(rpnCode[address].opCode)] += static_cast<std::uint64_t>(count);
+        }
+        opcodeCounts[static_cast<size_t>(rpnCode[loop.headerAddress].opCode)]--;
+    }
+    symbolTable.setVariableValue(loop.inductionVarIndex, StoredValue(start.value() + static_cast<int>(count)), &errorHandler);
+    // Возврат на заголовок: условие либо завершит цикл, либо оставшиеся итерации выполнятся скалярно
+    instructionPointer = loop.headerAddress;
+    return true;
+}
+
+bool Interpreter::executeParallelLoop(const ParallelLoopInfo& loop) {
+    // Как и в tryVectorLoop, при неинициализированных переменных цикл выполняется последовательно,
+    // чтобы ошибка была выдана обычным образом
+    std::optional<int> start = peekIntVariable(loop.inductionVarIndex);
+    std::optional<int> bound = loop.boundVarIndex ? peekIntVariable(loop.boundVarIndex.value()) : std::optional<int>(loop.boundConst);
+    if (!start || !bound || start.value() >= bound.value()) return false;
+    if (loop.automatic) {
+        long long work = (static_cast<long long>(bound.value()) - start.value()) * (loop.backJumpAddress - loop.headerAddress + 1);
+        if (threadCount < 2 || work < AUTO_PARALLEL_MIN_WORK) return false;
+        // Вблизи лимита выполнения цикл выполняется последовательно, чтобы ошибка была выдана там же, где и без распараллеливания
+        if (executedCounter + work > instructionLimit) return false;
+    }
+    for (const ParallelReduction& reduction : loop.reductions) {
+        const SymbolInfo* info = symbolTable.getSymbolInfo(reduction.varIndex);
+        if (!info || std::holds_alternative<std::monostate>(info->value)) return false;
+    }
+
+    if (!threadPool) {
+        threadPool = std::make_unique<WorkStealingPool>(threadCount);
+    }
+    const long long first = start.value();
+    const long long total = static_cast<long long>(bound.value()) - first;
+    // Несколько кусков на поток, чтобы перехват работы выравнивал неравномерную нагрузку
+    const size_t chunkCount = static_cast<size_t>(std::min<long long>(total, static_cast<long long>(threadPool->getThreadCount()) * 8));
+
+    // Начальное состояние приватных переменных (одинаковое для всех кусков)
+    std::vector<char> mask(symbolTable.getTableSize(), 0);
+    std::vector<StoredValue> initialValues(symbolTable.getTableSize());
+    auto makePrivate = [&](size_t index) {
+        mask[index] = 1;
+        initialValues[index] = symbolTable.getSymbolInfo(index)->value;
+    };
+    makePrivate(loop.inductionVarIndex);
+    for (size_t index : loop.privateScalars) makePrivate(index);
+    for (const ParallelReduction& reduction : loop.reductions) {
+        makePrivate(reduction.varIndex);
+        bool isFloat = symbolTable.getSymbolType(reduction.varIndex) == SymbolType::VARIABLE_FLOAT;
+        StoredValue identity;
+        switch (reduction.kind) {
+        case ParallelReduction::Kind::SUM:
+            identity = isFloat ? StoredValue(0.0f) : StoredValue(0);
+            break;
+        case ParallelReduction::Kind::MIN:
+            identity = isFloat ? StoredValue(std::numeric_limits<float>::infinity()) : StoredValue(std::numeric_limits<int>::max());
+            break;
+        case ParallelReduction::Kind::MAX:
+            identity = isFloat ? StoredValue(-std::numeric_limits<float>::infinity()) : StoredValue(std::numeric_limits<int>::min());
+            break;
+        }
+        initialValues[reduction.varIndex] = identity;
+    }
+
+    struct ChunkResult {
+        std::vector<StoredValue> values; // Приватные значения после последней итерации куска
+        std::vector<char> written;       // Каким приватным переменным присваивалось в куске
+        std::vector<std::uint64_t> opcodeCounts; // Выполнения тела по кодам операций (если они считаются)
+        long long from = 0;
+        std::optional<long long> failedIteration;
+        std::vector<ErrorInfo> errors; // Сообщения куска (включая предупреждения) в порядке выдачи
+        int executed = 0;
+    };
+    std::vector<ChunkResult> results(chunkCount);
+    std::atomic<long long> firstFailure(std::numeric_limits<long long>::max());
+
+    threadPool->run(chunkCount, [&](size_t chunk, size_t) {
+        long long from = first + total * static_cast<long long>(chunk) / static_cast<long long>(chunkCount);
+        long long to = first + total * static_cast<long long>(chunk + 1) / static_cast<long long>(chunkCount);
+        results[chunk].from = from;
+        if (from >= firstFailure.load()) return; // Итерации после ошибки все равно не выполнялись бы
+
+        ErrorHandler localErrors;
+        Interpreter worker(rpnCode, symbolTable, localErrors);
+        worker.isParallelWorker = true;
+        worker.sourceLocations = sourceLocations;
+        worker.privateMask = mask;
+        worker.privateValues = initialValues;
+        worker.privateWritten.assign(mask.size(), 0);
+        if (!opcodeCounts.empty()) worker.setOpcodeCounting(true);
+        worker.instructionLimit = instructionLimit;
+        worker.executedCounter = executedCounter; // Лимит выполнения считается от уже выполненных операций
+
+        ChunkResult& result = results[chunk];
+        for (long long iteration = from; iteration < to; ++iteration) {
+            worker.privateValues[loop.inductionVarIndex] = StoredValue(static_cast<int>(iteration));
+            if (!worker.executeRange(loop.bodyStart, loop.backJumpAddress)) {
+                result.failedIteration = iteration;
+                long long known = firstFailure.load();
+                while (iteration < known && !firstFailure.compare_exchange_weak(known, iteration)) {}
+                break;
+            }
+        }
+        result.errors = localErrors.getErrors();
+        result.values = std::move(worker.privateValues);
+        result.written = std::move(worker.privateWritten);
+        result.opcodeCounts = std::move(worker.opcodeCounts);
+        result.executed = worker.executedCounter - executedCounter;
+    });
+
+    // Сообщения переносятся в основной ErrorHandler в порядке итераций. Куски, начинающиеся
+    // после первой ошибки, при последовательном выполнении не выполнялись бы.
+    const long long failedAt = firstFailure.load();
+    for (const ChunkResult& result : results) {
+        if (result.from > failedAt) break;
+        for (const ErrorInfo& error : result.errors) errorHandler.logRuntimeError(error.message, error.line, error.column);
+        if (result.failedIteration) {
+            throw std::runtime_error("Fatal runtime error occurred.");
+        }
+    }
+
+    // Объединение редукций в порядке кусков (результат не зависит от планирования потоков)
+    for (const ParallelReduction& reduction : loop.reductions) {
+        StoredValue accumulator = symbolTable.getSymbolInfo(reduction.varIndex)->value;
+        for (const ChunkResult& result : results) {
+            const StoredValue& partial = result.values[reduction.varIndex];
+            if (std::holds_alternative<int>(accumulator)) {
+                int a = std::get<int>(accumulator);
+                int b = std::holds_alternative<int>(partial) ? std::get<int>(partial) : static_cast<int>(std::get<float>(partial));
+                if (reduction.kind == ParallelReduction::Kind::SUM) a = static_cast<int>(static_cast<unsigned>(a) + static_cast<unsigned>(b));
+                else if (reduction.kind == ParallelReduction::Kind::MIN) a = std::min(a, b);
+                else a = std::max(a, b);
+                accumulator = a;
+            }
+            else {
+                float a = std::get<float>(accumulator);
+                float b = std::holds_alternative<float>(partial) ? std::get<float>(partial) : static_cast<float>(std::get<int>(partial));
+                if (reduction.kind == ParallelReduction::Kind::SUM) a = a + b;
+                else if (reduction.kind == ParallelReduction::Kind::MIN) a = std::min(a, b);
+                else a = std::max(a, b);
+                accumulator = a;
+            }
+        }
+        symbolTable.setVariableValue(reduction.varIndex, accumulator, &errorHandler);
+    }
+    // Остальные приватные переменные - значение из последнего куска, где им присваивалось
+    // (присваивание может быть условным, и в последнем куске его могло не быть)
+    for (size_t index : loop.privateScalars) {
+        for (std::vector<ChunkResult>::const_reverse_iterator result = results.rbegin(); result != results.rend(); ++result) {
+            if (result->written.empty() || !result->written[index]) continue;
+            symbolTable.setVariableValue(index, result->values[index], &errorHandler);
+            break;
+        }
+    }
+    symbolTable.setVariableValue(loop.inductionVarIndex, StoredValue(bound.value()), &errorHandler);
+
+    // Счетчик выполнения - как при последовательном цикле: тело, плюс условие и JUMP на каждой итерации
+    // и последняя проверка условия (первая операция заголовка автоматического цикла уже учтена)
+    for (const ChunkResult& result : results) executedCounter += result.executed;
+    int headerOps = loop.bodyStart - loop.headerAddress;
+    executedCounter += static_cast<int>(total * (headerOps + 1) + headerOps - (loop.automatic ? 1 : 0));
+    if (!opcodeCounts.empty()) {
+        for (const ChunkResult& result : results) {
+            for (size_t op = 0; op < result.opcodeCounts.size(); ++op) opcodeCounts[op] += result.opcodeCounts[op];
+        }
+        for (int address = loop.headerAddress; address < loop.bodyStart; ++address) {
+            opcodeCounts[static_cast<size_t>(rpnCode[address].opCode)] += static_cast<std::uint64_t>(total + 1);
+        }
+        if (loop.automatic) opcodeCounts[static_cast<size_t>(rpnCode[loop.headerAddress].opCode)]--;
+        opcodeCounts[static_cast<size_t>(rpnCode[loop.backJumpAddress].opCode)] += static_cast<std::uint64_t>(total);
+    }
+    instructionPointer = loop.exitAddress;
+    return true;
+}
+
+// Метод execute() будет в следующей части
+// interpreter.cpp (Продолжение)
+// ... (код RuntimeStack, конструктор Interpreter, вспомогательные методы из Части 1) ...
 
 void Interpreter::execute() {
-    instructionPointer = 0;
-    stack.clear(); //     
+    stack.clear(); // Очищаем стек перед новым запуском
+    vectorTempDepth = 0; // Буферы векторных временных значений сохраняются для переиспользования
+    vectorWindowLength.reset();
 
-    //      (   )
-    const int MAX_EXECUTED_INSTRUCTIONS = 10000000; // 10  
-    int executedCounter = 0;
+    executedCounter = 0;
+    profiledAddress = -1;
+    executeRange(0, -1);
+    finishProfiledOperation(); // Последняя выполненная операция
+    profiledAddress = -1;
+    if (sampledAddress) *sampledAddress = -1;
+}
 
-    try { //   try-catch   runtimeError   
-        while (instructionPointer >= 0 && static_cast<size_t>(instructionPointer) < rpnCode.size()) {
-            if (executedCounter++ > MAX_EXECUTED_INSTRUCTIONS) {
+void Interpreter::setOpcodeCounting(bool enabled) {
+    if (enabled) opcodeCounts.assign(static_cast<size_t>(RPNOpCode::PARALLEL_LOOP) + 1, 0);
+    else opcodeCounts.clear();
+    updateInstrumentation();
+}
+
+void Interpreter::recordInstrumentation() {
+    if (profiler) finishProfiledOperation();
+    if (sampledAddress) *sampledAddress = instructionPointer;
+    if (!opcodeCounts.empty()) opcodeCounts[static_cast<size_t>(rpnCode[instructionPointer].opCode)]++;
+}
+
+void Interpreter::finishProfiledOperation() {
+    if (!profiler) return;
+    std::uint64_t now = readCycleCounter();
+    if (profiledAddress >= 0) profiler->record(profiledAddress, now - profiledStart);
+    profiledAddress = instructionPointer;
+    profiledStart = now;
+}
+
+bool Interpreter::executeRange(int startAddress, int stopAddress) {
+    instructionPointer = startAddress;
+
+    try { // Основной блок try-catch для перехвата runtimeError и других исключений
+        while (instructionPointer >= 0 && static_cast<size_t>(instructionPointer) < rpnCode.size() &&
+            instructionPointer != stopAddress) {
+            if (executedCounter++ > instructionLimit) {
                 runtimeError("Maximum instruction execution limit reached. Possible infinite loop.");
-                // runtimeError  ,   
+                // runtimeError бросит исключение, которое прервет цикл
             }
+            if (instrumented) recordInstrumentation();
 
             const RPNOperation& currentOp = rpnCode[instructionPointer];
-            instructionPointer++; //   ,    
+            instructionPointer++; // Инкрементируем до выполнения, чтобы переходы работали корректно
 
             switch (currentOp.opCode) {
-                // ---  ---
+                // --- Операнды ---
             case RPNOpCode::PUSH_CONST_INT:
                 if (!std::holds_alternative<int>(currentOp.operandValue)) {
                     runtimeError("Internal: PUSH_CONST_INT expects an int operand value.");
@@ -234,6 +752,15 @@ void Interpreter::execute() {
                 if (!currentOp.symbolIndex.has_value()) {
                     runtimeError("Internal: PUSH_VAR_ADDR missing symbol index.");
                 }
+                // Заголовок автоматически распараллеленного цикла
+                if (currentOp.parallelInfoIndex && !isParallelWorker && parallelLoops &&
+                    executeParallelLoop((*parallelLoops)[currentOp.parallelInfoIndex.value()])) {
+                    break;
+                }
+                // Заголовок векторизованного цикла: безопасная часть итераций выполняется за один проход
+                if (currentOp.loopInfoIndex && vectorLoops && tryVectorLoop((*vectorLoops)[currentOp.loopInfoIndex.value()])) {
+                    break;
+                }
                 stack.push(RuntimeStackItem(VarAddress{ currentOp.symbolIndex.value() }));
                 break;
 
@@ -241,40 +768,40 @@ void Interpreter::execute() {
                 if (!currentOp.symbolIndex.has_value()) {
                     runtimeError("Internal: PUSH_ARRAY_ADDR missing symbol index.");
                 }
-                //     **  (   ).
-                //       ArrayElementAddress     runtime_index,
-                //     INDEX.
-                //      VarAddress, ..     symbolTable.
-                //  INDEX        .
+                // На стек кладется адрес *базы* массива (индекс в таблице символов).
+                // Для работы с ним как с ArrayElementAddress ему нужен еще и runtime_index,
+                // который будет вычислен операцией INDEX.
+                // Поэтому здесь мы также используем VarAddress, т.к. это просто индекс в symbolTable.
+                // Операция INDEX затем возьмет этот базовый адрес и индекс элемента.
                 stack.push(RuntimeStackItem(VarAddress{ currentOp.symbolIndex.value() }));
                 break;
 
-                // ---   ---
+                // --- Арифметические операции ---
             case RPNOpCode::ADD: {
-                //    float, .. float "" int
+                // Операнды извлекаются как float, т.к. float "старше" int
                 // float right = popFloat();
                 // float left = popFloat();
-                //     int,    int.
-                //     float,  float.
-                // popFloat    int->float,  .
-                //   ,     int.
-                //   ,      ,
-                //  popFloat()   .
-                // :    float-  ,    int.
-                //      (1.0 + 2.0 = 3.0,   float 3.0,     float)
-                // :       float,  float.
-                // popFloat()  float.     int,   float.
-                // ,        float,  float.
-                //            popFloat.
-                // :     float,  ,
-                //  CONVERT_TO_INT    .
-                // ,      :
-                // RuntimeStackItem item_right = stack.pop(); //    ,   
-                // RuntimeStackItem item_left = stack.pop();   // (  peek)
-                //    :       (float).
-                //       int ( popFloat),      int.
-
-                //  :   StoredValue,    
+                // Если оба исходных были int, результат должен быть int.
+                // Если хотя бы один float, результат float.
+                // popFloat уже сделал преобразование int->float, если нужно.
+                // Теперь нужно определить, был ли результат изначально int.
+                // Это можно сделать, проверив типы исходных элементов на стеке,
+                // но popFloat() их уже потребил.
+                // Проще: если результат сложения float-чисел является целым, то храним как int.
+                // Но это не всегда корректно (1.0 + 2.0 = 3.0, должно быть float 3.0, если хоть один был float)
+                // Правило: если хотя бы один операнд был float, результат float.
+                // popFloat() вернул float. Если он был из int, он стал float.
+                // Значит, если хоть один из них изначально был float, результат float.
+                // Мы не можем это узнать напрямую здесь без анализа типов до popFloat.
+                // Решение: интерпретатор выполняет операции во float, если возможно,
+                // а CONVERT_TO_INT используется для явного приведения.
+                // Или, если язык требует сохранения целочисленной арифметики:
+                // RuntimeStackItem item_right = stack.pop(); // Нужно было бы заглянуть, а не извлечь
+                // RuntimeStackItem item_left = stack.pop();   // (Сложно без peek)
+                // Откатимся к простому варианту: операции выполняются над наиболее общим типом (float).
+                // Если оба операнда на стеке были int (до popFloat), то и результат должен быть int.
+
+                // Пересмотренный подход: извлекаем как StoredValue, затем работаем с типами
                 StoredValue val_right = getValueFromStackItem(popStack());
                 StoredValue val_left = getValueFromStackItem(popStack());
 
@@ -327,21 +854,21 @@ void Interpreter::execute() {
                 StoredValue val_right = getValueFromStackItem(popStack());
                 StoredValue val_left = getValueFromStackItem(popStack());
 
-                //     float,      int/int,
-                //       (, 5/2 = 2.5,   2).
-                //   ,    .
-                // ,  /   float,      float,   int/int  .
-                //  :   int,   int.    float,   float.
+                // Деление всегда производим во float, чтобы избежать потери точности при int/int,
+                // если язык этого не требует строго (например, 5/2 = 2.5, а не 2).
+                // Если строго целочисленное, то нужна другая логика.
+                // Предположим, что / всегда дает float, если хотя бы один операнд float, или если int/int дает дробное.
+                // Для простоты: если оба int, делим как int. Если хоть один float, делим как float.
                 if (std::holds_alternative<float>(val_left) || std::holds_alternative<float>(val_right)) {
                     float f_left = std::holds_alternative<int>(val_left) ? static_cast<float>(std::get<int>(val_left)) : std::get<float>(val_left);
                     float f_right = std::holds_alternative<int>(val_right) ? static_cast<float>(std::get<int>(val_right)) : std::get<float>(val_right);
-                    if (std::abs(f_right) < 1e-9) runtimeError("Division by zero."); //  float  
+                    if (std::abs(f_right) < 1e-9) runtimeError("Division by zero."); // Сравнение float с нулем
                     stack.push(RuntimeStackItem(f_left / f_right));
                 }
                 else if (std::holds_alternative<int>(val_left) && std::holds_alternative<int>(val_right)) {
                     int i_right = std::get<int>(val_right);
                     if (i_right == 0) runtimeError("Division by zero.");
-                    //  
+                    // Целочисленное деление
                     stack.push(RuntimeStackItem(std::get<int>(val_left) / i_right));
                 }
                 else {
@@ -350,8 +877,8 @@ void Interpreter::execute() {
                 break;
             }
 
-                               // ---   ---
-                               //   -  int (0  false, 1  true)
+                               // --- Операции сравнения ---
+                               // Результат сравнения - всегда int (0 для false, 1 для true)
             case RPNOpCode::CMP_EQ:
             case RPNOpCode::CMP_NE:
             case RPNOpCode::CMP_GT:
@@ -363,9 +890,9 @@ void Interpreter::execute() {
                 if (std::holds_alternative<float>(val_left) || std::holds_alternative<float>(val_right)) {
                     float f_left = std::holds_alternative<int>(val_left) ? static_cast<float>(std::get<int>(val_left)) : std::get<float>(val_left);
                     float f_right = std::holds_alternative<int>(val_right) ? static_cast<float>(std::get<int>(val_right)) : std::get<float>(val_right);
-                    //  float    /   
-                    //       .
-                    if (currentOp.opCode == RPNOpCode::CMP_EQ) result = (std::abs(f_left - f_right) < 1e-9); //  float  epsilon
+                    // Для float сравнение на точное равенство/неравенство может быть проблематичным
+                    // но для учебного проекта прямое сравнение допустимо.
+                    if (currentOp.opCode == RPNOpCode::CMP_EQ) result = (std::abs(f_left - f_right) < 1e-9); // Сравнение float с epsilon
                     else if (currentOp.opCode == RPNOpCode::CMP_NE) result = (std::abs(f_left - f_right) >= 1e-9);
                     else if (currentOp.opCode == RPNOpCode::CMP_GT) result = (f_left > f_right);
                     else if (currentOp.opCode == RPNOpCode::CMP_LT) result = (f_left < f_right);
@@ -385,51 +912,51 @@ void Interpreter::execute() {
                 break;
             }
 
-                                  // ---   ---
+                                  // --- Операция присваивания ---
             case RPNOpCode::ASSIGN: {
-                //  : ... Address ValueToAssign
-                //    ,  ValueToAssign    ( )
-                StoredValue valueToAssign = getValueFromStackItem(popStack()); // 
-                RuntimeStackItem addressItem = popStack(); //  (   )
+                // На стеке: ... Address ValueToAssign
+                // Парсер должен был обеспечить, что ValueToAssign уже нужного типа (или конвертирован)
+                StoredValue valueToAssign = getValueFromStackItem(popStack()); // Значение
+                RuntimeStackItem addressItem = popStack(); // Адрес (переменная или элемент массива)
                 setValueAtStackItemAddress(addressItem, valueToAssign);
                 break;
             }
 
-                                  // ---    ---
+                                  // --- Операция индексации массива ---
             case RPNOpCode::INDEX: {
-                //  : ... ArrayBaseAddress(VarAddress) IndexValue(int)
-                int elementRuntimeIndex = popInt(); //  
-                RuntimeStackItem arrayBaseAddrItem = popStack(); //    ( VarAddress)
+                // На стеке: ... ArrayBaseAddress(VarAddress) IndexValue(int)
+                int elementRuntimeIndex = popInt(); // Индекс элемента
+                RuntimeStackItem arrayBaseAddrItem = popStack(); // Базовый адрес массива (как VarAddress)
 
                 if (arrayBaseAddrItem.type != RuntimeStackItem::ItemType::VAR_ADDRESS) {
                     runtimeError("Internal: Expected array base address (as VarAddress) for INDEX operation.");
                 }
                 size_t arrayTableIndex = std::get<VarAddress>(arrayBaseAddrItem.value).table_index;
 
-                //     (  )
+                // Проверка на отрицательный индекс (парсером или здесь)
                 if (elementRuntimeIndex < 0) {
                     runtimeError("Array index cannot be negative: " +
                         symbolTable.getSymbolName(arrayTableIndex) + "[" + std::to_string(elementRuntimeIndex) + "].");
                 }
-                //         symbolTable.get/setArrayElementValue
+                // Проверка на выход за верхнюю границу делается в symbolTable.get/setArrayElementValue
 
                 stack.push(RuntimeStackItem(ArrayElementAddress{ arrayTableIndex, elementRuntimeIndex }));
                 break;
             }
 
-                                 // --- / ---
+                                 // --- Ввод/Вывод ---
             case RPNOpCode::READ_INT: {
-                RuntimeStackItem addressItem = popStack(); // ,  
+                RuntimeStackItem addressItem = popStack(); // Адрес, куда читать
                 int valueRead;
                 std::cout << "? int > ";
                 std::cin >> valueRead;
                 if (std::cin.fail()) {
-                    std::cin.clear(); //   
-                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); //  
+                    std::cin.clear(); // Сброс флагов ошибок
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Очистка буфера
                     runtimeError("Invalid input. Integer expected for READ_INT.");
                 }
                 else {
-                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); //   
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Очистка остатка буфера
                 }
                 setValueAtStackItemAddress(addressItem, StoredValue(valueRead));
                 break;
@@ -457,13 +984,13 @@ void Interpreter::execute() {
             }
             case RPNOpCode::WRITE_FLOAT: {
                 float valueToWrite = popFloat();
-                //  float   
+                // Вывод float с некоторой точностью
                 std::cout << std::fixed << std::setw(6) << valueToWrite << std::endl;
-                std::cout.unsetf(std::ios_base::floatfield); //   fixed   
+                std::cout.unsetf(std::ios_base::floatfield); // Сброс флага fixed для последующих выводов
                 break;
             }
 
-                                       // ---  ---
+                                       // --- Переходы ---
             case RPNOpCode::JUMP:
                 if (!currentOp.jumpTarget.has_value() || currentOp.jumpTarget.value() < 0) {
                     runtimeError("Internal: JUMP target address not set or invalid.");
@@ -472,69 +999,86 @@ void Interpreter::execute() {
                 break;
 
             case RPNOpCode::JUMP_FALSE: {
-                int condition = popInt(); //   (0  1)
+                int condition = popInt(); // Результат условия (0 или 1)
                 if (!currentOp.jumpTarget.has_value() || currentOp.jumpTarget.value() < 0) {
                     runtimeError("Internal: JUMP_FALSE target address not set or invalid.");
                 }
-                if (condition == 0) { //   
+                if (condition == 0) { // Если условие ложно
                     instructionPointer = currentOp.jumpTarget.value();
                 }
-                //  , IP      
+                // Если истинно, IP уже инкрементирован и переход не выполняется
                 break;
             }
 
-                                      // ---   ---
+                                      // --- Преобразование типов ---
             case RPNOpCode::CONVERT_TO_FLOAT: {
-                int intVal = popInt(); //   int (   float,  )
-                // :  StoredValue,  ,  
+                int intVal = popInt(); // Извлекаем как int (если там был float, он усечется)
+                // Правильнее: извлечь StoredValue, проверить тип, потом конвертировать
 // RuntimeStackItem item = popStack();
 // if (item.type == RuntimeStackItem::ItemType::INT_VALUE) {
 //    stack.push(RuntimeStackItem(static_cast<float>(std::get<int>(item.value))));
 // } else if (item.type == RuntimeStackItem::ItemType::FLOAT_VALUE) {
-//    stack.push(item); //  float,   
+//    stack.push(item); // Уже float, ничего не делаем
 // } else { runtimeError("CONVERT_TO_FLOAT expects a numeric value on stack."); }
                 stack.push(RuntimeStackItem(static_cast<float>(intVal)));
                 break;
             }
             case RPNOpCode::CONVERT_TO_INT: {
-                float floatVal = popFloat(); //   float (   int,  )
+                float floatVal = popFloat(); // Извлекаем как float (если там был int, он повысится)
                 // RuntimeStackItem item = popStack();
                 // if (item.type == RuntimeStackItem::ItemType::FLOAT_VALUE) {
                 //    stack.push(RuntimeStackItem(static_cast<int>(std::floor(std::get<float>(item.value)))));
                 // } else if (item.type == RuntimeStackItem::ItemType::INT_VALUE) {
-                //    stack.push(item); //  int
+                //    stack.push(item); // Уже int
                 // } else { runtimeError("CONVERT_TO_INT expects a numeric value on stack."); }
-                stack.push(RuntimeStackItem(static_cast<int>(std::floor(floatVal)))); // 
+                stack.push(RuntimeStackItem(static_cast<int>(std::floor(floatVal)))); // Усечение
                 break;
             }
 
+                                    // --- Векторные операции ---
+            case RPNOpCode::VEC_ADD: executeVectorBinary(VectorKernelOp::ADD); break;
+            case RPNOpCode::VEC_SUB: executeVectorBinary(VectorKernelOp::SUB); break;
+            case RPNOpCode::VEC_MUL: executeVectorBinary(VectorKernelOp::MUL); break;
+            case RPNOpCode::VEC_DIV: executeVectorBinary(VectorKernelOp::DIV); break;
+            case RPNOpCode::VEC_ASSIGN: executeVectorAssign(); break;
+            case RPNOpCode::VEC_SUM: executeVectorSum(); break;
+
+                                    // --- Параллельный цикл ---
+            case RPNOpCode::PARALLEL_LOOP:
+                // В рабочем потоке вложенный параллельный цикл выполняется последовательно
+                if (!isParallelWorker && parallelLoops) {
+                    executeParallelLoop((*parallelLoops)[static_cast<size_t>(std::get<int>(currentOp.operandValue))]);
+                }
+                break;
+
             default:
                 runtimeError("Unknown RPN operation code encountered: " + std::to_string(static_cast<int>(currentOp.opCode)));
                 break;
             }
-        } //  try
+        } // Конец try
     }
     catch (const std::runtime_error& e) {
-        // ,   runtimeError   ,    .
-        //     .
-        //      ErrorHandler' (, std::bad_alloc),  .
-        if (!errorHandler.hasErrors()) { //   ,  
+        // Ошибки, перехваченные из runtimeError или методов стека, уже должны быть залогированы.
+        // Здесь мы просто прекращаем выполнение.
+        // Если ошибка не была залогирована ErrorHandler'ом (например, std::bad_alloc), логируем здесь.
+        if (!errorHandler.hasErrors()) { // Если это новое, незалогированное исключение
             errorHandler.logRuntimeError("Unhandled std::runtime_error: " + std::string(e.what()));
         }
-        //   -  .
-        return;
+        // Выполнение прекращается из-за брошенного исключения.
+        return false;
     }
-    catch (const std::exception& e) { //   
+    catch (const std::exception& e) { // Другие стандартные исключения
         errorHandler.logRuntimeError("Unhandled std::exception: " + std::string(e.what()));
-        return;
+        return false;
     }
-    catch (...) { //  
+    catch (...) { // Все остальное
         errorHandler.logRuntimeError("Unknown unhandled exception during execution.");
-        return;
+        return false;
     }
 
-    //   ""    (,       )
+    // Проверка на "непустой" стек в конце (опционально, может указывать на логические ошибки в ОПС)
     // if (!stack.isEmpty() && !errorHandler.hasErrors()) {
     //     errorHandler.logRuntimeError("Warning: Stack is not empty at the end of execution. Size: " + std::to_string(stack.size()));
     // }
+    return true;
 }
\ No newline at end of file
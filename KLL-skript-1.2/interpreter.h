@@ -7,26 +7,39 @@
 #include <stack>
 #include <variant>
 #include <optional>
-#include <stdexcept> //  std::get  
+#include <stdexcept> // Для std::get и исключений
+#include <memory>    // Для std::unique_ptr (пул потоков)
 
 #include "definitions.h"    // RPNOpCode, SymbolType
-#include "rpn_op.h"         //  RPNOperation
-#include "symbol_table.h"   // SymbolTable, StoredValue ( )
+#include "rpn_op.h"         // Структура RPNOperation
+#include "symbol_table.h"   // SymbolTable, StoredValue (для значений)
 #include "error_handler.h"  // ErrorHandler
-
-// ---     ---
-//     (int, float)   (   )
-//    .
-
-//       
+#include "vector_kernels.h" // SIMD-ядра для векторных операций
+#include "loop_vectorizer.h" // VectorLoopInfo
+#include "parallel_loop.h"   // ParallelLoopInfo
+#include "thread_pool.h"     // WorkStealingPool
+#include "profiler.h"        // ExecutionProfiler
+#include "source_location.h" // SourceLocationTable
+#include "sampling_profiler.h" // SamplingProfiler
+
+// --- Элемент стека времени выполнения ---
+// Может хранить непосредственное значение (int, float) или адрес (индекс в таблице символов)
+// или адрес элемента массива.
+
+// Структура для адреса переменной в таблице символов
 struct VarAddress {
     size_t table_index;
 };
 
-//     
+// Структура для адреса элемента массива
 struct ArrayElementAddress {
-    size_t array_table_index; //      
-    int element_runtime_index;  //      
+    size_t array_table_index; // Индекс самого массива в таблице символов
+    int element_runtime_index;  // Вычисленный во время выполнения индекс элемента
+};
+
+// Структура для промежуточного результата векторной операции (номер буфера интерпретатора)
+struct VectorTempAddress {
+    size_t slot;
 };
 
 
@@ -34,25 +47,28 @@ struct RuntimeStackItem {
     enum class ItemType {
         INT_VALUE,
         FLOAT_VALUE,
-        VAR_ADDRESS,         //   
-        ARRAY_ELEMENT_ADDRESS //    
+        VAR_ADDRESS,         // Адрес простой переменной
+        ARRAY_ELEMENT_ADDRESS, // Адрес конкретного элемента массива
+        VECTOR_TEMP          // Промежуточный результат векторной операции
     } type;
 
-    std::variant<int, float, VarAddress, ArrayElementAddress> value;
+    std::variant<int, float, VarAddress, ArrayElementAddress, VectorTempAddress> value;
 
-    // 
+    // Конструкторы
     RuntimeStackItem(int val) : type(ItemType::INT_VALUE), value(val) {}
     RuntimeStackItem(float val) : type(ItemType::FLOAT_VALUE), value(val) {}
     RuntimeStackItem(VarAddress addr) : type(ItemType::VAR_ADDRESS), value(addr) {}
     RuntimeStackItem(ArrayElementAddress arrAddr) : type(ItemType::ARRAY_ELEMENT_ADDRESS), value(arrAddr) {}
+    RuntimeStackItem(VectorTempAddress tempAddr) : type(ItemType::VECTOR_TEMP), value(tempAddr) {}
 };
 
 
-// ---    ---
+// --- Класс Стека Интерпретатора ---
 class RuntimeStack {
 private:
     std::stack<RuntimeStackItem> stck;
-    static const size_t MAX_STACK_SIZE = 1000; //    
+    static const size_t MAX_STACK_SIZE = 1000; // Ограничение на глубину стека
+    size_t highWater = 0; // Наибольшая глубина с последнего clear()
 
 public:
     RuntimeStack() = default;
@@ -61,40 +77,160 @@ public:
     RuntimeStackItem pop();
     bool isEmpty() const;
     size_t size() const;
-    void clear(); //      ( )
+    size_t getHighWater() const { return highWater; }
+    void clear(); // Для сброса состояния между запусками (если нужно)
 };
 
 
-// ---    ---
-class Interpreter {
-private:
-    const std::vector<RPNOperation>& rpnCode; //    
-    SymbolTable& symbolTable;                 //    
-    ErrorHandler& errorHandler;               //    
+// --- Буфер для промежуточных результатов векторных операций ---
+struct VectorBuffer {
+    bool isFloat = false;
+    size_t length = 0;
+    std::vector<int> ints;
+    std::vector<float> floats;
+};
 
-    RuntimeStack stack;                       //   
-    int instructionPointer;                   //      (  rpnCode)
+// Операнд векторной операции: массив, временный буфер или скаляр (размножается на всю длину)
+struct VectorOperand {
+    bool isVector = false;
+    bool isFloat = false;
+    size_t length = 0;
+    const int* ints = nullptr;     // Данные, если isVector && !isFloat
+    const float* floats = nullptr; // Данные, если isVector && isFloat
+    int intScalar = 0;
+    float floatScalar = 0.0f;
+    std::optional<size_t> tempSlot; // Номер освобождаемого буфера, если операнд - временный результат
+};
 
-    // ---         ---
-    void runtimeError(const std::string& message); //     
 
-    //   
-    RuntimeStackItem popStack(); //  pop
-    int popInt();         //  int   float
-    float popFloat();       //  float   int
+// --- Класс Интерпретатора ОПС ---
+class Interpreter {
+private:
+    const std::vector<RPNOperation>& rpnCode; // Ссылка на код ОПС
+    SymbolTable& symbolTable;                 // Ссылка на таблицу символов
+    ErrorHandler& errorHandler;               // Ссылка на обработчик ошибок
+
+    RuntimeStack stack;                       // Стек времени выполнения
+    int instructionPointer;                   // Указатель на текущую инструкцию ОПС (адрес в rpnCode)
+    const std::vector<VectorLoopInfo>* vectorLoops; // Описатели векторизованных циклов (может быть nullptr)
+    const std::vector<ParallelLoopInfo>* parallelLoops; // Описатели параллельных циклов (может быть nullptr)
+
+    // Защита от слишком длинного выполнения (бесконечного цикла в ОПС)
+    static const int MAX_EXECUTED_INSTRUCTIONS = 10000000;
+    int instructionLimit; // По умолчанию MAX_EXECUTED_INSTRUCTIONS
+    // Минимальный объем работы (итерации * операции ОПС тела) для параллельного выполнения
+    // автоматически распараллеленного цикла
+    static const long long AUTO_PARALLEL_MIN_WORK = 200000; // 10 миллионов операций
+    int executedCounter;
+
+    // Буферы промежуточных результатов векторных выражений.
+    // Выделяются по принципу стека (LIFO) и переиспользуются между операторами,
+    // поэтому после первой итерации цикла векторные операции не выделяют память.
+    std::vector<VectorBuffer> vectorTemps;
+    size_t vectorTempDepth;
+    std::vector<float> conversionScratchLeft;  // Для повышения int-операндов до float
+    std::vector<float> conversionScratchRight;
+    // Окно [offset, offset + length) массивов-операндов при векторном выполнении цикла.
+    // Без окна векторные операции работают с массивами целиком.
+    size_t vectorWindowOffset;
+    std::optional<size_t> vectorWindowLength;
+
+    // --- Параллельные циклы ---
+    size_t threadCount;                          // Число рабочих потоков (включая основной)
+    std::unique_ptr<WorkStealingPool> threadPool; // Создается при первом параллельном цикле
+    // Состояние рабочего потока: собственный стек (поле stack), собственный ErrorHandler
+    // и приватные копии скалярных переменных, которым присваивается значение в теле цикла
+    bool isParallelWorker;
+    std::vector<char> privateMask;          // privateMask[индекс символа] != 0 - переменная приватная
+    std::vector<StoredValue> privateValues; // Значения приватных переменных (по индексу символа)
+    std::vector<char> privateWritten;       // privateWritten[индекс] != 0 - переменной присваивалось в этом куске
+
+    const SourceLocationTable* sourceLocations; // Позиции операций для сообщений об ошибках (может быть nullptr)
+
+    // --- Профилирование и метрики ---
+    // Основной цикл проверяет только флаг instrumented; сбор данных - в recordInstrumentation.
+    // Такты операции измеряются от ее начала до начала следующей операции,
+    // поэтому последняя операция учитывается после выхода из executeRange
+    bool instrumented;
+    ExecutionProfiler* profiler;
+    int profiledAddress;         // Выполняемая операция или -1
+    std::uint64_t profiledStart; // Счетчик тактов в начале ее выполнения
+    volatile std::sig_atomic_t* sampledAddress; // Ячейка адреса текущей операции для SamplingProfiler или nullptr
+    std::vector<std::uint64_t> opcodeCounts;    // Выполнения по кодам операций (пусто - не считаются)
+    void finishProfiledOperation();
+    void recordInstrumentation(); // Вызывается перед выполнением операции rpnCode[instructionPointer]
+    void updateInstrumentation() { instrumented = profiler || sampledAddress || !opcodeCounts.empty(); }
+
+    // --- Вспомогательные методы для работы со стеком и значениями ---
+    void runtimeError(const std::string& message); // Сообщает об ошибке времени выполнения
+
+    // Извлечение со стека
+    RuntimeStackItem popStack(); // Базовый pop
+    int popInt();         // Ожидает int или конвертируемый float
+    float popFloat();       // Ожидает float или конвертируемый int
     VarAddress popVarAddress();
     ArrayElementAddress popArrayElementAddress();
 
-    //    SymbolTable    
+    // Получение значения из SymbolTable по адресу со стека
     StoredValue getValueFromStackItem(const RuntimeStackItem& item);
-    //    SymbolTable    
+    // Установка значения в SymbolTable по адресу со стека
     void setValueAtStackItemAddress(const RuntimeStackItem& addressItem, const StoredValue& valueToSet);
 
+    // --- Векторные операции ---
+    VectorOperand popVectorOperand();
+    size_t acquireVectorTemp(bool isFloat, size_t length); // Выделяет буфер на вершине пула
+    void releaseVectorOperands(const VectorOperand& a, const VectorOperand& b);
+    const float* promoteToFloat(const VectorOperand& operand, std::vector<float>& scratch);
+    void executeVectorBinary(VectorKernelOp op);
+    void executeVectorAssign();
+    void executeVectorSum();
+    // Выполняет безопасную часть итераций векторизованного цикла; true, если итерации были выполнены
+    bool tryVectorLoop(const VectorLoopInfo& loop);
+    std::optional<int> peekIntVariable(size_t index) const; // Значение int-переменной без сообщений об ошибках
+
+    // Выполняет итерации параллельного цикла в пуле потоков и переходит за цикл.
+    // Возвращает false (ничего не изменив), если цикл нужно выполнить последовательно.
+    bool executeParallelLoop(const ParallelLoopInfo& loop);
+    bool isPrivateScalar(size_t index) const {
+        return isParallelWorker && index < privateMask.size() && privateMask[index] != 0;
+    }
+
+    // Выполнение ОПС с адреса startAddress до stopAddress (не включая) или до конца кода
+    // Возвращает false, если выполнение прервано ошибкой
+    bool executeRange(int startAddress, int stopAddress);
 
-public:
-    Interpreter(const std::vector<RPNOperation>& code, SymbolTable& symTab, ErrorHandler& errHandler);
 
-    void execute(); //    
+public:
+    Interpreter(const std::vector<RPNOperation>& code, SymbolTable& symTab, ErrorHandler& errHandler,
+        const std::vector<VectorLoopInfo>* loops = nullptr, const std::vector<ParallelLoopInfo>* parLoops = nullptr);
+
+    // Число потоков для параллельных циклов (по умолчанию - число ядер процессора)
+    void setThreadCount(size_t count);
+    // Лимит выполненных операций ОПС (по умолчанию MAX_EXECUTED_INSTRUCTIONS); для замеров на больших данных.
+    // Счетчик - int, поэтому лимит ограничен MAX_INSTRUCTION_LIMIT.
+    static const int MAX_INSTRUCTION_LIMIT = 2000000000;
+    void setInstructionLimit(int limit);
+    // Позиции операций ОПС: сообщения об ошибках выполнения получают строку и столбец исходного текста
+    void setSourceLocations(const SourceLocationTable* locations) { sourceLocations = locations; }
+    // Включает профилирование (nullptr - выключает); профилировщик должен жить до конца execute()
+    void setProfiler(ExecutionProfiler* executionProfiler) {
+        profiler = executionProfiler;
+        updateInstrumentation();
+    }
+    // Публикует адрес каждой выполняемой операции для профилировщика по выборкам (nullptr - выключает)
+    void setSamplingProfiler(SamplingProfiler* samplingProfiler) {
+        sampledAddress = samplingProfiler ? &samplingProfiler->getAddressSlot() : nullptr;
+        updateInstrumentation();
+    }
+    // Подсчет выполнений по кодам операций. Итерации векторизованных и параллельных циклов
+    // учитываются так же, как при скалярном выполнении (сумма равна getExecutedCount).
+    void setOpcodeCounting(bool enabled);
+    const std::vector<std::uint64_t>& getOpcodeCounts() const { return opcodeCounts; } // Индекс - RPNOpCode
+
+    int getExecutedCount() const { return executedCounter; } // Выполненные операции ОПС (последний запуск)
+    size_t getStackHighWater() const { return stack.getHighWater(); }
+
+    void execute(); // Запуск выполнения кода ОПС
 };
 
 #endif // INTERPRETER_H
\ No newline at end of file
@@ -0,0 +1,112 @@
+// ir.cpp
+#include "ir.h"
+
+#include <iomanip>
+
+const char* irOpName(IrOp op) {
+    switch (op) {
+    case IrOp::CONST_INT:     return "const_int";
+    case IrOp::CONST_FLOAT:   return "const_float";
+    case IrOp::LOAD_VAR:      return "load_var";
+    case IrOp::LOAD_ELEMENT:  return "load_element";
+    case IrOp::ARRAY_REF:     return "array_ref";
+    case IrOp::ADD:           return "add";
+    case IrOp::SUB:           return "sub";
+    case IrOp::MUL:           return "mul";
+    case IrOp::DIV:           return "div";
+    case IrOp::CMP_EQ:        return "cmp_eq";
+    case IrOp::CMP_NE:        return "cmp_ne";
+    case IrOp::CMP_GT:        return "cmp_gt";
+    case IrOp::CMP_LT:        return "cmp_lt";
+    case IrOp::TO_INT:        return "to_int";
+    case IrOp::TO_FLOAT:      return "to_float";
+    case IrOp::VEC_ADD:       return "vec_add";
+    case IrOp::VEC_SUB:       return "vec_sub";
+    case IrOp::VEC_MUL:       return "vec_mul";
+    case IrOp::VEC_DIV:       return "vec_div";
+    case IrOp::VEC_SUM:       return "vec_sum";
+    case IrOp::STORE_VAR:     return "store_var";
+    case IrOp::STORE_ELEMENT: return "store_element";
+    case IrOp::STORE_ARRAY:   return "store_array";
+    case IrOp::READ_VAR:      return "read_var";
+    case IrOp::READ_ELEMENT:  return "read_element";
+    case IrOp::WRITE:         return "write";
+    case IrOp::PARALLEL_LOOP: return "parallel_loop";
+    }
+    return "?";
+}
+
+int IrFunction::addBlock() {
+    blocks.emplace_back();
+    return static_cast<int>(blocks.size()) - 1;
+}
+
+int IrFunction::append(int block, const IrInstruction& instruction) {
+    instructions.push_back(instruction);
+    int id = static_cast<int>(instructions.size()) - 1;
+    blocks[block].instructions.push_back(id);
+    return id;
+}
+
+size_t IrFunction::countInstructions() const {
+    size_t count = 0;
+    for (const IrBlock& block : blocks) {
+        count += block.instructions.size();
+    }
+    return count;
+}
+
+void IrFunction::print(std::ostream& out, const SymbolTable& symbolTable) const {
+    std::ios_base::fmtflags savedFlags = out.flags();
+    std::streamsize savedPrecision = out.precision();
+    out << "\n--- Intermediate Representation (IR) ---" << std::endl;
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        const IrBlock& block = blocks[b];
+        out << "b" << b << ":" << std::endl;
+        for (int id : block.instructions) {
+            const IrInstruction& instr = instructions[id];
+            out << "  ";
+            if (instr.producesValue()) {
+                out << std::left << std::setw(7) << ("%" + std::to_string(id) + " =") << std::right;
+            }
+            out << irOpName(instr.op);
+            bool hasImmediate = true; // Константа, номер цикла или имя символа перед операндами
+            switch (instr.op) {
+            case IrOp::CONST_INT:     out << " " << instr.intValue; break;
+            case IrOp::CONST_FLOAT:   out << " " << std::fixed << std::setprecision(2) << instr.floatValue; break;
+            case IrOp::PARALLEL_LOOP: out << " #" << instr.intValue; break;
+            case IrOp::LOAD_VAR:
+            case IrOp::LOAD_ELEMENT:
+            case IrOp::ARRAY_REF:
+            case IrOp::STORE_VAR:
+            case IrOp::STORE_ELEMENT:
+            case IrOp::STORE_ARRAY:
+            case IrOp::READ_VAR:
+            case IrOp::READ_ELEMENT:
+                out << " " << symbolTable.getSymbolName(instr.symbolIndex);
+                break;
+            default:
+                hasImmediate = false;
+                break;
+            }
+            for (int k = 0; k < instr.operandCount(); ++k) {
+                out << ((k == 0 && !hasImmediate) ? " %" : ", %") << instr.operands[k];
+            }
+            out << "    ; line " << instr.line << std::endl;
+        }
+        switch (block.terminator) {
+        case IrTerminator::JUMP:
+            out << "  jump b" << block.target << std::endl;
+            break;
+        case IrTerminator::BRANCH:
+            out << "  branch %" << block.condition << " ? b" << block.target << " : b" << block.falseTarget << std::endl;
+            break;
+        case IrTerminator::EXIT:
+            out << "  exit" << std::endl;
+            break;
+        }
+    }
+    out << "-------------------------------------------------" << std::endl;
+    out.flags(savedFlags);
+    out.precision(savedPrecision);
+}
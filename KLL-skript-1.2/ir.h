@@ -0,0 +1,97 @@
+// ir.h
+#ifndef IR_H
+#define IR_H
+
+#include <vector>
+#include <ostream>
+#include <cstddef>
+
+#include "definitions.h"
+#include "symbol_table.h"
+
+// --- Промежуточное представление (IR) ---
+// Программа - граф потока управления из базовых блоков. Инструкции трехадресные: результат
+// инструкции - значение с номером этой инструкции (%N), операнды - номера других инструкций.
+// Все инструкции хранятся в IrFunction::instructions, блок перечисляет номера своих инструкций по порядку.
+//
+// Значения имеют форму деревьев: каждое значение используется ровно одной инструкцией (или условием
+// перехода) того же блока, и между определением и использованием нет инструкций с побочным эффектом.
+// Поэтому RpnGenerator выводит стековый код обходом деревьев от корней - инструкций без результата.
+// Переменные и массивы остаются в памяти (LOAD_* / STORE_*), а не в виде значений.
+
+enum class IrOp : unsigned char {
+    // Значения
+    CONST_INT,       // intValue
+    CONST_FLOAT,     // floatValue
+    LOAD_VAR,        // Переменная symbolIndex
+    LOAD_ELEMENT,    // symbolIndex[%0]
+    ARRAY_REF,       // Массив symbolIndex целиком (операнд векторной операции)
+    ADD, SUB, MUL, DIV,              // %0 op %1 (оба операнда одного скалярного типа)
+    CMP_EQ, CMP_NE, CMP_GT, CMP_LT,  // Результат - int 0/1
+    TO_INT, TO_FLOAT,                // Приведение %0
+    VEC_ADD, VEC_SUB, VEC_MUL, VEC_DIV, // Поэлементные операции (операнд может быть скаляром)
+    VEC_SUM,                         // Сумма элементов %0
+    // Инструкции без результата
+    STORE_VAR,       // symbolIndex = %0
+    STORE_ELEMENT,   // symbolIndex[%0] = %1
+    STORE_ARRAY,     // symbolIndex = %0 (целиком; скаляр заполняет массив)
+    READ_VAR,        // cin(symbolIndex)
+    READ_ELEMENT,    // cin(symbolIndex[%0])
+    WRITE,           // cout(%0)
+    PARALLEL_LOOP    // Следующий блок - заголовок цикла parallel с описателем intValue
+};
+
+const char* irOpName(IrOp op);
+
+struct IrInstruction {
+    static constexpr int NO_VALUE = -1;
+
+    IrOp op;
+    SymbolType type;   // Тип результата (для STORE_*, READ_* - тип записываемого значения)
+    int line;          // Позиция в исходном тексте
+    int column;
+    size_t symbolIndex;
+    union {
+        int intValue;
+        float floatValue;
+    };
+    int operands[2];   // Номера инструкций-операндов или NO_VALUE
+
+    bool producesValue() const { return op < IrOp::STORE_VAR; }
+    int operandCount() const { return (operands[0] == NO_VALUE) ? 0 : (operands[1] == NO_VALUE ? 1 : 2); }
+};
+
+enum class IrTerminator : unsigned char {
+    JUMP,   // Переход на target (в том числе на следующий блок)
+    BRANCH, // condition != 0 ? target : falseTarget
+    EXIT    // Конец программы
+};
+
+struct IrBlock {
+    std::vector<int> instructions; // Номера инструкций в порядке выполнения
+    IrTerminator terminator = IrTerminator::EXIT;
+    int condition = IrInstruction::NO_VALUE;
+    int target = -1;
+    int falseTarget = -1;
+};
+
+// Цикл parallel: блок заголовка (условие) и блок, следующий за циклом
+struct IrParallelRegion {
+    int headerBlock = -1;
+    int exitBlock = -1;
+};
+
+// Блоки хранятся в порядке размещения кода: переход на следующий блок генерируется без JUMP
+struct IrFunction {
+    std::vector<IrInstruction> instructions;
+    std::vector<IrBlock> blocks;
+    std::vector<IrParallelRegion> parallelRegions; // По номеру описателя цикла parallel
+
+    int addBlock();
+    // Добавляет инструкцию в конец блока и возвращает ее номер
+    int append(int block, const IrInstruction& instruction);
+    size_t countInstructions() const; // Инструкции, входящие в блоки
+    void print(std::ostream& out, const SymbolTable& symbolTable) const;
+};
+
+#endif // IR_H
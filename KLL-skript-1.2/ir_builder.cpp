@@ -0,0 +1,211 @@
+// ir_builder.cpp
+#include "ir_builder.h"
+
+namespace {
+
+    IrOp binaryIrOp(RPNOpCode op) {
+        switch (op) {
+        case RPNOpCode::ADD:     return IrOp::ADD;
+        case RPNOpCode::SUB:     return IrOp::SUB;
+        case RPNOpCode::MUL:     return IrOp::MUL;
+        case RPNOpCode::DIV:     return IrOp::DIV;
+        case RPNOpCode::CMP_EQ:  return IrOp::CMP_EQ;
+        case RPNOpCode::CMP_NE:  return IrOp::CMP_NE;
+        case RPNOpCode::CMP_GT:  return IrOp::CMP_GT;
+        case RPNOpCode::CMP_LT:  return IrOp::CMP_LT;
+        case RPNOpCode::VEC_ADD: return IrOp::VEC_ADD;
+        case RPNOpCode::VEC_SUB: return IrOp::VEC_SUB;
+        case RPNOpCode::VEC_MUL: return IrOp::VEC_MUL;
+        default:                 return IrOp::VEC_DIV;
+        }
+    }
+
+} // namespace
+
+IrBuilder::IrBuilder(IrFunction& func, const SymbolTable& symTab)
+    : function(func), symbolTable(symTab), currentBlock(-1) {
+}
+
+void IrBuilder::build(const AstStmt* program) {
+    function = IrFunction();
+    currentBlock = function.addBlock();
+    lowerList(program);
+    function.blocks[currentBlock].terminator = IrTerminator::EXIT;
+}
+
+int IrBuilder::emit(IrOp op, SymbolType type, int line, int column, int operand0, int operand1) {
+    IrInstruction instr;
+    instr.op = op;
+    instr.type = type;
+    instr.line = line;
+    instr.column = column;
+    instr.symbolIndex = 0;
+    instr.intValue = 0;
+    instr.operands[0] = operand0;
+    instr.operands[1] = operand1;
+    return function.append(currentBlock, instr);
+}
+
+void IrBuilder::jumpTo(int block) {
+    IrBlock& current = function.blocks[currentBlock];
+    current.terminator = IrTerminator::JUMP;
+    current.target = block;
+    currentBlock = block;
+}
+
+void IrBuilder::lowerList(const AstStmt* first) {
+    for (const AstStmt* stmt = first; stmt; stmt = stmt->next) {
+        lowerStatement(stmt);
+    }
+}
+
+void IrBuilder::lowerStatement(const AstStmt* stmt) {
+    switch (stmt->kind) {
+    case AstStmtKind::ASSIGN: {
+        int value = lowerExpression(stmt->value);
+        int store = emit(IrOp::STORE_VAR, stmt->value->type, stmt->line, stmt->column, value);
+        function.instructions[store].symbolIndex = stmt->symbolIndex;
+        break;
+    }
+    case AstStmtKind::ASSIGN_ELEMENT: {
+        int index = lowerExpression(stmt->index);
+        int value = lowerExpression(stmt->value);
+        int store = emit(IrOp::STORE_ELEMENT, stmt->value->type, stmt->line, stmt->column, index, value);
+        function.instructions[store].symbolIndex = stmt->symbolIndex;
+        break;
+    }
+    case AstStmtKind::VECTOR_ASSIGN: {
+        int value = lowerExpression(stmt->value);
+        int store = emit(IrOp::STORE_ARRAY, stmt->value->type, stmt->line, stmt->column, value);
+        function.instructions[store].symbolIndex = stmt->symbolIndex;
+        break;
+    }
+    case AstStmtKind::IF: {
+        int conditionBlock = currentBlock;
+        function.blocks[conditionBlock].terminator = IrTerminator::BRANCH;
+        function.blocks[conditionBlock].condition = lowerExpression(stmt->value);
+
+        // Блоки создаются по мере обхода, чтобы вложенные операторы оказались между ними
+        int thenBlock = function.addBlock();
+        function.blocks[conditionBlock].target = thenBlock;
+        currentBlock = thenBlock;
+        lowerList(stmt->body);
+        int thenEnd = currentBlock;
+
+        if (stmt->elseBody) {
+            int elseBlock = function.addBlock();
+            function.blocks[conditionBlock].falseTarget = elseBlock;
+            currentBlock = elseBlock;
+            lowerList(stmt->elseBody);
+            int joinBlock = function.addBlock();
+            function.blocks[thenEnd].terminator = IrTerminator::JUMP;
+            function.blocks[thenEnd].target = joinBlock;
+            jumpTo(joinBlock);
+        }
+        else {
+            int joinBlock = function.addBlock();
+            function.blocks[conditionBlock].falseTarget = joinBlock;
+            jumpTo(joinBlock);
+        }
+        break;
+    }
+    case AstStmtKind::WHILE: {
+        if (stmt->parallelLoopIndex != AstStmt::NOT_PARALLEL) {
+            int marker = emit(IrOp::PARALLEL_LOOP, SymbolType::VARIABLE_INT, stmt->line, stmt->column);
+            function.instructions[marker].intValue = static_cast<int>(stmt->parallelLoopIndex);
+        }
+        int headerBlock = function.addBlock();
+        jumpTo(headerBlock);
+        function.blocks[headerBlock].terminator = IrTerminator::BRANCH;
+        function.blocks[headerBlock].condition = lowerExpression(stmt->value);
+
+        int bodyBlock = function.addBlock();
+        function.blocks[headerBlock].target = bodyBlock;
+        currentBlock = bodyBlock;
+        lowerList(stmt->body);
+        function.blocks[currentBlock].terminator = IrTerminator::JUMP;
+        function.blocks[currentBlock].target = headerBlock;
+
+        int exitBlock = function.addBlock();
+        function.blocks[headerBlock].falseTarget = exitBlock;
+        currentBlock = exitBlock;
+
+        if (stmt->parallelLoopIndex != AstStmt::NOT_PARALLEL) {
+            if (function.parallelRegions.size() <= stmt->parallelLoopIndex) {
+                function.parallelRegions.resize(stmt->parallelLoopIndex + 1);
+            }
+            function.parallelRegions[stmt->parallelLoopIndex] = { headerBlock, exitBlock };
+        }
+        break;
+    }
+    case AstStmtKind::CIN: {
+        SymbolType symbolType = symbolTable.getSymbolType(stmt->symbolIndex);
+        SymbolType elementType = (symbolType == SymbolType::ARRAY_INT || symbolType == SymbolType::VARIABLE_INT)
+            ? SymbolType::VARIABLE_INT : SymbolType::VARIABLE_FLOAT;
+        int read;
+        if (stmt->index) {
+            int index = lowerExpression(stmt->index);
+            read = emit(IrOp::READ_ELEMENT, elementType, stmt->line, stmt->column, index);
+        }
+        else {
+            read = emit(IrOp::READ_VAR, elementType, stmt->line, stmt->column);
+        }
+        function.instructions[read].symbolIndex = stmt->symbolIndex;
+        break;
+    }
+    case AstStmtKind::COUT: {
+        int value = lowerExpression(stmt->value);
+        emit(IrOp::WRITE, stmt->value->type, stmt->line, stmt->column, value);
+        break;
+    }
+    case AstStmtKind::BLOCK:
+        lowerList(stmt->body);
+        break;
+    }
+}
+
+int IrBuilder::lowerExpression(const AstExpr* expr) {
+    switch (expr->kind) {
+    case AstExprKind::CONST_INT: {
+        int id = emit(IrOp::CONST_INT, expr->type, expr->line, expr->column);
+        function.instructions[id].intValue = expr->intValue;
+        return id;
+    }
+    case AstExprKind::CONST_FLOAT: {
+        int id = emit(IrOp::CONST_FLOAT, expr->type, expr->line, expr->column);
+        function.instructions[id].floatValue = expr->floatValue;
+        return id;
+    }
+    case AstExprKind::VARIABLE: {
+        int id = emit(IrOp::LOAD_VAR, expr->type, expr->line, expr->column);
+        function.instructions[id].symbolIndex = expr->symbolIndex;
+        return id;
+    }
+    case AstExprKind::ARRAY_ELEMENT: {
+        int index = lowerExpression(expr->left);
+        int id = emit(IrOp::LOAD_ELEMENT, expr->type, expr->line, expr->column, index);
+        function.instructions[id].symbolIndex = expr->symbolIndex;
+        return id;
+    }
+    case AstExprKind::WHOLE_ARRAY: {
+        int id = emit(IrOp::ARRAY_REF, expr->type, expr->line, expr->column);
+        function.instructions[id].symbolIndex = expr->symbolIndex;
+        return id;
+    }
+    case AstExprKind::BINARY: {
+        int left = lowerExpression(expr->left);
+        int right = lowerExpression(expr->right);
+        return emit(binaryIrOp(expr->op), expr->type, expr->line, expr->column, left, right);
+    }
+    case AstExprKind::CONVERT: {
+        int operand = lowerExpression(expr->left);
+        IrOp op = (expr->op == RPNOpCode::CONVERT_TO_INT) ? IrOp::TO_INT : IrOp::TO_FLOAT;
+        return emit(op, expr->type, expr->line, expr->column, operand);
+    }
+    case AstExprKind::SUM: {
+        int operand = lowerExpression(expr->left);
+        return emit(IrOp::VEC_SUM, expr->type, expr->line, expr->column, operand);
+    }
+    }
+    return IrInstruction::NO_VALUE;
+}
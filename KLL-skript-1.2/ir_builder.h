@@ -0,0 +1,33 @@
+// ir_builder.h
+#ifndef IR_BUILDER_H
+#define IR_BUILDER_H
+
+#include "ast.h"
+#include "ir.h"
+#include "symbol_table.h"
+
+// --- Понижение типизированного дерева в граф потока управления ---
+// Дерево должно быть построено без ошибок (все приведения типов уже записаны узлами CONVERT).
+// Блоки создаются в порядке размещения кода: if - условие, then, else, продолжение;
+// while - заголовок с условием, тело (с обратным переходом на заголовок), выход.
+class IrBuilder {
+public:
+    IrBuilder(IrFunction& function, const SymbolTable& symbolTable);
+
+    void build(const AstStmt* program);
+
+private:
+    IrFunction& function;
+    const SymbolTable& symbolTable;
+    int currentBlock;
+
+    void lowerList(const AstStmt* first);
+    void lowerStatement(const AstStmt* stmt);
+    int lowerExpression(const AstExpr* expr);
+
+    int emit(IrOp op, SymbolType type, int line, int column, int operand0 = IrInstruction::NO_VALUE,
+        int operand1 = IrInstruction::NO_VALUE);
+    void jumpTo(int block); // Завершает текущий блок переходом и делает block текущим
+};
+
+#endif // IR_BUILDER_H
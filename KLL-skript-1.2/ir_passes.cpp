@@ -0,0 +1,740 @@
+// ir_passes.cpp
+#include "ir_passes.h"
+#include "ssa.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+
+    // --- Общие вспомогательные функции ---
+
+    // Отмечает значение и все его операнды удаленными
+    void markTreeRemoved(const IrFunction& function, int root, std::vector<bool>& removed) {
+        std::vector<int> pending(1, root);
+        while (!pending.empty()) {
+            int id = pending.back();
+            pending.pop_back();
+            removed[id] = true;
+            const IrInstruction& instr = function.instructions[id];
+            for (int k = 0; k < instr.operandCount(); ++k) pending.push_back(instr.operands[k]);
+        }
+    }
+
+    void markOperandsRemoved(const IrFunction& function, int id, std::vector<bool>& removed) {
+        const IrInstruction& instr = function.instructions[id];
+        for (int k = 0; k < instr.operandCount(); ++k) markTreeRemoved(function, instr.operands[k], removed);
+    }
+
+    // Убирает удаленные инструкции из списков блоков (сами инструкции остаются в IrFunction::instructions)
+    void compactBlocks(IrFunction& function, const std::vector<bool>& removed) {
+        for (IrBlock& block : function.blocks) {
+            block.instructions.erase(std::remove_if(block.instructions.begin(), block.instructions.end(),
+                [&removed](int id) { return removed[id]; }), block.instructions.end());
+        }
+    }
+
+    // Значение id заменяется чтением переменной (операнды должны быть уже отмечены удаленными)
+    void rewriteToLoad(IrInstruction& instr, size_t variable) {
+        instr.op = IrOp::LOAD_VAR;
+        instr.symbolIndex = variable;
+        instr.operands[0] = IrInstruction::NO_VALUE;
+        instr.operands[1] = IrInstruction::NO_VALUE;
+    }
+
+    bool hasParallelMarker(const IrFunction& function, const IrBlock& block) {
+        for (int id : block.instructions) {
+            if (function.instructions[id].op == IrOp::PARALLEL_LOOP) return true;
+        }
+        return false;
+    }
+
+    // --- Решетка значений для распространения констант ---
+    struct LatticeValue {
+        enum class State : unsigned char { TOP, CONSTANT, BOTTOM };
+
+        State state = State::TOP;
+        SymbolType type = SymbolType::VARIABLE_INT;
+        int intValue = 0;
+        float floatValue = 0.0f;
+
+        static LatticeValue bottom() {
+            LatticeValue value;
+            value.state = State::BOTTOM;
+            return value;
+        }
+        static LatticeValue ofInt(int v) {
+            LatticeValue value;
+            value.state = State::CONSTANT;
+            value.intValue = v;
+            return value;
+        }
+        static LatticeValue ofFloat(float v) {
+            LatticeValue value;
+            value.state = State::CONSTANT;
+            value.type = SymbolType::VARIABLE_FLOAT;
+            value.floatValue = v;
+            return value;
+        }
+
+        bool isConstant() const { return state == State::CONSTANT; }
+        bool isFloat() const { return type == SymbolType::VARIABLE_FLOAT; }
+        float asFloat() const { return isFloat() ? floatValue : static_cast<float>(intValue); }
+
+        bool operator==(const LatticeValue& other) const {
+            if (state != other.state) return false;
+            if (state != State::CONSTANT) return true;
+            if (type != other.type) return false;
+            // Константы float сравниваются побитово (0.0 и -0.0 различны)
+            return isFloat() ? std::memcmp(&floatValue, &other.floatValue, sizeof(float)) == 0 : intValue == other.intValue;
+        }
+        bool operator!=(const LatticeValue& other) const { return !(*this == other); }
+    };
+
+    LatticeValue meet(const LatticeValue& a, const LatticeValue& b) {
+        if (a.state == LatticeValue::State::TOP) return b;
+        if (b.state == LatticeValue::State::TOP) return a;
+        if (a == b) return a;
+        return LatticeValue::bottom();
+    }
+
+    LatticeValue intResult(long long value) {
+        if (value < INT_MIN || value > INT_MAX) return LatticeValue::bottom(); // Переполнение не сворачивается
+        return LatticeValue::ofInt(static_cast<int>(value));
+    }
+
+    // Свертка повторяет арифметику интерпретатора; операции, которые завершились бы ошибкой, не сворачиваются
+    LatticeValue foldOperation(IrOp op, const LatticeValue& a, const LatticeValue& b) {
+        if (op == IrOp::TO_FLOAT) return LatticeValue::ofFloat(a.asFloat());
+        if (op == IrOp::TO_INT) {
+            float floored = std::floor(a.asFloat());
+            if (!(floored >= static_cast<float>(INT_MIN) && floored < static_cast<float>(INT_MAX))) return LatticeValue::bottom();
+            return LatticeValue::ofInt(static_cast<int>(floored));
+        }
+
+        if (a.isFloat() || b.isFloat()) {
+            float left = a.asFloat();
+            float right = b.asFloat();
+            switch (op) {
+            case IrOp::ADD: return LatticeValue::ofFloat(left + right);
+            case IrOp::SUB: return LatticeValue::ofFloat(left - right);
+            case IrOp::MUL: return LatticeValue::ofFloat(left * right);
+            case IrOp::DIV:
+                if (std::abs(right) < 1e-9) return LatticeValue::bottom();
+                return LatticeValue::ofFloat(left / right);
+            case IrOp::CMP_EQ: return LatticeValue::ofInt(std::abs(left - right) < 1e-9 ? 1 : 0);
+            case IrOp::CMP_NE: return LatticeValue::ofInt(std::abs(left - right) >= 1e-9 ? 1 : 0);
+            case IrOp::CMP_GT: return LatticeValue::ofInt(left > right ? 1 : 0);
+            case IrOp::CMP_LT: return LatticeValue::ofInt(left < right ? 1 : 0);
+            default: return LatticeValue::bottom();
+            }
+        }
+
+        long long left = a.intValue;
+        long long right = b.intValue;
+        switch (op) {
+        case IrOp::ADD: return intResult(left + right);
+        case IrOp::SUB: return intResult(left - right);
+        case IrOp::MUL: return intResult(left * right);
+        case IrOp::DIV:
+            if (right == 0) return LatticeValue::bottom();
+            return intResult(left / right);
+        case IrOp::CMP_EQ: return LatticeValue::ofInt(left == right ? 1 : 0);
+        case IrOp::CMP_NE: return LatticeValue::ofInt(left != right ? 1 : 0);
+        case IrOp::CMP_GT: return LatticeValue::ofInt(left > right ? 1 : 0);
+        case IrOp::CMP_LT: return LatticeValue::ofInt(left < right ? 1 : 0);
+        default: return LatticeValue::bottom();
+        }
+    }
+
+    bool isScalarOperation(IrOp op) {
+        return op >= IrOp::ADD && op <= IrOp::TO_FLOAT;
+    }
+
+    // --- Разреженное условное распространение констант ---
+    class ConstantPropagation {
+    public:
+        ConstantPropagation(IrFunction& func, const SsaForm& ssaForm)
+            : function(func), ssa(ssaForm) {
+        }
+
+        bool run() {
+            if (function.blocks.empty()) return false;
+            propagate();
+            return rewrite();
+        }
+
+    private:
+        struct Use {
+            int block;
+            int item;  // Корневая инструкция, условие перехода или номер phi в блоке
+            bool phi;
+        };
+
+        IrFunction& function;
+        const SsaForm& ssa;
+        std::vector<LatticeValue> values; // По версиям
+        std::vector<bool> executableBlock;
+        std::vector<std::vector<bool>> executableEdge; // [блок][номер предшественника]
+        std::vector<std::pair<int, int>> flowWorklist;
+        std::vector<int> ssaWorklist;
+        std::vector<std::vector<Use>> uses;
+
+        LatticeValue evaluate(int id) const {
+            const IrInstruction& instr = function.instructions[id];
+            switch (instr.op) {
+            case IrOp::CONST_INT:   return LatticeValue::ofInt(instr.intValue);
+            case IrOp::CONST_FLOAT: return LatticeValue::ofFloat(instr.floatValue);
+            case IrOp::LOAD_VAR: {
+                int version = ssa.getInstructionVersion(id);
+                return (version == SsaForm::NO_VERSION) ? LatticeValue::bottom() : values[version];
+            }
+            default:
+                break;
+            }
+            if (!isScalarOperation(instr.op)) return LatticeValue::bottom();
+
+            LatticeValue left = evaluate(instr.operands[0]);
+            LatticeValue right = (instr.operandCount() > 1) ? evaluate(instr.operands[1]) : left;
+            if (left.state == LatticeValue::State::BOTTOM || right.state == LatticeValue::State::BOTTOM) {
+                return LatticeValue::bottom();
+            }
+            if (!left.isConstant() || !right.isConstant()) return LatticeValue();
+            LatticeValue result = foldOperation(instr.op, left, right);
+            if (result.isConstant() && result.type != instr.type) return LatticeValue::bottom();
+            return result;
+        }
+
+        void setValue(int version, const LatticeValue& value) {
+            LatticeValue lowered = meet(values[version], value);
+            if (lowered != values[version]) {
+                values[version] = lowered;
+                ssaWorklist.push_back(version);
+            }
+        }
+
+        void addEdge(int from, int to) {
+            flowWorklist.emplace_back(from, to);
+        }
+
+        void visitPhi(int block, size_t index) {
+            const SsaPhi& phi = ssa.getPhis(block)[index];
+            if (ssa.isProtected(block)) {
+                setValue(phi.result, LatticeValue::bottom());
+                return;
+            }
+            LatticeValue value;
+            for (size_t k = 0; k < phi.arguments.size(); ++k) {
+                if (executableEdge[block][k]) value = meet(value, values[phi.arguments[k]]);
+            }
+            setValue(phi.result, value);
+        }
+
+        void visitTerminator(int block) {
+            const IrBlock& b = function.blocks[block];
+            if (b.terminator == IrTerminator::JUMP) {
+                addEdge(block, b.target);
+            }
+            else if (b.terminator == IrTerminator::BRANCH) {
+                LatticeValue condition = ssa.isProtected(block) ? LatticeValue::bottom() : evaluate(b.condition);
+                if (condition.isConstant() && !condition.isFloat()) {
+                    addEdge(block, condition.intValue != 0 ? b.target : b.falseTarget);
+                }
+                else if (condition.state == LatticeValue::State::BOTTOM) {
+                    addEdge(block, b.target);
+                    addEdge(block, b.falseTarget);
+                }
+            }
+        }
+
+        void visitStatement(int block, int root) {
+            const IrInstruction& instr = function.instructions[root];
+            if (instr.producesValue()) { // Условие перехода
+                visitTerminator(block);
+                return;
+            }
+            int version = ssa.getInstructionVersion(root);
+            if (version == SsaForm::NO_VERSION) return;
+            if (instr.op == IrOp::STORE_VAR && !ssa.isProtected(block)) setValue(version, evaluate(instr.operands[0]));
+            else setValue(version, LatticeValue::bottom());
+        }
+
+        void visitBlock(int block) {
+            for (size_t k = 0; k < ssa.getPhis(block).size(); ++k) visitPhi(block, k);
+            for (int id : function.blocks[block].instructions) {
+                if (!function.instructions[id].producesValue()) visitStatement(block, id);
+            }
+            visitTerminator(block);
+        }
+
+        void propagate() {
+            size_t blockCount = function.blocks.size();
+            values.assign(ssa.getVersionCount(), LatticeValue());
+            for (size_t v = 0; v < ssa.getSymbolCount(); ++v) values[ssa.getEntryVersion(v)] = LatticeValue::bottom(); // Не инициализирована
+            executableBlock.assign(blockCount, false);
+            executableEdge.assign(blockCount, {});
+            uses.assign(ssa.getVersionCount(), {});
+            for (size_t b = 0; b < blockCount; ++b) {
+                int block = static_cast<int>(b);
+                if (!ssa.isReachable(block)) continue;
+                executableEdge[b].assign(ssa.getPredecessors(block).size(), false);
+                for (int id : function.blocks[b].instructions) {
+                    if (function.instructions[id].op != IrOp::LOAD_VAR) continue;
+                    int version = ssa.getInstructionVersion(id);
+                    if (version != SsaForm::NO_VERSION) uses[version].push_back({ block, ssa.getOwner(id), false });
+                }
+                const std::vector<SsaPhi>& phis = ssa.getPhis(block);
+                for (size_t k = 0; k < phis.size(); ++k) {
+                    for (int argument : phis[k].arguments) uses[argument].push_back({ block, static_cast<int>(k), true });
+                }
+            }
+
+            executableBlock[0] = true;
+            visitBlock(0);
+            while (!flowWorklist.empty() || !ssaWorklist.empty()) {
+                while (!flowWorklist.empty()) {
+                    auto [from, to] = flowWorklist.back();
+                    flowWorklist.pop_back();
+                    const std::vector<int>& preds = ssa.getPredecessors(to);
+                    size_t edge = static_cast<size_t>(std::find(preds.begin(), preds.end(), from) - preds.begin());
+                    if (executableEdge[to][edge]) continue;
+                    executableEdge[to][edge] = true;
+                    if (!executableBlock[to]) {
+                        executableBlock[to] = true;
+                        visitBlock(to);
+                    }
+                    else {
+                        for (size_t k = 0; k < ssa.getPhis(to).size(); ++k) visitPhi(to, k);
+                    }
+                }
+                while (!ssaWorklist.empty()) {
+                    int version = ssaWorklist.back();
+                    ssaWorklist.pop_back();
+                    for (const Use& use : uses[version]) {
+                        if (!executableBlock[use.block]) continue;
+                        if (use.phi) visitPhi(use.block, static_cast<size_t>(use.item));
+                        else visitStatement(use.block, use.item);
+                    }
+                }
+            }
+        }
+
+        // Заменяет постоянные поддеревья константами (сверху вниз: сворачивается наибольшее поддерево)
+        bool foldTree(int id, std::vector<bool>& removed) {
+            IrInstruction& instr = function.instructions[id];
+            if (instr.op == IrOp::CONST_INT || instr.op == IrOp::CONST_FLOAT) return false;
+            LatticeValue value = instr.producesValue() ? evaluate(id) : LatticeValue::bottom();
+            if (value.isConstant()) {
+                markOperandsRemoved(function, id, removed);
+                instr.op = value.isFloat() ? IrOp::CONST_FLOAT : IrOp::CONST_INT;
+                if (value.isFloat()) instr.floatValue = value.floatValue;
+                else instr.intValue = value.intValue;
+                instr.operands[0] = IrInstruction::NO_VALUE;
+                instr.operands[1] = IrInstruction::NO_VALUE;
+                return true;
+            }
+            bool changed = false;
+            for (int k = 0; k < instr.operandCount(); ++k) changed |= foldTree(instr.operands[k], removed);
+            return changed;
+        }
+
+        bool rewrite() {
+            bool changed = false;
+            std::vector<bool> removed(function.instructions.size(), false);
+            for (size_t b = 0; b < function.blocks.size(); ++b) {
+                int blockIndex = static_cast<int>(b);
+                IrBlock& block = function.blocks[b];
+                if (ssa.isProtected(blockIndex)) continue;
+                if (!executableBlock[b]) {
+                    // Недостижимый блок не выполняется: его код не нужен (блоки с маркером parallel оставляются)
+                    if (hasParallelMarker(function, block)) continue;
+                    if (block.instructions.empty() && block.terminator == IrTerminator::EXIT) continue;
+                    for (int id : block.instructions) removed[id] = true;
+                    block.terminator = IrTerminator::EXIT;
+                    block.condition = IrInstruction::NO_VALUE;
+                    block.target = -1;
+                    block.falseTarget = -1;
+                    changed = true;
+                    continue;
+                }
+                for (int id : block.instructions) {
+                    if (!function.instructions[id].producesValue()) changed |= foldTree(id, removed);
+                }
+                if (block.terminator == IrTerminator::BRANCH) {
+                    LatticeValue condition = evaluate(block.condition);
+                    if (condition.isConstant() && !condition.isFloat()) {
+                        markTreeRemoved(function, block.condition, removed);
+                        block.target = (condition.intValue != 0) ? block.target : block.falseTarget;
+                        block.terminator = IrTerminator::JUMP;
+                        block.condition = IrInstruction::NO_VALUE;
+                        block.falseTarget = -1;
+                        changed = true;
+                    }
+                    else {
+                        changed |= foldTree(block.condition, removed);
+                    }
+                }
+            }
+            compactBlocks(function, removed);
+            return changed;
+        }
+    };
+
+    // --- Нумерация значений ---
+    struct ExpressionKey {
+        int op;
+        int type;
+        int left;
+        int right;
+        long long immediate;
+
+        bool operator==(const ExpressionKey& other) const {
+            return op == other.op && type == other.type && left == other.left && right == other.right && immediate == other.immediate;
+        }
+    };
+
+    struct ExpressionKeyHash {
+        size_t operator()(const ExpressionKey& key) const {
+            uint64_t h = static_cast<uint64_t>(key.op) * 0x9E3779B97F4A7C15ull;
+            h ^= static_cast<uint64_t>(key.type) + 0x7F4A7C15ull + (h << 6) + (h >> 2);
+            h ^= static_cast<uint64_t>(static_cast<uint32_t>(key.left)) + 0x9E3779B9ull + (h << 6) + (h >> 2);
+            h ^= static_cast<uint64_t>(static_cast<uint32_t>(key.right)) + 0x9E3779B9ull + (h << 6) + (h >> 2);
+            h ^= static_cast<uint64_t>(key.immediate) + 0x9E3779B9ull + (h << 6) + (h >> 2);
+            return static_cast<size_t>(h);
+        }
+    };
+
+    class ValueNumbering : public SsaWalker {
+    public:
+        ValueNumbering(IrFunction& func, const SsaForm& ssaForm, std::vector<bool>& removedFlags)
+            : SsaWalker(ssaForm, func), mutableFunction(func), removed(removedFlags), nextNumber(0), changed(false) {
+            versionNumbers.assign(ssa.getVersionCount(), -1);
+            valueNumbers.assign(func.instructions.size(), -1);
+            table.reserve(func.instructions.size());
+        }
+
+        bool hasChanged() const { return changed; }
+
+    protected:
+        void enterBlock(int /*block*/) override {
+            scopeMarks.push_back(undoLog.size());
+        }
+
+        void leaveBlock(int /*block*/) override {
+            size_t mark = scopeMarks.back();
+            scopeMarks.pop_back();
+            for (size_t k = undoLog.size(); k > mark; --k) {
+                const UndoEntry& entry = undoLog[k - 1];
+                if (entry.hadPrevious) available[entry.number] = entry.previous;
+                else available.erase(entry.number);
+            }
+            undoLog.resize(mark);
+        }
+
+        void visitStatement(int block, int root) override {
+            if (ssa.isProtected(block)) return;
+            const IrInstruction& instr = function.instructions[root];
+            if (instr.producesValue()) {
+                replaceRedundant(root);
+                return;
+            }
+            if (instr.op == IrOp::STORE_VAR && removeRedundantStore(root)) return;
+            for (int k = 0; k < instr.operandCount(); ++k) replaceRedundant(instr.operands[k]);
+            if (instr.op != IrOp::STORE_VAR) return;
+
+            int version = ssa.getInstructionVersion(root);
+            int number = numberOf(instr.operands[0]);
+            versionNumbers[version] = number;
+            auto it = available.find(number);
+            bool hadPrevious = (it != available.end());
+            if (hadPrevious && currentVersion(it->second.first) == it->second.second) return; // Значение уже доступно
+            undoLog.push_back({ number, hadPrevious, hadPrevious ? it->second : std::pair<size_t, int>() });
+            available[number] = { instr.symbolIndex, version };
+        }
+
+    private:
+        struct UndoEntry {
+            int number;
+            bool hadPrevious;
+            std::pair<size_t, int> previous;
+        };
+
+        IrFunction& mutableFunction;
+        std::vector<bool>& removed;
+        std::unordered_map<ExpressionKey, int, ExpressionKeyHash> table;
+        std::vector<int> versionNumbers;
+        std::vector<int> valueNumbers;
+        // Номер значения -> (переменная, версия), хранящая его в доминирующем присваивании
+        std::unordered_map<int, std::pair<size_t, int>> available;
+        std::vector<UndoEntry> undoLog;
+        std::vector<size_t> scopeMarks;
+        int nextNumber;
+        bool changed;
+
+        int versionNumber(int version) {
+            if (versionNumbers[version] == -1) versionNumbers[version] = nextNumber++; // phi, ввод или вход
+            return versionNumbers[version];
+        }
+
+        int numberOf(int id) {
+            if (valueNumbers[id] != -1) return valueNumbers[id];
+            const IrInstruction& instr = function.instructions[id];
+            ExpressionKey key{ static_cast<int>(instr.op), static_cast<int>(instr.type), -1, -1, 0 };
+            switch (instr.op) {
+            case IrOp::CONST_INT:
+                key.immediate = instr.intValue;
+                break;
+            case IrOp::CONST_FLOAT: {
+                uint32_t bits;
+                std::memcpy(&bits, &instr.floatValue, sizeof(bits));
+                key.immediate = bits;
+                break;
+            }
+            case IrOp::LOAD_VAR: {
+                int version = ssa.getInstructionVersion(id);
+                valueNumbers[id] = (version == SsaForm::NO_VERSION) ? nextNumber++ : versionNumber(version);
+                return valueNumbers[id];
+            }
+            default:
+                if (!isScalarOperation(instr.op)) { // Чтение памяти и векторные операции уникальны
+                    valueNumbers[id] = nextNumber++;
+                    return valueNumbers[id];
+                }
+                key.left = numberOf(instr.operands[0]);
+                if (instr.operandCount() > 1) key.right = numberOf(instr.operands[1]);
+                // Коммутативные операции и a > b == b < a приводятся к одному виду
+                if (instr.op == IrOp::CMP_GT) {
+                    key.op = static_cast<int>(IrOp::CMP_LT);
+                    std::swap(key.left, key.right);
+                }
+                else if ((instr.op == IrOp::ADD || instr.op == IrOp::MUL || instr.op == IrOp::CMP_EQ || instr.op == IrOp::CMP_NE)
+                    && key.left > key.right) {
+                    std::swap(key.left, key.right);
+                }
+                break;
+            }
+            auto inserted = table.emplace(key, nextNumber);
+            if (inserted.second) ++nextNumber;
+            valueNumbers[id] = inserted.first->second;
+            return valueNumbers[id];
+        }
+
+        // v = E, где значение E уже лежит в текущей версии v: присваивание удаляется целиком
+        // (замена E чтением v дала бы копию v = v, которую не удаляют ни распространение копий, ни DSE)
+        bool removeRedundantStore(int root) {
+            const IrInstruction& instr = function.instructions[root];
+            int number = numberOf(instr.operands[0]);
+            auto it = available.find(number);
+            if (it == available.end() || it->second.first != instr.symbolIndex ||
+                currentVersion(instr.symbolIndex) != it->second.second) {
+                return false;
+            }
+            markTreeRemoved(function, root, removed);
+            // Новая версия v хранит то же значение: последующие вычисления E заменяются чтением v
+            int version = ssa.getInstructionVersion(root);
+            versionNumbers[version] = number;
+            undoLog.push_back({ number, true, it->second });
+            it->second.second = version;
+            changed = true;
+            return true;
+        }
+
+        void replaceRedundant(int id) {
+            IrInstruction& instr = mutableFunction.instructions[id];
+            if (!isScalarOperation(instr.op)) {
+                if (instr.op == IrOp::LOAD_ELEMENT) replaceRedundant(instr.operands[0]);
+                return;
+            }
+            auto it = available.find(numberOf(id));
+            if (it != available.end() && currentVersion(it->second.first) == it->second.second) {
+                markOperandsRemoved(function, id, removed);
+                rewriteToLoad(instr, it->second.first);
+                changed = true;
+                return;
+            }
+            for (int k = 0; k < instr.operandCount(); ++k) replaceRedundant(instr.operands[k]);
+        }
+    };
+
+    // --- Распространение копий ---
+    class CopyPropagation : public SsaWalker {
+    public:
+        CopyPropagation(IrFunction& func, const SsaForm& ssaForm)
+            : SsaWalker(ssaForm, func), mutableFunction(func), changed(false) {
+            copySources.assign(ssa.getVersionCount(), SsaForm::NO_VERSION);
+        }
+
+        bool hasChanged() const { return changed; }
+
+    protected:
+        void visitStatement(int block, int root) override {
+            if (ssa.isProtected(block)) return;
+            propagate(root);
+            const IrInstruction& instr = function.instructions[root];
+            if (instr.op != IrOp::STORE_VAR) return;
+            const IrInstruction& value = function.instructions[instr.operands[0]];
+            if (value.op != IrOp::LOAD_VAR || value.symbolIndex == instr.symbolIndex) return;
+            // Версия источника - та, что лежит в его переменной сейчас (после замены цепочки копий)
+            copySources[ssa.getInstructionVersion(root)] = currentVersion(value.symbolIndex);
+        }
+
+    private:
+        IrFunction& mutableFunction;
+        std::vector<int> copySources; // Версия-копия -> версия, значение которой она хранит
+        bool changed;
+
+        void propagate(int id) {
+            IrInstruction& instr = mutableFunction.instructions[id];
+            if (instr.op == IrOp::LOAD_VAR) {
+                int version = ssa.getInstructionVersion(id);
+                if (version == SsaForm::NO_VERSION) return;
+                int source = copySources[version];
+                if (source == SsaForm::NO_VERSION) return;
+                size_t variable = ssa.getVersion(source).variable;
+                if (currentVersion(variable) == source) {
+                    instr.symbolIndex = variable;
+                    changed = true;
+                }
+                return;
+            }
+            for (int k = 0; k < instr.operandCount(); ++k) propagate(instr.operands[k]);
+        }
+    };
+
+} // namespace
+
+bool ConstantPropagationPass::run(IrFunction& function, const SymbolTable& symbolTable) {
+    SsaForm ssa(function, symbolTable);
+    ConstantPropagation propagation(function, ssa);
+    return propagation.run();
+}
+
+bool GlobalValueNumberingPass::run(IrFunction& function, const SymbolTable& symbolTable) {
+    SsaForm ssa(function, symbolTable);
+    std::vector<bool> removed(function.instructions.size(), false);
+    ValueNumbering numbering(function, ssa, removed);
+    numbering.run();
+    compactBlocks(function, removed);
+    return numbering.hasChanged();
+}
+
+bool CopyPropagationPass::run(IrFunction& function, const SymbolTable& symbolTable) {
+    SsaForm ssa(function, symbolTable);
+    CopyPropagation propagation(function, ssa);
+    propagation.run();
+    return propagation.hasChanged();
+}
+
+bool DeadStoreEliminationPass::run(IrFunction& function, const SymbolTable& symbolTable) {
+    bool changed = false;
+    // Удаление присваивания может сделать мертвыми присваивания, которые оно читало: повторяем до неподвижной точки
+    while (true) {
+        SsaForm ssa(function, symbolTable);
+        size_t versionCount = ssa.getVersionCount();
+
+        // phi-версия -> phi
+        std::vector<const SsaPhi*> phiOf(versionCount, nullptr);
+        for (size_t b = 0; b < function.blocks.size(); ++b) {
+            for (const SsaPhi& phi : ssa.getPhis(static_cast<int>(b))) phiOf[phi.result] = &phi;
+        }
+
+        // Живые версии: читаемые LOAD_VAR и аргументы живых phi
+        std::vector<bool> live(versionCount, false);
+        std::vector<int> worklist;
+        for (size_t b = 0; b < function.blocks.size(); ++b) {
+            if (!ssa.isReachable(static_cast<int>(b))) continue;
+            for (int id : function.blocks[b].instructions) {
+                if (function.instructions[id].op != IrOp::LOAD_VAR) continue;
+                int version = ssa.getInstructionVersion(id);
+                if (version != SsaForm::NO_VERSION && !live[version]) {
+                    live[version] = true;
+                    worklist.push_back(version);
+                }
+            }
+        }
+        while (!worklist.empty()) {
+            int version = worklist.back();
+            worklist.pop_back();
+            if (!phiOf[version]) continue;
+            for (int argument : phiOf[version]->arguments) {
+                if (!live[argument]) {
+                    live[argument] = true;
+                    worklist.push_back(argument);
+                }
+            }
+        }
+
+        // Версии, инициализированные на всех путях (чтение остальных может завершиться ошибкой)
+        std::vector<bool> initialized(versionCount, true);
+        for (size_t v = 0; v < ssa.getSymbolCount(); ++v) initialized[ssa.getEntryVersion(v)] = false;
+        bool updated = true;
+        while (updated) {
+            updated = false;
+            for (size_t v = 0; v < versionCount; ++v) {
+                if (!phiOf[v] || !initialized[v]) continue;
+                for (int argument : phiOf[v]->arguments) {
+                    if (!initialized[argument]) {
+                        initialized[v] = false;
+                        updated = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Значение можно не вычислять, если его вычисление не может завершиться ошибкой
+        auto isSafe = [&](int root) {
+            std::vector<int> pending(1, root);
+            while (!pending.empty()) {
+                const IrInstruction& instr = function.instructions[pending.back()];
+                int id = pending.back();
+                pending.pop_back();
+                switch (instr.op) {
+                case IrOp::CONST_INT:
+                case IrOp::CONST_FLOAT:
+                    break;
+                case IrOp::LOAD_VAR: {
+                    int version = ssa.getInstructionVersion(id);
+                    if (version == SsaForm::NO_VERSION || !initialized[version]) return false;
+                    break;
+                }
+                case IrOp::DIV: {
+                    const IrInstruction& divisor = function.instructions[instr.operands[1]];
+                    bool nonZero = (divisor.op == IrOp::CONST_INT && divisor.intValue != 0 && divisor.intValue != -1) ||
+                        (divisor.op == IrOp::CONST_FLOAT && std::abs(divisor.floatValue) >= 1e-9);
+                    if (!nonZero) return false;
+                    pending.push_back(instr.operands[0]);
+                    break;
+                }
+                default:
+                    if (!isScalarOperation(instr.op)) return false; // Память и векторные операции
+                    for (int k = 0; k < instr.operandCount(); ++k) pending.push_back(instr.operands[k]);
+                    break;
+                }
+            }
+            return true;
+        };
+
+        std::vector<bool> removed(function.instructions.size(), false);
+        bool removedAny = false;
+        for (size_t b = 0; b < function.blocks.size(); ++b) {
+            int block = static_cast<int>(b);
+            if (!ssa.isReachable(block) || ssa.isProtected(block)) continue;
+            for (int id : function.blocks[b].instructions) {
+                const IrInstruction& instr = function.instructions[id];
+                if (instr.op != IrOp::STORE_VAR || live[ssa.getInstructionVersion(id)]) continue;
+                if (!isSafe(instr.operands[0])) continue;
+                markTreeRemoved(function, id, removed);
+                removedAny = true;
+            }
+        }
+        if (!removedAny) break;
+        compactBlocks(function, removed);
+        changed = true;
+    }
+    return changed;
+}
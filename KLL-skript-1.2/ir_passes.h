@@ -0,0 +1,52 @@
+// ir_passes.h
+#ifndef IR_PASSES_H
+#define IR_PASSES_H
+
+#include "ir.h"
+#include "symbol_table.h"
+
+// --- Оптимизирующие проходы над IR ---
+// Каждый проход строит SSA-форму скалярных переменных заново (SsaForm) и меняет IR на месте:
+// значения переписываются в константы или чтения переменных, лишние инструкции удаляются из блоков.
+// Проходы сохраняют поведение программы, включая ошибки времени выполнения (деление на ноль,
+// чтение неинициализированной переменной): выражения, которые могут завершиться ошибкой, не удаляются.
+class IrPass {
+public:
+    virtual ~IrPass() = default;
+    virtual const char* getName() const = 0;
+    // Возвращает true, если IR изменился
+    virtual bool run(IrFunction& function, const SymbolTable& symbolTable) = 0;
+};
+
+// Разреженное условное распространение констант (Вегман - Задек): значения версий и исполнимость
+// ребер вычисляются совместно, поэтому ветви с постоянным условием и недостижимый код удаляются.
+class ConstantPropagationPass : public IrPass {
+public:
+    const char* getName() const override { return "sccp"; }
+    bool run(IrFunction& function, const SymbolTable& symbolTable) override;
+};
+
+// Глобальная нумерация значений: выражение, равное значению, которое доминирующее присваивание
+// уже сохранило в переменной (и эта переменная с тех пор не менялась), заменяется чтением переменной.
+class GlobalValueNumberingPass : public IrPass {
+public:
+    const char* getName() const override { return "gvn"; }
+    bool run(IrFunction& function, const SymbolTable& symbolTable) override;
+};
+
+// Распространение копий: после x = y чтения x читают y, пока y не переприсвоен.
+class CopyPropagationPass : public IrPass {
+public:
+    const char* getName() const override { return "copy-prop"; }
+    bool run(IrFunction& function, const SymbolTable& symbolTable) override;
+};
+
+// Удаление мертвых присваиваний: версия переменной, которую никто не читает, не сохраняется
+// (если вычисление значения не может завершиться ошибкой).
+class DeadStoreEliminationPass : public IrPass {
+public:
+    const char* getName() const override { return "dse"; }
+    bool run(IrFunction& function, const SymbolTable& symbolTable) override;
+};
+
+#endif // IR_PASSES_H
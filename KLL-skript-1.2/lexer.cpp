@@ -1,72 +1,78 @@
 // lexer.cpp
 #include "lexer.h"
-#include <cctype>   //  isalpha, isdigit, isprint
-#include <sstream>  //     
+#include <cctype>   // Для isalpha, isdigit, isprint
+#include <sstream>  // Для форматирования сообщений об ошибках
+#include <string_view> // Текст лексем без копирования
+#include <charconv> // Для std::from_chars (разбор чисел прямо из исходного кода)
+#include <cstring>  // Для std::memchr
+#include "vector_kernels.h" // spanCharClass - SIMD-пропуск однородных участков
 
-// ---    ---
+// --- Инициализация статических таблиц ---
 
-// :
+// Состояния:
 // 0: START
 // 1: IDENTIFIER
-// 2: NUMBER_INT (  )
-// 3: NUMBER_FLOAT_DECIMAL ( ,  )
-// 4: NUMBER_FLOAT_EXP ( 'e'  'E',     -      )
+// 2: NUMBER_INT (целая часть числа)
+// 3: NUMBER_FLOAT_DECIMAL (после точки, ожидаем цифры)
+// 4: NUMBER_FLOAT_EXP (после 'e' или 'E', ожидаем знак или цифры - не реализуем для упрощения по заданию)
 
-//   (  stateTransitionTable):
-// 0:  (a-z, A-Z)
-// 1:  (0-9)
+// Категории символов (индексы для stateTransitionTable):
+// 0: буква (a-z, A-Z)
+// 1: цифра (0-9)
 // 2: +
 // 3: -
 // 4: =
 // 5: *
 // 6: /
-// 7: , \t, \r
+// 7: пробел, \t, \r
 // 8: (
 // 9: )
 // 10: [
 // 11: ]
-// 12: ~ ( ==)
+// 12: ~ (для ==)
 // 13: >
 // 14: <
-// 15: ! ( !=)
+// 15: ! (для !=)
 // 16: ;
-// 17: \n ( )
-// 18:    (    , , )
+// 17: \n (перевод строки)
+// 18: другие печатные символы (не вошедшие в другие категории, например, запятая)
 // 19: $ (EOF)
-// 20: . (  float)
+// 20: . (точка для float)
+// 21: " (начало строки)
 
-const int Lexer::stateTransitionTable[5][21] = {
-    // :  0   1   2   3   4   5   6   7   8   9  10  11  12  13  14  15  16  17  18  19  20
-    // :      +   -   =   *   /   (   )   [   ]   ~   >   <   !   ;  \n   EOF  .
-    /* 0 START */ { 1,  2, 30, 31, 32, 33, 34,  0, 35, 36, 37, 38, 39, 40, 41, 42, 43,  0, 45, 46, 47}, //  30-43,46 -   ; 0-; 45-; 47- float  
-    /* 1 IDENT */ { 10, 10, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11}, // 10- ; 11- 
-    /* 2 NUM_INT */ { 21, 20, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,  3}, // 20- ; 21- ; 3-   float_decimal
-    /* 3 NUM_FLT_D*/{ 23, 22, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23}, // 22-  ; 23- float
-    /* 4 NUM_FLT_E */{99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99}  //    (  , 99 - /)
+const int Lexer::stateTransitionTable[5][22] = {
+    // Категория:  0   1   2   3   4   5   6   7   8   9  10  11  12  13  14  15  16  17  18  19  20  21
+    // Символ:    бук циф +   -   =   *   /  проб (   )   [   ]   ~   >   <   !   ;  \n  др EOF  .   "
+    /* 0 START */ { 1,  2, 30, 31, 32, 33, 34,  0, 35, 36, 37, 38, 39, 40, 41, 42, 43,  0, 45, 46, 47, 48}, // Действия 30-43,46 - создание простых токенов; 0-игнор; 45-ошибка; 47-начало float с точки; 48-строка
+    /* 1 IDENT */ { 10, 10, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11}, // 10-продолжить идентификатор; 11-завершить идентификатор
+    /* 2 NUM_INT */ { 21, 20, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,  3, 21}, // 20-продолжить целое; 21-завершить целое; 3-переход в состояние float_decimal
+    /* 3 NUM_FLT_D*/{ 23, 22, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23}, // 22-продолжить дробную часть; 23-завершить float
+    /* 4 NUM_FLT_E */{99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99}  // Состояние для экспоненты (пока не используется, 99 - ошибка/недостижимо)
 };
-//  ( ):
-// 0:  ,   START
-// 1:  ,   IDENTIFIER,  
-// 2:   ,   NUMBER_INT,  
-// 3:    ,   NUMBER_FLOAT_DECIMAL,  
-// 10:  ,   IDENTIFIER,  
-// 11:  / ,  ,   
-// 20:   ,   NUMBER_INT,  
-// 21:   ,  ,   
-// 22:    float,   NUMBER_FLOAT_DECIMAL,  
-// 23:  float,  ,   
-// 30-43:      ,  ,  
-// 45:  -  
-// 46: EOF -  T_EOF
-// 47:  float   (, ".5"),   NUMBER_FLOAT_DECIMAL,   ( "0"  )
+// Действия (семантические программы):
+// 0: Игнорировать символ, остаться в START
+// 1: Начало идентификатора, переход в IDENTIFIER, добавить символ
+// 2: Начало целого числа, переход в NUMBER_INT, добавить цифру
+// 3: Встретили точку после цифр, переход в NUMBER_FLOAT_DECIMAL, добавить точку
+// 10: Продолжить идентификатор, остаться в IDENTIFIER, добавить символ
+// 11: Завершить идентификатор/ключевое слово, вернуть токен, символ НЕ потреблять
+// 20: Продолжить целое число, остаться в NUMBER_INT, добавить цифру
+// 21: Завершить целое число, вернуть токен, символ НЕ потреблять
+// 22: Продолжить дробную часть float, остаться в NUMBER_FLOAT_DECIMAL, добавить цифру
+// 23: Завершить float, вернуть токен, символ НЕ потреблять
+// 30-43: Распознан односимвольный токен или простой разделитель, вернуть токен, символ ПОТРЕБИТЬ
+// 45: Ошибка - неизвестный символ
+// 46: EOF - вернуть T_EOF
+// 47: Начало float с точки (например, ".5"), переход в NUMBER_FLOAT_DECIMAL, добавить точку
+// 48: Строка в кавычках - читается целиком до закрывающей кавычки (readStringLiteral)
 
 
 const int Lexer::asciiCategoryTable[128] = {
-    //   (0-31),  - ""  \n, \t, \r
+    // Управляющие символы (0-31), большинство - "другие" или \n, \t, \r
     18, 18, 18, 18, 18, 18, 18, 18, 18,  7, 17, 18, 18,  7, 18, 18, // 0-15   (\t=7, \n=17, \r=7)
     18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, // 16-31
-    //  
-     7, 15, 18, 18, 19, 18, 18, 18,  8,  9,  5,  2, 18,  3, 20,  6, // 32-47  (' '=7, '!'=15, '$'=19 (EOF), '('=8, ')'=9, '*'=5, '+'=2, ','=18, '-'=3, '.'=20, '/'=6)
+    // Печатные символы
+     7, 15, 21, 18, 19, 18, 18, 18,  8,  9,  5,  2, 18,  3, 20,  6, // 32-47  (' '=7, '!'=15, '"'=21, '$'=19 (EOF), '('=8, ')'=9, '*'=5, '+'=2, ','=18, '-'=3, '.'=20, '/'=6)
      1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 18, 16, 14,  4, 13, 18, // 48-63  ('0'-'9'=1, ':'=18, ';'=16, '<'=14, '='=4, '>'=13, '?'=18)
     18,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, // 64-79  ('@'=18, 'A'-'O'=0)
      0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 10, 18, 11, 18, 18, // 80-95  ('P'-'Z'=0, '['=10, '\'=18, ']'=11, '^'=18, '_'=18)
@@ -75,8 +81,8 @@ const int Lexer::asciiCategoryTable[128] = {
 };
 
 
-Lexer::Lexer(const std::string& source, SymbolTable& symTable, ErrorHandler& errHandler)
-    : sourceCode(source), currentPos(0), currentLine(1), lineStartPos(0),
+Lexer::Lexer(std::string_view source, SymbolTable& symTable, ErrorHandler& errHandler)
+    : sourceCode(source), currentPos(0), currentLine(1), lineStartPos(0), bulkScanning(true),
     symbolTable(symTable), errorHandler(errHandler) {
 }
 
@@ -84,12 +90,12 @@ char Lexer::peekChar(size_t offset) const {
     if (currentPos + offset < sourceCode.length()) {
         return sourceCode[currentPos + offset];
     }
-    return '$'; //    ,    
+    return '$'; // Специальный символ конца файла, если вышли за пределы
 }
 
 char Lexer::consumeChar() {
     if (currentPos >= sourceCode.length()) {
-        return '$'; //   
+        return '$'; // Уже в конце
     }
     char consumed = sourceCode[currentPos];
     currentPos++;
@@ -105,138 +111,216 @@ int Lexer::getCurrentColumn() const {
     return static_cast<int>(currentPos - lineStartPos) + 1;
 }
 
-Token Lexer::createFinalToken(TokenType type, const std::string& text) {
-    //     EOF,        
-    std::string tokenText = text;
-    if (text.empty()) {
-        if (type >= TokenType::T_ASSIGN && type <= TokenType::T_SEMICOLON) { //  
-            tokenText = std::string(1, static_cast<char>(type));
+// Быстрый путь КА: в каждом из этих состояний символы своего класса только потребляются
+// (действия 0, 10, 20, 22), поэтому при входе в состояние весь участок пропускается сразу,
+// по 16-32 символа за раз. Символ на границе лексемы по-прежнему обрабатывает таблица переходов.
+void Lexer::skipCharRun(LexerState state) {
+    if (currentPos >= sourceCode.length()) return;
+    const char* text = sourceCode.data() + currentPos;
+    const size_t remaining = sourceCode.length() - currentPos;
+    // Участки из одного символа (пробел вокруг оператора, однобуквенное имя) встречаются чаще всего:
+    // для них хватает проверки по таблице категорий, без вызова векторного ядра
+    const unsigned char first = static_cast<unsigned char>(text[0]);
+    const int category = (first < 128) ? asciiCategoryTable[first] : 18;
+    switch (state) {
+    case LexerState::START:
+        if (category != 7 && category != 17) return;
+        break;
+    case LexerState::IDENTIFIER:
+        if (category != 0 && category != 1) return;
+        break;
+    default:
+        if (category != 1) return;
+        break;
+    }
+    switch (state) {
+    case LexerState::START: {
+        size_t run = VectorKernels::spanCharClass(CharClass::SPACE, text, remaining);
+        // Переводы строк внутри участка учитываются так же, как в consumeChar
+        const char* end = text + run;
+        for (const char* nl = static_cast<const char*>(std::memchr(text, '\n', run)); nl;
+            nl = static_cast<const char*>(std::memchr(nl + 1, '\n', static_cast<size_t>(end - nl - 1)))) {
+            currentLine++;
+            lineStartPos = static_cast<int>(nl - sourceCode.data()) + 1;
         }
-        else if (type == TokenType::T_EOF) {
+        currentPos += run;
+        break;
+    }
+    case LexerState::IDENTIFIER:
+        currentPos += VectorKernels::spanCharClass(CharClass::ALNUM, text, remaining);
+        break;
+    case LexerState::NUMBER_INT:
+    case LexerState::NUMBER_FLOAT_DECIMAL:
+        currentPos += VectorKernels::spanCharClass(CharClass::DIGIT, text, remaining);
+        break;
+    default:
+        break;
+    }
+}
+
+Token Lexer::createFinalToken(TokenType type, std::string_view text) {
+    // Для односимвольных токенов и EOF текст не передается: берется только что прочитанный символ или "EOF"
+    std::string_view tokenText = text;
+    if (text.empty()) {
+        if (type == TokenType::T_EOF) {
             tokenText = "EOF";
         }
-        //          
+        else if (currentPos > 0) { // Односимвольные операторы: только что прочитанный символ исходного кода
+            tokenText = sourceCode.substr(currentPos - 1, 1);
+        }
+        // для ключевых слов текст будет передан явно при создании токена
     }
     return Token(type, tokenText, currentLine, getCurrentColumn() - static_cast<int>(tokenText.length()));
 }
 
-Token Lexer::createIntToken(int value, const std::string& text) {
+Token Lexer::createIntToken(int value, std::string_view text) {
     return Token(TokenType::T_NUMBER_INT, value, currentLine, getCurrentColumn() - static_cast<int>(text.length()), text);
 }
 
-Token Lexer::createFloatToken(float value, const std::string& text) {
+Token Lexer::createFloatToken(float value, std::string_view text) {
     return Token(TokenType::T_NUMBER_FLOAT, value, currentLine, getCurrentColumn() - static_cast<int>(text.length()), text);
 }
 
 
+Token Lexer::readStringLiteral() {
+    int startLine = currentLine;
+    int startColumn = getCurrentColumn();
+    consumeChar(); // Открывающая кавычка
+    size_t textStart = currentPos;
+    while (true) {
+        char c = peekChar();
+        if ((c == '$' && currentPos >= sourceCode.length()) || c == '\n') {
+            errorHandler.logLexicalError("Unterminated string literal.", startLine, startColumn);
+            return Token(TokenType::T_ERROR, startLine, startColumn);
+        }
+        if (c == '"') break;
+        consumeChar();
+    }
+    std::string_view text = sourceCode.substr(textStart, currentPos - textStart);
+    consumeChar(); // Закрывающая кавычка
+    return Token(TokenType::T_STRING, text, startLine, startColumn);
+}
+
 Token Lexer::getNextToken() {
-    LexerState currentState = LexerState::START; //    ( 0  )
-    std::string currentLexemeText = "";
-    // int currentNumberIntValue = 0; //  ,   currentLexemeText  
-    // float currentNumberFloatValue = 0.0f;
+    LexerState currentState = LexerState::START; // Начальное состояние КА (используем 0 для таблицы)
+    // Лексема не копируется посимвольно: запоминается ее начало, а текст берется из sourceCode
+    size_t lexemeStart = currentPos;
 
-    while (true) { //   
+    while (true) { // Цикл конечного автомата
         char currentChar = peekChar();
-        int charCategory = 18; // 'other_printable'  
+        int charCategory = 18; // 'other_printable' по умолчанию
 
-        if (currentChar == '$' && currentPos >= sourceCode.length()) { //    
+        if (currentChar == '$' && currentPos >= sourceCode.length()) { // Явная проверка конца строки
             charCategory = 19; // '$' (EOF)
         }
         else if (currentChar >= 0 && static_cast<unsigned char>(currentChar) < 128) {
             charCategory = asciiCategoryTable[static_cast<unsigned char>(currentChar)];
         }
         else {
-            //    ASCII 0-127 (, UTF-8).   ""
-            //    ,     ASCII.
-            //  ,   "".
+            // Символ вне диапазона ASCII 0-127 (например, UTF-8). Считаем его "другим"
+            // или можно выдать ошибку, если язык поддерживает только ASCII.
+            // Для простоты, пока считаем "другим".
             charCategory = 18;
         }
 
         int semanticAction = stateTransitionTable[static_cast<int>(currentState)][charCategory];
 
         switch (semanticAction) {
-        case 0: //   (, \t, \r),   START
+        case 0: // Игнорировать символ (пробел, \t, \r), остаться в START
             consumeChar();
             currentState = LexerState::START;
-            currentLexemeText = ""; //  
+            if (bulkScanning) skipCharRun(currentState); // Остаток участка пробелов и переводов строк
+            lexemeStart = currentPos; // Сброс лексемы
             break;
-        case 1: //  
-            currentLexemeText += consumeChar();
-            currentState = LexerState::IDENTIFIER; //    1 (IDENTIFIER)
+        case 1: // Начало идентификатора
+            lexemeStart = currentPos;
+            consumeChar();
+            currentState = LexerState::IDENTIFIER; // Переход в состояние 1 (IDENTIFIER)
+            if (bulkScanning) skipCharRun(currentState);
             break;
-        case 2: //   
-            currentLexemeText += consumeChar();
-            currentState = LexerState::NUMBER_INT; //    2 (NUMBER_INT)
+        case 2: // Начало целого числа
+            lexemeStart = currentPos;
+            consumeChar();
+            currentState = LexerState::NUMBER_INT; // Переход в состояние 2 (NUMBER_INT)
+            if (bulkScanning) skipCharRun(currentState);
             break;
-        case 3: //    (  NUMBER_FLOAT_DECIMAL)
-            currentLexemeText += consumeChar(); // '.'
+        case 3: // Точка после цифр (переход в NUMBER_FLOAT_DECIMAL)
+            consumeChar(); // '.'
             currentState = static_cast<LexerState>(3); // NUMBER_FLOAT_DECIMAL
+            if (bulkScanning) skipCharRun(currentState);
             break;
-        case 10: //  
-            currentLexemeText += consumeChar();
-            // currentState  LexerState::IDENTIFIER
+        case 10: // Продолжить идентификатор
+            consumeChar();
+            // currentState остается LexerState::IDENTIFIER
             break;
-        case 11: //  / 
-            //   ,    
-            if (auto kwType = symbolTable.getKeywordType(currentLexemeText); kwType.has_value()) {
-                return createFinalToken(kwType.value(), currentLexemeText);
-            }
-            else {
-                return createFinalToken(TokenType::T_IDENTIFIER, currentLexemeText);
+        case 11: // Завершить идентификатор/ключевое слово
+            // Символ НЕ потребляем, он начнет следующий токен
+        {
+            std::string_view lexeme = sourceCode.substr(lexemeStart, currentPos - lexemeStart);
+            if (auto kwType = SymbolTable::getKeywordType(lexeme); kwType.has_value()) {
+                return createFinalToken(kwType.value(), lexeme);
             }
-            // break; //  , .. return
-        case 20: //   
-            currentLexemeText += consumeChar();
-            // currentState  LexerState::NUMBER_INT
+            // Идентификатор хешируется здесь один раз; парсер и таблица символов дальше используют номер
+            Token token = createFinalToken(TokenType::T_IDENTIFIER, lexeme);
+            token.identifierId = symbolTable.internIdentifier(lexeme);
+            return token;
+        }
+        case 20: // Продолжить целое число
+            consumeChar();
+            // currentState остается LexerState::NUMBER_INT
             break;
-        case 21: //   
-            //   
-            try {
-                return createIntToken(std::stoi(currentLexemeText), currentLexemeText);
-            }
-            catch (const std::out_of_range& oor) {
-                errorHandler.logLexicalError("Integer literal '" + currentLexemeText + "' is out of range.", currentLine, getCurrentColumn() - static_cast<int>(currentLexemeText.length()));
-                return Token(TokenType::T_ERROR, currentLine, getCurrentColumn() - static_cast<int>(currentLexemeText.length()));
+        case 21: // Завершить целое число
+            // Символ НЕ потребляем
+        {
+            std::string_view lexeme = sourceCode.substr(lexemeStart, currentPos - lexemeStart);
+            int value = 0;
+            std::from_chars_result parsed = std::from_chars(lexeme.data(), lexeme.data() + lexeme.size(), value);
+            if (parsed.ec == std::errc::result_out_of_range) {
+                errorHandler.logLexicalError("Integer literal '" + std::string(lexeme) + "' is out of range.", currentLine, getCurrentColumn() - static_cast<int>(lexeme.length()));
+                return Token(TokenType::T_ERROR, currentLine, getCurrentColumn() - static_cast<int>(lexeme.length()));
             }
-            // break; //  
-        case 22: //    float
-            currentLexemeText += consumeChar();
+            return createIntToken(value, lexeme);
+        }
+        case 22: // Продолжить дробную часть float
+            consumeChar();
             currentState = static_cast<LexerState>(3); // NUMBER_FLOAT_DECIMAL
             break;
-        case 23: //  float
-            //   
-            // ,       (e.g. "12.")
-            if (currentLexemeText.back() == '.') {
-                errorHandler.logLexicalError("Malformed float literal '" + currentLexemeText + "'. Digit expected after decimal point.", currentLine, getCurrentColumn() - static_cast<int>(currentLexemeText.length()));
-                return Token(TokenType::T_ERROR, currentLine, getCurrentColumn() - static_cast<int>(currentLexemeText.length()));
-            }
-            try {
-                return createFloatToken(std::stof(currentLexemeText), currentLexemeText);
+        case 23: // Завершить float
+            // Символ НЕ потребляем
+        {
+            std::string_view lexeme = sourceCode.substr(lexemeStart, currentPos - lexemeStart);
+            // Проверка, если после точки не было цифр (e.g. "12.")
+            if (lexeme.back() == '.') {
+                errorHandler.logLexicalError("Malformed float literal '" + std::string(lexeme) + "'. Digit expected after decimal point.", currentLine, getCurrentColumn() - static_cast<int>(lexeme.length()));
+                return Token(TokenType::T_ERROR, currentLine, getCurrentColumn() - static_cast<int>(lexeme.length()));
             }
-            catch (const std::out_of_range& oor) {
-                errorHandler.logLexicalError("Float literal '" + currentLexemeText + "' is out of range.", currentLine, getCurrentColumn() - static_cast<int>(currentLexemeText.length()));
-                return Token(TokenType::T_ERROR, currentLine, getCurrentColumn() - static_cast<int>(currentLexemeText.length()));
+            float value = 0.0f;
+            std::from_chars_result parsed = std::from_chars(lexeme.data(), lexeme.data() + lexeme.size(), value);
+            if (parsed.ec == std::errc::result_out_of_range) {
+                errorHandler.logLexicalError("Float literal '" + std::string(lexeme) + "' is out of range.", currentLine, getCurrentColumn() - static_cast<int>(lexeme.length()));
+                return Token(TokenType::T_ERROR, currentLine, getCurrentColumn() - static_cast<int>(lexeme.length()));
             }
-            // break; //  
+            return createFloatToken(value, lexeme);
+        }
 
-        //   (30-43)
-        case 30: consumeChar(); return createFinalToken(TokenType::T_PLUS, "+");
-        case 31: consumeChar(); return createFinalToken(TokenType::T_MINUS, "-");
-        case 32: consumeChar(); return createFinalToken(TokenType::T_ASSIGN, "=");
-        case 33: consumeChar(); return createFinalToken(TokenType::T_MULTIPLY, "*");
-        case 34: consumeChar(); return createFinalToken(TokenType::T_DIVIDE, "/");
-        case 35: consumeChar(); return createFinalToken(TokenType::T_LPAREN, "(");
-        case 36: consumeChar(); return createFinalToken(TokenType::T_RPAREN, ")");
-        case 37: consumeChar(); return createFinalToken(TokenType::T_LBRACKET, "[");
-        case 38: consumeChar(); return createFinalToken(TokenType::T_RBRACKET, "]");
-        case 39: consumeChar(); return createFinalToken(TokenType::T_EQUAL, "~");
-        case 40: consumeChar(); return createFinalToken(TokenType::T_GREATER, ">");
-        case 41: consumeChar(); return createFinalToken(TokenType::T_LESS, "<");
-        case 42: consumeChar(); return createFinalToken(TokenType::T_NOT_EQUAL, "!");
-        case 43: consumeChar(); return createFinalToken(TokenType::T_SEMICOLON, ";");
-            // case 18  START ( \n)   consumeChar()  currentState = LexerState::START
+        // Односимвольные токены (30-43)
+        case 30: consumeChar(); return createFinalToken(TokenType::T_PLUS);
+        case 31: consumeChar(); return createFinalToken(TokenType::T_MINUS);
+        case 32: consumeChar(); return createFinalToken(TokenType::T_ASSIGN);
+        case 33: consumeChar(); return createFinalToken(TokenType::T_MULTIPLY);
+        case 34: consumeChar(); return createFinalToken(TokenType::T_DIVIDE);
+        case 35: consumeChar(); return createFinalToken(TokenType::T_LPAREN);
+        case 36: consumeChar(); return createFinalToken(TokenType::T_RPAREN);
+        case 37: consumeChar(); return createFinalToken(TokenType::T_LBRACKET);
+        case 38: consumeChar(); return createFinalToken(TokenType::T_RBRACKET);
+        case 39: consumeChar(); return createFinalToken(TokenType::T_EQUAL);
+        case 40: consumeChar(); return createFinalToken(TokenType::T_GREATER);
+        case 41: consumeChar(); return createFinalToken(TokenType::T_LESS);
+        case 42: consumeChar(); return createFinalToken(TokenType::T_NOT_EQUAL);
+        case 43: consumeChar(); return createFinalToken(TokenType::T_SEMICOLON);
+            // case 18 из START (категория \n) была обработана consumeChar() и currentState = LexerState::START
 
-        case 45: //  -     
+        case 45: // Ошибка - неизвестный символ в текущем состоянии
         {
             char errChar = consumeChar();
             std::string msg = "Unexpected character '";
@@ -244,29 +328,33 @@ Token Lexer::getNextToken() {
             else msg += "\\" + std::to_string(static_cast<unsigned char>(errChar));
             msg += "'.";
             errorHandler.logLexicalError(msg, currentLine, getCurrentColumn() - 1);
-            //   ,       
-            //       .
-            return Token(TokenType::T_ERROR, currentLine, getCurrentColumn() - 1); // -1     
+            // Возвращаем токен ошибки, чтобы парсер мог его обработать или пропустить
+            // Позиция в токене ошибки уже будет корректной.
+            return Token(TokenType::T_ERROR, currentLine, getCurrentColumn() - 1); // -1 потому что символ уже съеден
         }
         case 46: // EOF
             return createFinalToken(TokenType::T_EOF);
 
-        case 47: //  float   (, ".5")
-            currentLexemeText = "0"; //  "0"   stof(".5") -> stof("0.5")
-            currentLexemeText += consumeChar(); //    '.'
-            currentState = static_cast<LexerState>(3); //   NUMBER_FLOAT_DECIMAL
-            //      ,      NUMBER_FLOAT_DECIMAL ( 23)
+        case 47: // Начало float с точки (например, ".5"; from_chars разбирает такую запись без ведущего нуля)
+            lexemeStart = currentPos;
+            consumeChar(); // Точка '.'
+            if (bulkScanning) skipCharRun(LexerState::NUMBER_FLOAT_DECIMAL);
+            currentState = static_cast<LexerState>(3); // Переход в NUMBER_FLOAT_DECIMAL
+            // Если сразу после точки не цифра, это будет обработано в состоянии NUMBER_FLOAT_DECIMAL (действие 23)
             break;
 
-        case 99: //  /  
+        case 48: // Строка в кавычках
+            return readStringLiteral();
+
+        case 99: // Недостижимое состояние/ошибка в таблице
             errorHandler.logLexicalError("Internal Lexer Error: Unreachable state or invalid action 99.", currentLine, getCurrentColumn());
-            consumeChar(); //   
+            consumeChar(); // Попытка пропустить символ
             return Token(TokenType::T_ERROR, currentLine, getCurrentColumn() - 1);
 
 
-        default: //    -  
+        default: // Неизвестное семантическое действие - внутренняя ошибка
             errorHandler.logLexicalError("Internal Lexer Error: Unknown semantic action " + std::to_string(semanticAction) + ".", currentLine, getCurrentColumn());
-            consumeChar(); //   ,    
+            consumeChar(); // Попытка пропустить символ, чтобы избежать бесконечного цикла
             return Token(TokenType::T_ERROR, currentLine, getCurrentColumn() - 1);
         }
     }
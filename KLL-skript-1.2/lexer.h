@@ -3,51 +3,59 @@
 #define LEXER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "definitions.h"    // TokenType, LexerState
-#include "token.h"          //  Token
-#include "symbol_table.h"   //    
-#include "error_handler.h"  //   
+#include "token.h"          // Структура Token
+#include "symbol_table.h"   // Для проверки ключевых слов
+#include "error_handler.h"  // Для логирования ошибок
 
 class Lexer {
 private:
-    const std::string& sourceCode; //    
-    size_t currentPos;             //    sourceCode
-    int currentLine;               //   
-    int lineStartPos;              //     (  )
-
-    SymbolTable& symbolTable;      //    
-    ErrorHandler& errorHandler;    //    
-
-    //    
-    // [][ ] ->   
-    // : 0-START, 1-IDENTIFIER, 2-NUMBER_INT, 3-NUMBER_FLOAT_DECIMAL, 4-NUMBER_FLOAT_EXP
-    //  : .   asciiCategoryTable
-    static const int stateTransitionTable[5][21]; //     float
-
-    //   ASCII    
-    // : 0:'a'-'z','A'-'Z', 1:'0'-'9', 2:'+', 3:'-', 4:'=', 5:'*', 6:'/',
+    std::string_view sourceCode;   // Исходный код (буфер принадлежит вызывающему, токены ссылаются в него)
+    size_t currentPos;             // Текущая позиция в sourceCode
+    int currentLine;               // Текущий номер строки
+    int lineStartPos;              // Позиция начала текущей строки (для вычисления столбца)
+
+    bool bulkScanning;             // Пропуск однородных участков блоками (SIMD), см. skipCharRun
+
+    SymbolTable& symbolTable;      // Ссылка на таблицу символов
+    ErrorHandler& errorHandler;    // Ссылка на обработчик ошибок
+
+    // Таблицы для конечного автомата
+    // [Состояние][Категория символа] -> Номер семантического действия
+    // Состояния: 0-START, 1-IDENTIFIER, 2-NUMBER_INT, 3-NUMBER_FLOAT_DECIMAL, 4-NUMBER_FLOAT_EXP
+    // Категории символов: см. комментарии к asciiCategoryTable
+    static const int stateTransitionTable[5][22]; // Увеличено количество состояний для float
+
+    // Таблица преобразования ASCII кодов в категории символов
+    // Категории: 0:'a'-'z','A'-'Z', 1:'0'-'9', 2:'+', 3:'-', 4:'=', 5:'*', 6:'/',
     //            7:' ', 8:'(', 9:')', 10:'[', 11:']', 12:'~', 13:'>', 14:'<',
-    //            15:'!', 16:';', 17:'\n', 18:other_printable, 19:'$', 20:'.' (  float)
+    //            15:'!', 16:';', 17:'\n', 18:other_printable, 19:'$', 20:'.' (точка для float), 21:'"
     static const int asciiCategoryTable[128];
 
-    //  
-    char peekChar(size_t offset = 0) const; //    ,   
-    char consumeChar();                     //      
-    int getCurrentColumn() const;           //   
+    // Вспомогательные методы
+    char peekChar(size_t offset = 0) const; // Посмотреть символ со смещением, не сдвигая позицию
+    char consumeChar();                     // Прочитать текущий символ и сдвинуть позицию
+    int getCurrentColumn() const;           // Вычислить текущий столбец
+    void skipCharRun(LexerState state);     // Пропустить символы, которые КА в состоянии state только потребил бы
 
-    //    ,  errorHandler  
-    Token createFinalToken(TokenType type, const std::string& text = "");
-    Token createIntToken(int value, const std::string& text);
-    Token createFloatToken(float value, const std::string& text);
-    // createErrorToken    , ..    errorHandler
+    // Методы для создания токенов, используя errorHandler для сообщений
+    Token createFinalToken(TokenType type, std::string_view text = {});
+    Token createIntToken(int value, std::string_view text);
+    Token createFloatToken(float value, std::string_view text);
+    Token readStringLiteral(); // Строка в кавычках (без escape-последовательностей, в пределах одной строки)
+    // createErrorToken теперь не нужен здесь, т.к. ошибки логируются через errorHandler
 
 public:
-    Lexer(const std::string& source, SymbolTable& symTable, ErrorHandler& errHandler);
+    Lexer(std::string_view source, SymbolTable& symTable, ErrorHandler& errHandler);
 
-    //     ( )
+    // Основная функция лексического анализатора (реализация КА)
     Token getNextToken();
+
+    // Отключение быстрого пропуска (для сравнения с чисто табличным КА); на результат не влияет
+    void setBulkScanning(bool enabled) { bulkScanning = enabled; }
 };
 
 #endif // LEXER_H
\ No newline at end of file
@@ -0,0 +1,396 @@
+// loop_parallelizer.cpp
+#include "loop_parallelizer.h"
+#include <algorithm> // Для std::find
+
+namespace {
+
+    bool isVar(const RPNOperation& op, size_t index) {
+        return op.opCode == RPNOpCode::PUSH_VAR_ADDR && op.symbolIndex && op.symbolIndex.value() == index;
+    }
+
+    // Обращения к скалярной переменной в теле цикла (позиции - адреса ОПС, т.е. порядок выполнения)
+    struct ScalarUsage {
+        int firstReadAt = -1;
+        int firstWriteAt = -1;          // Адрес PUSH_VAR_ADDR цели первого присваивания
+        int firstWriteAssignAt = -1;    // Адрес ASSIGN этого присваивания
+        bool firstWriteIsUnconditional = false;
+        int reads = 0;
+        int writes = 0;
+        int sumStatements = 0;          // Присваивания вида s = s + E / s = s - E
+    };
+}
+
+LoopParallelizer::LoopParallelizer(std::vector<RPNOperation>& code, const SymbolTable& symTab)
+    : rpnCode(code), symbolTable(symTab) {
+}
+
+void LoopParallelizer::run(std::vector<ParallelLoopInfo>& loops) {
+    reports.clear();
+    for (size_t i = 0; i < rpnCode.size(); ++i) {
+        const RPNOperation& op = rpnCode[i];
+        // Цикл while заканчивается обратным переходом на свой заголовок
+        if (op.opCode != RPNOpCode::JUMP || !op.jumpTarget || op.jumpTarget.value() < 0 ||
+            op.jumpTarget.value() >= static_cast<int>(i)) {
+            continue;
+        }
+        int header = op.jumpTarget.value();
+        if (header > 0 && rpnCode[header - 1].opCode == RPNOpCode::PARALLEL_LOOP) {
+            continue; // Явный параллельный цикл - описатель уже построен парсером
+        }
+        ParallelLoopReport report{ header, static_cast<int>(i), false, "" };
+        if (rpnCode[header].loopInfoIndex) {
+            // Векторное выполнение в одном потоке быстрее интерпретации тела в нескольких
+            report.reason = "vectorized instead";
+            reports.push_back(report);
+            continue;
+        }
+        ParallelLoopInfo info;
+        report.parallelized = analyzeLoop(header, static_cast<int>(i), info, report.reason);
+        reports.push_back(report);
+        if (report.parallelized) {
+            rpnCode[header].parallelInfoIndex = loops.size();
+            loops.push_back(std::move(info));
+        }
+    }
+}
+
+bool LoopParallelizer::analyzeLoop(int header, int backJump, ParallelLoopInfo& info, std::string& reason) const {
+    // Заголовок: PUSH_VAR_ADDR i; PUSH_VAR_ADDR n | PUSH_CONST_INT k; CMP_LT; JUMP_FALSE (выход)
+    if (backJump - header < 10) {
+        reason = "loop body is too short";
+        return false;
+    }
+    const RPNOperation& inductionOp = rpnCode[header];
+    const RPNOperation& boundOp = rpnCode[header + 1];
+    const RPNOperation& exitOp = rpnCode[header + 3];
+    if (inductionOp.opCode != RPNOpCode::PUSH_VAR_ADDR || rpnCode[header + 2].opCode != RPNOpCode::CMP_LT ||
+        exitOp.opCode != RPNOpCode::JUMP_FALSE || !exitOp.jumpTarget || exitOp.jumpTarget.value() != backJump + 1) {
+        reason = "condition is not of the form 'i < n'";
+        return false;
+    }
+    size_t inductionVar = inductionOp.symbolIndex.value();
+    if (symbolTable.getSymbolType(inductionVar) != SymbolType::VARIABLE_INT) {
+        reason = "loop variable is not an int";
+        return false;
+    }
+    info.boundConst = 0;
+    if (boundOp.opCode == RPNOpCode::PUSH_CONST_INT) {
+        info.boundConst = std::get<int>(boundOp.operandValue);
+    }
+    else if (boundOp.opCode == RPNOpCode::PUSH_VAR_ADDR &&
+        symbolTable.getSymbolType(boundOp.symbolIndex.value()) == SymbolType::VARIABLE_INT &&
+        boundOp.symbolIndex.value() != inductionVar) {
+        info.boundVarIndex = boundOp.symbolIndex.value();
+    }
+    else {
+        reason = "loop bound is not an int variable or constant";
+        return false;
+    }
+
+    // Тело заканчивается инкрементом: PUSH_VAR_ADDR i; PUSH_VAR_ADDR i; PUSH_CONST_INT 1; ADD; ASSIGN
+    int bodyStart = header + 4;
+    int bodyEnd = backJump - 5;
+    const RPNOperation& step = rpnCode[bodyEnd + 2];
+    if (!isVar(rpnCode[bodyEnd], inductionVar) || !isVar(rpnCode[bodyEnd + 1], inductionVar) ||
+        step.opCode != RPNOpCode::PUSH_CONST_INT || std::get<int>(step.operandValue) != 1 ||
+        rpnCode[bodyEnd + 3].opCode != RPNOpCode::ADD || rpnCode[bodyEnd + 4].opCode != RPNOpCode::ASSIGN) {
+        reason = "last statement is not 'i = i + 1'";
+        return false;
+    }
+
+    // Условно выполняемые операции (внутри if/else): в теле допустимы только переходы вперед
+    std::vector<int> conditionalDepth(static_cast<size_t>(bodyEnd - bodyStart + 1), 0);
+    for (int p = bodyStart; p < bodyEnd; ++p) {
+        const RPNOperation& op = rpnCode[p];
+        if (op.opCode != RPNOpCode::JUMP && op.opCode != RPNOpCode::JUMP_FALSE) continue;
+        int target = op.jumpTarget.value_or(-1);
+        if (target <= p) {
+            reason = "loop body contains a nested loop";
+            return false;
+        }
+        if (target > bodyEnd) {
+            reason = "unsupported control flow in loop body";
+            return false;
+        }
+        conditionalDepth[p + 1 - bodyStart] += 1;
+        conditionalDepth[target - bodyStart] -= 1;
+    }
+    for (size_t k = 1; k < conditionalDepth.size(); ++k) conditionalDepth[k] += conditionalDepth[k - 1];
+
+    // Символьное выполнение тела на стеке: кто читается, кто записывается и какими индексами
+    enum class ItemKind { VALUE, VAR, ARRAY_BASE, ELEMENT };
+    struct Item {
+        ItemKind kind;
+        size_t symbol;   // VAR, ARRAY_BASE, ELEMENT
+        int pushedAt;    // Адрес PUSH_VAR_ADDR для VAR
+        AffineForm form; // VALUE - значение, ELEMENT - индекс
+        bool isSumOfSymbol; // VALUE = symbol + E или symbol - E (symbol - прочитанная напрямую переменная)
+    };
+
+    std::vector<size_t> writtenScalars;
+    std::map<size_t, ScalarUsage> usage;
+    std::vector<ArrayAccess> accesses;
+
+    auto simulate = [&](bool collectOnly) -> bool {
+        std::vector<Item> stack;
+        auto pop = [&](Item& item) {
+            if (stack.empty()) {
+                reason = "unsupported expression shape";
+                return false;
+            }
+            item = stack.back();
+            stack.pop_back();
+            return true;
+        };
+        // Использование элемента стека как значения (чтение переменной или элемента массива)
+        auto valueOf = [&](const Item& item) {
+            AffineForm form;
+            if (item.kind == ItemKind::VALUE) return item.form;
+            if (item.kind == ItemKind::ELEMENT) {
+                if (!collectOnly) accesses.push_back({ item.symbol, false, item.form });
+                return form;
+            }
+            if (item.kind != ItemKind::VAR) return form;
+            if (item.symbol == inductionVar) {
+                form.isAffine = true;
+                form.coefficient = 1;
+            }
+            else if (std::find(writtenScalars.begin(), writtenScalars.end(), item.symbol) != writtenScalars.end()) {
+                // Чтения считаются только во втором проходе: в первом множество writtenScalars еще неполное
+                if (collectOnly) return form;
+                ScalarUsage& use = usage[item.symbol];
+                if (use.firstReadAt < 0) use.firstReadAt = item.pushedAt;
+                ++use.reads;
+            }
+            else if (symbolTable.getSymbolType(item.symbol) == SymbolType::VARIABLE_INT) {
+                form.isAffine = true;
+                form.terms[item.symbol] = 1;
+            }
+            return form;
+        };
+
+        for (int p = bodyStart; p < bodyEnd; ++p) {
+            const RPNOperation& op = rpnCode[p];
+            Item left{}, right{};
+            switch (op.opCode) {
+            case RPNOpCode::PUSH_CONST_INT: {
+                Item item{ ItemKind::VALUE, 0, p, AffineForm{}, false };
+                item.form.isAffine = true;
+                item.form.constant = std::get<int>(op.operandValue);
+                stack.push_back(item);
+                break;
+            }
+            case RPNOpCode::PUSH_CONST_FLOAT:
+                stack.push_back({ ItemKind::VALUE, 0, p, AffineForm{}, false });
+                break;
+            case RPNOpCode::PUSH_VAR_ADDR:
+                stack.push_back({ ItemKind::VAR, op.symbolIndex.value(), p, AffineForm{}, false });
+                break;
+            case RPNOpCode::PUSH_ARRAY_ADDR:
+                stack.push_back({ ItemKind::ARRAY_BASE, op.symbolIndex.value(), p, AffineForm{}, false });
+                break;
+            case RPNOpCode::INDEX: {
+                if (!pop(right) || !pop(left)) return false;
+                if (left.kind != ItemKind::ARRAY_BASE) {
+                    reason = "unsupported expression shape";
+                    return false;
+                }
+                stack.push_back({ ItemKind::ELEMENT, left.symbol, p, valueOf(right), false });
+                break;
+            }
+            case RPNOpCode::ADD:
+            case RPNOpCode::SUB:
+            case RPNOpCode::MUL:
+            case RPNOpCode::DIV: {
+                if (!pop(right) || !pop(left)) return false;
+                AffineForm a = valueOf(left);
+                AffineForm b = valueOf(right);
+                Item result{ ItemKind::VALUE, 0, p, AffineForm{}, false };
+                if (op.opCode == RPNOpCode::ADD || op.opCode == RPNOpCode::SUB) {
+                    long long sign = (op.opCode == RPNOpCode::ADD) ? 1 : -1;
+                    if (a.isAffine && b.isAffine) {
+                        result.form = a;
+                        result.form.coefficient += sign * b.coefficient;
+                        result.form.constant += sign * b.constant;
+                        for (const auto& term : b.terms) {
+                            result.form.terms[term.first] += sign * term.second;
+                            if (result.form.terms[term.first] == 0) result.form.terms.erase(term.first);
+                        }
+                    }
+                    if (left.kind == ItemKind::VAR) {
+                        result.symbol = left.symbol;
+                        result.isSumOfSymbol = true;
+                    }
+                }
+                else if (op.opCode == RPNOpCode::MUL && a.isAffine && b.isAffine) {
+                    // Аффинно только произведение на константу
+                    bool aConst = a.coefficient == 0 && a.terms.empty();
+                    bool bConst = b.coefficient == 0 && b.terms.empty();
+                    if (aConst || bConst) {
+                        long long factor = aConst ? a.constant : b.constant;
+                        result.form = aConst ? b : a;
+                        result.form.coefficient *= factor;
+                        result.form.constant *= factor;
+                        for (auto& term : result.form.terms) term.second *= factor;
+                        if (factor == 0) result.form.terms.clear();
+                    }
+                }
+                stack.push_back(result);
+                break;
+            }
+            case RPNOpCode::CMP_EQ:
+            case RPNOpCode::CMP_NE:
+            case RPNOpCode::CMP_GT:
+            case RPNOpCode::CMP_LT:
+                if (!pop(right) || !pop(left)) return false;
+                valueOf(left);
+                valueOf(right);
+                stack.push_back({ ItemKind::VALUE, 0, p, AffineForm{}, false });
+                break;
+            case RPNOpCode::CONVERT_TO_FLOAT:
+            case RPNOpCode::CONVERT_TO_INT:
+                if (!pop(left)) return false;
+                valueOf(left);
+                stack.push_back({ ItemKind::VALUE, 0, p, AffineForm{}, false });
+                break;
+            case RPNOpCode::JUMP_FALSE:
+                if (!pop(left)) return false;
+                valueOf(left);
+                break;
+            case RPNOpCode::JUMP:
+                break;
+            case RPNOpCode::ASSIGN: {
+                if (!pop(right) || !pop(left)) return false;
+                AffineForm value = valueOf(right);
+                (void)value;
+                if (left.kind == ItemKind::ELEMENT) {
+                    if (!collectOnly) accesses.push_back({ left.symbol, true, left.form });
+                }
+                else if (left.kind == ItemKind::VAR) {
+                    size_t target = left.symbol;
+                    if (target == inductionVar) {
+                        reason = "loop variable is modified in the body";
+                        return false;
+                    }
+                    if (collectOnly) {
+                        if (std::find(writtenScalars.begin(), writtenScalars.end(), target) == writtenScalars.end()) {
+                            writtenScalars.push_back(target);
+                        }
+                        break;
+                    }
+                    ScalarUsage& use = usage[target];
+                    if (use.firstWriteAt < 0) {
+                        use.firstWriteAt = left.pushedAt;
+                        use.firstWriteAssignAt = p;
+                        use.firstWriteIsUnconditional = conditionalDepth[left.pushedAt - bodyStart] == 0;
+                    }
+                    ++use.writes;
+                    if (right.kind == ItemKind::VALUE && right.isSumOfSymbol && right.symbol == target) {
+                        ++use.sumStatements;
+                    }
+                }
+                else {
+                    reason = "unsupported assignment in loop body";
+                    return false;
+                }
+                break;
+            }
+            case RPNOpCode::READ_INT:
+            case RPNOpCode::READ_FLOAT:
+            case RPNOpCode::WRITE_INT:
+            case RPNOpCode::WRITE_FLOAT:
+                reason = "loop body contains I/O";
+                return false;
+            case RPNOpCode::VEC_ADD:
+            case RPNOpCode::VEC_SUB:
+            case RPNOpCode::VEC_MUL:
+            case RPNOpCode::VEC_DIV:
+            case RPNOpCode::VEC_ASSIGN:
+            case RPNOpCode::VEC_SUM:
+                reason = "loop body contains whole-array operations";
+                return false;
+            case RPNOpCode::PARALLEL_LOOP:
+                reason = "loop body contains a parallel loop";
+                return false;
+            }
+        }
+        if (!stack.empty()) {
+            reason = "unsupported expression shape";
+            return false;
+        }
+        return true;
+    };
+
+    // Первый проход - множество изменяемых скаляров, второй - обращения с учетом этого множества
+    if (!simulate(true) || !simulate(false)) return false;
+
+    if (info.boundVarIndex && std::find(writtenScalars.begin(), writtenScalars.end(), info.boundVarIndex.value()) != writtenScalars.end()) {
+        reason = "loop bound is modified in the body";
+        return false;
+    }
+
+    // Скалярные зависимости: приватные переменные и суммы
+    for (size_t var : writtenScalars) {
+        const ScalarUsage& use = usage[var];
+        bool isPrivate = use.firstWriteIsUnconditional &&
+            (use.firstReadAt < 0 || use.firstReadAt > use.firstWriteAssignAt);
+        if (isPrivate) {
+            info.privateScalars.push_back(var);
+            continue;
+        }
+        bool isSum = use.sumStatements == use.writes && use.reads == use.writes;
+        if (isSum && symbolTable.getSymbolType(var) != SymbolType::VARIABLE_INT) {
+            reason = "float reduction into '" + symbolTable.getSymbolName(var) + "' would change rounding";
+            return false;
+        }
+        if (!isSum) {
+            reason = "loop-carried dependence through '" + symbolTable.getSymbolName(var) + "'";
+            return false;
+        }
+        info.reductions.push_back({ ParallelReduction::Kind::SUM, var });
+    }
+
+    if (!checkArrayAccesses(accesses, reason)) return false;
+
+    info.headerAddress = header;
+    info.bodyStart = bodyStart;
+    info.backJumpAddress = backJump;
+    info.exitAddress = backJump + 1;
+    info.inductionVarIndex = inductionVar;
+    info.automatic = true;
+    return true;
+}
+
+bool LoopParallelizer::checkArrayAccesses(const std::vector<ArrayAccess>& accesses, std::string& reason) const {
+    for (const ArrayAccess& write : accesses) {
+        if (!write.isWrite) continue;
+        const std::string& name = symbolTable.getSymbolName(write.arrayIndex);
+        if (!write.index.isAffine) {
+            reason = "index of '" + name + "' is not affine in the loop variable";
+            return false;
+        }
+        if (write.index.coefficient == 0) {
+            reason = "'" + name + "' is written at a loop-invariant index";
+            return false;
+        }
+        for (const ArrayAccess& other : accesses) {
+            if (other.arrayIndex != write.arrayIndex) continue;
+            if (!other.index.isAffine) {
+                reason = "index of '" + name + "' is not affine in the loop variable";
+                return false;
+            }
+            // c*i1 + d1 = c*i2 + d2 при i1 != i2 возможно, только если d2 - d1 кратно c и не равно 0
+            if (other.index.coefficient != write.index.coefficient || other.index.terms != write.index.terms) {
+                reason = "cannot prove independence of accesses to '" + name + "'";
+                return false;
+            }
+            long long distance = other.index.constant - write.index.constant;
+            if (distance != 0 && distance % write.index.coefficient == 0) {
+                reason = "loop-carried dependence on '" + name + "' (distance " +
+                    std::to_string(distance / write.index.coefficient) + ")";
+                return false;
+            }
+        }
+    }
+    return true;
+}
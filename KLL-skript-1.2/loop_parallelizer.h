@@ -0,0 +1,68 @@
+// loop_parallelizer.h
+#ifndef LOOP_PARALLELIZER_H
+#define LOOP_PARALLELIZER_H
+
+#include <vector>
+#include <string>
+#include <map>
+
+#include "definitions.h"  // RPNOpCode, SymbolType
+#include "rpn_op.h"       // RPNOperation
+#include "symbol_table.h" // SymbolTable
+#include "parallel_loop.h" // ParallelLoopInfo
+
+// --- Автоматическое распараллеливание счетных циклов ---
+// Анализ зависимостей для циклов вида while (i < n) begin ... ; i = i + 1 end без вложенных циклов и ввода-вывода.
+// Цикл признается параллельным, если ни одна итерация не зависит от результатов другой:
+//  - каждый изменяемый массив индексируется аффинно (c*i + d, d - инвариант цикла) с одинаковыми c и d
+//    во всех обращениях (или d отличаются на величину, не кратную c);
+//  - каждая изменяемая скалярная переменная либо приватна (безусловно присваивается до первого чтения
+//    в итерации), либо является целочисленной суммой s = s + E / s = s - E.
+// Код цикла не меняется: первая операция заголовка помечается индексом описателя
+// (RPNOperation::parallelInfoIndex), а решение о параллельном выполнении с учетом объема работы
+// принимает интерпретатор.
+
+// Решение по отдельному циклу (для отладочного вывода ОПС)
+struct ParallelLoopReport {
+    int headerAddress;
+    int backJumpAddress;
+    bool parallelized;
+    std::string reason; // Причина отказа, если !parallelized
+};
+
+class LoopParallelizer {
+private:
+    // Аффинная форма значения: coefficient * i + sum(terms[v] * v) + constant,
+    // где v - скалярные переменные, не изменяемые в теле цикла
+    struct AffineForm {
+        bool isAffine = false;
+        long long coefficient = 0;
+        std::map<size_t, long long> terms;
+        long long constant = 0;
+    };
+    // Обращение к элементу массива в теле цикла
+    struct ArrayAccess {
+        size_t arrayIndex;
+        bool isWrite;
+        AffineForm index;
+    };
+
+    std::vector<RPNOperation>& rpnCode;
+    const SymbolTable& symbolTable;
+    std::vector<ParallelLoopReport> reports;
+
+    // Пытается построить описатель для цикла с заголовком header и обратным переходом backJump.
+    // При неудаче возвращает false и причину в reason.
+    bool analyzeLoop(int header, int backJump, ParallelLoopInfo& info, std::string& reason) const;
+    bool checkArrayAccesses(const std::vector<ArrayAccess>& accesses, std::string& reason) const;
+
+public:
+    LoopParallelizer(std::vector<RPNOperation>& code, const SymbolTable& symTab);
+
+    // Находит подходящие циклы, помечает их заголовки и добавляет описатели в loops
+    // (явные параллельные циклы и уже векторизованные циклы пропускаются)
+    void run(std::vector<ParallelLoopInfo>& loops);
+    const std::vector<ParallelLoopReport>& getReports() const { return reports; }
+};
+
+#endif // LOOP_PARALLELIZER_H
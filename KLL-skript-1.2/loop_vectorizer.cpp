@@ -0,0 +1,307 @@
+// loop_vectorizer.cpp
+#include "loop_vectorizer.h"
+#include <algorithm> // Для std::find
+#include <cmath>     // Для std::abs
+
+namespace {
+
+    // Элемент стека при разборе выражения тела цикла
+    struct ExprItem {
+        bool isVector;
+        bool isFloat;
+        bool isConst;
+        double constValue;
+    };
+
+    void addUnique(std::vector<size_t>& list, size_t value) {
+        if (std::find(list.begin(), list.end(), value) == list.end()) {
+            list.push_back(value);
+        }
+    }
+
+    bool isVar(const RPNOperation& op, size_t index) {
+        return op.opCode == RPNOpCode::PUSH_VAR_ADDR && op.symbolIndex && op.symbolIndex.value() == index;
+    }
+}
+
+LoopVectorizer::LoopVectorizer(std::vector<RPNOperation>& code, const SymbolTable& symTab)
+    : rpnCode(code), symbolTable(symTab) {
+}
+
+std::vector<VectorLoopInfo> LoopVectorizer::run() {
+    std::vector<VectorLoopInfo> loops;
+    reports.clear();
+    for (size_t i = 0; i < rpnCode.size(); ++i) {
+        const RPNOperation& op = rpnCode[i];
+        // Цикл while заканчивается обратным переходом на свой заголовок
+        if (op.opCode != RPNOpCode::JUMP || !op.jumpTarget || op.jumpTarget.value() < 0 ||
+            op.jumpTarget.value() >= static_cast<int>(i)) {
+            continue;
+        }
+        int header = op.jumpTarget.value();
+        std::string reason;
+        std::optional<VectorLoopInfo> info = analyzeLoop(header, static_cast<int>(i), reason);
+        reports.push_back(LoopReport{ header, static_cast<int>(i), info.has_value(), info ? "" : reason });
+        if (info) {
+            rpnCode[header].loopInfoIndex = loops.size();
+            loops.push_back(std::move(info.value()));
+        }
+    }
+    return loops;
+}
+
+std::optional<VectorLoopInfo> LoopVectorizer::analyzeLoop(int header, int backJump, std::string& reason) const {
+    // Заголовок: PUSH_VAR_ADDR i; PUSH_VAR_ADDR n | PUSH_CONST_INT k; CMP_LT; JUMP_FALSE (выход)
+    if (backJump - header < 10) {
+        reason = "loop body is too short";
+        return std::nullopt;
+    }
+    const RPNOperation& inductionOp = rpnCode[header];
+    const RPNOperation& boundOp = rpnCode[header + 1];
+    const RPNOperation& exitOp = rpnCode[header + 3];
+    if (inductionOp.opCode != RPNOpCode::PUSH_VAR_ADDR || rpnCode[header + 2].opCode != RPNOpCode::CMP_LT ||
+        exitOp.opCode != RPNOpCode::JUMP_FALSE || !exitOp.jumpTarget || exitOp.jumpTarget.value() != backJump + 1) {
+        reason = "condition is not of the form 'i < n'";
+        return std::nullopt;
+    }
+
+    VectorLoopInfo info;
+    info.headerAddress = header;
+    info.backJumpAddress = backJump;
+    info.inductionVarIndex = inductionOp.symbolIndex.value();
+    info.boundConst = 0;
+    info.scalarOpsPerIteration = backJump - header + 1;
+
+    if (symbolTable.getSymbolType(info.inductionVarIndex) != SymbolType::VARIABLE_INT) {
+        reason = "loop variable is not an int";
+        return std::nullopt;
+    }
+    if (boundOp.opCode == RPNOpCode::PUSH_CONST_INT) {
+        info.boundConst = std::get<int>(boundOp.operandValue);
+    }
+    else if (boundOp.opCode == RPNOpCode::PUSH_VAR_ADDR &&
+        symbolTable.getSymbolType(boundOp.symbolIndex.value()) == SymbolType::VARIABLE_INT &&
+        boundOp.symbolIndex.value() != info.inductionVarIndex) {
+        info.boundVarIndex = boundOp.symbolIndex.value();
+    }
+    else {
+        reason = "loop bound is not an int variable or constant";
+        return std::nullopt;
+    }
+
+    // Переходы и ввод-вывод в теле проверяются до разбора операторов: разбиение по ASSIGN
+    // приняло бы условие if за часть присваивания и указало бы неверную причину
+    for (int p = header + 4; p < backJump; ++p) {
+        RPNOpCode code = rpnCode[p].opCode;
+        if (code == RPNOpCode::JUMP || code == RPNOpCode::JUMP_FALSE || code == RPNOpCode::PARALLEL_LOOP) {
+            reason = "control flow in loop body";
+            return std::nullopt;
+        }
+        if (code == RPNOpCode::READ_INT || code == RPNOpCode::READ_FLOAT ||
+            code == RPNOpCode::WRITE_INT || code == RPNOpCode::WRITE_FLOAT) {
+            reason = "I/O in loop body";
+            return std::nullopt;
+        }
+    }
+
+    // Тело заканчивается инкрементом: PUSH_VAR_ADDR i; PUSH_VAR_ADDR i; PUSH_CONST_INT 1; ADD; ASSIGN
+    int bodyStart = header + 4;
+    int bodyEnd = backJump - 5;
+    const RPNOperation& step = rpnCode[bodyEnd + 2];
+    if (!isVar(rpnCode[bodyEnd], info.inductionVarIndex) || !isVar(rpnCode[bodyEnd + 1], info.inductionVarIndex) ||
+        step.opCode != RPNOpCode::PUSH_CONST_INT || std::get<int>(step.operandValue) != 1 ||
+        rpnCode[bodyEnd + 3].opCode != RPNOpCode::ADD || rpnCode[bodyEnd + 4].opCode != RPNOpCode::ASSIGN) {
+        reason = "last statement is not 'i = i + 1'";
+        return std::nullopt;
+    }
+
+    // Разбиение тела на операторы (каждый заканчивается ASSIGN) и сбор записываемых скаляров
+    std::vector<std::pair<int, int>> statementRanges;
+    std::vector<size_t> writtenScalars;
+    int statementStart = bodyStart;
+    for (int p = bodyStart; p < bodyEnd; ++p) {
+        if (rpnCode[p].opCode == RPNOpCode::ASSIGN) {
+            statementRanges.emplace_back(statementStart, p);
+            if (rpnCode[statementStart].opCode == RPNOpCode::PUSH_VAR_ADDR) {
+                size_t target = rpnCode[statementStart].symbolIndex.value();
+                if (std::find(writtenScalars.begin(), writtenScalars.end(), target) != writtenScalars.end()) {
+                    reason = "variable '" + symbolTable.getSymbolName(target) + "' is assigned more than once";
+                    return std::nullopt;
+                }
+                writtenScalars.push_back(target);
+            }
+            statementStart = p + 1;
+        }
+    }
+    if (statementStart != bodyEnd || statementRanges.empty()) {
+        reason = "loop body contains control flow or I/O";
+        return std::nullopt;
+    }
+    if (info.boundVarIndex && std::find(writtenScalars.begin(), writtenScalars.end(), info.boundVarIndex.value()) != writtenScalars.end()) {
+        reason = "loop bound is modified in the body";
+        return std::nullopt;
+    }
+
+    for (const auto& range : statementRanges) {
+        int from = range.first;
+        int assignAt = range.second;
+        const RPNOperation& first = rpnCode[from];
+        VectorLoopStatement statement;
+        bool isFloat = false;
+        bool isVector = false;
+
+        if (first.opCode == RPNOpCode::PUSH_ARRAY_ADDR) {
+            // a[i] = E [CONVERT_*]
+            if (assignAt - from < 4 || !isVar(rpnCode[from + 1], info.inductionVarIndex) || rpnCode[from + 2].opCode != RPNOpCode::INDEX) {
+                reason = "array store is not indexed by the loop variable";
+                return std::nullopt;
+            }
+            int valueEnd = assignAt;
+            RPNOpCode beforeAssign = rpnCode[assignAt - 1].opCode;
+            if (beforeAssign == RPNOpCode::CONVERT_TO_INT || beforeAssign == RPNOpCode::CONVERT_TO_FLOAT) {
+                --valueEnd; // Приведение к типу элемента выполняет VEC_ASSIGN
+            }
+            statement.kind = VectorLoopStatement::Kind::ARRAY_STORE;
+            statement.targetIndex = first.symbolIndex.value();
+            addUnique(info.accessedArrays, statement.targetIndex);
+            if (!convertExpression(from + 3, valueEnd, info.inductionVarIndex, writtenScalars, info,
+                statement.valueCode, isFloat, isVector, reason)) {
+                return std::nullopt;
+            }
+        }
+        else if (first.opCode == RPNOpCode::PUSH_VAR_ADDR) {
+            // s = s + E | s = s - E (целочисленная редукция)
+            size_t target = first.symbolIndex.value();
+            RPNOpCode combine = rpnCode[assignAt - 1].opCode;
+            if (target == info.inductionVarIndex) {
+                reason = "loop variable is modified in the body";
+                return std::nullopt;
+            }
+            if (assignAt - from < 4 || !isVar(rpnCode[from + 1], target) ||
+                (combine != RPNOpCode::ADD && combine != RPNOpCode::SUB)) {
+                reason = "scalar assignment to '" + symbolTable.getSymbolName(target) + "' is not a reduction 's = s + E'";
+                return std::nullopt;
+            }
+            if (symbolTable.getSymbolType(target) != SymbolType::VARIABLE_INT) {
+                reason = "float reduction into '" + symbolTable.getSymbolName(target) + "' would change rounding";
+                return std::nullopt;
+            }
+            statement.kind = (combine == RPNOpCode::ADD) ? VectorLoopStatement::Kind::SUM_ADD : VectorLoopStatement::Kind::SUM_SUB;
+            statement.targetIndex = target;
+            if (!convertExpression(from + 2, assignAt - 1, info.inductionVarIndex, writtenScalars, info,
+                statement.valueCode, isFloat, isVector, reason)) {
+                return std::nullopt;
+            }
+            if (isFloat) {
+                reason = "float reduction into '" + symbolTable.getSymbolName(target) + "' would change rounding";
+                return std::nullopt;
+            }
+            if (!isVector) {
+                reason = "reduction into '" + symbolTable.getSymbolName(target) + "' does not read any array";
+                return std::nullopt;
+            }
+        }
+        else {
+            reason = "unsupported statement in loop body";
+            return std::nullopt;
+        }
+        info.statements.push_back(std::move(statement));
+    }
+    // Векторные ядра работают с непрерывной памятью, у разреженного массива ее нет
+    for (size_t arrayIndex : info.accessedArrays) {
+        if (symbolTable.isArraySparse(arrayIndex)) {
+            reason = "array '" + symbolTable.getSymbolName(arrayIndex) + "' uses sparse storage";
+            return std::nullopt;
+        }
+    }
+    return info;
+}
+
+bool LoopVectorizer::convertExpression(int from, int to, size_t inductionVar, const std::vector<size_t>& writtenScalars,
+    VectorLoopInfo& info, std::vector<RPNOperation>& out, bool& isFloat, bool& isVector, std::string& reason) const {
+    std::vector<ExprItem> stack;
+    for (int p = from; p < to; ++p) {
+        const RPNOperation& op = rpnCode[p];
+        switch (op.opCode) {
+        case RPNOpCode::PUSH_ARRAY_ADDR: {
+            size_t arrayIndex = op.symbolIndex.value();
+            if (p + 2 >= to || !isVar(rpnCode[p + 1], inductionVar) || rpnCode[p + 2].opCode != RPNOpCode::INDEX) {
+                reason = "array '" + symbolTable.getSymbolName(arrayIndex) + "' is not indexed by the loop variable";
+                return false;
+            }
+            addUnique(info.accessedArrays, arrayIndex);
+            stack.push_back({ true, symbolTable.getSymbolType(arrayIndex) == SymbolType::ARRAY_FLOAT, false, 0.0 });
+            out.emplace_back(RPNOpCode::PUSH_ARRAY_ADDR, arrayIndex);
+            p += 2;
+            break;
+        }
+        case RPNOpCode::PUSH_VAR_ADDR: {
+            size_t varIndex = op.symbolIndex.value();
+            if (varIndex == inductionVar) {
+                reason = "loop variable is used as a value";
+                return false;
+            }
+            if (std::find(writtenScalars.begin(), writtenScalars.end(), varIndex) != writtenScalars.end()) {
+                reason = "loop-carried dependence through '" + symbolTable.getSymbolName(varIndex) + "'";
+                return false;
+            }
+            addUnique(info.invariantScalars, varIndex);
+            stack.push_back({ false, symbolTable.getSymbolType(varIndex) == SymbolType::VARIABLE_FLOAT, false, 0.0 });
+            out.push_back(op);
+            break;
+        }
+        case RPNOpCode::PUSH_CONST_INT:
+            stack.push_back({ false, false, true, static_cast<double>(std::get<int>(op.operandValue)) });
+            out.push_back(op);
+            break;
+        case RPNOpCode::PUSH_CONST_FLOAT:
+            stack.push_back({ false, true, true, static_cast<double>(std::get<float>(op.operandValue)) });
+            out.push_back(op);
+            break;
+        case RPNOpCode::ADD:
+        case RPNOpCode::SUB:
+        case RPNOpCode::MUL:
+        case RPNOpCode::DIV: {
+            if (stack.size() < 2) {
+                reason = "unsupported expression shape";
+                return false;
+            }
+            ExprItem right = stack.back(); stack.pop_back();
+            ExprItem left = stack.back(); stack.pop_back();
+            if (op.opCode == RPNOpCode::DIV) {
+                // Деление на переменную могло бы завершиться ошибкой посреди цикла - оставляем скалярным
+                bool zeroDivisor = right.isFloat ? std::abs(right.constValue) < 1e-9 : right.constValue == 0.0;
+                if (!right.isConst || zeroDivisor) {
+                    reason = "division by a non-constant value";
+                    return false;
+                }
+            }
+            stack.push_back({ left.isVector || right.isVector, left.isFloat || right.isFloat, false, 0.0 });
+            RPNOpCode vecOp = RPNOpCode::VEC_ADD;
+            if (op.opCode == RPNOpCode::SUB) vecOp = RPNOpCode::VEC_SUB;
+            else if (op.opCode == RPNOpCode::MUL) vecOp = RPNOpCode::VEC_MUL;
+            else if (op.opCode == RPNOpCode::DIV) vecOp = RPNOpCode::VEC_DIV;
+            out.emplace_back(vecOp);
+            break;
+        }
+        case RPNOpCode::CONVERT_TO_FLOAT:
+            // Векторные операции сами повышают int до float, как и скалярные
+            if (stack.empty()) {
+                reason = "unsupported expression shape";
+                return false;
+            }
+            stack.back().isFloat = true;
+            break;
+        default:
+            reason = "unsupported operation in loop body";
+            return false;
+        }
+    }
+    if (stack.size() != 1) {
+        reason = "unsupported expression shape";
+        return false;
+    }
+    isFloat = stack.back().isFloat;
+    isVector = stack.back().isVector;
+    return true;
+}
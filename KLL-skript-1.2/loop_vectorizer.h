@@ -0,0 +1,75 @@
+// loop_vectorizer.h
+#ifndef LOOP_VECTORIZER_H
+#define LOOP_VECTORIZER_H
+
+#include <vector>
+#include <string>
+#include <optional>
+
+#include "definitions.h"  // RPNOpCode, SymbolType
+#include "rpn_op.h"       // RPNOperation
+#include "symbol_table.h" // SymbolTable
+
+// --- Автовекторизация простых счетных циклов ---
+// Распознает в сгенерированном ОПС циклы вида
+//     while (i < n) begin a[i] = b[i] * k + c[i]; s = s + a[i]; i = i + 1 end
+// (единичный шаг, инвариантная граница, обращения к массивам только по индексу i)
+// и строит для их тела эквивалентную программу из векторных операций VEC_*.
+// Сам код цикла не меняется (адреса ОПС в сообщениях об ошибках остаются прежними):
+// первая операция заголовка помечается индексом описателя (RPNOperation::loopInfoIndex),
+// а интерпретатор при входе в цикл выполняет безопасную часть итераций векторно
+// и передает остаток обычному скалярному циклу.
+
+// Оператор тела цикла в векторной форме
+struct VectorLoopStatement {
+    enum class Kind {
+        ARRAY_STORE, // a[i] = E      ->  a[окно] = E поэлементно
+        SUM_ADD,     // s = s + E     ->  s = s + sum(E)
+        SUM_SUB      // s = s - E     ->  s = s - sum(E)
+    } kind;
+    size_t targetIndex;                  // Массив или переменная-аккумулятор (индекс в таблице символов)
+    std::vector<RPNOperation> valueCode; // Вычисление E из PUSH_* и VEC_* операций
+};
+
+// Описатель векторизованного цикла
+struct VectorLoopInfo {
+    int headerAddress;          // Адрес первой операции условия (цель обратного перехода)
+    int backJumpAddress;        // Адрес JUMP в конце тела
+    size_t inductionVarIndex;   // Переменная цикла i
+    std::optional<size_t> boundVarIndex; // Граница - переменная n ...
+    int boundConst;                      // ... или константа (если boundVarIndex пуст)
+    std::vector<size_t> accessedArrays;   // Массивы, к которым обращается тело (для проверки границ)
+    std::vector<size_t> invariantScalars; // Читаемые телом скалярные переменные (должны быть инициализированы)
+    std::vector<VectorLoopStatement> statements;
+    int scalarOpsPerIteration;  // Число операций ОПС одной скалярной итерации (для лимита выполнения)
+};
+
+// Решение по отдельному циклу (для отладочного вывода ОПС)
+struct LoopReport {
+    int headerAddress;
+    int backJumpAddress;
+    bool vectorized;
+    std::string reason; // Причина отказа, если !vectorized
+};
+
+class LoopVectorizer {
+private:
+    std::vector<RPNOperation>& rpnCode;
+    const SymbolTable& symbolTable;
+    std::vector<LoopReport> reports;
+
+    // Пытается построить описатель для цикла с заголовком header и обратным переходом backJump.
+    // При неудаче возвращает std::nullopt и причину в reason.
+    std::optional<VectorLoopInfo> analyzeLoop(int header, int backJump, std::string& reason) const;
+    bool convertExpression(int from, int to, size_t inductionVar, const std::vector<size_t>& writtenScalars,
+        VectorLoopInfo& info, std::vector<RPNOperation>& out, bool& isFloat, bool& isVector, std::string& reason) const;
+
+public:
+    LoopVectorizer(std::vector<RPNOperation>& code, const SymbolTable& symTab);
+
+    // Находит подходящие циклы, помечает их заголовки и возвращает описатели
+    std::vector<VectorLoopInfo> run();
+    const std::vector<LoopReport>& getReports() const { return reports; }
+};
+
+#endif // LOOP_VECTORIZER_H
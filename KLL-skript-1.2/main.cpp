@@ -3,29 +3,146 @@
 #include <fstream>
 #include <string>
 #include <vector>
-#include <sstream>
+#include <string_view>
 
-//    
-//    ,     ,
-//     .
+// Заголовочные файлы будущих модулей
+// Пока они не существуют, компиляция этого файла не пройдет,
+// но это отражает финальную структуру.
 #include "definitions.h"
-#include "token.h" //  Token    
+#include "token.h" // Если Token будет в отдельном файле
 #include "error_handler.h"
 #include "symbol_table.h"
+#include "mapped_file.h" // Отображение исходного файла в память
 #include "lexer.h"
+#include "token_buffer.h"
 #include "parser.h"
 #include "interpreter.h"
-#include "rpn_op.h" //  RPNOperation    
+#include "rpn_op.h" // Если RPNOperation будет в отдельном файле
+#include "vector_kernels.h"
+#include "profiler.h"
+#include "sampling_profiler.h"
+#include "run_metrics.h"
 
 
 int main(int argc, char* argv[]) {
-    // 1.    
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <source_file>" << std::endl;
+    // 1. Обработка аргументов командной строки
+    // --simd=scalar|sse2|avx2 ограничивает набор инструкций векторных операций (по умолчанию - лучший доступный)
+    // --no-vectorize отключает автовекторизацию циклов (для сравнения со скалярным выполнением)
+    // --no-auto-parallel отключает автоматическое распараллеливание циклов (явные parallel-циклы остаются)
+    // --threads=N задает число потоков для параллельных циклов (по умолчанию - число ядер; 1 - последовательно)
+    // --memory-stats выводит после выполнения представление и занятую память каждого массива
+    // --pretokenize лексирует весь файл в буфер токенов до начала разбора (иначе токены читаются по одному)
+    // --dump-ir выводит промежуточное представление (граф базовых блоков), из которого получен ОПС
+    // -O0..-O3 - уровень оптимизации IR (по умолчанию -O0); при -O1 и выше выводится статистика проходов
+    // --profile=PREFIX профилирует выполнение: PREFIX.annotated.txt - исходный текст с числом операций
+    //   и тактами каждой строки и сводкой по циклам, PREFIX.folded - свернутые стеки для flamegraph.pl
+    // --sample-profile=FILE записывает в FILE самые частые строки и диапазоны ОПС по выборкам SIGPROF
+    // --sample-rate=HZ - частота выборок (по умолчанию 1000)
+    // --metrics=json[:FILE] выводит метрики запуска одним объектом JSON в stderr (или в FILE):
+    //   время фаз, число токенов, размер ОПС, выполненные операции по кодам, глубину стека, память массивов
+    std::string sourceFileName;
+    bool vectorizeLoops = true;
+    bool autoParallel = true;
+    size_t threadCount = 0; // 0 - по умолчанию
+    bool memoryStats = false;
+    bool pretokenize = false;
+    bool dumpIR = false;
+    int optimizationLevel = 0;
+    std::string profilePrefix;
+    std::string sampleProfileFile;
+    int sampleRate = SamplingProfiler::DEFAULT_FREQUENCY;
+    bool collectMetrics = false;
+    std::string metricsFile; // Пусто - stderr
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--simd=", 0) == 0) {
+            std::string setName = arg.substr(7);
+            if (setName == "scalar") VectorKernels::setInstructionSet(InstructionSet::SCALAR);
+            else if (setName == "sse2") VectorKernels::setInstructionSet(InstructionSet::SSE2);
+            else if (setName == "avx2") VectorKernels::setInstructionSet(InstructionSet::AVX2);
+            else {
+                std::cerr << "Error: Unknown instruction set '" << setName << "' (expected scalar, sse2 or avx2)" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--no-vectorize") {
+            vectorizeLoops = false;
+        }
+        else if (arg == "--no-auto-parallel") {
+            autoParallel = false;
+        }
+        else if (arg == "--memory-stats") {
+            memoryStats = true;
+        }
+        else if (arg == "--pretokenize") {
+            pretokenize = true;
+        }
+        else if (arg == "--dump-ir") {
+            dumpIR = true;
+        }
+        else if (arg.size() == 3 && arg[0] == '-' && arg[1] == 'O') {
+            optimizationLevel = arg[2] - '0';
+            if (optimizationLevel < 0 || optimizationLevel > PassManager::MAX_OPTIMIZATION_LEVEL) {
+                std::cerr << "Error: Unknown optimization level '" << arg << "' (expected -O0, -O1, -O2 or -O3)" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg.rfind("--profile=", 0) == 0) {
+            profilePrefix = arg.substr(10);
+            if (profilePrefix.empty()) {
+                std::cerr << "Error: Missing output prefix in '" << arg << "'" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg.rfind("--sample-profile=", 0) == 0) {
+            sampleProfileFile = arg.substr(17);
+            if (sampleProfileFile.empty()) {
+                std::cerr << "Error: Missing output file in '" << arg << "'" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg.rfind("--sample-rate=", 0) == 0) {
+            try {
+                sampleRate = std::stoi(arg.substr(14));
+                if (sampleRate < 1) throw std::invalid_argument("rate");
+            }
+            catch (const std::exception&) {
+                std::cerr << "Error: Invalid sampling rate in '" << arg << "'" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--metrics=json" || arg.rfind("--metrics=json:", 0) == 0) {
+            collectMetrics = true;
+            metricsFile = arg.size() > 14 ? arg.substr(15) : "";
+        }
+        else if (arg.rfind("--threads=", 0) == 0) {
+            try {
+                int value = std::stoi(arg.substr(10));
+                if (value < 1) throw std::invalid_argument("threads");
+                threadCount = static_cast<size_t>(value);
+            }
+            catch (const std::exception&) {
+                std::cerr << "Error: Invalid thread count in '" << arg << "'" << std::endl;
+                return 1;
+            }
+        }
+        else if (sourceFileName.empty()) {
+            sourceFileName = arg;
+        }
+        else {
+            sourceFileName.clear();
+            break;
+        }
+    }
+    if (sourceFileName.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--simd=scalar|sse2|avx2] [--no-vectorize] [--no-auto-parallel] [--threads=N] [--memory-stats] [--pretokenize] [--dump-ir] [-O0|-O1|-O2|-O3] [--profile=PREFIX] [--sample-profile=FILE] [--sample-rate=HZ] [--metrics=json[:FILE]] <source_file>" << std::endl;
         return 1;
     }
 
-    std::string sourceFileName = argv[1];
+    RunMetrics metrics;
+    metrics.sourceFile = sourceFileName;
+    PhaseStopwatch stopwatch;
+
     std::ifstream sourceFile(sourceFileName);
 
     if (!sourceFile.is_open()) {
@@ -33,65 +150,187 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    // 2.     
-    std::stringstream buffer;
-    buffer << sourceFile.rdbuf();
-    std::string sourceCode = buffer.str();
+    // 2. Исходный код отображается в память, а не копируется: лексер и токены ссылаются прямо
+    // на страницы файла, поэтому отображение должно жить до конца компиляции
+    bool sourceIsEmpty = sourceFile.peek() == std::ifstream::traits_type::eof();
     sourceFile.close();
+    MappedFile sourceMapping;
+    std::string_view sourceCode; // Пустой файл не отображается (mmap нулевой длины недопустим)
+    if (!sourceIsEmpty) {
+        std::string mapError;
+        if (!sourceMapping.open(sourceFileName, MappingMode::READ_ONLY, mapError)) {
+            std::cerr << "Error: Could not map file '" << sourceFileName << "': " << mapError << std::endl;
+            return 1;
+        }
+        sourceCode = std::string_view(static_cast<const char*>(sourceMapping.data()), sourceMapping.size());
+    }
+
+    stopwatch.finish(metrics, "read");
 
-    // 3.   
-    ErrorHandler errorHandler; //   
-    SymbolTable symbolTable(errorHandler);   //   
-    Lexer lexer(sourceCode, symbolTable, errorHandler); //  
-    Parser parser(lexer, symbolTable, errorHandler);     //  
+    // 3. Инициализация компонентов компилятора
+    ErrorHandler errorHandler; // Создаем обработчик ошибок
+    SymbolTable symbolTable(errorHandler);   // Создаем таблицу символов
+
+    // Метрики выводятся при любом завершении после чтения файла; false - не удалось записать файл метрик
+    auto reportMetrics = [&](const char* status) {
+        if (!collectMetrics) return true;
+        metrics.status = status;
+        for (size_t i = 0; i < symbolTable.getTableSize(); ++i) {
+            if (std::optional<ArrayMemoryStats> stats = symbolTable.getArrayMemoryStats(i)) {
+                metrics.arrayDeclaredBytes += stats->declaredBytes;
+                metrics.arrayResidentBytes += stats->residentBytes;
+            }
+        }
+        if (metricsFile.empty()) {
+            metrics.writeJson(std::cerr);
+            return true;
+        }
+        std::ofstream out(metricsFile);
+        if (!out) {
+            std::cerr << "Error: Could not write metrics file '" << metricsFile << "'" << std::endl;
+            return false;
+        }
+        metrics.writeJson(out);
+        return true;
+    };
+    Lexer lexer(sourceCode, symbolTable, errorHandler); // Создаем лексер
 
     std::cout << "Starting compilation of file: " << sourceFileName << std::endl;
 
-    // 4.   ( +   +  )
+    TokenBuffer tokenBuffer; // Заполняется только при --pretokenize
+    if (pretokenize) {
+        stopwatch.restart();
+        tokenBuffer = TokenBuffer::tokenize(lexer, sourceCode);
+        stopwatch.finish(metrics, "lex");
+        metrics.tokenCount = tokenBuffer.size() - 1; // Без T_EOF
+        // Лексические ошибки всего файла уже известны; разбирать программу с ними нет смысла
+        if (errorHandler.hasErrors()) {
+            std::cerr << "Compilation failed." << std::endl;
+            errorHandler.printErrors();
+            reportMetrics("compile_error");
+            return 1;
+        }
+    }
+    Parser parser = pretokenize ? Parser(tokenBuffer, symbolTable, errorHandler)
+                                : Parser(lexer, symbolTable, errorHandler); // Создаем парсер
+    parser.setLoopVectorization(vectorizeLoops);
+    parser.setAutoParallelization(autoParallel);
+    parser.setOptimizationLevel(optimizationLevel);
+
+    // 4. Фаза компиляции (Лексический + Синтаксический анализ + Генерация ОПС)
+    stopwatch.restart();
     bool parseSuccess = parser.parse();
+    stopwatch.finish(metrics, "parse");
+    metrics.tokenCount = parser.getTokenCount();
+    metrics.rpnSize = parser.getRPNCode().size();
 
     if (!parseSuccess || errorHandler.hasErrors()) {
         std::cerr << "Compilation failed." << std::endl;
-        errorHandler.printErrors(); //    
-        return 1; // ,       
+        errorHandler.printErrors(); // Выводим все накопленные ошибки
+        reportMetrics("compile_error");
+        return 1; // Завершаем, если парсинг не удался или были ошибки
     }
 
     std::cout << "Compilation successful. RPN code generated." << std::endl;
 
-    // ()     
-    parser.printRPN(); //       Parser
+    // (Опционально) Вывод сгенерированного ОПС для отладки
+    if (optimizationLevel > 0) parser.printPassStatistics();
+    if (dumpIR) parser.printIR();
+    parser.printRPN(); // Этот метод нужно будет реализовать в Parser
 
-    // 5.  
+    // 5. Фаза интерпретации
     std::cout << "\nStarting execution..." << std::endl;
     std::cout << "---------------------" << std::endl;
 
     const std::vector<RPNOperation>& rpnCode = parser.getRPNCode();
 
-    // ,    ,    ,    (,  )
+    // Проверка, что ОПС не пуст, если парсинг был успешен, но ОПС пуст (например, пустая программа)
     if (rpnCode.empty() && parseSuccess) {
         std::cout << "Program is empty. Nothing to execute." << std::endl;
         std::cout << "---------------------" << std::endl;
         std::cout << "Execution finished." << std::endl;
-        return 0;
+        return reportMetrics("ok") ? 0 : 1;
     }
 
 
-    Interpreter interpreter(rpnCode, symbolTable, errorHandler);
+    Interpreter interpreter(rpnCode, symbolTable, errorHandler, &parser.getVectorLoops(), &parser.getParallelLoops());
+    if (threadCount != 0) interpreter.setThreadCount(threadCount);
+    interpreter.setSourceLocations(&parser.getSourceLocations());
+    interpreter.setOpcodeCounting(collectMetrics);
+    std::optional<ExecutionProfiler> profiler;
+    if (!profilePrefix.empty()) {
+        profiler.emplace(rpnCode, parser.getSourceLocations());
+        interpreter.setProfiler(&*profiler);
+    }
+    std::optional<SamplingProfiler> samplingProfiler;
+    if (!sampleProfileFile.empty()) {
+        samplingProfiler.emplace(rpnCode.size());
+        std::string samplingError;
+        if (!samplingProfiler->start(sampleRate, samplingError)) {
+            std::cerr << "Error: Could not start sampling profiler: " << samplingError << std::endl;
+            return 1;
+        }
+        interpreter.setSamplingProfiler(&*samplingProfiler);
+    }
 
-    //  
+    // Запускаем выполнение
+    stopwatch.restart();
     interpreter.execute();
+    stopwatch.finish(metrics, "execute");
+    metrics.instructionsExecuted = interpreter.getExecutedCount();
+    metrics.opcodeCounts = interpreter.getOpcodeCounts();
+    metrics.stackHighWater = interpreter.getStackHighWater();
+    if (collectMetrics) {
+        auto countOf = [&metrics](RPNOpCode op) { return metrics.opcodeCounts[static_cast<size_t>(op)]; };
+        metrics.itemsRead = countOf(RPNOpCode::READ_INT) + countOf(RPNOpCode::READ_FLOAT);
+        metrics.itemsWritten = countOf(RPNOpCode::WRITE_INT) + countOf(RPNOpCode::WRITE_FLOAT);
+    }
+
+    if (samplingProfiler) {
+        samplingProfiler->stop();
+        std::ofstream samples(sampleProfileFile);
+        if (!samples) {
+            std::cerr << "Error: Could not write sampling profile '" << sampleProfileFile << "'" << std::endl;
+            return 1;
+        }
+        samplingProfiler->writeReport(samples, parser.getSourceLocations(), sourceCode);
+    }
+
+    // Профиль записывается и при ошибке выполнения: он показывает, где программа провела время до нее
+    if (profiler) {
+        std::ofstream annotated(profilePrefix + ".annotated.txt");
+        std::ofstream folded(profilePrefix + ".folded");
+        if (!annotated || !folded) {
+            std::cerr << "Error: Could not write profile files with prefix '" << profilePrefix << "'" << std::endl;
+            return 1;
+        }
+        profiler->writeAnnotatedSource(annotated, sourceCode);
+        profiler->writeCollapsedStacks(folded);
+    }
 
     if (errorHandler.hasErrors()) {
         std::cerr << "Execution failed with runtime errors." << std::endl;
-        errorHandler.printErrors(); //    
+        errorHandler.printErrors(); // Выводим ошибки времени выполнения
+        reportMetrics("runtime_error");
         return 1;
     }
 
     std::cout << "---------------------" << std::endl;
     std::cout << "Execution finished." << std::endl;
 
-    // ()       
-    // symbolTable.print(); //       SymbolTable
+    if (memoryStats) {
+        std::cout << "Array memory (name: storage, declared bytes, resident bytes):" << std::endl;
+        for (size_t i = 0; i < symbolTable.getTableSize(); ++i) {
+            if (std::optional<ArrayMemoryStats> stats = symbolTable.getArrayMemoryStats(i)) {
+                std::cout << "  " << symbolTable.getSymbolName(i) << ": " << stats->storage << ", "
+                    << stats->declaredBytes << ", " << stats->residentBytes << std::endl;
+            }
+        }
+    }
+
+    // (Опционально) Вывод таблицы символов в конце для отладки
+    // symbolTable.print(); // Этот метод нужно будет реализовать в SymbolTable
 
-    return 0; //  
+    if (!reportMetrics("ok")) return 1;
+    return 0; // Успешное завершение
 }
\ No newline at end of file
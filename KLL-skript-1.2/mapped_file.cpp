@@ -0,0 +1,186 @@
+// mapped_file.cpp
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring> // Для std::strerror
+#include <vector>
+#include <algorithm> // Для std::min
+#endif
+
+MappedFile::MappedFile()
+    : address(nullptr), length(0), mode(MappingMode::READ_ONLY), anonymous(false)
+#ifdef _WIN32
+    , fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr)
+#endif
+{
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path, MappingMode mappingMode, std::string& error) {
+    close();
+    mode = mappingMode;
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        error = "cannot open file (error " + std::to_string(GetLastError()) + ")";
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize)) {
+        error = "cannot determine file size (error " + std::to_string(GetLastError()) + ")";
+        close();
+        return false;
+    }
+    if (fileSize.QuadPart == 0) {
+        error = "file is empty";
+        close();
+        return false;
+    }
+    // Большие страницы (SEC_LARGE_PAGES) для отображений файлов Windows не поддерживает
+    DWORD protection = (mode == MappingMode::READ_ONLY) ? PAGE_READONLY : PAGE_WRITECOPY;
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, protection, 0, 0, nullptr);
+    if (!mappingHandle) {
+        error = "cannot create file mapping (error " + std::to_string(GetLastError()) + ")";
+        close();
+        return false;
+    }
+    DWORD access = (mode == MappingMode::READ_ONLY) ? FILE_MAP_READ : FILE_MAP_COPY;
+    address = MapViewOfFile(mappingHandle, access, 0, 0, 0);
+    if (!address) {
+        error = "cannot map file (error " + std::to_string(GetLastError()) + ")";
+        close();
+        return false;
+    }
+    length = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+bool MappedFile::allocateAnonymous(size_t bytes, std::string& error) {
+    close();
+    mode = MappingMode::COPY_ON_WRITE;
+    // Зафиксированные (MEM_COMMIT) страницы получают физическую память только при первом обращении
+    address = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!address) {
+        error = "cannot allocate memory (error " + std::to_string(GetLastError()) + ")";
+        return false;
+    }
+    length = bytes;
+    anonymous = true;
+    return true;
+}
+
+size_t MappedFile::getResidentBytes() const {
+    return length; // Подсчет страниц рабочего набора (QueryWorkingSetEx) слишком дорог для статистики
+}
+
+void MappedFile::close() {
+    if (address && anonymous) VirtualFree(address, 0, MEM_RELEASE);
+    else if (address) UnmapViewOfFile(address);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+    address = nullptr;
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+    length = 0;
+    anonymous = false;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path, MappingMode mappingMode, std::string& error) {
+    close();
+    mode = mappingMode;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = std::string("cannot open file (") + std::strerror(errno) + ")";
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        error = std::string("cannot determine file size (") + std::strerror(errno) + ")";
+        ::close(fd);
+        return false;
+    }
+    if (info.st_size == 0) {
+        error = "file is empty";
+        ::close(fd);
+        return false;
+    }
+    size_t fileSize = static_cast<size_t>(info.st_size);
+    // MAP_PRIVATE с PROT_WRITE - копирование при записи: изменения не попадают в файл
+    int protection = (mode == MappingMode::READ_ONLY) ? PROT_READ : (PROT_READ | PROT_WRITE);
+    int flags = (mode == MappingMode::READ_ONLY) ? MAP_SHARED : MAP_PRIVATE;
+    void* mapped = mmap(nullptr, fileSize, protection, flags, fd, 0);
+    ::close(fd); // Отображение остается действительным после закрытия дескриптора
+    if (mapped == MAP_FAILED) {
+        error = std::string("cannot map file (") + std::strerror(errno) + ")";
+        return false;
+    }
+    // Подсказки ядру: массивы обычно просматриваются последовательно; прозрачные большие
+    // страницы (где ядро поддерживает их для файлов) уменьшают число промахов TLB
+    madvise(mapped, fileSize, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    madvise(mapped, fileSize, MADV_HUGEPAGE);
+#endif
+    address = mapped;
+    length = fileSize;
+    return true;
+}
+
+bool MappedFile::allocateAnonymous(size_t bytes, std::string& error) {
+    close();
+    mode = MappingMode::COPY_ON_WRITE;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE; // Не резервировать место в подкачке под весь массив сразу
+#endif
+    void* mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (mapped == MAP_FAILED) {
+        error = std::string("cannot allocate memory (") + std::strerror(errno) + ")";
+        return false;
+    }
+    address = mapped;
+    length = bytes;
+    anonymous = true;
+    return true;
+}
+
+size_t MappedFile::getResidentBytes() const {
+    if (!address) return 0;
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    std::vector<unsigned char> residency((length + pageSize - 1) / pageSize);
+#ifdef __APPLE__
+    int status = mincore(address, length, reinterpret_cast<char*>(residency.data()));
+#else
+    int status = mincore(address, length, residency.data());
+#endif
+    if (status != 0) {
+        return length;
+    }
+    size_t residentPages = 0;
+    for (unsigned char page : residency) residentPages += (page & 1);
+    return std::min(length, residentPages * pageSize);
+}
+
+void MappedFile::close() {
+    if (address) munmap(address, length);
+    address = nullptr;
+    length = 0;
+    anonymous = false;
+}
+
+#endif
@@ -0,0 +1,54 @@
+// mapped_file.h
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+
+// --- Отображение файла в память (mmap / MapViewOfFile) ---
+// Используется для массивов, объявленных как arr int a["data.bin"]: элементы массива - это
+// непосредственно байты файла, без чтения и разбора. Страницы подгружаются ОС по мере обращения,
+// поэтому файл может быть больше доступной оперативной памяти.
+// Тот же класс выделяет анонимную (не связанную с файлом) память для больших обычных массивов:
+// ОС выдает нулевые страницы по первому обращению, поэтому незатронутые части массива память не занимают.
+
+enum class MappingMode {
+    READ_ONLY,    // Только чтение (запись в массив запрещена)
+    COPY_ON_WRITE // Запись допускается, но изменяет частную копию страницы, а не файл
+};
+
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Отображает файл целиком. При ошибке возвращает false и описание в error.
+    bool open(const std::string& path, MappingMode mode, std::string& error);
+    // Выделяет bytes байт анонимной памяти, заполненной нулями (режим COPY_ON_WRITE - запись разрешена)
+    bool allocateAnonymous(size_t bytes, std::string& error);
+
+    // Объем страниц, фактически находящихся в памяти (если ОС не сообщает - size())
+    size_t getResidentBytes() const;
+    bool isAnonymous() const { return anonymous; }
+
+    void* data() const { return address; }
+    size_t size() const { return length; }
+    MappingMode getMode() const { return mode; }
+
+private:
+    void* address;
+    size_t length;
+    MappingMode mode;
+    bool anonymous;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+    void close();
+};
+
+#endif // MAPPED_FILE_H
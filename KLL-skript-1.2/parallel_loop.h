@@ -0,0 +1,45 @@
+// parallel_loop.h
+#ifndef PARALLEL_LOOP_H
+#define PARALLEL_LOOP_H
+
+#include <vector>
+#include <optional>
+#include <cstddef>
+
+// --- Описатель параллельного цикла ---
+// parallel reduce(+ s) reduce(max m) while (i < n) begin ... i = i + 1 end
+// Парсер генерирует перед заголовком обычного цикла операцию PARALLEL_LOOP с номером описателя.
+// Описатели циклов, распараллеленных автоматически (LoopParallelizer), хранятся в том же списке,
+// а на них указывает RPNOperation::parallelInfoIndex первой операции заголовка.
+// Интерпретатор делит итерации [i, n) на куски и выполняет тело в пуле потоков;
+// если параллельное выполнение невозможно (например, i не инициализирована),
+// операция ничего не делает и цикл выполняется как обычный while.
+
+struct ParallelReduction {
+    enum class Kind {
+        SUM, // +
+        MIN, // min
+        MAX  // max
+    } kind;
+    size_t varIndex; // Скалярная переменная-аккумулятор
+};
+
+struct ParallelLoopInfo {
+    int headerAddress;      // Начало условия i < n (цель обратного перехода)
+    int bodyStart;          // Первая операция тела (после JUMP_FALSE)
+    int backJumpAddress;    // JUMP в конце тела
+    int exitAddress;        // Первая операция после цикла
+    size_t inductionVarIndex;
+    std::optional<size_t> boundVarIndex; // Граница - переменная ...
+    int boundConst;                      // ... или константа
+    std::vector<ParallelReduction> reductions;
+    // Скалярные переменные, которым присваивается значение в теле. У каждого куска итераций
+    // своя копия (начальное значение - значение до цикла); после цикла переменная получает
+    // значение из куска с последней итерацией, как при последовательном выполнении.
+    std::vector<size_t> privateScalars;
+    // Цикл найден анализом зависимостей: выполняется параллельно, только если объем работы
+    // превышает порог (иначе накладные расходы на потоки больше выигрыша)
+    bool automatic = false;
+};
+
+#endif // PARALLEL_LOOP_H
@@ -1,26 +1,71 @@
 ﻿// parser.cpp
 #include "parser.h"
+#include "ir_builder.h"
+#include "rpn_generator.h"
 #include <iostream> 
 #include <iomanip>  
-#include <algorithm> // Не используется активно, но может пригодиться
+#include <algorithm> // std::count, std::find (проверка параллельных циклов)
+#include <chrono>    // Время этапов разбора
 
 // --- Конструктор ---
 Parser::Parser(Lexer& lex, SymbolTable& symTab, ErrorHandler& errHandler)
-    : lexer(lex), symbolTable(symTab), errorHandler(errHandler),
-    declarationContextActive(true), lastDeclaredType(SymbolType::VARIABLE_INT)
+    : lexer(&lex), tokenBuffer(nullptr), tokenIndex(0), tokensRead(0), symbolTable(symTab), errorHandler(errHandler),
+    declarationContextActive(true), lastDeclaredType(SymbolType::VARIABLE_INT),
+    vectorContextActive(false), programBody(nullptr), optimizationLevel(0), passManager(symTab),
+    loopVectorizationEnabled(true), autoParallelizationEnabled(true),
+    parallelBodyDepth(0)
+{
+    nextToken();
+}
+
+Parser::Parser(const TokenBuffer& tokens, SymbolTable& symTab, ErrorHandler& errHandler)
+    : lexer(nullptr), tokenBuffer(&tokens), tokenIndex(0), tokensRead(0), symbolTable(symTab), errorHandler(errHandler),
+    declarationContextActive(true), lastDeclaredType(SymbolType::VARIABLE_INT),
+    vectorContextActive(false), programBody(nullptr), optimizationLevel(0), passManager(symTab),
+    loopVectorizationEnabled(true), autoParallelizationEnabled(true),
+    parallelBodyDepth(0)
 {
     nextToken();
 }
 
 // --- Вспомогательные методы ---
 void Parser::nextToken() {
-    currentToken = lexer.getNextToken();
-    // Пропускаем T_ERROR токены, так как лексер уже должен был сообщить об ошибке через errorHandler
-    // и вернуть T_ERROR. Если мы здесь зациклимся, значит лексер не возвращает T_EOF при ошибках.
-    while (currentToken.type == TokenType::T_ERROR && currentToken.type != TokenType::T_EOF) {
-        // errorHandler уже должен был зарегистрировать ошибку
-        currentToken = lexer.getNextToken();
+    if (!lookaheadTokens.empty()) {
+        currentToken = lookaheadTokens.front();
+        lookaheadTokens.pop_front();
+        return;
+    }
+    currentToken = readToken();
+}
+
+Token Parser::readToken() {
+    Token token;
+    if (tokenBuffer) {
+        // T_ERROR в буфер не попадают; за концом буфера get возвращает T_EOF
+        token = tokenBuffer->get(tokenIndex < tokenBuffer->size() ? tokenIndex++ : tokenIndex);
+    }
+    else {
+        token = lexer->getNextToken();
+        // Пропускаем T_ERROR токены, так как лексер уже должен был сообщить об ошибке через errorHandler
+        // и вернуть T_ERROR. Если мы здесь зациклимся, значит лексер не возвращает T_EOF при ошибках.
+        while (token.type == TokenType::T_ERROR && token.type != TokenType::T_EOF) {
+            // errorHandler уже должен был зарегистрировать ошибку
+            token = lexer->getNextToken();
+        }
     }
+    if (token.type != TokenType::T_EOF) tokensRead++;
+    return token;
+}
+
+Token Parser::peekToken(size_t ahead) {
+    if (ahead == 0) return currentToken;
+    if (tokenBuffer && lookaheadTokens.empty()) {
+        return tokenBuffer->get(tokenIndex + ahead - 1); // Просмотр по буферу - без копирования в очередь
+    }
+    while (lookaheadTokens.size() < ahead) {
+        lookaheadTokens.push_back(readToken());
+    }
+    return lookaheadTokens[ahead - 1];
 }
 
 bool Parser::match(TokenType expectedType) {
@@ -38,7 +83,7 @@ void Parser::consume(TokenType expectedType) {
     else {
         std::string expectedTokenText = "token of type " + std::to_string(static_cast<int>(expectedType));
         // Можно будет улучшить, добавив маппинг TokenType -> string
-        reportSyntaxError("Expected " + expectedTokenText + " but found '" + currentToken.text +
+        reportSyntaxError("Expected " + expectedTokenText + " but found '" + std::string(currentToken.text) +
             "' (type " + std::to_string(static_cast<int>(currentToken.type)) + ")");
         // После серьезной синтаксической ошибки, возможно, стоит остановить парсинг
         // или применить более сложную стратегию восстановления.
@@ -57,67 +102,120 @@ void Parser::reportSemanticError(const std::string& message, int line, int col)
 }
 
 
-// --- Генерация ОПС ---
-void Parser::emit(RPNOpCode opCode) {
-    rpnCode.emplace_back(opCode);
-}
-
-void Parser::emit(RPNOpCode opCode, int value) {
-    rpnCode.emplace_back(opCode, value);
+// --- Узлы дерева ---
+AstExpr* Parser::newConstInt(int value, int line, int column) {
+    AstExpr* expr = astArena.newExpr(AstExprKind::CONST_INT, SymbolType::VARIABLE_INT, line, column);
+    expr->intValue = value;
+    return expr;
 }
 
-void Parser::emit(RPNOpCode opCode, float value) {
-    rpnCode.emplace_back(opCode, value);
+AstExpr* Parser::newConstFloat(float value, int line, int column) {
+    AstExpr* expr = astArena.newExpr(AstExprKind::CONST_FLOAT, SymbolType::VARIABLE_FLOAT, line, column);
+    expr->floatValue = value;
+    return expr;
 }
 
-void Parser::emit(RPNOpCode opCode, size_t symbolIndex) {
-    rpnCode.emplace_back(opCode, symbolIndex);
+AstExpr* Parser::newBinary(RPNOpCode op, SymbolType type, AstExpr* left, AstExpr* right, const Token& opToken) {
+    AstExpr* expr = astArena.newExpr(AstExprKind::BINARY, type, opToken.line, opToken.column);
+    expr->op = op;
+    expr->left = left;
+    expr->right = right;
+    return expr;
 }
 
-void Parser::emit(RPNOpCode opCode, bool isIoPlaceholder) {
-    rpnCode.emplace_back(opCode, isIoPlaceholder);
+AstExpr* Parser::newConvert(AstExpr* operand, SymbolType targetType) {
+    if (operand->type == targetType) return operand;
+    AstExpr* expr = astArena.newExpr(AstExprKind::CONVERT, targetType, operand->line, operand->column);
+    expr->op = (targetType == SymbolType::VARIABLE_INT) ? RPNOpCode::CONVERT_TO_INT : RPNOpCode::CONVERT_TO_FLOAT;
+    expr->left = operand;
+    return expr;
 }
 
-int Parser::emitJumpPlaceholder(RPNOpCode jumpOpCode) {
-    rpnCode.emplace_back(jumpOpCode, -1, true); // Используем конструктор RPNOperation(RPNOpCode, int, bool)
-    return static_cast<int>(rpnCode.size()) - 1;
+// Заглушка на месте выражения с ошибкой (код по дереву с ошибками не генерируется)
+AstExpr* Parser::invalidExpr() {
+    return newConstInt(0, currentToken.line, currentToken.column);
 }
 
-void Parser::patchJump(int rpnAddressToPatch, int targetRpnAddress) {
-    if (rpnAddressToPatch < 0 || static_cast<size_t>(rpnAddressToPatch) >= rpnCode.size()) {
-        reportSemanticError("Internal Parser Error: Invalid RPN address (" + std::to_string(rpnAddressToPatch) + ") for jump patching.");
-        return;
-    }
-    // Проверяем, что это действительно операция перехода
-    if (rpnCode[rpnAddressToPatch].opCode != RPNOpCode::JUMP && rpnCode[rpnAddressToPatch].opCode != RPNOpCode::JUMP_FALSE) {
-        reportSemanticError("Internal Parser Error: Attempting to patch non-jump instruction at address " + std::to_string(rpnAddressToPatch) + ".");
-        return;
+// --- Основной метод парсинга ---
+namespace {
+    double millisecondsSince(std::chrono::steady_clock::time_point& start) {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double, std::milli>(now - start).count();
+        start = now;
+        return elapsed;
     }
-    rpnCode[rpnAddressToPatch].jumpTarget = targetRpnAddress;
 }
 
-int Parser::getCurrentRPNAddress() const {
-    return static_cast<int>(rpnCode.size());
-}
-
-// --- Основной метод парсинга ---
 bool Parser::parse() {
+    phaseTimes = ParsePhaseTimes();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
     declarationContextActive = true;
     parseProgram();
     // Проверяем, что после конца программы нет "мусора", только если не было других ошибок
     if (currentToken.type != TokenType::T_EOF && !errorHandler.hasErrors()) {
         reportSyntaxError("Unexpected tokens found after end of program.");
     }
+    phaseTimes.syntax = millisecondsSince(start);
+    if (!errorHandler.hasErrors()) {
+        generateCode();
+    }
+    start = std::chrono::steady_clock::now();
+    // Представление больших массивов выбирается до анализа циклов: векторизатор не трогает разреженные массивы
+    if (!errorHandler.hasErrors()) {
+        symbolTable.applySparseHeuristic(wholeArrayOperands);
+    }
+    if (!errorHandler.hasErrors() && loopVectorizationEnabled) {
+        LoopVectorizer vectorizer(rpnCode, symbolTable);
+        vectorLoops = vectorizer.run();
+        loopReports = vectorizer.getReports();
+    }
+    // Распараллеливание - после векторизации: векторизованные циклы оставляются векторными
+    if (!errorHandler.hasErrors() && autoParallelizationEnabled) {
+        LoopParallelizer parallelizer(rpnCode, symbolTable);
+        parallelizer.run(parallelLoops);
+        parallelReports = parallelizer.getReports();
+    }
+    phaseTimes.loopAnalysis = millisecondsSince(start);
     return !errorHandler.hasErrors();
 }
 
+// Дерево -> граф потока управления (IR) -> ОПС. Циклы parallel проверяются по готовой ОПС.
+void Parser::generateCode() {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    IrBuilder builder(irCode, symbolTable);
+    builder.build(programBody);
+    phaseTimes.irBuild = millisecondsSince(start);
+    if (optimizationLevel > 0) {
+        passManager.addStandardPasses(optimizationLevel);
+        passManager.run(irCode);
+    }
+    phaseTimes.optimize = millisecondsSince(start);
+    RpnGenerator generator(irCode);
+    rpnCode = generator.generate();
+    rpnLocations = generator.getLocations();
+
+    const std::vector<int>& blockAddresses = generator.getBlockAddresses();
+    for (const ParallelLoopCheck& check : parallelLoopChecks) {
+        const IrParallelRegion& region = irCode.parallelRegions[check.loopIndex];
+        ParallelLoopInfo& info = parallelLoops[check.loopIndex];
+        std::string reason;
+        if (!checkParallelLoop(blockAddresses[region.headerBlock], blockAddresses[region.exitBlock],
+            check.assignedScalars, info, reason)) {
+            reportSemanticError("Invalid parallel loop: " + reason + ".", check.line, check.column);
+        }
+    }
+    phaseTimes.rpnEmission = millisecondsSince(start);
+}
+
 // P → <OptDeclarationList> begin A end EOF
 void Parser::parseProgram() {
     parseOptDeclarationList();
     declarationContextActive = false;
 
     consume(TokenType::T_KW_BEGIN);
-    parseStatementList(); // A
+    AstStmtList statements;
+    parseStatementList(statements); // A
+    programBody = statements.first;
     consume(TokenType::T_KW_END);
     // EOF проверяется в parse()
 }
@@ -179,7 +277,7 @@ void Parser::parseVarList(SymbolType varType) {
     if (currentToken.type == TokenType::T_IDENTIFIER) {
         Token idToken = currentToken;
         nextToken();
-        symbolTable.addVariable(idToken.text, varType, idToken.line);
+        symbolTable.addVariable(idToken.identifierId, varType, idToken.line);
         parseVarListTail(varType);
     }
     else {
@@ -194,7 +292,7 @@ void Parser::parseVarListTail(SymbolType varType) {
         if (currentToken.type == TokenType::T_IDENTIFIER) {
             Token idToken = currentToken;
             nextToken();
-            symbolTable.addVariable(idToken.text, varType, idToken.line);
+            symbolTable.addVariable(idToken.identifierId, varType, idToken.line);
         }
         else {
             reportSyntaxError("Expected identifier after comma in variable list.");
@@ -203,24 +301,14 @@ void Parser::parseVarListTail(SymbolType varType) {
     }
 }
 
-// M → a [ k ] <ArrListTail>
+// M → a [ <ArraySize> ] <ArrListTail>
 void Parser::parseArrList(SymbolType arrAggregateType) {
     if (currentToken.type == TokenType::T_IDENTIFIER) {
         Token idToken = currentToken;
         nextToken();
         consume(TokenType::T_LBRACKET);
         if (errorHandler.hasErrors()) return;
-        if (currentToken.type == TokenType::T_NUMBER_INT) {
-            int arraySize = currentToken.getIntValue();
-            if (arraySize <= 0) {
-                reportSemanticError("Array size must be a positive integer.", currentToken.line, currentToken.column);
-            }
-            nextToken();
-            symbolTable.addArray(idToken.text, arrAggregateType, idToken.line, static_cast<size_t>(arraySize > 0 ? arraySize : 1));
-        }
-        else {
-            reportSyntaxError("Expected integer number for array size.");
-        }
+        parseArraySizeSpec(idToken, arrAggregateType);
         if (errorHandler.hasErrors()) return;
         consume(TokenType::T_RBRACKET);
         parseArrListTail(arrAggregateType);
@@ -230,7 +318,55 @@ void Parser::parseArrList(SymbolType arrAggregateType) {
     }
 }
 
-// <ArrListTail> → , a [ k ] <ArrListTail> | λ
+// <ArraySize> → k <StorageHint> | "путь" <MapMode>
+// <StorageHint> → sparse | dense | λ,  <MapMode> → readonly | cow | λ
+// Массив с путем к файлу отображается на файл; размер определяется длиной файла.
+// Без подсказки очень большой массив, который не используется целиком, становится разреженным.
+void Parser::parseArraySizeSpec(const Token& idToken, SymbolType arrAggregateType) {
+    if (currentToken.type == TokenType::T_NUMBER_INT) {
+        int arraySize = currentToken.getIntValue();
+        if (arraySize <= 0) {
+            reportSemanticError("Array size must be a positive integer.", currentToken.line, currentToken.column);
+        }
+        nextToken();
+        ArrayStorageHint hint = ArrayStorageHint::AUTO;
+        if (currentToken.identifierId == WORD_SPARSE) {
+            hint = ArrayStorageHint::SPARSE;
+            nextToken();
+        }
+        else if (currentToken.identifierId == WORD_DENSE) {
+            hint = ArrayStorageHint::DENSE;
+            nextToken();
+        }
+        else if (currentToken.type != TokenType::T_RBRACKET) {
+            reportSyntaxError("Expected 'sparse' or 'dense' after array size.");
+            return;
+        }
+        symbolTable.addArray(idToken.identifierId, arrAggregateType, idToken.line, static_cast<size_t>(arraySize > 0 ? arraySize : 1), hint);
+    }
+    else if (currentToken.type == TokenType::T_STRING) {
+        std::string path(currentToken.text);
+        nextToken();
+        MappingMode mode = MappingMode::READ_ONLY;
+        if (currentToken.identifierId == WORD_READONLY) {
+            nextToken();
+        }
+        else if (currentToken.identifierId == WORD_COW) {
+            mode = MappingMode::COPY_ON_WRITE;
+            nextToken();
+        }
+        else if (currentToken.type != TokenType::T_RBRACKET) {
+            reportSyntaxError("Expected 'readonly' or 'cow' after file name in array declaration.");
+            return;
+        }
+        symbolTable.addMappedArray(idToken.identifierId, arrAggregateType, idToken.line, path, mode);
+    }
+    else {
+        reportSyntaxError("Expected integer number or file name for array size.");
+    }
+}
+
+// <ArrListTail> → , a [ <ArraySize> ] <ArrListTail> | λ
 void Parser::parseArrListTail(SymbolType arrAggregateType) {
     while (match(TokenType::T_COMMA)) {
         if (errorHandler.hasErrors()) return;
@@ -239,17 +375,7 @@ void Parser::parseArrListTail(SymbolType arrAggregateType) {
             nextToken();
             consume(TokenType::T_LBRACKET);
             if (errorHandler.hasErrors()) return;
-            if (currentToken.type == TokenType::T_NUMBER_INT) {
-                int arraySize = currentToken.getIntValue();
-                if (arraySize <= 0) {
-                    reportSemanticError("Array size must be a positive integer.", currentToken.line, currentToken.column);
-                }
-                nextToken();
-                symbolTable.addArray(idToken.text, arrAggregateType, idToken.line, static_cast<size_t>(arraySize > 0 ? arraySize : 1));
-            }
-            else {
-                reportSyntaxError("Expected integer number for array size.");
-            }
+            parseArraySizeSpec(idToken, arrAggregateType);
             if (errorHandler.hasErrors()) return;
             consume(TokenType::T_RBRACKET);
         }
@@ -261,55 +387,52 @@ void Parser::parseArrListTail(SymbolType arrAggregateType) {
 }
 
 // A → <Statement> <StatementTail>
-void Parser::parseStatementList() {
+void Parser::parseStatementList(AstStmtList& statements) {
     if (currentToken.type != TokenType::T_KW_END && currentToken.type != TokenType::T_EOF) {
         if (errorHandler.hasErrors()) return;
-        parseStatement();
+        statements.append(parseStatement());
         if (errorHandler.hasErrors()) return;
-        parseStatementTail();
+        parseStatementTail(statements);
     }
 }
 
 // <StatementTail> → ; A | λ
-void Parser::parseStatementTail() {
+void Parser::parseStatementTail(AstStmtList& statements) {
     if (currentToken.type == TokenType::T_SEMICOLON) {
         nextToken();
         if (currentToken.type != TokenType::T_KW_END && currentToken.type != TokenType::T_EOF) {
             if (errorHandler.hasErrors()) return;
-            parseStatementList();
+            parseStatementList(statements);
         }
     }
 }
 
-// <Statement> → aH = G | if (C) <ScopedStatement> E_else | while (C) <ScopedStatement> | cin(aH) | cout(G) | begin A end | λ
-void Parser::parseStatement() {
+// <Statement> → aH = G | if (C) <ScopedStatement> E_else | while (C) <ScopedStatement> | cin(aH) | cout(G) | begin A end
+//              | parallel <ReduceList> while (C) <ScopedStatement> | λ
+// Возвращает nullptr для пустого оператора и при ошибке
+AstStmt* Parser::parseStatement() {
     if (currentToken.type == TokenType::T_SEMICOLON ||
         currentToken.type == TokenType::T_KW_END ||
         currentToken.type == TokenType::T_EOF ||
         currentToken.type == TokenType::T_KW_ELSE) {
-        return; // Пустой оператор
+        return nullptr; // Пустой оператор
     }
-    if (errorHandler.hasErrors()) return; // Прерываем, если уже есть ошибки на входе в оператор
+    if (errorHandler.hasErrors()) return nullptr; // Прерываем, если уже есть ошибки на входе в оператор
 
     switch (currentToken.type) {
     case TokenType::T_IDENTIFIER:
-        parseAssignmentOrExpressionStatement();
-        break;
+        if (isParallelStatementStart()) return parseParallelStatement();
+        return parseAssignmentOrExpressionStatement();
     case TokenType::T_KW_IF:
-        parseIfStatement();
-        break;
+        return parseIfStatement();
     case TokenType::T_KW_WHILE:
-        parseWhileStatement();
-        break;
+        return parseWhileStatement();
     case TokenType::T_KW_CIN:
-        parseCinStatement();
-        break;
+        return parseCinStatement();
     case TokenType::T_KW_COUT:
-        parseCoutStatement();
-        break;
+        return parseCoutStatement();
     case TokenType::T_KW_BEGIN:
-        parseBeginEndBlock();
-        break;
+        return parseBeginEndBlock();
     default:
         reportSyntaxError("Expected a statement (identifier, if, while, cin, cout, begin, or ';').");
         // Попытка пропустить до следующей точки с запятой для простого восстановления
@@ -319,93 +442,138 @@ void Parser::parseStatement() {
             !errorHandler.hasErrors()) { // Добавим !errorHandler.hasErrors() чтоб не зациклиться если лексер сломался
             nextToken();
         }
-        break;
+        return nullptr;
     }
 }
 
 // <ScopedStatement> -> <Statement> | begin A end
-void Parser::parseScopedStatement() {
-    if (errorHandler.hasErrors()) return;
+AstStmt* Parser::parseScopedStatement() {
+    if (errorHandler.hasErrors()) return nullptr;
     if (currentToken.type == TokenType::T_KW_BEGIN) {
-        parseBeginEndBlock();
-    }
-    else {
-        parseStatement();
+        return parseBeginEndBlock();
     }
+    return parseStatement();
 }
 
 // <Assignment> → aH = G
-void Parser::parseAssignmentOrExpressionStatement() {
+AstStmt* Parser::parseAssignmentOrExpressionStatement() {
     Token idToken = currentToken;
     nextToken();
 
-    auto symbolOpt = symbolTable.findSymbol(idToken.text);
+    auto symbolOpt = symbolTable.findSymbol(idToken.identifierId);
     if (!symbolOpt) {
-        reportSemanticError("Identifier '" + idToken.text + "' not declared.", idToken.line, idToken.column);
-        return;
+        reportSemanticError("Identifier '" + std::string(idToken.text) + "' not declared.", idToken.line, idToken.column);
+        return nullptr;
     }
     size_t symbolIndex = symbolOpt.value();
     const SymbolInfo* symbolInfoPtr = symbolTable.getSymbolInfo(symbolIndex);
     if (!symbolInfoPtr) {
-        reportSemanticError("Internal: Symbol info not found for declared identifier '" + idToken.text + "'.", idToken.line, idToken.column);
-        return;
+        reportSemanticError("Internal: Symbol info not found for declared identifier '" + std::string(idToken.text) + "'.", idToken.line, idToken.column);
+        return nullptr;
     }
     const SymbolInfo& symbolInfo = *symbolInfoPtr;
 
+    AstStmt* stmt = nullptr;
     SymbolType actualLHSItemType;
 
     if (symbolInfo.type == SymbolType::ARRAY_INT || symbolInfo.type == SymbolType::ARRAY_FLOAT) {
-        emit(RPNOpCode::PUSH_ARRAY_ADDR, symbolIndex);
-        if (parseArrayIndexOpt(symbolInfo)) {
-            emit(RPNOpCode::INDEX);
-            actualLHSItemType = (symbolInfo.type == SymbolType::ARRAY_INT) ? SymbolType::VARIABLE_INT : SymbolType::VARIABLE_FLOAT;
+        if (symbolInfo.isReadOnly()) {
+            reportSemanticError("Array '" + std::string(idToken.text) + "' is mapped read-only and cannot be assigned to.", idToken.line, idToken.column);
+            return nullptr;
         }
-        else {
-            reportSemanticError("Cannot assign to an entire array '" + symbolInfo.name + "'. Index required.", idToken.line, idToken.column);
-            return;
+        AstExpr* index = parseArrayIndexOpt(symbolInfo);
+        if (!index) {
+            // Присваивание целому массиву - векторный оператор
+            return parseVectorAssignment(symbolInfo, idToken);
         }
+        stmt = astArena.newStmt(AstStmtKind::ASSIGN_ELEMENT, idToken.line, idToken.column);
+        stmt->index = index;
+        actualLHSItemType = (symbolInfo.type == SymbolType::ARRAY_INT) ? SymbolType::VARIABLE_INT : SymbolType::VARIABLE_FLOAT;
     }
     else if (symbolInfo.type == SymbolType::VARIABLE_INT || symbolInfo.type == SymbolType::VARIABLE_FLOAT) {
-        emit(RPNOpCode::PUSH_VAR_ADDR, symbolIndex);
+        stmt = astArena.newStmt(AstStmtKind::ASSIGN, idToken.line, idToken.column);
         actualLHSItemType = symbolInfo.type;
+        if (parallelBodyDepth > 0) parallelAssignedScalars.push_back(symbolIndex);
     }
     else { // Этого не должно происходить, если типы символов ограничены
-        reportSemanticError("Identifier '" + idToken.text + "' is not a variable or array that can be assigned to.", idToken.line, idToken.column);
-        return;
+        reportSemanticError("Identifier '" + std::string(idToken.text) + "' is not a variable or array that can be assigned to.", idToken.line, idToken.column);
+        return nullptr;
     }
+    stmt->symbolIndex = symbolIndex;
 
-    if (errorHandler.hasErrors()) return;
+    if (errorHandler.hasErrors()) return stmt;
     consume(TokenType::T_ASSIGN);
-    if (errorHandler.hasErrors()) return;
+    if (errorHandler.hasErrors()) return stmt;
 
-    SymbolType expressionType = parseExpression();
+    AstExpr* expression = parseExpression();
 
-    if (expressionType == SymbolType::VARIABLE_INT || expressionType == SymbolType::VARIABLE_FLOAT) {
-        ensureTypesMatchOrConvert(actualLHSItemType, expressionType, true /*forAssignment*/);
-        emit(RPNOpCode::ASSIGN);
+    if (expression->type == SymbolType::VARIABLE_INT || expression->type == SymbolType::VARIABLE_FLOAT) {
+        // Правая часть приводится к типу цели
+        stmt->value = newConvert(expression, actualLHSItemType);
     }
     else if (!errorHandler.hasErrors()) { // Сообщаем об ошибке только если ее не было ранее в выражении
         reportSemanticError("Invalid expression on the right side of assignment for '" + symbolInfo.name + "'.", currentToken.line, currentToken.column);
     }
+    return stmt;
+}
+
+// a = G, где a - массив без индекса
+AstStmt* Parser::parseVectorAssignment(const SymbolInfo& arrayInfo, const Token& idToken) {
+    if (errorHandler.hasErrors()) return nullptr;
+    if (parallelBodyDepth > 0) {
+        reportSemanticError("Assignment to entire array '" + arrayInfo.name + "' is not allowed inside a parallel loop.", idToken.line, idToken.column);
+        return nullptr;
+    }
+    AstStmt* stmt = astArena.newStmt(AstStmtKind::VECTOR_ASSIGN, idToken.line, idToken.column);
+    if (std::optional<size_t> arrayIndex = symbolTable.findSymbol(idToken.identifierId)) {
+        stmt->symbolIndex = arrayIndex.value();
+        noteWholeArrayOperand(arrayIndex.value(), idToken);
+    }
+    consume(TokenType::T_ASSIGN);
+    if (errorHandler.hasErrors()) return stmt;
+
+    bool savedActive = vectorContextActive;
+    std::optional<size_t> savedLength = vectorContextLength;
+    vectorContextActive = true;
+    vectorContextLength = arrayInfo.arrayDeclaredSize;
+    AstExpr* expression = parseExpression();
+    vectorContextActive = savedActive;
+    vectorContextLength = savedLength;
+
+    if (errorHandler.hasErrors()) return stmt;
+    // Допустимы как векторные, так и скалярные выражения (скаляр заполняет весь массив).
+    // Приведение типов элементов выполняет сама операция VEC_ASSIGN.
+    if (expression->type == SymbolType::ARRAY_INT || expression->type == SymbolType::ARRAY_FLOAT ||
+        expression->type == SymbolType::VARIABLE_INT || expression->type == SymbolType::VARIABLE_FLOAT) {
+        stmt->value = expression;
+    }
+    else {
+        reportSemanticError("Invalid expression on the right side of assignment to array '" + arrayInfo.name + "'.", idToken.line, idToken.column);
+    }
+    return stmt;
 }
 
 // H → [G] | λ
-bool Parser::parseArrayIndexOpt(const SymbolInfo& symbolInfo) {
+// Возвращает выражение индекса (с приведением к int) или nullptr, если индекса нет
+AstExpr* Parser::parseArrayIndexOpt(const SymbolInfo& symbolInfo) {
     if (match(TokenType::T_LBRACKET)) {
-        if (errorHandler.hasErrors()) { consume(TokenType::T_RBRACKET); return true; } // Попытка съесть ] если ошибка
-        SymbolType indexExprType = parseExpression();
+        if (errorHandler.hasErrors()) { consume(TokenType::T_RBRACKET); return invalidExpr(); } // Попытка съесть ] если ошибка
+        bool savedVectorContext = vectorContextActive;
+        vectorContextActive = false; // Индекс всегда скалярный: a[i] внутри векторного выражения
+        AstExpr* index = parseExpression();
+        vectorContextActive = savedVectorContext;
 
         if (!errorHandler.hasErrors()) { // Проверяем тип индекса только если выражение было корректным
-            if (indexExprType == SymbolType::VARIABLE_FLOAT) {
+            if (index->type == SymbolType::VARIABLE_FLOAT) {
                 reportSemanticError("Warning: Array index expression for '" + symbolInfo.name + "' is float, truncating to int.",
-                    currentToken.type == TokenType::T_RBRACKET ? currentToken.line : lexer.getNextToken().line, // Попытка получить позицию конца выражения
-                    currentToken.type == TokenType::T_RBRACKET ? currentToken.column - 1 : lexer.getNextToken().column - 1);
-                emit(RPNOpCode::CONVERT_TO_INT);
+                    currentToken.type == TokenType::T_RBRACKET ? currentToken.line : peekToken(1).line, // Попытка получить позицию конца выражения
+                    currentToken.type == TokenType::T_RBRACKET ? currentToken.column - 1 : peekToken(1).column - 1);
+                index = newConvert(index, SymbolType::VARIABLE_INT);
             }
-            else if (indexExprType != SymbolType::VARIABLE_INT) {
+            else if (index->type != SymbolType::VARIABLE_INT) {
                 reportSemanticError("Array index expression for '" + symbolInfo.name + "' must evaluate to an integer.",
-                    currentToken.type == TokenType::T_RBRACKET ? currentToken.line : lexer.getNextToken().line,
-                    currentToken.type == TokenType::T_RBRACKET ? currentToken.column - 1 : lexer.getNextToken().column - 1);
+                    currentToken.type == TokenType::T_RBRACKET ? currentToken.line : peekToken(1).line,
+                    currentToken.type == TokenType::T_RBRACKET ? currentToken.column - 1 : peekToken(1).column - 1);
             }
         }
         if (errorHandler.hasErrors() && currentToken.type != TokenType::T_RBRACKET) {
@@ -413,124 +581,263 @@ bool Parser::parseArrayIndexOpt(const SymbolInfo& symbolInfo) {
             while (currentToken.type != TokenType::T_RBRACKET && currentToken.type != TokenType::T_SEMICOLON && currentToken.type != TokenType::T_EOF) nextToken();
         }
         consume(TokenType::T_RBRACKET);
-        return true;
+        return index;
     }
-    return false;
+    return nullptr;
 }
 
-void Parser::parseIfStatement() {
+AstStmt* Parser::parseIfStatement() {
+    AstStmt* stmt = astArena.newStmt(AstStmtKind::IF, currentToken.line, currentToken.column);
     consume(TokenType::T_KW_IF);
-    if (errorHandler.hasErrors()) return;
+    if (errorHandler.hasErrors()) return stmt;
     consume(TokenType::T_LPAREN);
-    if (errorHandler.hasErrors()) return;
-    parseCondition();
-    if (errorHandler.hasErrors()) { consume(TokenType::T_RPAREN); return; }
+    if (errorHandler.hasErrors()) return stmt;
+    stmt->value = parseCondition();
+    if (errorHandler.hasErrors()) { consume(TokenType::T_RPAREN); return stmt; }
     consume(TokenType::T_RPAREN);
 
-    int jumpFalsePlaceholder = emitJumpPlaceholder(RPNOpCode::JUMP_FALSE);
-    parseScopedStatement();
+    stmt->body = parseScopedStatement();
 
-    int jumpOverElsePlaceholder = -1;
     if (currentToken.type == TokenType::T_KW_ELSE) {
-        jumpOverElsePlaceholder = emitJumpPlaceholder(RPNOpCode::JUMP);
-    }
-
-    patchJump(jumpFalsePlaceholder, getCurrentRPNAddress());
-
-    if (currentToken.type == TokenType::T_KW_ELSE) {
-        if (errorHandler.hasErrors()) return; // Не парсим else, если 'then' блок с ошибками
-        parseElseClause(jumpOverElsePlaceholder);
+        if (errorHandler.hasErrors()) return stmt; // Не парсим else, если 'then' блок с ошибками
+        stmt->elseBody = parseElseClause();
     }
+    return stmt;
 }
 
-void Parser::parseElseClause(int jumpOverElsePlaceholder) {
+// E_else → else <ScopedStatement>
+AstStmt* Parser::parseElseClause() {
     consume(TokenType::T_KW_ELSE);
-    if (errorHandler.hasErrors()) return;
-    parseScopedStatement();
-    if (jumpOverElsePlaceholder != -1) { // Убедимся, что метка была создана
-        patchJump(jumpOverElsePlaceholder, getCurrentRPNAddress());
-    }
+    if (errorHandler.hasErrors()) return nullptr;
+    return parseScopedStatement();
 }
 
-void Parser::parseWhileStatement() {
+AstStmt* Parser::parseWhileStatement() {
+    AstStmt* stmt = astArena.newStmt(AstStmtKind::WHILE, currentToken.line, currentToken.column);
     consume(TokenType::T_KW_WHILE);
-    if (errorHandler.hasErrors()) return;
-
-    int conditionStartAddress = getCurrentRPNAddress();
+    if (errorHandler.hasErrors()) return stmt;
 
     consume(TokenType::T_LPAREN);
-    if (errorHandler.hasErrors()) return;
-    parseCondition();
-    if (errorHandler.hasErrors()) { consume(TokenType::T_RPAREN); return; }
+    if (errorHandler.hasErrors()) return stmt;
+    stmt->value = parseCondition();
+    if (errorHandler.hasErrors()) { consume(TokenType::T_RPAREN); return stmt; }
     consume(TokenType::T_RPAREN);
 
-    int jumpFalseToEndPlaceholder = emitJumpPlaceholder(RPNOpCode::JUMP_FALSE);
-    parseScopedStatement();
+    stmt->body = parseScopedStatement();
+    return stmt;
+}
+
+// parallel и reduce - контекстные слова: оператор начинается с parallel, только если за ним идет while
+// или reduce; иначе parallel - обычная переменная (parallel = 1)
+bool Parser::isParallelStatementStart() {
+    if (currentToken.type != TokenType::T_IDENTIFIER || currentToken.identifierId != WORD_PARALLEL) return false;
+    Token next = peekToken(1);
+    return next.type == TokenType::T_KW_WHILE || (next.type == TokenType::T_IDENTIFIER && next.identifierId == WORD_REDUCE);
+}
+
+// parallel <ReduceList> while (C) <ScopedStatement>
+// Цикл остается обычным while с номером описателя; генератор ставит перед его заголовком PARALLEL_LOOP,
+// поэтому при последовательном выполнении (и в отладочном выводе) ОПС не меняется.
+// Канонический вид цикла проверяется после генерации ОПС (generateCode).
+AstStmt* Parser::parseParallelStatement() {
+    Token parallelToken = currentToken;
+    nextToken(); // parallel (проверено isParallelStatementStart)
+
+    std::vector<ParallelReduction> reductions;
+    while (currentToken.type == TokenType::T_IDENTIFIER && currentToken.identifierId == WORD_REDUCE && !errorHandler.hasErrors()) {
+        nextToken();
+        consume(TokenType::T_LPAREN);
+        if (errorHandler.hasErrors()) return nullptr;
+
+        ParallelReduction reduction;
+        if (currentToken.type == TokenType::T_PLUS) {
+            reduction.kind = ParallelReduction::Kind::SUM;
+        }
+        else if (currentToken.identifierId == WORD_MIN) {
+            reduction.kind = ParallelReduction::Kind::MIN;
+        }
+        else if (currentToken.identifierId == WORD_MAX) {
+            reduction.kind = ParallelReduction::Kind::MAX;
+        }
+        else {
+            reportSyntaxError("Expected '+', 'min' or 'max' in reduce(...).");
+            return nullptr;
+        }
+        nextToken();
+
+        if (currentToken.type != TokenType::T_IDENTIFIER) {
+            reportSyntaxError("Expected reduction variable in reduce(...).");
+            return nullptr;
+        }
+        Token varToken = currentToken;
+        nextToken();
+        auto symbolOpt = symbolTable.findSymbol(varToken.identifierId);
+        if (!symbolOpt) {
+            reportSemanticError("Identifier '" + std::string(varToken.text) + "' not declared.", varToken.line, varToken.column);
+            return nullptr;
+        }
+        SymbolType varType = symbolTable.getSymbolType(symbolOpt.value());
+        if (varType != SymbolType::VARIABLE_INT && varType != SymbolType::VARIABLE_FLOAT) {
+            reportSemanticError("Reduction variable '" + std::string(varToken.text) + "' must be a scalar.", varToken.line, varToken.column);
+            return nullptr;
+        }
+        for (const ParallelReduction& existing : reductions) {
+            if (existing.varIndex == symbolOpt.value()) {
+                reportSemanticError("Variable '" + std::string(varToken.text) + "' is used in more than one reduction.", varToken.line, varToken.column);
+                return nullptr;
+            }
+        }
+        reduction.varIndex = symbolOpt.value();
+        reductions.push_back(reduction);
+        consume(TokenType::T_RPAREN);
+    }
+    if (errorHandler.hasErrors()) return nullptr;
+    if (currentToken.type != TokenType::T_KW_WHILE) {
+        reportSyntaxError("Expected 'while' after 'parallel'.");
+        return nullptr;
+    }
+
+    // Номер описателя резервируется до разбора тела, чтобы вложенные циклы получили следующие номера
+    size_t loopIndex = parallelLoops.size();
+    parallelLoops.emplace_back();
+
+    std::vector<size_t> outerAssigned;
+    outerAssigned.swap(parallelAssignedScalars);
+    ++parallelBodyDepth;
+    AstStmt* loop = parseWhileStatement();
+    --parallelBodyDepth;
+    std::vector<size_t> assigned;
+    assigned.swap(parallelAssignedScalars);
+    // Присваивания во вложенном цикле - это и присваивания в теле внешнего
+    parallelAssignedScalars = outerAssigned;
+    parallelAssignedScalars.insert(parallelAssignedScalars.end(), assigned.begin(), assigned.end());
+    if (errorHandler.hasErrors()) return loop;
+
+    loop->parallelLoopIndex = loopIndex;
+    parallelLoops[loopIndex].reductions = reductions;
+    parallelLoopChecks.push_back({ loopIndex, parallelToken.line, parallelToken.column, assigned });
+    return loop;
+}
 
-    emit(RPNOpCode::JUMP);
-    patchJump(getCurrentRPNAddress() - 1, conditionStartAddress);
+bool Parser::checkParallelLoop(int header, int exit, const std::vector<size_t>& assignedScalars,
+    ParallelLoopInfo& info, std::string& reason) const {
+    auto isIntVariable = [&](const RPNOperation& op) {
+        return op.opCode == RPNOpCode::PUSH_VAR_ADDR && op.symbolIndex &&
+            symbolTable.getSymbolType(op.symbolIndex.value()) == SymbolType::VARIABLE_INT;
+    };
+    auto countAssigned = [&](size_t index) {
+        return std::count(assignedScalars.begin(), assignedScalars.end(), index);
+    };
+
+    // Заголовок: PUSH_VAR_ADDR i, PUSH_VAR_ADDR n | PUSH_CONST_INT k, CMP_LT, JUMP_FALSE
+    if (exit - header < 10 || !isIntVariable(rpnCode[header]) ||
+        rpnCode[header + 2].opCode != RPNOpCode::CMP_LT || rpnCode[header + 3].opCode != RPNOpCode::JUMP_FALSE) {
+        reason = "condition must be 'i < n' with int variable i";
+        return false;
+    }
+    const RPNOperation& boundOp = rpnCode[header + 1];
+    if (isIntVariable(boundOp)) {
+        info.boundVarIndex = boundOp.symbolIndex.value();
+        info.boundConst = 0;
+    }
+    else if (boundOp.opCode == RPNOpCode::PUSH_CONST_INT) {
+        info.boundConst = std::get<int>(boundOp.operandValue);
+    }
+    else {
+        reason = "loop bound must be an int variable or constant";
+        return false;
+    }
+    info.inductionVarIndex = rpnCode[header].symbolIndex.value();
+
+    // Конец тела: i = i + 1 и обратный переход
+    int backJump = exit - 1;
+    const RPNOperation* step = &rpnCode[backJump - 5];
+    bool isStep = step[0].opCode == RPNOpCode::PUSH_VAR_ADDR && step[0].symbolIndex == info.inductionVarIndex &&
+        step[1].opCode == RPNOpCode::PUSH_VAR_ADDR && step[1].symbolIndex == info.inductionVarIndex &&
+        step[2].opCode == RPNOpCode::PUSH_CONST_INT && std::get<int>(step[2].operandValue) == 1 &&
+        step[3].opCode == RPNOpCode::ADD && step[4].opCode == RPNOpCode::ASSIGN;
+    if (!isStep || countAssigned(info.inductionVarIndex) != 1) {
+        reason = "loop body must end with 'i = i + 1' and not assign i elsewhere";
+        return false;
+    }
+    if (info.boundVarIndex && countAssigned(info.boundVarIndex.value()) != 0) {
+        reason = "loop bound must not change in the body";
+        return false;
+    }
+    for (const ParallelReduction& reduction : info.reductions) {
+        if (reduction.varIndex == info.inductionVarIndex || reduction.varIndex == info.boundVarIndex) {
+            reason = "loop variable or bound cannot be a reduction variable";
+            return false;
+        }
+    }
 
-    patchJump(jumpFalseToEndPlaceholder, getCurrentRPNAddress());
+    info.headerAddress = header;
+    info.bodyStart = header + 4;
+    info.backJumpAddress = backJump;
+    info.exitAddress = exit;
+    info.privateScalars.clear();
+    for (size_t index : assignedScalars) {
+        bool isReduction = std::any_of(info.reductions.begin(), info.reductions.end(),
+            [index](const ParallelReduction& reduction) { return reduction.varIndex == index; });
+        if (index == info.inductionVarIndex || isReduction ||
+            std::find(info.privateScalars.begin(), info.privateScalars.end(), index) != info.privateScalars.end()) {
+            continue;
+        }
+        info.privateScalars.push_back(index);
+    }
+    return true;
 }
 
-void Parser::parseCinStatement() {
+AstStmt* Parser::parseCinStatement() {
+    if (parallelBodyDepth > 0) {
+        reportSemanticError("'cin' is not allowed inside a parallel loop.");
+        return nullptr;
+    }
+    AstStmt* stmt = astArena.newStmt(AstStmtKind::CIN, currentToken.line, currentToken.column);
     consume(TokenType::T_KW_CIN);
-    if (errorHandler.hasErrors()) return;
+    if (errorHandler.hasErrors()) return stmt;
     consume(TokenType::T_LPAREN);
-    if (errorHandler.hasErrors()) return;
+    if (errorHandler.hasErrors()) return stmt;
 
     if (currentToken.type == TokenType::T_IDENTIFIER) {
         Token idToken = currentToken;
         nextToken();
 
-        auto symbolOpt = symbolTable.findSymbol(idToken.text);
+        auto symbolOpt = symbolTable.findSymbol(idToken.identifierId);
         if (!symbolOpt) {
-            reportSemanticError("Identifier '" + idToken.text + "' not declared for input.", idToken.line, idToken.column);
+            reportSemanticError("Identifier '" + std::string(idToken.text) + "' not declared for input.", idToken.line, idToken.column);
             if (currentToken.type == TokenType::T_RPAREN) consume(TokenType::T_RPAREN);
-            return;
+            return stmt;
         }
         size_t symbolIndex = symbolOpt.value();
         const SymbolInfo* symInfoPtr = symbolTable.getSymbolInfo(symbolIndex);
         if (!symInfoPtr) {
-            reportSemanticError("Internal: Symbol info missing for '" + idToken.text + "'.", idToken.line, idToken.column);
+            reportSemanticError("Internal: Symbol info missing for '" + std::string(idToken.text) + "'.", idToken.line, idToken.column);
             if (currentToken.type == TokenType::T_RPAREN) consume(TokenType::T_RPAREN);
-            return;
+            return stmt;
         }
         const SymbolInfo& symInfo = *symInfoPtr;
-
-        RPNOpCode readOpCode;
-        SymbolType itemToReadType = symInfo.type;
+        stmt->symbolIndex = symbolIndex;
 
         if (symInfo.type == SymbolType::ARRAY_INT || symInfo.type == SymbolType::ARRAY_FLOAT) {
-            emit(RPNOpCode::PUSH_ARRAY_ADDR, symbolIndex);
-            if (parseArrayIndexOpt(symInfo)) {
-                emit(RPNOpCode::INDEX);
-                itemToReadType = (symInfo.type == SymbolType::ARRAY_INT) ? SymbolType::VARIABLE_INT : SymbolType::VARIABLE_FLOAT;
+            if (symInfo.isReadOnly()) {
+                reportSemanticError("Array '" + symInfo.name + "' is mapped read-only and cannot be read into.", idToken.line, idToken.column);
+                if (currentToken.type == TokenType::T_RPAREN) consume(TokenType::T_RPAREN);
+                return stmt;
             }
-            else { // Ошибка (отсутствие индекса) уже обработана в parseArrayIndexOpt, если нужно
+            stmt->index = parseArrayIndexOpt(symInfo);
+            if (!stmt->index) { // Ошибка (отсутствие индекса) уже обработана в parseArrayIndexOpt, если нужно
                 if (!errorHandler.hasErrors()) // Если parseArrayIndexOpt не сообщил об ошибке
                     reportSemanticError("Cannot read into an entire array '" + symInfo.name + "'. Index required.", idToken.line, idToken.column);
                 if (currentToken.type == TokenType::T_RPAREN) consume(TokenType::T_RPAREN);
-                return;
+                return stmt;
             }
         }
-        else if (symInfo.type == SymbolType::VARIABLE_INT || symInfo.type == SymbolType::VARIABLE_FLOAT) {
-            emit(RPNOpCode::PUSH_VAR_ADDR, symbolIndex);
-        }
-        else {
+        else if (symInfo.type != SymbolType::VARIABLE_INT && symInfo.type != SymbolType::VARIABLE_FLOAT) {
             reportSemanticError("Identifier '" + symInfo.name + "' is not a variable or array element suitable for 'cin'.", idToken.line, idToken.column);
             if (currentToken.type == TokenType::T_RPAREN) consume(TokenType::T_RPAREN);
-            return;
-        }
-
-        if (itemToReadType == SymbolType::VARIABLE_INT) readOpCode = RPNOpCode::READ_INT;
-        else if (itemToReadType == SymbolType::VARIABLE_FLOAT) readOpCode = RPNOpCode::READ_FLOAT;
-        else {
-            reportSemanticError("Internal: Undetermined type for read operation on '" + symInfo.name + "'.", idToken.line, idToken.column);
-            if (currentToken.type == TokenType::T_RPAREN) consume(TokenType::T_RPAREN); return;
+            return stmt;
         }
-        if (!errorHandler.hasErrors()) emit(readOpCode, true /*isIoPlaceholder*/);
-
     }
     else {
         reportSyntaxError("Expected identifier inside cin(...).");
@@ -540,57 +847,66 @@ void Parser::parseCinStatement() {
         while (currentToken.type != TokenType::T_RPAREN && currentToken.type != TokenType::T_SEMICOLON && currentToken.type != TokenType::T_EOF) nextToken();
     }
     consume(TokenType::T_RPAREN);
+    return stmt;
 }
 
-void Parser::parseCoutStatement() {
+AstStmt* Parser::parseCoutStatement() {
+    if (parallelBodyDepth > 0) {
+        reportSemanticError("'cout' is not allowed inside a parallel loop.");
+        return nullptr;
+    }
+    AstStmt* stmt = astArena.newStmt(AstStmtKind::COUT, currentToken.line, currentToken.column);
     consume(TokenType::T_KW_COUT);
-    if (errorHandler.hasErrors()) return;
+    if (errorHandler.hasErrors()) return stmt;
     consume(TokenType::T_LPAREN);
-    if (errorHandler.hasErrors()) return;
+    if (errorHandler.hasErrors()) return stmt;
 
-    SymbolType exprType = parseExpression();
+    AstExpr* expression = parseExpression();
 
-    if (errorHandler.hasErrors()) { // Если ошибка в выражении, не генерируем write
+    if (errorHandler.hasErrors()) { // Если ошибка в выражении, оператор не нужен
         if (currentToken.type == TokenType::T_RPAREN) consume(TokenType::T_RPAREN);
-        return;
+        return stmt;
     }
 
-    RPNOpCode writeOpCode;
-    if (exprType == SymbolType::VARIABLE_INT) writeOpCode = RPNOpCode::WRITE_INT;
-    else if (exprType == SymbolType::VARIABLE_FLOAT) writeOpCode = RPNOpCode::WRITE_FLOAT;
-    else {
+    if (expression->type != SymbolType::VARIABLE_INT && expression->type != SymbolType::VARIABLE_FLOAT) {
         reportSemanticError("Cannot determine type of expression for 'cout'. Expression result type is invalid.", currentToken.line, currentToken.column);
         if (currentToken.type == TokenType::T_RPAREN) consume(TokenType::T_RPAREN);
-        return;
+        return stmt;
     }
-    emit(writeOpCode, true /*isIoPlaceholder*/);
+    stmt->value = expression;
     consume(TokenType::T_RPAREN);
+    return stmt;
 }
 
-void Parser::parseBeginEndBlock() {
+AstStmt* Parser::parseBeginEndBlock() {
+    AstStmt* stmt = astArena.newStmt(AstStmtKind::BLOCK, currentToken.line, currentToken.column);
     consume(TokenType::T_KW_BEGIN);
-    if (errorHandler.hasErrors()) return;
-    parseStatementList();
+    if (errorHandler.hasErrors()) return stmt;
+    AstStmtList statements;
+    parseStatementList(statements);
+    stmt->body = statements.first;
     if (errorHandler.hasErrors() && currentToken.type != TokenType::T_KW_END) {
         // Пытаемся найти 'end' если были ошибки внутри блока
         while (currentToken.type != TokenType::T_KW_END && currentToken.type != TokenType::T_EOF) nextToken();
     }
     consume(TokenType::T_KW_END);
+    return stmt;
 }
 
 // --- Разбор выражений и условий ---
 
 // <Condition> → G <ComparisonOp> G
-void Parser::parseCondition() {
-    SymbolType leftExprType = parseExpression();
-    if (errorHandler.hasErrors()) return;
+AstExpr* Parser::parseCondition() {
+    AstExpr* left = parseExpression();
+    if (errorHandler.hasErrors()) return left;
+    Token opToken = currentToken;
     RPNOpCode comparisonOp = parseComparisonOp();
-    if (errorHandler.hasErrors()) return;
-    SymbolType rightExprType = parseExpression();
-    if (errorHandler.hasErrors()) return;
+    if (errorHandler.hasErrors()) return left;
+    AstExpr* right = parseExpression();
+    if (errorHandler.hasErrors()) return left;
 
-    bool leftOk = (leftExprType == SymbolType::VARIABLE_INT || leftExprType == SymbolType::VARIABLE_FLOAT);
-    bool rightOk = (rightExprType == SymbolType::VARIABLE_INT || rightExprType == SymbolType::VARIABLE_FLOAT);
+    bool leftOk = (left->type == SymbolType::VARIABLE_INT || left->type == SymbolType::VARIABLE_FLOAT);
+    bool rightOk = (right->type == SymbolType::VARIABLE_INT || right->type == SymbolType::VARIABLE_FLOAT);
 
     if (!leftOk) {
         reportSemanticError("Left operand of comparison is not a valid numeric type.", currentToken.line, currentToken.column);
@@ -598,11 +914,10 @@ void Parser::parseCondition() {
     if (!rightOk) {
         reportSemanticError("Right operand of comparison is not a valid numeric type.", currentToken.line, currentToken.column);
     }
+    if (!leftOk || !rightOk) return left;
 
-    if (leftOk && rightOk) {
-        ensureTypesMatchOrConvert(leftExprType, rightExprType, false /*not for assignment*/);
-        emit(comparisonOp);
-    }
+    promoteOperands(left, right);
+    return newBinary(comparisonOp, SymbolType::VARIABLE_INT, left, right, opToken);
 }
 
 // <ComparisonOp> → ~ | > | < | !
@@ -613,266 +928,297 @@ RPNOpCode Parser::parseComparisonOp() {
     if (match(TokenType::T_LESS))      return RPNOpCode::CMP_LT;
     if (match(TokenType::T_NOT_EQUAL)) return RPNOpCode::CMP_NE;
 
-    reportSyntaxError("Expected comparison operator (~, >, <, !). Found '" + opToken.text + "'.");
+    reportSyntaxError("Expected comparison operator (~, >, <, !). Found '" + std::string(opToken.text) + "'.");
     return RPNOpCode::CMP_EQ;
 }
 
 // G → <Term> <ExpressionPrime>
-SymbolType Parser::parseExpression() {
-    SymbolType termType = parseTerm();
-    if (errorHandler.hasErrors()) return SymbolType::VARIABLE_INT; // Возврат типа по умолчанию при ошибке
-    return parseExpressionPrime(termType);
+AstExpr* Parser::parseExpression() {
+    AstExpr* term = parseTerm();
+    if (errorHandler.hasErrors()) return term;
+    return parseExpressionPrime(term);
 }
 
 // <ExpressionPrime> → + <Term> <ExpressionPrime> | - <Term> <ExpressionPrime> | λ
-SymbolType Parser::parseExpressionPrime(SymbolType leftOperandType) {
-    SymbolType currentResultType = leftOperandType;
+AstExpr* Parser::parseExpressionPrime(AstExpr* leftOperand) {
+    AstExpr* result = leftOperand;
     while (currentToken.type == TokenType::T_PLUS || currentToken.type == TokenType::T_MINUS) {
-        if (errorHandler.hasErrors()) return currentResultType; // Прерываем при ошибке
+        if (errorHandler.hasErrors()) return result; // Прерываем при ошибке
 
         Token opToken = currentToken;
         nextToken();
 
-        SymbolType rightOperandType = parseTerm();
-        if (errorHandler.hasErrors()) return currentResultType; // Прерываем, если ошибка в правом терме
+        AstExpr* right = parseTerm();
+        if (errorHandler.hasErrors()) return result; // Прерываем, если ошибка в правом терме
+
+        // Векторная операция: хотя бы один операнд - массив (возможен только в векторном контексте)
+        if (result->isVector() || right->isVector()) {
+            result = newBinary(opToken.type == TokenType::T_PLUS ? RPNOpCode::VEC_ADD : RPNOpCode::VEC_SUB,
+                vectorResultType(result->type, right->type), result, right, opToken);
+            continue;
+        }
 
         // Проверка типов операндов
-        bool leftOk = (currentResultType == SymbolType::VARIABLE_INT || currentResultType == SymbolType::VARIABLE_FLOAT);
-        bool rightOk = (rightOperandType == SymbolType::VARIABLE_INT || rightOperandType == SymbolType::VARIABLE_FLOAT);
+        bool leftOk = (result->type == SymbolType::VARIABLE_INT || result->type == SymbolType::VARIABLE_FLOAT);
+        bool rightOk = (right->type == SymbolType::VARIABLE_INT || right->type == SymbolType::VARIABLE_FLOAT);
 
         if (!leftOk || !rightOk) {
-            reportSemanticError("Invalid operand type(s) for '" + opToken.text + "' operation.", opToken.line, opToken.column);
-            // Тип результата не меняется, пропускаем emit
+            reportSemanticError("Invalid operand type(s) for '" + std::string(opToken.text) + "' operation.", opToken.line, opToken.column);
+            // Тип результата не меняется
         }
         else {
-            ensureTypesMatchOrConvert(currentResultType, rightOperandType, false /*for binary op*/);
-
-            if (currentResultType == SymbolType::VARIABLE_FLOAT || rightOperandType == SymbolType::VARIABLE_FLOAT) {
-                currentResultType = SymbolType::VARIABLE_FLOAT;
-            }
-            else {
-                currentResultType = SymbolType::VARIABLE_INT;
-            }
-            emit(opToken.type == TokenType::T_PLUS ? RPNOpCode::ADD : RPNOpCode::SUB);
+            promoteOperands(result, right);
+            result = newBinary(opToken.type == TokenType::T_PLUS ? RPNOpCode::ADD : RPNOpCode::SUB, result->type, result, right, opToken);
         }
     }
-    return currentResultType;
+    return result;
 }
 
 // <Term> → <Factor> <TermPrime>
-SymbolType Parser::parseTerm() {
-    SymbolType factorType = parseFactor();
-    if (errorHandler.hasErrors()) return SymbolType::VARIABLE_INT;
-    return parseTermPrime(factorType);
+AstExpr* Parser::parseTerm() {
+    AstExpr* factor = parseFactor();
+    if (errorHandler.hasErrors()) return factor;
+    return parseTermPrime(factor);
 }
 
 // <TermPrime> → * <Factor> <TermPrime> | / <Factor> <TermPrime> | λ
-SymbolType Parser::parseTermPrime(SymbolType leftOperandType) {
-    SymbolType currentResultType = leftOperandType;
+AstExpr* Parser::parseTermPrime(AstExpr* leftOperand) {
+    AstExpr* result = leftOperand;
     while (currentToken.type == TokenType::T_MULTIPLY || currentToken.type == TokenType::T_DIVIDE) {
-        if (errorHandler.hasErrors()) return currentResultType;
+        if (errorHandler.hasErrors()) return result;
 
         Token opToken = currentToken;
         nextToken();
 
-        SymbolType rightOperandType = parseFactor();
-        if (errorHandler.hasErrors()) return currentResultType;
+        AstExpr* right = parseFactor();
+        if (errorHandler.hasErrors()) return result;
+
+        if (result->isVector() || right->isVector()) {
+            result = newBinary(opToken.type == TokenType::T_MULTIPLY ? RPNOpCode::VEC_MUL : RPNOpCode::VEC_DIV,
+                vectorResultType(result->type, right->type), result, right, opToken);
+            continue;
+        }
 
-        bool leftOk = (currentResultType == SymbolType::VARIABLE_INT || currentResultType == SymbolType::VARIABLE_FLOAT);
-        bool rightOk = (rightOperandType == SymbolType::VARIABLE_INT || rightOperandType == SymbolType::VARIABLE_FLOAT);
+        bool leftOk = (result->type == SymbolType::VARIABLE_INT || result->type == SymbolType::VARIABLE_FLOAT);
+        bool rightOk = (right->type == SymbolType::VARIABLE_INT || right->type == SymbolType::VARIABLE_FLOAT);
 
         if (!leftOk || !rightOk) {
-            reportSemanticError("Invalid operand type(s) for '" + opToken.text + "' operation.", opToken.line, opToken.column);
+            reportSemanticError("Invalid operand type(s) for '" + std::string(opToken.text) + "' operation.", opToken.line, opToken.column);
         }
         else {
-            ensureTypesMatchOrConvert(currentResultType, rightOperandType, false);
-
-            if (currentResultType == SymbolType::VARIABLE_FLOAT || rightOperandType == SymbolType::VARIABLE_FLOAT) {
-                currentResultType = SymbolType::VARIABLE_FLOAT;
-            }
-            else {
-                currentResultType = SymbolType::VARIABLE_INT;
-            }
-            emit(opToken.type == TokenType::T_MULTIPLY ? RPNOpCode::MUL : RPNOpCode::DIV);
+            promoteOperands(result, right);
+            result = newBinary(opToken.type == TokenType::T_MULTIPLY ? RPNOpCode::MUL : RPNOpCode::DIV, result->type, result, right, opToken);
         }
     }
-    return currentResultType;
+    return result;
+}
+
+SymbolType Parser::vectorResultType(SymbolType left, SymbolType right) {
+    bool anyFloat = (left == SymbolType::ARRAY_FLOAT || left == SymbolType::VARIABLE_FLOAT ||
+        right == SymbolType::ARRAY_FLOAT || right == SymbolType::VARIABLE_FLOAT);
+    return anyFloat ? SymbolType::ARRAY_FLOAT : SymbolType::ARRAY_INT;
+}
+
+// Векторные операции работают с непрерывной памятью массива, поэтому такой массив
+// не может быть разреженным (явная подсказка sparse - ошибка, AUTO - остается плотным)
+void Parser::noteWholeArrayOperand(size_t symbolIndex, const Token& idToken) {
+    if (symbolTable.isArraySparse(symbolIndex)) {
+        const SymbolInfo* info = symbolTable.getSymbolInfo(symbolIndex);
+        reportSemanticError("Sparse array '" + (info ? info->name : std::string(idToken.text)) + "' cannot be used in whole-array operations.",
+            idToken.line, idToken.column);
+        return;
+    }
+    wholeArrayOperands.push_back(symbolIndex);
+}
+
+// sum(G) - сумма элементов векторного выражения
+AstExpr* Parser::parseSumCall() {
+    Token sumToken = currentToken;
+    nextToken(); // sum (контекстное слово проверено в parseFactor)
+    consume(TokenType::T_LPAREN);
+    if (errorHandler.hasErrors()) return invalidExpr();
+
+    // Аргумент разбирается в собственном векторном контексте: длину задает первый массив
+    bool savedActive = vectorContextActive;
+    std::optional<size_t> savedLength = vectorContextLength;
+    vectorContextActive = true;
+    vectorContextLength.reset();
+    AstExpr* argument = parseExpression();
+    vectorContextActive = savedActive;
+    vectorContextLength = savedLength;
+
+    if (errorHandler.hasErrors()) return invalidExpr();
+    consume(TokenType::T_RPAREN);
+
+    if (!argument->isVector()) {
+        reportSemanticError("Argument of 'sum' must be an array expression.", sumToken.line, sumToken.column);
+        return invalidExpr();
+    }
+    AstExpr* sum = astArena.newExpr(AstExprKind::SUM,
+        (argument->type == SymbolType::ARRAY_INT) ? SymbolType::VARIABLE_INT : SymbolType::VARIABLE_FLOAT, sumToken.line, sumToken.column);
+    sum->left = argument;
+    return sum;
 }
 
-// <Factor> → (G) | aH | k_int | k_float | -<Factor> (Унарный минус)
-SymbolType Parser::parseFactor() {
+// <Factor> → (G) | aH | k_int | k_float | -<Factor> (Унарный минус) | sum(G)
+AstExpr* Parser::parseFactor() {
     Token factorStartToken = currentToken;
-    SymbolType factorType = SymbolType::VARIABLE_INT; // Тип по умолчанию при ошибке
 
-    if (errorHandler.hasErrors()) return factorType;
+    if (errorHandler.hasErrors()) return invalidExpr();
 
     switch (currentToken.type) {
-    case TokenType::T_LPAREN:
+    case TokenType::T_LPAREN: {
         nextToken();
-        factorType = parseExpression();
+        AstExpr* inner = parseExpression();
         if (errorHandler.hasErrors() && currentToken.type != TokenType::T_RPAREN) {
             while (currentToken.type != TokenType::T_RPAREN && currentToken.type != TokenType::T_SEMICOLON && currentToken.type != TokenType::T_EOF) nextToken();
         }
         consume(TokenType::T_RPAREN);
-        break;
+        return inner;
+    }
     case TokenType::T_IDENTIFIER: {
+        // sum( - встроенная свертка: вызовов функций в языке нет, поэтому переменная sum так не встречается
+        if (currentToken.identifierId == WORD_SUM && peekToken(1).type == TokenType::T_LPAREN) {
+            return parseSumCall();
+        }
         Token idToken = currentToken;
         nextToken();
 
-        auto symbolOpt = symbolTable.findSymbol(idToken.text);
+        auto symbolOpt = symbolTable.findSymbol(idToken.identifierId);
         if (!symbolOpt) {
-            reportSemanticError("Identifier '" + idToken.text + "' not declared.", idToken.line, idToken.column);
-            return factorType;
+            reportSemanticError("Identifier '" + std::string(idToken.text) + "' not declared.", idToken.line, idToken.column);
+            return invalidExpr();
         }
         size_t symbolIndex = symbolOpt.value();
         const SymbolInfo* symInfoPtr = symbolTable.getSymbolInfo(symbolIndex);
         if (!symInfoPtr) {
-            reportSemanticError("Internal: Symbol info missing for '" + idToken.text + "'.", idToken.line, idToken.column);
-            return factorType;
+            reportSemanticError("Internal: Symbol info missing for '" + std::string(idToken.text) + "'.", idToken.line, idToken.column);
+            return invalidExpr();
         }
         const SymbolInfo& symInfo = *symInfoPtr;
 
         if (symInfo.type == SymbolType::ARRAY_INT || symInfo.type == SymbolType::ARRAY_FLOAT) {
-            emit(RPNOpCode::PUSH_ARRAY_ADDR, symbolIndex);
-            if (parseArrayIndexOpt(symInfo)) {
-                emit(RPNOpCode::INDEX);
-                factorType = (symInfo.type == SymbolType::ARRAY_INT) ? SymbolType::VARIABLE_INT : SymbolType::VARIABLE_FLOAT;
+            if (AstExpr* index = parseArrayIndexOpt(symInfo)) {
+                AstExpr* element = astArena.newExpr(AstExprKind::ARRAY_ELEMENT,
+                    (symInfo.type == SymbolType::ARRAY_INT) ? SymbolType::VARIABLE_INT : SymbolType::VARIABLE_FLOAT, idToken.line, idToken.column);
+                element->symbolIndex = symbolIndex;
+                element->left = index;
+                return element;
             }
-            else {
-                if (!errorHandler.hasErrors()) // Если parseArrayIndexOpt не сообщил об ошибке
-                    reportSemanticError("Cannot use an entire array '" + symInfo.name + "' as a value in an expression. Index required.", idToken.line, idToken.column);
-                // Тип factorType останется дефолтным (INT), что может вызвать проблемы далее.
+            if (vectorContextActive) {
+                // Массив целиком как операнд векторного выражения
+                if (vectorContextLength && vectorContextLength.value() != symInfo.arrayDeclaredSize) {
+                    reportSemanticError("Array '" + symInfo.name + "' has size " + std::to_string(symInfo.arrayDeclaredSize) +
+                        ", but the vector expression requires size " + std::to_string(vectorContextLength.value()) + ".", idToken.line, idToken.column);
+                }
+                vectorContextLength = symInfo.arrayDeclaredSize;
+                noteWholeArrayOperand(symbolIndex, idToken);
+                AstExpr* wholeArray = astArena.newExpr(AstExprKind::WHOLE_ARRAY, symInfo.type, idToken.line, idToken.column);
+                wholeArray->symbolIndex = symbolIndex;
+                return wholeArray;
             }
+            if (!errorHandler.hasErrors()) // Если parseArrayIndexOpt не сообщил об ошибке
+                reportSemanticError("Cannot use an entire array '" + symInfo.name + "' as a value in an expression. Index required.", idToken.line, idToken.column);
+            return invalidExpr();
         }
-        else if (symInfo.type == SymbolType::VARIABLE_INT || symInfo.type == SymbolType::VARIABLE_FLOAT) {
-            // Для использования значения переменной в выражении, мы кладем ее АДРЕС.
-            // Интерпретатор будет извлекать значение по этому адресу при выполнении операций.
-            emit(RPNOpCode::PUSH_VAR_ADDR, symbolIndex);
-            factorType = symInfo.type;
+        if (symInfo.type == SymbolType::VARIABLE_INT || symInfo.type == SymbolType::VARIABLE_FLOAT) {
+            AstExpr* variable = astArena.newExpr(AstExprKind::VARIABLE, symInfo.type, idToken.line, idToken.column);
+            variable->symbolIndex = symbolIndex;
+            return variable;
         }
-        else { // Не должно случиться
-            reportSemanticError("Identifier '" + symInfo.name + "' is not a recognized variable or array for use in expression.", idToken.line, idToken.column);
-        }
-        break;
+        // Не должно случиться
+        reportSemanticError("Identifier '" + symInfo.name + "' is not a recognized variable or array for use in expression.", idToken.line, idToken.column);
+        return invalidExpr();
     }
-    case TokenType::T_NUMBER_INT:
-        emit(RPNOpCode::PUSH_CONST_INT, currentToken.getIntValue());
+    case TokenType::T_NUMBER_INT: {
+        AstExpr* constant = newConstInt(currentToken.getIntValue(), currentToken.line, currentToken.column);
         nextToken();
-        factorType = SymbolType::VARIABLE_INT;
-        break;
-    case TokenType::T_NUMBER_FLOAT:
-        emit(RPNOpCode::PUSH_CONST_FLOAT, currentToken.getFloatValue());
+        return constant;
+    }
+    case TokenType::T_NUMBER_FLOAT: {
+        AstExpr* constant = newConstFloat(currentToken.getFloatValue(), currentToken.line, currentToken.column);
         nextToken();
-        factorType = SymbolType::VARIABLE_FLOAT;
-        break;
-    case TokenType::T_MINUS:
+        return constant;
+    }
+    case TokenType::T_MINUS: {
         nextToken();
-        {
-            SymbolType subFactorType = parseFactor();
-            if (errorHandler.hasErrors()) return factorType; // Если ошибка в subFactor
-
-            if (subFactorType == SymbolType::VARIABLE_INT) {
-                emit(RPNOpCode::PUSH_CONST_INT, 0); // 0
-                ensureTypesMatchOrConvert(SymbolType::VARIABLE_INT, subFactorType, false); // 0 (int) - subFactor (int)
-                emit(RPNOpCode::SUB);
-                factorType = SymbolType::VARIABLE_INT;
-            }
-            else if (subFactorType == SymbolType::VARIABLE_FLOAT) {
-                emit(RPNOpCode::PUSH_CONST_FLOAT, 0.0f); // 0.0
-                ensureTypesMatchOrConvert(SymbolType::VARIABLE_FLOAT, subFactorType, false); // 0.0 (float) - subFactor (float)
-                emit(RPNOpCode::SUB);
-                factorType = SymbolType::VARIABLE_FLOAT;
-            }
-            else {
-                reportSemanticError("Cannot apply unary minus to non-numeric type.", factorStartToken.line, factorStartToken.column);
-            }
+        AstExpr* operand = parseFactor();
+        if (errorHandler.hasErrors()) return operand; // Если ошибка в операнде
+
+        if (operand->type == SymbolType::VARIABLE_INT) { // -a == 0 - a
+            return newBinary(RPNOpCode::SUB, SymbolType::VARIABLE_INT,
+                newConstInt(0, factorStartToken.line, factorStartToken.column), operand, factorStartToken);
         }
-        break;
+        if (operand->type == SymbolType::VARIABLE_FLOAT) {
+            return newBinary(RPNOpCode::SUB, SymbolType::VARIABLE_FLOAT,
+                newConstFloat(0.0f, factorStartToken.line, factorStartToken.column), operand, factorStartToken);
+        }
+        if (operand->isVector()) { // -a == a * -1 поэлементно
+            return newBinary(RPNOpCode::VEC_MUL, operand->type,
+                operand, newConstInt(-1, factorStartToken.line, factorStartToken.column), factorStartToken);
+        }
+        reportSemanticError("Cannot apply unary minus to non-numeric type.", factorStartToken.line, factorStartToken.column);
+        return operand;
+    }
     default:
-        reportSyntaxError("Expected factor (expression in parenthesis, identifier, number, or unary minus). Found '" + factorStartToken.text + "'.");
-        break;
+        reportSyntaxError("Expected factor (expression in parenthesis, identifier, number, or unary minus). Found '" + std::string(factorStartToken.text) + "'.");
+        return invalidExpr();
     }
-    return factorType;
 }
 
 // --- Семантические проверки и утилиты ---
-void Parser::ensureTypesMatchOrConvert(SymbolType typeLHS, SymbolType typeRHS, bool forAssignment) {
-    // typeLHS - тип левого операнда (или цели присваивания). Уже на стеке (или адрес для присваивания).
-    // typeRHS - тип правого операнда (или источника для присваивания). Только что сгенерирован ОПС для него (на вершине).
-
-    bool lhsIsNum = (typeLHS == SymbolType::VARIABLE_INT || typeLHS == SymbolType::VARIABLE_FLOAT);
-    bool rhsIsNum = (typeRHS == SymbolType::VARIABLE_INT || typeRHS == SymbolType::VARIABLE_FLOAT);
-
-    if (!lhsIsNum || !rhsIsNum) {
-        // Если один из операндов нечисловой, и это не ошибка, уже обработанная ранее,
-        // то здесь можно дополнительно сообщить, но обычно предыдущие проверки типа должны были это покрыть.
-        // reportSemanticError("Type mismatch: operands must be numeric for this operation.");
-        return;
+// Бинарная операция над int и float выполняется в float: целый операнд (левый или правый)
+// оборачивается узлом приведения
+void Parser::promoteOperands(AstExpr*& left, AstExpr*& right) {
+    if (left->type == SymbolType::VARIABLE_FLOAT && right->type == SymbolType::VARIABLE_INT) {
+        right = newConvert(right, SymbolType::VARIABLE_FLOAT);
     }
-
-    if (typeLHS == typeRHS) {
-        return; // Типы совпадают, конвертация не нужна
-    }
-
-    if (forAssignment) {
-        // Присваивание: RHS (typeRHS, на вершине стека) конвертируется к типу LHS (typeLHS)
-        if (typeLHS == SymbolType::VARIABLE_INT && typeRHS == SymbolType::VARIABLE_FLOAT) {
-            // Цель int, источник float -> конвертируем float на вершине в int
-            emit(RPNOpCode::CONVERT_TO_INT);
-        }
-        else if (typeLHS == SymbolType::VARIABLE_FLOAT && typeRHS == SymbolType::VARIABLE_INT) {
-            // Цель float, источник int -> конвертируем int на вершине в float
-            emit(RPNOpCode::CONVERT_TO_FLOAT);
-        }
-    }
-    else {
-        // Бинарные арифметические/сравнительные операции: оба операнда приводятся к float, если один из них float
-        // На стеке: ... val_LHS val_RHS
-        if (typeLHS == SymbolType::VARIABLE_FLOAT && typeRHS == SymbolType::VARIABLE_INT) {
-            // val_LHS (float), val_RHS (int) -> конвертируем val_RHS (на вершине) в float
-            emit(RPNOpCode::CONVERT_TO_FLOAT);
-        }
-        else if (typeLHS == SymbolType::VARIABLE_INT && typeRHS == SymbolType::VARIABLE_FLOAT) {
-            // val_LHS (int), val_RHS (float)
-            // Нужно конвертировать val_LHS. Это требует:
-            // 1. Сохранить val_RHS (на вершине) во временную переменную (или специальную ОПС команду)
-            // 2. Вытащить val_LHS, конвертировать, положить обратно
-            // 3. Вернуть val_RHS на стек
-            // Это сложно для текущей ОПС.
-            // Проще всего, если интерпретатор делает неявное повышение или
-            // мы пересматриваем порядок генерации ОПС для левого операнда.
-
-            // Текущее УПРОЩЕННОЕ решение: Мы НЕ конвертируем здесь левый операнд (typeLHS).
-            // Вместо этого, логика в parseExpressionPrime/parseTermPrime ДОЛЖНА была обеспечить,
-            // что если currentResultType (который станет typeLHS здесь) был INT,
-            // а только что разобранный правый операнд (который станет typeRHS здесь) FLOAT,
-            // то currentResultType сам становится FLOAT (и его значение на стеке должно было быть
-            // преобразовано, если это был результат предыдущей операции).
-            // Однако, если typeLHS - это результат parseFactor (например, int переменная), а typeRHS - float,
-            // то именно здесь нужно вставить конвертацию для typeLHS.
-            // Это все еще указывает на сложность.
-
-            // Более прагматичный подход для ЯВНОЙ конверсии парсером:
-            // Если мы определили, что итоговая операция будет float (т.к. один из операндов float),
-            // то перед emit(OPERATOR) мы должны убедиться, что ОБА операнда на стеке - float.
-            // В parseExpressionPrime/TermPrime, после разбора правого операнда:
-            // if (currentResultType_был_INT && rightOperandType_стал_FLOAT) -> КОНВЕРТИРОВАТЬ ЛЕВЫЙ (сложно)
-            // if (currentResultType_был_FLOAT && rightOperandType_стал_INT) -> КОНВЕРТИРОВАТЬ ПРАВЫЙ (просто, emit CONVERT_TO_FLOAT)
-
-            // ОСТАВИМ ТАК: если левый INT, а правый FLOAT, то интерпретатор должен будет повысить левый.
-            // Если левый FLOAT, а правый INT, то мы конвертируем правый (на вершине).
-            // Эта асимметрия - компромисс.
-            // reportSemanticError("Performing implicit promotion for binary operation: left operand (int) with right operand (float). Interpreter will handle promotion.", currentToken.line, currentToken.column);
-            // Ничего не генерируем здесь, полагаемся на интерпретатор для (INT op FLOAT)
-        }
+    else if (left->type == SymbolType::VARIABLE_INT && right->type == SymbolType::VARIABLE_FLOAT) {
+        left = newConvert(left, SymbolType::VARIABLE_FLOAT);
     }
 }
 
 // --- Получение и вывод ОПС ---
+void Parser::printIR() const {
+    irCode.print(std::cout, symbolTable);
+}
+
+void Parser::printPassStatistics() const {
+    passManager.printStatistics(std::cout);
+}
+
 const std::vector<RPNOperation>& Parser::getRPNCode() const {
     return rpnCode;
 }
 
+size_t Parser::getTokenCount() const {
+    return tokensRead;
+}
+
+const SourceLocationTable& Parser::getSourceLocations() const {
+    return rpnLocations;
+}
+
+const std::vector<VectorLoopInfo>& Parser::getVectorLoops() const {
+    return vectorLoops;
+}
+
+const std::vector<ParallelLoopInfo>& Parser::getParallelLoops() const {
+    return parallelLoops;
+}
+
+void Parser::setLoopVectorization(bool enabled) {
+    loopVectorizationEnabled = enabled;
+}
+
+void Parser::setAutoParallelization(bool enabled) {
+    autoParallelizationEnabled = enabled;
+}
+
+void Parser::setOptimizationLevel(int level) {
+    optimizationLevel = level;
+}
+
 void Parser::printRPN() const {
     std::cout << "\n--- Reverse Polish Notation (RPN) ---" << std::endl;
     std::cout << "Idx | OpCode            | Operand  | SymIdx | JumpTo" << std::endl;
@@ -904,6 +1250,13 @@ void Parser::printRPN() const {
         case RPNOpCode::JUMP_FALSE:       std::cout << std::left << std::setw(17) << "JUMP_FALSE"; break;
         case RPNOpCode::CONVERT_TO_FLOAT: std::cout << std::left << std::setw(17) << "CONVERT_TO_FLOAT"; break;
         case RPNOpCode::CONVERT_TO_INT:   std::cout << std::left << std::setw(17) << "CONVERT_TO_INT"; break;
+        case RPNOpCode::VEC_ADD:          std::cout << std::left << std::setw(17) << "VEC_ADD"; break;
+        case RPNOpCode::VEC_SUB:          std::cout << std::left << std::setw(17) << "VEC_SUB"; break;
+        case RPNOpCode::VEC_MUL:          std::cout << std::left << std::setw(17) << "VEC_MUL"; break;
+        case RPNOpCode::VEC_DIV:          std::cout << std::left << std::setw(17) << "VEC_DIV"; break;
+        case RPNOpCode::VEC_ASSIGN:       std::cout << std::left << std::setw(17) << "VEC_ASSIGN"; break;
+        case RPNOpCode::VEC_SUM:          std::cout << std::left << std::setw(17) << "VEC_SUM"; break;
+        case RPNOpCode::PARALLEL_LOOP:    std::cout << std::left << std::setw(17) << "PARALLEL_LOOP"; break;
             // default убран, чтобы компилятор предупреждал о необработанных RPNOpCode
         }
         std::cout << " | ";
@@ -934,7 +1287,35 @@ void Parser::printRPN() const {
         else {
             std::cout << std::setw(6) << "-";
         }
+        if (op.loopInfoIndex.has_value()) {
+            std::cout << "  <- vectorized loop #" << op.loopInfoIndex.value();
+        }
+        if (op.parallelInfoIndex.has_value()) {
+            std::cout << "  <- parallel loop #" << op.parallelInfoIndex.value();
+        }
         std::cout << std::endl;
     }
     std::cout << "-------------------------------------------------" << std::endl;
+    for (const auto& report : loopReports) {
+        std::cout << "Loop RPN[" << report.headerAddress << ".." << report.backJumpAddress << "]: ";
+        if (report.vectorized) std::cout << "vectorized" << std::endl;
+        else std::cout << "not vectorized (" << report.reason << ")" << std::endl;
+    }
+    for (size_t k = 0; k < parallelLoops.size(); ++k) {
+        const ParallelLoopInfo& loop = parallelLoops[k];
+        std::cout << "Parallel loop #" << k << " RPN[" << loop.headerAddress << ".." << loop.backJumpAddress << "]: "
+            << (loop.automatic ? "automatic" : "explicit");
+        for (const ParallelReduction& reduction : loop.reductions) {
+            const char* op = (reduction.kind == ParallelReduction::Kind::SUM) ? "+" :
+                (reduction.kind == ParallelReduction::Kind::MIN) ? "min" : "max";
+            const SymbolInfo* info = symbolTable.getSymbolInfo(reduction.varIndex);
+            std::cout << ", reduce(" << op << " " << (info ? info->name : "?") << ")";
+        }
+        std::cout << std::endl;
+    }
+    for (const auto& report : parallelReports) {
+        if (report.parallelized) continue; // Уже выведен в списке параллельных циклов
+        std::cout << "Loop RPN[" << report.headerAddress << ".." << report.backJumpAddress << "]: not parallelized ("
+            << report.reason << ")" << std::endl;
+    }
 }
\ No newline at end of file
@@ -5,18 +5,41 @@
 #include <vector>
 #include <string>
 #include <stack>   // Для стека меток (адресов для патчинга)
+#include <deque>   // Очередь просмотренных вперед токенов
 #include <optional>
 
 #include "definitions.h"    // TokenType, RPNOpCode, SymbolType
 #include "token.h"          // Структура Token
 #include "rpn_op.h"         // Структура RPNOperation
+#include "source_location.h" // Позиции операций ОПС
 #include "lexer.h"          // Класс Lexer
+#include "token_buffer.h"   // Заранее лексированные токены
 #include "symbol_table.h"   // Класс SymbolTable
 #include "error_handler.h"  // Класс ErrorHandler
+#include "ast.h"            // Типизированное дерево программы
+#include "ir.h"             // Граф потока управления и генерация ОПС
+#include "pass_manager.h"   // Оптимизирующие проходы над IR
+#include "loop_vectorizer.h" // Автовекторизация циклов
+#include "parallel_loop.h"   // Описатели параллельных циклов
+#include "loop_parallelizer.h" // Автоматическое распараллеливание циклов
+
+// Время этапов последнего parse() в миллисекундах (без чтения токенов лексером заранее, см. TokenBuffer)
+struct ParsePhaseTimes {
+    double syntax = 0.0;       // Разбор и построение дерева (при чтении токенов из лексера - вместе с лексером)
+    double irBuild = 0.0;      // Дерево -> IR
+    double optimize = 0.0;     // Проходы -O1..-O3
+    double rpnEmission = 0.0;  // IR -> ОПС, проверка циклов parallel
+    double loopAnalysis = 0.0; // Выбор представления массивов, векторизация, распараллеливание
+};
 
 class Parser {
 private:
-    Lexer& lexer;
+    // Источник токенов: лексер (токены читаются по одному) или заранее заполненный буфер
+    Lexer* lexer;
+    const TokenBuffer* tokenBuffer;
+    size_t tokenIndex;                // Следующий токен буфера
+    size_t tokensRead;                // Прочитанные из источника токены (без T_EOF)
+    std::deque<Token> lookaheadTokens; // Токены, уже прочитанные из лексера через peekToken
     SymbolTable& symbolTable;
     ErrorHandler& errorHandler;
 
@@ -25,12 +48,42 @@ private:
     // или уже разбираем исполняемый код. Помогает различать контекст.
     bool declarationContextActive;
     SymbolType lastDeclaredType; // Для запоминания типа при объявлении массивов (int arr A[10] или float arr B[5])
+    // Векторный контекст: внутри правой части присваивания целому массиву (c = a + b * 2)
+    // или аргумента sum(...) массивы без индекса допустимы как операнды.
+    bool vectorContextActive;
+    std::optional<size_t> vectorContextLength; // Требуемая длина массивов-операндов (nullopt - задается первым массивом)
 
 
+    AstArena astArena;        // Узлы дерева программы
+    AstStmt* programBody;     // Операторы между begin и end
+    IrFunction irCode;        // Промежуточное представление, из которого генерируется ОПС
+    int optimizationLevel;    // -O0..-O3
+    PassManager passManager;
     std::vector<RPNOperation> rpnCode; // Генерируемый код ОПС
+    SourceLocationTable rpnLocations;  // Позиции операций ОПС в исходном тексте
+    bool loopVectorizationEnabled;
+    std::vector<VectorLoopInfo> vectorLoops; // Описатели векторизованных циклов
+    std::vector<LoopReport> loopReports;     // Решения векторизатора (для printRPN)
+    std::vector<ParallelLoopInfo> parallelLoops; // Описатели циклов parallel ... while и автоматически найденных
+    bool autoParallelizationEnabled;
+    std::vector<ParallelLoopReport> parallelReports; // Решения анализа зависимостей (для printRPN)
+    std::vector<size_t> wholeArrayOperands; // Массивы, используемые целиком (им нужна плотная память)
+    int parallelBodyDepth; // Глубина вложенности тел параллельных циклов
+    std::vector<size_t> parallelAssignedScalars; // Скалярные переменные, которым присваивается значение в теле
+    // Цикл parallel, канонический вид которого проверяется по ОПС после генерации
+    struct ParallelLoopCheck {
+        size_t loopIndex;
+        int line;
+        int column;
+        std::vector<size_t> assignedScalars;
+    };
+    std::vector<ParallelLoopCheck> parallelLoopChecks;
+    ParsePhaseTimes phaseTimes;
 
     // Вспомогательные методы
     void nextToken(); // Получить следующий токен от лексера
+    Token readToken(); // Следующий токен источника (без T_ERROR), минуя очередь просмотра
+    Token peekToken(size_t ahead); // Токен на ahead позиций после текущего (0 - текущий), без продвижения
     bool match(TokenType expectedType); // Проверить тип текущего токена и перейти к следующему
     void consume(TokenType expectedType); // Как match, но без возвращаемого значения, просто требует совпадения
 
@@ -38,16 +91,14 @@ private:
     void reportSyntaxError(const std::string& message);
     void reportSemanticError(const std::string& message, int line = 0, int col = 0);
 
-    // Генерация ОПС
-    void emit(RPNOpCode opCode);
-    void emit(RPNOpCode opCode, int value);      // Для PUSH_CONST_INT
-    void emit(RPNOpCode opCode, float value);    // Для PUSH_CONST_FLOAT
-    void emit(RPNOpCode opCode, size_t symbolIndex); // Для PUSH_VAR_ADDR, PUSH_ARRAY_ADDR
-    void emit(RPNOpCode opCode, bool isIoPlaceholder); // Для READ/WRITE операций (для разрешения перегрузки)
+    // Построение узлов дерева
+    AstExpr* newConstInt(int value, int line, int column);
+    AstExpr* newConstFloat(float value, int line, int column);
+    AstExpr* newBinary(RPNOpCode op, SymbolType type, AstExpr* left, AstExpr* right, const Token& opToken);
+    AstExpr* newConvert(AstExpr* operand, SymbolType targetType); // Без узла, если тип уже совпадает
+    AstExpr* invalidExpr();
 
-    int emitJumpPlaceholder(RPNOpCode jumpOpCode); // Генерирует JUMP/JUMP_FALSE с -1, возвращает индекс
-    void patchJump(int rpnAddressToPatch, int targetRpnAddress); // Патчит переход по указанному адресу
-    int getCurrentRPNAddress() const; // Текущий "адрес" в rpnCode (равен rpnCode.size())
+    void generateCode(); // Дерево -> IR -> ОПС, проверка циклов parallel
 
     // --- Методы рекурсивного спуска для разбора грамматики ---
     // Грамматика из вашей документации (с адаптациями для float и рекурсивного спуска)
@@ -57,18 +108,28 @@ private:
     // <ArrayTypeSpec> -> int | float (Это новое, чтобы знать тип элементов массива)
     // L → a <VarListTail>
     // <VarListTail> → , a <VarListTail> | λ
-    // M → a [ k ] <ArrListTail>
-    // <ArrListTail> → , a [ k ] <ArrListTail> | λ
+    // M → a [ <ArraySize> ] <ArrListTail>
+    // <ArraySize> → k | "файл" <MapMode>  (массив, отображенный на двоичный файл; размер - по длине файла)
+    // <MapMode> → readonly | cow | λ        (по умолчанию readonly; cow - запись в частную копию)
+    // <ArrListTail> → , a [ <ArraySize> ] <ArrListTail> | λ
     // A → <Statement> <StatementTail> (StatementTail обрабатывает '; A' или 'λ')
     // <StatementTail> → ; A | λ
-    // <Statement> → aH = G | if (C) <ScopedStatement> E_else | while (C) <ScopedStatement> | cin(aH) | cout(G) | begin A end | λ
+    // <Statement> → aH = G | if (C) <ScopedStatement> E_else | while (C) <ScopedStatement> | cin(aH) | cout(G) | begin A end
+    //              | parallel <ReduceList> while (C) <ScopedStatement> | λ
+    // <ReduceList> → reduce ( <ReduceOp> a ) <ReduceList> | λ
+    // <ReduceOp> → + | min | max
+    // Параллельный цикл должен иметь вид while (i < n) begin ... ; i = i + 1 end (i, n - int, n или константа
+    // не меняются в теле); cin/cout и присваивание целому массиву в теле запрещены.
     // <ScopedStatement> -> <Statement> | begin A end (чтобы if/while могли иметь один оператор или блок)
     // H → [G] | λ (индекс массива)
     // G → <Term> <ExpressionPrime> (Выражение)
     // <ExpressionPrime> → + <Term> <ExpressionPrime> | - <Term> <ExpressionPrime> | λ
     // <Term> → <Factor> <TermPrime>
     // <TermPrime> → * <Factor> <TermPrime> | / <Factor> <TermPrime> | λ
-    // <Factor> → (G) | aH | k_int | k_float | -<Factor> (Унарный минус)
+    // <Factor> → (G) | aH | k_int | k_float | -<Factor> (Унарный минус) | sum(G)
+    // Векторные операторы: a = G, где a - массив без индекса. В G (и в аргументе sum)
+    // массивы без индекса означают поэлементную операцию; все массивы должны иметь одинаковый размер,
+    // скаляры размножаются на всю длину.
     // E_else → else <ScopedStatement> | λ
     // C → G <ComparisonOp> G (Условие)
     // <ComparisonOp> → ~ | > | < | !
@@ -82,49 +143,76 @@ private:
     void parseVarListTail(SymbolType varType);
     void parseArrList(SymbolType elementType); // elementType - тип элементов массива
     void parseArrListTail(SymbolType elementType);
+    void parseArraySizeSpec(const Token& idToken, SymbolType arrAggregateType); // k [sparse|dense] или "файл" [readonly|cow]
 
-    void parseStatementList(); // A в грамматике
-    void parseStatementTail();
-    void parseStatement();
-    void parseScopedStatement(); // Для then/else/while тел
+    // Операторы добавляются в список statements; отдельные операторы возвращаются узлом
+    // дерева (nullptr - пустой оператор или ошибка)
+    void parseStatementList(AstStmtList& statements); // A в грамматике
+    void parseStatementTail(AstStmtList& statements);
+    AstStmt* parseStatement();
+    AstStmt* parseScopedStatement(); // Для then/else/while тел
 
-    // Возвращает true, если был разобран индекс (и ОПС для него сгенерирован)
+    // Возвращает выражение индекса или nullptr, если индекса нет
     // symbolInfo - информация о символе (массиве)
-    bool parseArrayIndexOpt(const SymbolInfo& symbolInfo); // H в грамматике
+    AstExpr* parseArrayIndexOpt(const SymbolInfo& symbolInfo); // H в грамматике
 
-    void parseAssignmentOrExpressionStatement(); // Разбирает либо aH=G, либо просто G (если будет разрешено)
+    AstStmt* parseAssignmentOrExpressionStatement(); // Разбирает либо aH=G, либо просто G (если будет разрешено)
     // Пока будет только aH=G
-
-    void parseIfStatement();
-    void parseElseClause(int jumpOverElsePlaceholder); // E_else
-    void parseWhileStatement();
-    void parseCinStatement();
-    void parseCoutStatement();
-    void parseBeginEndBlock();
-
-    // Для выражений и условий
-    SymbolType parseExpression(); // G, возвращает предполагаемый тип результата выражения
-    SymbolType parseTerm();
-    SymbolType parseFactor();
-    SymbolType parseExpressionPrime(SymbolType leftOperandType); // Принимает тип левого операнда для проверки и преобразования
-    SymbolType parseTermPrime(SymbolType leftOperandType);
-
-    void parseCondition(); // C
+    AstStmt* parseVectorAssignment(const SymbolInfo& arrayInfo, const Token& idToken); // a = G для целого массива
+
+    AstStmt* parseIfStatement();
+    AstStmt* parseElseClause(); // E_else
+    AstStmt* parseWhileStatement();
+    AstStmt* parseParallelStatement(); // parallel reduce(...) while ...
+    bool isParallelStatementStart();   // Текущий токен - контекстное слово parallel перед while или reduce
+    // Проверяет канонический вид параллельного цикла [header, exit) и заполняет описатель.
+    // При несоответствии возвращает false и причину в reason.
+    bool checkParallelLoop(int header, int exit, const std::vector<size_t>& assignedScalars,
+        ParallelLoopInfo& info, std::string& reason) const;
+    AstStmt* parseCinStatement();
+    AstStmt* parseCoutStatement();
+    AstStmt* parseBeginEndBlock();
+
+    // Для выражений и условий: возвращают типизированный узел (при ошибке - заглушку, не nullptr)
+    AstExpr* parseExpression(); // G
+    AstExpr* parseTerm();
+    AstExpr* parseFactor();
+    AstExpr* parseExpressionPrime(AstExpr* leftOperand);
+    AstExpr* parseTermPrime(AstExpr* leftOperand);
+    AstExpr* parseSumCall(); // sum(G)
+    void noteWholeArrayOperand(size_t symbolIndex, const Token& idToken); // Учет массива для выбора представления
+    // Тип результата векторной операции: ARRAY_FLOAT, если хотя бы один операнд вещественный
+    static SymbolType vectorResultType(SymbolType left, SymbolType right);
+    static bool isArrayType(SymbolType type) { return type == SymbolType::ARRAY_INT || type == SymbolType::ARRAY_FLOAT; }
+
+    AstExpr* parseCondition(); // C
     RPNOpCode parseComparisonOp();
 
     // Семантические действия и проверки
     // Проверяет, объявлен ли идентификатор, и возвращает его индекс и тип
     std::optional<std::pair<size_t, SymbolType>> checkIdentifier(const Token& idToken, bool isAssignmentTarget = false);
-    // Выполняет преобразование типа на стеке ОПС, если необходимо
-    void ensureTypesMatchOrConvert(SymbolType type1, SymbolType type2, bool forAssignment = false);
+    // Приводит int-операнд смешанной бинарной операции к float
+    void promoteOperands(AstExpr*& left, AstExpr*& right);
 
 
 public:
     Parser(Lexer& lex, SymbolTable& symTab, ErrorHandler& errHandler);
+    // Разбор заранее лексированной программы (буфер должен жить до конца разбора)
+    Parser(const TokenBuffer& tokens, SymbolTable& symTab, ErrorHandler& errHandler);
 
     bool parse(); // Запуск парсинга
     const std::vector<RPNOperation>& getRPNCode() const; // Получение сгенерированного ОПС
+    const SourceLocationTable& getSourceLocations() const; // Позиции операций ОПС в исходном тексте
+    size_t getTokenCount() const; // Число разобранных токенов (без T_EOF)
+    const ParsePhaseTimes& getPhaseTimes() const { return phaseTimes; }
+    const std::vector<VectorLoopInfo>& getVectorLoops() const;
+    const std::vector<ParallelLoopInfo>& getParallelLoops() const;
+    void setLoopVectorization(bool enabled); // Вызывать до parse()
+    void setAutoParallelization(bool enabled); // Вызывать до parse()
+    void setOptimizationLevel(int level);      // Вызывать до parse()
     void printRPN() const; // Отладочный вывод ОПС
+    void printIR() const;  // Отладочный вывод промежуточного представления
+    void printPassStatistics() const; // Время и изменение числа инструкций каждого прохода
 };
 
 #endif // PARSER_H
\ No newline at end of file
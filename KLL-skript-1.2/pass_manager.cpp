@@ -0,0 +1,72 @@
+// pass_manager.cpp
+#include "pass_manager.h"
+
+#include <chrono>
+#include <iomanip>
+
+PassManager::PassManager(const SymbolTable& symTab)
+    : symbolTable(symTab), maxIterations(1) {
+}
+
+void PassManager::addPass(std::unique_ptr<IrPass> pass) {
+    passes.push_back(std::move(pass));
+}
+
+void PassManager::addStandardPasses(int optimizationLevel) {
+    if (optimizationLevel <= 0) return;
+    addPass(std::make_unique<ConstantPropagationPass>());
+    if (optimizationLevel >= 2) addPass(std::make_unique<GlobalValueNumberingPass>());
+    addPass(std::make_unique<CopyPropagationPass>());
+    addPass(std::make_unique<DeadStoreEliminationPass>());
+    if (optimizationLevel >= 3) maxIterations = MAX_ITERATIONS;
+}
+
+void PassManager::run(IrFunction& function) {
+    statistics.clear();
+    for (int iteration = 1; iteration <= maxIterations; ++iteration) {
+        bool anyChanged = false;
+        for (const auto& pass : passes) {
+            PassStatistics stats;
+            stats.name = pass->getName();
+            stats.iteration = iteration;
+            stats.instructionsBefore = function.countInstructions();
+            auto start = std::chrono::steady_clock::now();
+            stats.changed = pass->run(function, symbolTable);
+            auto finish = std::chrono::steady_clock::now();
+            stats.milliseconds = std::chrono::duration<double, std::milli>(finish - start).count();
+            stats.instructionsAfter = function.countInstructions();
+            anyChanged |= stats.changed;
+            statistics.push_back(stats);
+        }
+        if (!anyChanged) break;
+    }
+}
+
+void PassManager::printStatistics(std::ostream& out) const {
+    std::ios_base::fmtflags savedFlags = out.flags();
+    std::streamsize savedPrecision = out.precision();
+    out << "\n--- Optimization passes ---" << std::endl;
+    out << "Pass       | Iter | Time (ms) | Instr before | Instr after | Delta" << std::endl;
+    out << "-----------|------|-----------|--------------|-------------|-------" << std::endl;
+    double totalMilliseconds = 0.0;
+    for (const PassStatistics& stats : statistics) {
+        long long delta = static_cast<long long>(stats.instructionsAfter) - static_cast<long long>(stats.instructionsBefore);
+        out << std::left << std::setw(10) << stats.name << std::right << " | "
+            << std::setw(4) << stats.iteration << " | "
+            << std::fixed << std::setprecision(3) << std::setw(9) << stats.milliseconds << " | "
+            << std::setw(12) << stats.instructionsBefore << " | "
+            << std::setw(11) << stats.instructionsAfter << " | "
+            << std::showpos << delta << std::noshowpos << std::endl;
+        totalMilliseconds += stats.milliseconds;
+    }
+    if (!statistics.empty()) {
+        long long delta = static_cast<long long>(statistics.back().instructionsAfter) -
+            static_cast<long long>(statistics.front().instructionsBefore);
+        out << "Total: " << std::fixed << std::setprecision(3) << totalMilliseconds << " ms, "
+            << statistics.front().instructionsBefore << " -> " << statistics.back().instructionsAfter
+            << " instructions (" << std::showpos << delta << std::noshowpos << ")" << std::endl;
+    }
+    out << "-------------------------------------------------" << std::endl;
+    out.flags(savedFlags);
+    out.precision(savedPrecision);
+}
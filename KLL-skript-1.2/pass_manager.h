@@ -0,0 +1,54 @@
+// pass_manager.h
+#ifndef PASS_MANAGER_H
+#define PASS_MANAGER_H
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ir.h"
+#include "ir_passes.h"
+#include "symbol_table.h"
+
+// Статистика одного запуска прохода
+struct PassStatistics {
+    std::string name;
+    int iteration;             // Номер повторения конвейера (с 1)
+    double milliseconds;
+    size_t instructionsBefore; // Инструкции IR в блоках до и после прохода
+    size_t instructionsAfter;
+    bool changed;
+};
+
+// --- Менеджер проходов ---
+// Выполняет проходы по порядку и замеряет время и изменение числа инструкций IR каждого из них.
+// Уровни оптимизации:
+//   -O0 - без проходов;
+//   -O1 - sccp, copy-prop, dse;
+//   -O2 - sccp, gvn, copy-prop, dse;
+//   -O3 - конвейер -O2 повторяется, пока он меняет IR (не более MAX_ITERATIONS раз).
+class PassManager {
+public:
+    static const int MAX_OPTIMIZATION_LEVEL = 3;
+    static const int MAX_ITERATIONS = 4;
+
+    explicit PassManager(const SymbolTable& symbolTable);
+
+    void addPass(std::unique_ptr<IrPass> pass);
+    void addStandardPasses(int optimizationLevel);
+    void setMaxIterations(int iterations) { maxIterations = iterations; }
+
+    void run(IrFunction& function);
+
+    const std::vector<PassStatistics>& getStatistics() const { return statistics; }
+    void printStatistics(std::ostream& out) const;
+
+private:
+    const SymbolTable& symbolTable;
+    std::vector<std::unique_ptr<IrPass>> passes;
+    int maxIterations;
+    std::vector<PassStatistics> statistics;
+};
+
+#endif // PASS_MANAGER_H
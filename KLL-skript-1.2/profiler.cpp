@@ -0,0 +1,128 @@
+// profiler.cpp
+#include "profiler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <string>
+
+ExecutionProfiler::ExecutionProfiler(const std::vector<RPNOperation>& rpnCode, const SourceLocationTable& sourceLocations)
+    : code(rpnCode), locations(sourceLocations), counts(rpnCode.size(), 0), cycles(rpnCode.size(), 0) {
+    findLoops();
+}
+
+int ExecutionProfiler::lineOf(int address) const {
+    return address >= 0 ? locations.lineOf(static_cast<size_t>(address)) : 0;
+}
+
+// Цикл - переход назад (JUMP или JUMP_FALSE на адрес не больше своего).
+// Переходы назад на один заголовок объединяются в один цикл.
+void ExecutionProfiler::findLoops() {
+    std::map<int, int> backEdges; // Заголовок -> последний обратный переход
+    for (size_t address = 0; address < code.size(); ++address) {
+        const RPNOperation& op = code[address];
+        if ((op.opCode == RPNOpCode::JUMP || op.opCode == RPNOpCode::JUMP_FALSE) &&
+            op.jumpTarget && op.jumpTarget.value() <= static_cast<int>(address)) {
+            int& backEdge = backEdges[op.jumpTarget.value()];
+            backEdge = std::max(backEdge, static_cast<int>(address));
+        }
+    }
+
+    std::vector<int> enclosing; // Стек объемлющих циклов
+    for (const auto& [header, backEdge] : backEdges) {
+        while (!enclosing.empty() && loops[enclosing.back()].backEdge < header) enclosing.pop_back();
+        loops.push_back({ header, backEdge, lineOf(header), enclosing.empty() ? -1 : enclosing.back() });
+        enclosing.push_back(static_cast<int>(loops.size()) - 1);
+    }
+
+    // Внешние циклы идут раньше вложенных, поэтому вложенный цикл перезаписывает отметку внешнего
+    innermostLoop.assign(code.size(), -1);
+    for (size_t k = 0; k < loops.size(); ++k) {
+        for (int address = loops[k].header; address <= loops[k].backEdge; ++address) {
+            innermostLoop[address] = static_cast<int>(k);
+        }
+    }
+}
+
+void ExecutionProfiler::writeAnnotatedSource(std::ostream& out, std::string_view sourceText) const {
+    std::ios_base::fmtflags savedFlags = out.flags();
+    std::streamsize savedPrecision = out.precision();
+
+    // Суммы по строкам (строки нумеруются с 1)
+    int lastLine = 0;
+    for (size_t address = 0; address < code.size(); ++address) lastLine = std::max(lastLine, lineOf(static_cast<int>(address)));
+    std::vector<std::uint64_t> lineCounts(lastLine + 1, 0);
+    std::vector<std::uint64_t> lineCycles(lastLine + 1, 0);
+    std::uint64_t totalCount = 0;
+    std::uint64_t totalCycles = 0;
+    for (size_t address = 0; address < code.size(); ++address) {
+        int line = lineOf(static_cast<int>(address));
+        lineCounts[line] += counts[address];
+        lineCycles[line] += cycles[address];
+        totalCount += counts[address];
+        totalCycles += cycles[address];
+    }
+    auto percent = [totalCycles](std::uint64_t value) {
+        return totalCycles == 0 ? 0.0 : 100.0 * static_cast<double>(value) / static_cast<double>(totalCycles);
+    };
+
+    out << "--- Execution profile ---" << std::endl;
+    out << "Total: " << totalCount << " operations, " << totalCycles << " cycles" << std::endl;
+    out << "    Operations |          Cycles |  Time% | Line | Source" << std::endl;
+    out << "---------------|-----------------|--------|------|-------" << std::endl;
+    out << std::fixed << std::setprecision(2);
+    int line = 1;
+    size_t position = 0;
+    while (position < sourceText.size()) {
+        size_t end = sourceText.find('\n', position);
+        if (end == std::string_view::npos) end = sourceText.size();
+        std::string_view text = sourceText.substr(position, end - position);
+        if (!text.empty() && text.back() == '\r') text.remove_suffix(1);
+        if (line <= lastLine && lineCounts[line] != 0) {
+            out << std::setw(14) << lineCounts[line] << " | " << std::setw(15) << lineCycles[line] << " | "
+                << std::setw(6) << percent(lineCycles[line]) << " | ";
+        }
+        else {
+            out << std::setw(14) << "" << " | " << std::setw(15) << "" << " | " << std::setw(6) << "" << " | ";
+        }
+        out << std::setw(4) << line << " | " << text << std::endl;
+        position = end + 1;
+        ++line;
+    }
+
+    if (!loops.empty()) {
+        out << "\n--- Loops ---" << std::endl;
+        for (size_t k = 0; k < loops.size(); ++k) {
+            const ProfiledLoop& loop = loops[k];
+            int depth = 0;
+            for (int parent = loop.parent; parent != -1; parent = loops[parent].parent) ++depth;
+            std::uint64_t loopCycles = 0;
+            int endLine = loop.line;
+            for (int address = loop.header; address <= loop.backEdge; ++address) {
+                loopCycles += cycles[address];
+                endLine = std::max(endLine, lineOf(address));
+            }
+            out << std::string(depth * 2, ' ') << "loop@L" << loop.line << " (lines " << loop.line << "-" << endLine
+                << "): " << counts[loop.backEdge] << " iterations, " << loopCycles << " cycles ("
+                << percent(loopCycles) << "%)" << std::endl;
+        }
+    }
+    out << "-------------------------" << std::endl;
+    out.flags(savedFlags);
+    out.precision(savedPrecision);
+}
+
+void ExecutionProfiler::writeCollapsedStacks(std::ostream& out) const {
+    std::map<std::string, std::uint64_t> stacks;
+    std::vector<int> chain;
+    for (size_t address = 0; address < code.size(); ++address) {
+        if (cycles[address] == 0) continue;
+        chain.clear();
+        for (int loop = innermostLoop[address]; loop != -1; loop = loops[loop].parent) chain.push_back(loop);
+        std::string stack = "program";
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) stack += ";loop@L" + std::to_string(loops[*it].line);
+        stack += ";line " + std::to_string(lineOf(static_cast<int>(address)));
+        stacks[stack] += cycles[address];
+    }
+    for (const auto& [stack, value] : stacks) out << stack << " " << value << "\n";
+}
@@ -0,0 +1,79 @@
+// profiler.h
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "rpn_op.h"
+#include "source_location.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define KLL_HAS_RDTSC 1
+#else
+#include <chrono>
+#define KLL_HAS_RDTSC 0
+#endif
+
+// Счетчик тактов процессора (на платформах без rdtsc - наносекунды монотонных часов)
+inline std::uint64_t readCycleCounter() {
+#if KLL_HAS_RDTSC
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Цикл программы в ОПС: обратный переход с адреса backEdge на адрес header
+struct ProfiledLoop {
+    int header;
+    int backEdge;
+    int line;   // Строка заголовка цикла
+    int parent; // Номер объемлющего цикла или -1
+};
+
+// --- Профилировщик выполнения ---
+// Интерпретатор сообщает о каждой выполненной операции ОПС (record): число выполнений и такты
+// от начала этой операции до начала следующей. По таблице позиций операций ОПС значения
+// суммируются по строкам исходного текста и по циклам.
+// Операции векторизованных и параллельных циклов выполняются вне основного цикла интерпретатора,
+// поэтому их время относится к операции заголовка цикла.
+class ExecutionProfiler {
+public:
+    ExecutionProfiler(const std::vector<RPNOperation>& code, const SourceLocationTable& locations);
+
+    void record(int address, std::uint64_t cycles) {
+        counts[address]++;
+        this->cycles[address] += cycles;
+    }
+
+    std::uint64_t getCount(int address) const { return counts[address]; }
+    std::uint64_t getCycles(int address) const { return cycles[address]; }
+    const std::vector<ProfiledLoop>& getLoops() const { return loops; }
+
+    // Исходный текст с числом выполненных операций, тактами и долей времени каждой строки,
+    // затем сводка по циклам
+    void writeAnnotatedSource(std::ostream& out, std::string_view sourceText) const;
+    // Свернутые стеки для flamegraph.pl: "program;loop@L3;loop@L5;line 7 <такты>"
+    void writeCollapsedStacks(std::ostream& out) const;
+
+private:
+    const std::vector<RPNOperation>& code;
+    const SourceLocationTable& locations;
+    std::vector<std::uint64_t> counts; // По адресу ОПС
+    std::vector<std::uint64_t> cycles;
+    std::vector<ProfiledLoop> loops;   // По возрастанию адреса заголовка
+    std::vector<int> innermostLoop;    // Ближайший объемлющий цикл каждой операции или -1
+
+    void findLoops();
+    int lineOf(int address) const;
+};
+
+#endif // PROFILER_H
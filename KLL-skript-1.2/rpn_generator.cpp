@@ -0,0 +1,162 @@
+// rpn_generator.cpp
+#include "rpn_generator.h"
+
+RpnGenerator::RpnGenerator(const IrFunction& func)
+    : function(func) {
+}
+
+std::vector<RPNOperation> RpnGenerator::generate() {
+    code.clear();
+    pendingJumps.clear();
+    locations.clear();
+    location = SourceLocation();
+    blockAddresses.assign(function.blocks.size(), 0);
+
+    for (size_t b = 0; b < function.blocks.size(); ++b) {
+        const IrBlock& block = function.blocks[b];
+        blockAddresses[b] = static_cast<int>(code.size());
+        for (int id : block.instructions) {
+            // Значения выводятся в составе использующей их инструкции
+            if (!function.instructions[id].producesValue()) {
+                emitRoot(id);
+            }
+        }
+        int nextBlock = static_cast<int>(b) + 1;
+        switch (block.terminator) {
+        case IrTerminator::BRANCH:
+            emitValue(block.condition);
+            locate(function.instructions[block.condition]);
+            emitJump(RPNOpCode::JUMP_FALSE, block.falseTarget);
+            if (block.target != nextBlock) emitJump(RPNOpCode::JUMP, block.target);
+            break;
+        case IrTerminator::JUMP:
+            if (block.target != nextBlock) emitJump(RPNOpCode::JUMP, block.target);
+            break;
+        case IrTerminator::EXIT:
+            break;
+        }
+    }
+
+    locate(location);
+
+    for (const auto& jump : pendingJumps) {
+        code[jump.first].jumpTarget = blockAddresses[jump.second];
+    }
+    return std::move(code);
+}
+
+void RpnGenerator::locate(SourceLocation next) {
+    locations.extendTo(code.size(), location);
+    location = next;
+}
+
+void RpnGenerator::emitJump(RPNOpCode jumpOpCode, int targetBlock) {
+    pendingJumps.emplace_back(static_cast<int>(code.size()), targetBlock);
+    code.emplace_back(jumpOpCode, -1, true); // Адрес заполняется после вывода всех блоков
+}
+
+void RpnGenerator::emitValue(int id) {
+    const IrInstruction& instr = function.instructions[id];
+    SourceLocation outer = location;
+    locate(instr);
+    switch (instr.op) {
+    case IrOp::CONST_INT:
+        code.emplace_back(RPNOpCode::PUSH_CONST_INT, instr.intValue);
+        break;
+    case IrOp::CONST_FLOAT:
+        code.emplace_back(RPNOpCode::PUSH_CONST_FLOAT, instr.floatValue);
+        break;
+    case IrOp::LOAD_VAR:
+        // Для использования значения переменной кладется ее адрес; значение извлекает интерпретатор
+        code.emplace_back(RPNOpCode::PUSH_VAR_ADDR, instr.symbolIndex);
+        break;
+    case IrOp::LOAD_ELEMENT:
+        code.emplace_back(RPNOpCode::PUSH_ARRAY_ADDR, instr.symbolIndex);
+        emitValue(instr.operands[0]);
+        code.emplace_back(RPNOpCode::INDEX);
+        break;
+    case IrOp::ARRAY_REF:
+        code.emplace_back(RPNOpCode::PUSH_ARRAY_ADDR, instr.symbolIndex);
+        break;
+    case IrOp::VEC_SUM:
+    case IrOp::TO_INT:
+    case IrOp::TO_FLOAT:
+        emitValue(instr.operands[0]);
+        code.emplace_back(instr.op == IrOp::VEC_SUM ? RPNOpCode::VEC_SUM :
+            instr.op == IrOp::TO_INT ? RPNOpCode::CONVERT_TO_INT : RPNOpCode::CONVERT_TO_FLOAT);
+        break;
+    default: {
+        // Интерпретатор сам приводит int к float при разнотипных скалярных операндах, поэтому
+        // явное приведение левого операнда опускается (правый операнд выше на стеке и приводится как раньше)
+        const IrInstruction& left = function.instructions[instr.operands[0]];
+        const IrInstruction& right = function.instructions[instr.operands[1]];
+        bool implicitPromotion = left.op == IrOp::TO_FLOAT && right.type == SymbolType::VARIABLE_FLOAT
+            && instr.op < IrOp::VEC_ADD;
+        emitValue(implicitPromotion ? left.operands[0] : instr.operands[0]);
+        emitValue(instr.operands[1]);
+        RPNOpCode opCode = RPNOpCode::ADD;
+        switch (instr.op) {
+        case IrOp::SUB:     opCode = RPNOpCode::SUB; break;
+        case IrOp::MUL:     opCode = RPNOpCode::MUL; break;
+        case IrOp::DIV:     opCode = RPNOpCode::DIV; break;
+        case IrOp::CMP_EQ:  opCode = RPNOpCode::CMP_EQ; break;
+        case IrOp::CMP_NE:  opCode = RPNOpCode::CMP_NE; break;
+        case IrOp::CMP_GT:  opCode = RPNOpCode::CMP_GT; break;
+        case IrOp::CMP_LT:  opCode = RPNOpCode::CMP_LT; break;
+        case IrOp::VEC_ADD: opCode = RPNOpCode::VEC_ADD; break;
+        case IrOp::VEC_SUB: opCode = RPNOpCode::VEC_SUB; break;
+        case IrOp::VEC_MUL: opCode = RPNOpCode::VEC_MUL; break;
+        case IrOp::VEC_DIV: opCode = RPNOpCode::VEC_DIV; break;
+        default: break; // ADD
+        }
+        code.emplace_back(opCode);
+        break;
+    }
+    }
+    locate(outer); // Операции после значения относятся к использующей его инструкции
+}
+
+void RpnGenerator::emitRoot(int id) {
+    const IrInstruction& instr = function.instructions[id];
+    locate(instr);
+    switch (instr.op) {
+    case IrOp::STORE_VAR:
+        code.emplace_back(RPNOpCode::PUSH_VAR_ADDR, instr.symbolIndex);
+        emitValue(instr.operands[0]);
+        code.emplace_back(RPNOpCode::ASSIGN);
+        break;
+    case IrOp::STORE_ELEMENT:
+        code.emplace_back(RPNOpCode::PUSH_ARRAY_ADDR, instr.symbolIndex);
+        emitValue(instr.operands[0]);
+        code.emplace_back(RPNOpCode::INDEX);
+        emitValue(instr.operands[1]);
+        code.emplace_back(RPNOpCode::ASSIGN);
+        break;
+    case IrOp::STORE_ARRAY:
+        code.emplace_back(RPNOpCode::PUSH_ARRAY_ADDR, instr.symbolIndex);
+        emitValue(instr.operands[0]);
+        code.emplace_back(RPNOpCode::VEC_ASSIGN);
+        break;
+    case IrOp::READ_VAR:
+    case IrOp::READ_ELEMENT:
+        if (instr.op == IrOp::READ_VAR) {
+            code.emplace_back(RPNOpCode::PUSH_VAR_ADDR, instr.symbolIndex);
+        }
+        else {
+            code.emplace_back(RPNOpCode::PUSH_ARRAY_ADDR, instr.symbolIndex);
+            emitValue(instr.operands[0]);
+            code.emplace_back(RPNOpCode::INDEX);
+        }
+        code.emplace_back(instr.type == SymbolType::VARIABLE_INT ? RPNOpCode::READ_INT : RPNOpCode::READ_FLOAT, true);
+        break;
+    case IrOp::WRITE:
+        emitValue(instr.operands[0]);
+        code.emplace_back(instr.type == SymbolType::VARIABLE_INT ? RPNOpCode::WRITE_INT : RPNOpCode::WRITE_FLOAT, true);
+        break;
+    case IrOp::PARALLEL_LOOP:
+        code.emplace_back(RPNOpCode::PARALLEL_LOOP, instr.intValue);
+        break;
+    default:
+        break; // Значения здесь не встречаются
+    }
+}
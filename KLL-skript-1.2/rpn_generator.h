@@ -0,0 +1,42 @@
+// rpn_generator.h
+#ifndef RPN_GENERATOR_H
+#define RPN_GENERATOR_H
+
+#include <vector>
+
+#include "ir.h"
+#include "rpn_op.h"
+#include "source_location.h"
+
+// --- Генерация ОПС из промежуточного представления ---
+// Блоки выводятся в порядке IrFunction::blocks. Операнды-деревья выводятся перед операцией
+// в стековом порядке; BRANCH дает условие и JUMP_FALSE, переход на следующий по порядку блок
+// опускается. Адреса переходов заполняются после вывода всех блоков.
+// Каждая операция получает позицию ближайшей инструкции IR, из которой она выведена; переходы
+// в конце блока - позицию условия (BRANCH) или последней операции блока (JUMP).
+class RpnGenerator {
+public:
+    explicit RpnGenerator(const IrFunction& function);
+
+    std::vector<RPNOperation> generate();
+    // Адрес ОПС начала каждого блока (после generate)
+    const std::vector<int>& getBlockAddresses() const { return blockAddresses; }
+    // Позиции операций ОПС в исходном тексте (после generate)
+    const SourceLocationTable& getLocations() const { return locations; }
+
+private:
+    const IrFunction& function;
+    std::vector<RPNOperation> code;
+    std::vector<int> blockAddresses;
+    SourceLocationTable locations;
+    SourceLocation location; // Позиция операций, выведенных после последней записи в locations
+    std::vector<std::pair<int, int>> pendingJumps; // (адрес перехода в ОПС, номер блока-цели)
+
+    void emitValue(int id); // Дерево значения: операнды, затем операция
+    void emitRoot(int id);  // Инструкция без результата
+    void emitJump(RPNOpCode jumpOpCode, int targetBlock);
+    void locate(SourceLocation next); // Записывает позицию выведенных операций и задает следующую
+    void locate(const IrInstruction& instr) { locate({ instr.line, instr.column }); }
+};
+
+#endif // RPN_GENERATOR_H
@@ -0,0 +1,98 @@
+// run_metrics.cpp
+#include "run_metrics.h"
+
+#include <iomanip>
+
+#include "definitions.h"
+
+namespace {
+
+    const char* rpnOpCodeName(size_t opCode) {
+        static const char* const names[] = {
+            "PUSH_VAR_ADDR", "PUSH_ARRAY_ADDR", "PUSH_CONST_INT", "PUSH_CONST_FLOAT",
+            "ADD", "SUB", "MUL", "DIV",
+            "CMP_EQ", "CMP_NE", "CMP_GT", "CMP_LT",
+            "ASSIGN", "INDEX",
+            "READ_INT", "READ_FLOAT", "WRITE_INT", "WRITE_FLOAT",
+            "JUMP", "JUMP_FALSE",
+            "CONVERT_TO_FLOAT", "CONVERT_TO_INT",
+            "VEC_ADD", "VEC_SUB", "VEC_MUL", "VEC_DIV", "VEC_ASSIGN", "VEC_SUM",
+            "PARALLEL_LOOP"
+        };
+        static_assert(sizeof(names) / sizeof(names[0]) == static_cast<size_t>(RPNOpCode::PARALLEL_LOOP) + 1,
+            "rpnOpCodeName: names must match RPNOpCode");
+        return opCode < sizeof(names) / sizeof(names[0]) ? names[opCode] : "UNKNOWN";
+    }
+
+    void writeJsonString(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                        << std::dec << std::setfill(' ');
+                }
+                else {
+                    out << c;
+                }
+                break;
+            }
+        }
+        out << '"';
+    }
+
+} // namespace
+
+void RunMetrics::writeJson(std::ostream& out) const {
+    std::ios_base::fmtflags savedFlags = out.flags();
+    std::streamsize savedPrecision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\"source\":";
+    writeJsonString(out, sourceFile);
+    out << ",\"status\":\"" << status << "\"";
+    out << ",\"phases\":[";
+    for (size_t k = 0; k < phases.size(); ++k) {
+        if (k > 0) out << ",";
+        out << "{\"name\":\"" << phases[k].name << "\",\"wall_ms\":" << phases[k].wallMilliseconds
+            << ",\"cpu_ms\":" << phases[k].cpuMilliseconds << "}";
+    }
+    out << "]";
+    out << ",\"tokens\":" << tokenCount;
+    out << ",\"rpn_size\":" << rpnSize;
+    out << ",\"instructions_executed\":" << instructionsExecuted;
+    out << ",\"opcodes\":{";
+    bool first = true;
+    for (size_t opCode = 0; opCode < opcodeCounts.size(); ++opCode) {
+        if (opcodeCounts[opCode] == 0) continue;
+        if (!first) out << ",";
+        first = false;
+        out << "\"" << rpnOpCodeName(opCode) << "\":" << opcodeCounts[opCode];
+    }
+    out << "}";
+    out << ",\"stack_high_water\":" << stackHighWater;
+    out << ",\"array_bytes\":{\"declared\":" << arrayDeclaredBytes << ",\"resident\":" << arrayResidentBytes << "}";
+    out << ",\"io_items\":{\"read\":" << itemsRead << ",\"written\":" << itemsWritten << "}";
+    out << "}" << std::endl;
+
+    out.flags(savedFlags);
+    out.precision(savedPrecision);
+}
+
+void PhaseStopwatch::restart() {
+    wallStart = std::chrono::steady_clock::now();
+    cpuStart = std::clock();
+}
+
+void PhaseStopwatch::finish(RunMetrics& metrics, const char* phaseName) {
+    double wall = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+    double cpu = 1000.0 * static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    metrics.phases.push_back({ phaseName, wall, cpu });
+    restart();
+}
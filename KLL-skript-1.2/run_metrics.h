@@ -0,0 +1,52 @@
+// run_metrics.h
+#ifndef RUN_METRICS_H
+#define RUN_METRICS_H
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Время одной фазы: по настенным часам и процессорное (всех потоков процесса)
+struct PhaseTiming {
+    std::string name;
+    double wallMilliseconds;
+    double cpuMilliseconds;
+};
+
+// --- Метрики запуска (--metrics=json) ---
+// main заполняет поля по ходу компиляции и выполнения; writeJson выводит их одним объектом JSON.
+// Фазы: read (открытие и отображение файла), lex (только при --pretokenize; иначе лексер работает
+// внутри parse), parse (разбор, IR, оптимизация, генерация ОПС), execute.
+struct RunMetrics {
+    std::string sourceFile;
+    std::string status = "ok"; // "ok", "compile_error", "runtime_error"
+    std::vector<PhaseTiming> phases;
+    size_t tokenCount = 0;
+    size_t rpnSize = 0;
+    long long instructionsExecuted = 0;
+    std::vector<std::uint64_t> opcodeCounts; // Индекс - RPNOpCode
+    size_t stackHighWater = 0;
+    size_t arrayDeclaredBytes = 0;
+    size_t arrayResidentBytes = 0;
+    std::uint64_t itemsRead = 0;    // Выполненные READ_INT / READ_FLOAT
+    std::uint64_t itemsWritten = 0; // Выполненные WRITE_INT / WRITE_FLOAT
+
+    void writeJson(std::ostream& out) const;
+};
+
+// Замер фазы: от конструктора (или restart) до finish
+class PhaseStopwatch {
+public:
+    PhaseStopwatch() { restart(); }
+    void restart();
+    void finish(RunMetrics& metrics, const char* phaseName);
+
+private:
+    std::chrono::steady_clock::time_point wallStart;
+    std::clock_t cpuStart;
+};
+
+#endif // RUN_METRICS_H
@@ -0,0 +1,213 @@
+// sampling_profiler.cpp
+#include "sampling_profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+#ifndef _WIN32
+#include <sys/time.h>
+#include <cerrno>
+#include <cstring> // Для std::strerror
+#endif
+
+namespace {
+    std::atomic<SamplingProfiler*> activeProfiler(nullptr);
+#ifndef _WIN32
+    struct sigaction previousAction;
+#endif
+}
+
+SamplingProfiler::SamplingProfiler(size_t codeSize)
+    : currentAddress(-1), ring(), head(0), tail(0), droppedSamples(0), addressSamples(codeSize, 0),
+    outsideSamples(0), totalSamples(0), frequency(DEFAULT_FREQUENCY), running(false) {
+}
+
+SamplingProfiler::~SamplingProfiler() {
+    stop();
+}
+
+bool SamplingProfiler::isSupported() {
+#ifdef _WIN32
+    return false;
+#else
+    return true;
+#endif
+}
+
+// Обработчик сигнала: только операции с атомарными переменными без блокировок и volatile-ячейкой
+void SamplingProfiler::handleSignal(int) {
+    SamplingProfiler* self = activeProfiler.load(std::memory_order_acquire);
+    if (!self) return;
+    if (self->handlerBusy.test_and_set(std::memory_order_acquire)) {
+        self->droppedSamples.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    size_t position = self->head.load(std::memory_order_relaxed);
+    if (position - self->tail.load(std::memory_order_acquire) >= RING_CAPACITY) {
+        self->droppedSamples.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        self->ring[position & (RING_CAPACITY - 1)] = self->currentAddress;
+        self->head.store(position + 1, std::memory_order_release);
+    }
+    self->handlerBusy.clear(std::memory_order_release);
+}
+
+bool SamplingProfiler::start(int samplesPerSecond, std::string& error) {
+#ifdef _WIN32
+    (void)samplesPerSecond;
+    error = "sampling profiler requires setitimer/SIGPROF (not available on Windows)";
+    return false;
+#else
+    if (samplesPerSecond < 1 || samplesPerSecond > 1000000) {
+        error = "sampling frequency must be between 1 and 1000000 Hz";
+        return false;
+    }
+    SamplingProfiler* expected = nullptr;
+    if (!activeProfiler.compare_exchange_strong(expected, this)) {
+        error = "another sampling profiler is already running";
+        return false;
+    }
+    frequency = samplesPerSecond;
+
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = &SamplingProfiler::handleSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART; // Системные вызовы (ввод-вывод) не прерываются выборками
+    if (sigaction(SIGPROF, &action, &previousAction) != 0) {
+        error = std::string("sigaction failed: ") + std::strerror(errno);
+        activeProfiler.store(nullptr);
+        return false;
+    }
+
+    running = true;
+    drainThread = std::thread([this]() {
+        std::unique_lock<std::mutex> lock(drainMutex);
+        while (running) {
+            drain();
+            drainWakeup.wait_for(lock, std::chrono::milliseconds(20));
+        }
+    });
+
+    long interval = 1000000L / samplesPerSecond;
+    struct itimerval timer;
+    timer.it_interval.tv_sec = interval / 1000000L;
+    timer.it_interval.tv_usec = interval % 1000000L;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        error = std::string("setitimer failed: ") + std::strerror(errno);
+        stop();
+        return false;
+    }
+    return true;
+#endif
+}
+
+void SamplingProfiler::stop() {
+#ifndef _WIN32
+    if (activeProfiler.load() != this) return;
+    struct itimerval timer;
+    std::memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    sigaction(SIGPROF, &previousAction, nullptr);
+    activeProfiler.store(nullptr, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(drainMutex);
+        running = false;
+    }
+    drainWakeup.notify_one();
+    if (drainThread.joinable()) drainThread.join();
+    drain();
+#endif
+}
+
+void SamplingProfiler::drain() {
+    size_t last = head.load(std::memory_order_acquire);
+    size_t position = tail.load(std::memory_order_relaxed);
+    for (; position != last; ++position) {
+        std::sig_atomic_t address = ring[position & (RING_CAPACITY - 1)];
+        if (address >= 0 && static_cast<size_t>(address) < addressSamples.size()) addressSamples[address]++;
+        else outsideSamples++;
+        totalSamples++;
+    }
+    tail.store(position, std::memory_order_release);
+}
+
+void SamplingProfiler::writeReport(std::ostream& out, const SourceLocationTable& locations, std::string_view sourceText) const {
+    std::ios_base::fmtflags savedFlags = out.flags();
+    std::streamsize savedPrecision = out.precision();
+    auto percent = [this](std::uint64_t value) {
+        return totalSamples == 0 ? 0.0 : 100.0 * static_cast<double>(value) / static_cast<double>(totalSamples);
+    };
+
+    // Строки исходного текста (нумерация с 1)
+    std::vector<std::string_view> sourceLines(1);
+    size_t position = 0;
+    while (position < sourceText.size()) {
+        size_t end = sourceText.find('\n', position);
+        if (end == std::string_view::npos) end = sourceText.size();
+        std::string_view text = sourceText.substr(position, end - position);
+        if (!text.empty() && text.back() == '\r') text.remove_suffix(1);
+        sourceLines.push_back(text);
+        position = end + 1;
+    }
+
+    // Выборки по сериям таблицы позиций и по строкам
+    struct RangeSamples {
+        size_t first;
+        size_t last;
+        SourceLocation location;
+        std::uint64_t samples;
+    };
+    std::vector<RangeSamples> ranges;
+    std::vector<std::uint64_t> lineSamples(sourceLines.size(), 0);
+    const std::vector<SourceLocationTable::Run>& runs = locations.getRuns();
+    for (size_t k = 0; k < runs.size(); ++k) {
+        size_t end = (k + 1 < runs.size()) ? runs[k + 1].start : locations.size();
+        std::uint64_t samples = 0;
+        for (size_t address = runs[k].start; address < end && address < addressSamples.size(); ++address) {
+            samples += addressSamples[address];
+        }
+        if (samples == 0) continue;
+        ranges.push_back({ runs[k].start, end - 1, runs[k].location, samples });
+        int line = runs[k].location.line;
+        if (line > 0 && static_cast<size_t>(line) < lineSamples.size()) lineSamples[line] += samples;
+    }
+    std::stable_sort(ranges.begin(), ranges.end(),
+        [](const RangeSamples& a, const RangeSamples& b) { return a.samples > b.samples; });
+    std::vector<int> hotLines;
+    for (size_t line = 1; line < lineSamples.size(); ++line) {
+        if (lineSamples[line] != 0) hotLines.push_back(static_cast<int>(line));
+    }
+    std::stable_sort(hotLines.begin(), hotLines.end(),
+        [&lineSamples](int a, int b) { return lineSamples[a] > lineSamples[b]; });
+
+    out << "--- Sampling profile ---" << std::endl;
+    out << "Samples: " << totalSamples << " at " << frequency << " Hz, dropped: " << getDroppedSamples()
+        << ", outside interpreter loop: " << outsideSamples << std::endl;
+    out << std::fixed << std::setprecision(2);
+
+    out << "\nHot lines:" << std::endl;
+    out << "  Samples |  Share | Line | Source" << std::endl;
+    for (size_t k = 0; k < hotLines.size() && k < REPORT_LIMIT; ++k) {
+        int line = hotLines[k];
+        out << std::setw(9) << lineSamples[line] << " | " << std::setw(5) << percent(lineSamples[line]) << "% | "
+            << std::setw(4) << line << " | " << sourceLines[line] << std::endl;
+    }
+
+    out << "\nHot RPN ranges:" << std::endl;
+    out << "  Samples |  Share | RPN range     | Position" << std::endl;
+    for (size_t k = 0; k < ranges.size() && k < REPORT_LIMIT; ++k) {
+        const RangeSamples& range = ranges[k];
+        std::string addresses = "[" + std::to_string(range.first) + ".." + std::to_string(range.last) + "]";
+        out << std::setw(9) << range.samples << " | " << std::setw(5) << percent(range.samples) << "% | "
+            << std::left << std::setw(13) << addresses << std::right << " | Line " << range.location.line
+            << ", Col " << range.location.column << std::endl;
+    }
+    out << "------------------------" << std::endl;
+    out.flags(savedFlags);
+    out.precision(savedPrecision);
+}
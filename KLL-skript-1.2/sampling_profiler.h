@@ -0,0 +1,77 @@
+// sampling_profiler.h
+#ifndef SAMPLING_PROFILER_H
+#define SAMPLING_PROFILER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <csignal>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "source_location.h"
+
+// --- Профилировщик по выборкам (SIGPROF) ---
+// Таймер setitimer(ITIMER_PROF) с заданной частотой посылает процессу SIGPROF. Интерпретатор перед
+// каждой операцией записывает ее адрес в ячейку getAddressSlot() (volatile sig_atomic_t - одна запись
+// в память, без синхронизации); обработчик сигнала читает ячейку и кладет адрес в кольцевой буфер.
+// Буфер без блокировок: обработчик - единственный писатель, фоновый поток периодически переносит
+// выборки в гистограмму по адресам. Если буфер полон (или обработчик уже выполняется в другом потоке),
+// выборка отбрасывается и учитывается в getDroppedSamples().
+// Одновременно может работать только один профилировщик. На Windows не поддерживается.
+class SamplingProfiler {
+public:
+    static const int DEFAULT_FREQUENCY = 1000; // Гц
+
+    explicit SamplingProfiler(size_t codeSize);
+    ~SamplingProfiler();
+
+    SamplingProfiler(const SamplingProfiler&) = delete;
+    SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+
+    static bool isSupported();
+
+    // Запускает таймер. При ошибке возвращает false и описание в error.
+    bool start(int frequency, std::string& error);
+    void stop(); // Останавливает таймер и переносит оставшиеся выборки
+
+    volatile std::sig_atomic_t& getAddressSlot() { return currentAddress; }
+
+    std::uint64_t getTotalSamples() const { return totalSamples; }
+    std::uint64_t getDroppedSamples() const { return droppedSamples.load(); }
+
+    // Самые частые строки исходного текста и диапазоны ОПС с одной позицией (серии таблицы позиций)
+    void writeReport(std::ostream& out, const SourceLocationTable& locations, std::string_view sourceText) const;
+
+private:
+    static const size_t RING_CAPACITY = 1 << 14; // Степень двойки
+    static const size_t REPORT_LIMIT = 20;       // Строк в каждой таблице отчета
+
+    volatile std::sig_atomic_t currentAddress; // Адрес выполняемой операции или -1
+
+    // Кольцевой буфер: head увеличивает обработчик сигнала, tail - поток переноса
+    std::sig_atomic_t ring[RING_CAPACITY];
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+    std::atomic_flag handlerBusy = ATOMIC_FLAG_INIT;
+    std::atomic<std::uint64_t> droppedSamples;
+
+    std::vector<std::uint64_t> addressSamples; // Гистограмма по адресам ОПС
+    std::uint64_t outsideSamples; // Выборки вне основного цикла интерпретатора (адрес -1)
+    std::uint64_t totalSamples;
+    int frequency;
+
+    std::thread drainThread;
+    std::mutex drainMutex;             // Только для ожидания потока переноса (обработчик сигнала их не трогает)
+    std::condition_variable drainWakeup;
+    bool running;
+
+    void drain(); // Переносит выборки из буфера в гистограмму
+    static void handleSignal(int signalNumber);
+};
+
+#endif // SAMPLING_PROFILER_H
@@ -0,0 +1,34 @@
+// source_location.cpp
+#include "source_location.h"
+
+#include <algorithm>
+
+void SourceLocationTable::append(SourceLocation location) {
+    extendTo(operationCount + 1, location);
+}
+
+void SourceLocationTable::extendTo(size_t address, SourceLocation location) {
+    if (address <= operationCount) return;
+    if (runs.empty() || runs.back().location != location) {
+        runs.push_back({ operationCount, location });
+    }
+    operationCount = address;
+}
+
+std::optional<SourceLocation> SourceLocationTable::lookup(size_t address) const {
+    if (address >= operationCount) return std::nullopt;
+    // Последняя серия, начинающаяся не позже address
+    auto it = std::upper_bound(runs.begin(), runs.end(), address,
+        [](size_t value, const Run& run) { return value < run.start; });
+    return std::prev(it)->location;
+}
+
+int SourceLocationTable::lineOf(size_t address) const {
+    std::optional<SourceLocation> location = lookup(address);
+    return location ? location->line : 0;
+}
+
+void SourceLocationTable::clear() {
+    runs.clear();
+    operationCount = 0;
+}
@@ -0,0 +1,49 @@
+// source_location.h
+#ifndef SOURCE_LOCATION_H
+#define SOURCE_LOCATION_H
+
+#include <vector>
+#include <optional>
+#include <cstddef>
+
+// Позиция в исходном тексте (строки и столбцы нумеруются с 1)
+struct SourceLocation {
+    int line = 0;
+    int column = 0;
+
+    bool operator==(const SourceLocation& other) const { return line == other.line && column == other.column; }
+    bool operator!=(const SourceLocation& other) const { return !(*this == other); }
+};
+
+// --- Таблица позиций операций ОПС ---
+// Хранится отдельно от кода ОПС (RPNOperation не увеличивается, интерпретатор обращается к таблице
+// только при ошибке или профилировании). Соседние операции одного выражения имеют одну позицию,
+// поэтому таблица сжата по длинам серий: запись - адрес первой операции серии и ее позиция.
+// Поиск позиции по адресу - двоичный поиск серии.
+class SourceLocationTable {
+public:
+    struct Run {
+        size_t start; // Адрес первой операции серии
+        SourceLocation location;
+    };
+
+    // Позиция следующей операции (адрес size()); совпадающая с предыдущей продолжает ее серию
+    void append(SourceLocation location);
+    // Позиция операций [size(), address) - все получают location
+    void extendTo(size_t address, SourceLocation location);
+
+    std::optional<SourceLocation> lookup(size_t address) const; // nullopt - адрес за концом таблицы
+    int lineOf(size_t address) const; // 0 - адрес за концом таблицы
+
+    size_t size() const { return operationCount; } // Число операций ОПС
+    size_t getRunCount() const { return runs.size(); }
+    const std::vector<Run>& getRuns() const { return runs; } // Серия k заканчивается перед началом серии k + 1
+    size_t getMemoryBytes() const { return runs.capacity() * sizeof(Run); }
+    void clear();
+
+private:
+    std::vector<Run> runs; // По возрастанию start; у первой серии start == 0
+    size_t operationCount = 0;
+};
+
+#endif // SOURCE_LOCATION_H
@@ -0,0 +1,39 @@
+// sparse_array.cpp
+#include "sparse_array.h"
+
+SparseArrayStore::SparseArrayStore(size_t elementCount)
+    : pageCount((elementCount + PAGE_ELEMENTS - 1) / PAGE_ELEMENTS),
+    pages(new std::atomic<uint32_t*>[pageCount]) {
+    for (size_t i = 0; i < pageCount; ++i) {
+        pages[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+SparseArrayStore::~SparseArrayStore() {
+    for (size_t i = 0; i < pageCount; ++i) {
+        delete[] pages[i].load(std::memory_order_relaxed);
+    }
+}
+
+uint32_t* SparseArrayStore::pageForWrite(size_t pageIndex) {
+    uint32_t* page = pages[pageIndex].load(std::memory_order_acquire);
+    if (page) return page;
+    uint32_t* fresh = new uint32_t[PAGE_ELEMENTS](); // Нули
+    if (pages[pageIndex].compare_exchange_strong(page, fresh, std::memory_order_acq_rel)) {
+        return fresh;
+    }
+    delete[] fresh; // Страницу уже создал другой поток
+    return page;
+}
+
+size_t SparseArrayStore::getPopulatedPageCount() const {
+    size_t populated = 0;
+    for (size_t i = 0; i < pageCount; ++i) {
+        if (pages[i].load(std::memory_order_relaxed)) ++populated;
+    }
+    return populated;
+}
+
+size_t SparseArrayStore::getResidentBytes() const {
+    return getPopulatedPageCount() * PAGE_ELEMENTS * sizeof(uint32_t) + pageCount * sizeof(std::atomic<uint32_t*>);
+}
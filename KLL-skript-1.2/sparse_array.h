@@ -0,0 +1,55 @@
+// sparse_array.h
+#ifndef SPARSE_ARRAY_H
+#define SPARSE_ARRAY_H
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // Для std::memcpy
+
+// --- Разреженное хранилище элементов массива ---
+// Массив делится на страницы по PAGE_ELEMENTS элементов; страница выделяется (заполненная нулями)
+// при первой записи в нее, а чтение из невыделенной страницы возвращает 0.
+// Каталог страниц - массив атомарных указателей, поэтому рабочие потоки параллельного цикла
+// могут записывать элементы одновременно (страницу создает тот поток, чей CAS прошел первым).
+// Элементы хранятся как 32-битные образы int или float.
+
+class SparseArrayStore {
+public:
+    static const size_t PAGE_ELEMENTS = 1024;
+
+    explicit SparseArrayStore(size_t elementCount);
+    ~SparseArrayStore();
+
+    SparseArrayStore(const SparseArrayStore&) = delete;
+    SparseArrayStore& operator=(const SparseArrayStore&) = delete;
+
+    template <typename T>
+    T load(size_t index) const {
+        static_assert(sizeof(T) == sizeof(uint32_t), "32-bit elements expected");
+        const uint32_t* page = pages[index / PAGE_ELEMENTS].load(std::memory_order_acquire);
+        T value{};
+        if (page) std::memcpy(&value, &page[index % PAGE_ELEMENTS], sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void store(size_t index, T value) {
+        static_assert(sizeof(T) == sizeof(uint32_t), "32-bit elements expected");
+        uint32_t* page = pageForWrite(index / PAGE_ELEMENTS);
+        std::memcpy(&page[index % PAGE_ELEMENTS], &value, sizeof(T));
+    }
+
+    size_t getPageCount() const { return pageCount; }
+    size_t getPopulatedPageCount() const;
+    size_t getResidentBytes() const; // Выделенные страницы и каталог
+
+private:
+    size_t pageCount;
+    std::unique_ptr<std::atomic<uint32_t*>[]> pages;
+
+    uint32_t* pageForWrite(size_t pageIndex);
+};
+
+#endif // SPARSE_ARRAY_H
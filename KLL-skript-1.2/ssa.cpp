@@ -0,0 +1,282 @@
+// ssa.cpp
+#include "ssa.h"
+
+#include <algorithm>
+
+SsaForm::SsaForm(const IrFunction& func, const SymbolTable& symbolTable)
+    : function(func) {
+    size_t symbolCount = symbolTable.getTableSize();
+    scalar.assign(symbolCount, false);
+    versions.reserve(symbolCount);
+    for (size_t i = 0; i < symbolCount; ++i) {
+        SymbolType type = symbolTable.getSymbolType(i);
+        scalar[i] = (type == SymbolType::VARIABLE_INT || type == SymbolType::VARIABLE_FLOAT);
+        versions.push_back({ i, 0, SsaVersion::ENTRY });
+    }
+    instructionVersions.assign(function.instructions.size(), NO_VERSION);
+    owners.assign(function.instructions.size(), IrInstruction::NO_VALUE);
+
+    buildGraph();
+    computeDominators();
+    markProtectedBlocks();
+    placePhis();
+    renameVariables();
+}
+
+void SsaForm::buildGraph() {
+    size_t blockCount = function.blocks.size();
+    successors.assign(blockCount, {});
+    predecessors.assign(blockCount, {});
+    reachable.assign(blockCount, false);
+    for (size_t b = 0; b < blockCount; ++b) {
+        const IrBlock& block = function.blocks[b];
+        if (block.terminator == IrTerminator::JUMP) {
+            successors[b].push_back(block.target);
+        }
+        else if (block.terminator == IrTerminator::BRANCH) {
+            successors[b].push_back(block.target);
+            if (block.falseTarget != block.target) successors[b].push_back(block.falseTarget);
+        }
+    }
+    if (blockCount == 0) return;
+
+    // Обратный постпорядок обхода в глубину от начала программы (без рекурсии)
+    std::vector<int> postorder;
+    std::vector<std::pair<int, size_t>> stack; // (блок, следующий преемник)
+    reachable[0] = true;
+    stack.emplace_back(0, 0);
+    while (!stack.empty()) {
+        auto& top = stack.back();
+        if (top.second < successors[top.first].size()) {
+            int next = successors[top.first][top.second++];
+            if (!reachable[next]) {
+                reachable[next] = true;
+                stack.emplace_back(next, 0);
+            }
+        }
+        else {
+            postorder.push_back(top.first);
+            stack.pop_back();
+        }
+    }
+    reversePostorder.assign(postorder.rbegin(), postorder.rend());
+
+    for (int b : reversePostorder) {
+        for (int s : successors[b]) predecessors[s].push_back(b);
+    }
+}
+
+// Итеративный алгоритм Купера - Харви - Кеннеди по обратному постпорядку
+void SsaForm::computeDominators() {
+    size_t blockCount = function.blocks.size();
+    immediateDominator.assign(blockCount, -1);
+    dominatorChildren.assign(blockCount, {});
+    if (reversePostorder.empty()) return;
+
+    std::vector<int> order(blockCount, -1);
+    for (size_t k = 0; k < reversePostorder.size(); ++k) order[reversePostorder[k]] = static_cast<int>(k);
+
+    int entry = reversePostorder[0];
+    immediateDominator[entry] = entry;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t k = 1; k < reversePostorder.size(); ++k) {
+            int b = reversePostorder[k];
+            int newDominator = -1;
+            for (int p : predecessors[b]) {
+                if (immediateDominator[p] == -1) continue; // Еще не обработан
+                if (newDominator == -1) {
+                    newDominator = p;
+                    continue;
+                }
+                int x = p, y = newDominator;
+                while (x != y) {
+                    while (order[x] > order[y]) x = immediateDominator[x];
+                    while (order[y] > order[x]) y = immediateDominator[y];
+                }
+                newDominator = x;
+            }
+            if (newDominator != immediateDominator[b]) {
+                immediateDominator[b] = newDominator;
+                changed = true;
+            }
+        }
+    }
+    immediateDominator[entry] = -1;
+    for (int b : reversePostorder) {
+        if (immediateDominator[b] != -1) dominatorChildren[immediateDominator[b]].push_back(b);
+    }
+}
+
+void SsaForm::markProtectedBlocks() {
+    protectedBlock.assign(function.blocks.size(), false);
+    for (const IrParallelRegion& region : function.parallelRegions) {
+        if (region.headerBlock < 0) continue;
+        for (int b = region.headerBlock; b < region.exitBlock; ++b) protectedBlock[b] = true;
+    }
+}
+
+// Минимальная SSA: phi для переменной x ставится в итерированной границе доминирования блоков,
+// присваивающих x
+void SsaForm::placePhis() {
+    size_t blockCount = function.blocks.size();
+    phis.assign(blockCount, {});
+
+    std::vector<std::vector<int>> frontier(blockCount);
+    for (int b : reversePostorder) {
+        if (predecessors[b].size() < 2) continue;
+        for (int p : predecessors[b]) {
+            int runner = p;
+            while (runner != -1 && runner != immediateDominator[b]) {
+                if (frontier[runner].empty() || frontier[runner].back() != b) frontier[runner].push_back(b);
+                runner = immediateDominator[runner];
+            }
+        }
+    }
+
+    std::vector<std::vector<int>> definitionBlocks(scalar.size());
+    for (int b : reversePostorder) {
+        for (int id : function.blocks[b].instructions) {
+            const IrInstruction& instr = function.instructions[id];
+            if (instr.op != IrOp::STORE_VAR && instr.op != IrOp::READ_VAR) continue;
+            std::vector<int>& defs = definitionBlocks[instr.symbolIndex];
+            if (defs.empty() || defs.back() != b) defs.push_back(b);
+        }
+    }
+
+    // Отметки "phi уже поставлена" и "блок в списке" хранят номер переменной + 1, чтобы не очищать их
+    std::vector<size_t> hasPhi(blockCount, 0);
+    std::vector<size_t> queued(blockCount, 0);
+    std::vector<int> worklist;
+    for (size_t variable = 0; variable < definitionBlocks.size(); ++variable) {
+        if (definitionBlocks[variable].empty()) continue;
+        size_t stamp = variable + 1;
+        worklist = definitionBlocks[variable];
+        for (int b : worklist) queued[b] = stamp;
+        while (!worklist.empty()) {
+            int b = worklist.back();
+            worklist.pop_back();
+            for (int d : frontier[b]) {
+                if (hasPhi[d] == stamp) continue;
+                hasPhi[d] = stamp;
+                SsaPhi phi;
+                phi.variable = variable;
+                phi.result = static_cast<int>(versions.size());
+                phi.arguments.assign(predecessors[d].size(), NO_VERSION);
+                versions.push_back({ variable, d, SsaVersion::PHI });
+                phis[d].push_back(std::move(phi));
+                if (queued[d] != stamp) {
+                    queued[d] = stamp;
+                    worklist.push_back(d);
+                }
+            }
+        }
+    }
+}
+
+void SsaForm::renameVariables() {
+    if (reversePostorder.empty()) return;
+    std::vector<int> current(scalar.size());
+    for (size_t i = 0; i < current.size(); ++i) current[i] = getEntryVersion(i);
+    std::vector<std::pair<size_t, int>> undoLog;
+
+    // Обход дерева доминаторов: (блок, размер журнала отмены при входе); отрицательный блок - выход
+    std::vector<std::pair<int, size_t>> stack;
+    stack.emplace_back(reversePostorder[0], 0);
+    while (!stack.empty()) {
+        auto [b, mark] = stack.back();
+        stack.pop_back();
+        if (b < 0) {
+            for (size_t k = undoLog.size(); k > mark; --k) current[undoLog[k - 1].first] = undoLog[k - 1].second;
+            undoLog.resize(mark);
+            continue;
+        }
+        stack.emplace_back(-1, undoLog.size());
+
+        for (const SsaPhi& phi : phis[b]) {
+            undoLog.emplace_back(phi.variable, current[phi.variable]);
+            current[phi.variable] = phi.result;
+        }
+        const IrBlock& block = function.blocks[b];
+        for (int id : block.instructions) {
+            const IrInstruction& instr = function.instructions[id];
+            if (instr.op == IrOp::LOAD_VAR) {
+                instructionVersions[id] = current[instr.symbolIndex];
+            }
+            else if (instr.op == IrOp::STORE_VAR || instr.op == IrOp::READ_VAR) {
+                int version = static_cast<int>(versions.size());
+                versions.push_back({ instr.symbolIndex, b, id });
+                instructionVersions[id] = version;
+                undoLog.emplace_back(instr.symbolIndex, current[instr.symbolIndex]);
+                current[instr.symbolIndex] = version;
+            }
+            if (!instr.producesValue()) assignOwner(id, id);
+        }
+        if (block.terminator == IrTerminator::BRANCH) assignOwner(block.condition, block.condition);
+
+        for (int s : successors[b]) {
+            const std::vector<int>& preds = predecessors[s];
+            size_t edge = static_cast<size_t>(std::find(preds.begin(), preds.end(), b) - preds.begin());
+            for (SsaPhi& phi : phis[s]) phi.arguments[edge] = current[phi.variable];
+        }
+        for (int child : dominatorChildren[b]) stack.emplace_back(child, 0);
+    }
+}
+
+void SsaForm::assignOwner(int root, int value) {
+    std::vector<int> pending(1, value);
+    while (!pending.empty()) {
+        int id = pending.back();
+        pending.pop_back();
+        owners[id] = root;
+        const IrInstruction& instr = function.instructions[id];
+        for (int k = 0; k < instr.operandCount(); ++k) pending.push_back(instr.operands[k]);
+    }
+}
+
+// --- SsaWalker ---
+SsaWalker::SsaWalker(const SsaForm& ssaForm, const IrFunction& func)
+    : ssa(ssaForm), function(func) {
+}
+
+void SsaWalker::define(int version) {
+    size_t variable = ssa.getVersion(version).variable;
+    undoLog.emplace_back(variable, current[variable]);
+    current[variable] = version;
+}
+
+void SsaWalker::run() {
+    if (function.blocks.empty()) return;
+    current.resize(ssa.getSymbolCount());
+    for (size_t i = 0; i < current.size(); ++i) current[i] = ssa.getEntryVersion(i);
+    undoLog.clear();
+
+    std::vector<std::pair<int, size_t>> stack;
+    stack.emplace_back(0, 0);
+    while (!stack.empty()) {
+        auto [b, mark] = stack.back();
+        stack.pop_back();
+        if (b < 0) {
+            int block = -b - 1;
+            leaveBlock(block);
+            for (size_t k = undoLog.size(); k > mark; --k) current[undoLog[k - 1].first] = undoLog[k - 1].second;
+            undoLog.resize(mark);
+            continue;
+        }
+        stack.emplace_back(-b - 1, undoLog.size());
+
+        enterBlock(b);
+        for (const SsaPhi& phi : ssa.getPhis(b)) define(phi.result);
+        const IrBlock& block = function.blocks[b];
+        for (size_t k = 0; k < block.instructions.size(); ++k) {
+            int id = block.instructions[k];
+            if (function.instructions[id].producesValue()) continue;
+            visitStatement(b, id);
+            int version = ssa.getInstructionVersion(id);
+            if (version != SsaForm::NO_VERSION) define(version);
+        }
+        if (block.terminator == IrTerminator::BRANCH) visitStatement(b, block.condition);
+        for (int child : ssa.getDominatorChildren(b)) stack.emplace_back(child, 0);
+    }
+}
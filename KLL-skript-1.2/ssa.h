@@ -0,0 +1,116 @@
+// ssa.h
+#ifndef SSA_H
+#define SSA_H
+
+#include <vector>
+#include <cstddef>
+
+#include "ir.h"
+#include "symbol_table.h"
+
+// --- SSA-форма скалярных переменных над IR ---
+// Каждое присваивание скалярной переменной (STORE_VAR, READ_VAR) создает новую версию, в точках
+// слияния потока управления ставятся phi-функции (по границам доминирования), каждое чтение LOAD_VAR
+// получает версию, которую оно видит. Сам IR не меняется: все версии одной переменной хранятся
+// в ее ячейке, поэтому выход из SSA тривиален, пока оптимизации заменяют чтение x только чтением
+// версии, которая в этой точке еще лежит в своей переменной (см. SsaWalker::currentVersion).
+//
+// Блоки циклов parallel (от заголовка до выхода) считаются защищенными: их ОПС после генерации
+// проверяется по шаблону, а тело выполняется потоками, поэтому проходы их не переписывают.
+
+struct SsaVersion {
+    static constexpr int ENTRY = -1; // Значение на входе в программу (переменная не инициализирована)
+    static constexpr int PHI = -2;
+
+    size_t variable;
+    int block;
+    int definition; // Номер инструкции STORE_VAR / READ_VAR, ENTRY или PHI
+};
+
+struct SsaPhi {
+    size_t variable;
+    int result;                 // Версия, которую определяет phi
+    std::vector<int> arguments; // Версия на выходе каждого предшественника (по порядку predecessors)
+};
+
+class SsaForm {
+public:
+    static constexpr int NO_VERSION = -1;
+
+    SsaForm(const IrFunction& function, const SymbolTable& symbolTable);
+
+    // --- Граф потока управления ---
+    const std::vector<int>& getSuccessors(int block) const { return successors[block]; }
+    // Только достижимые из начала программы предшественники
+    const std::vector<int>& getPredecessors(int block) const { return predecessors[block]; }
+    bool isReachable(int block) const { return reachable[block]; }
+    int getImmediateDominator(int block) const { return immediateDominator[block]; }
+    const std::vector<int>& getDominatorChildren(int block) const { return dominatorChildren[block]; }
+    bool isProtected(int block) const { return protectedBlock[block]; }
+
+    // --- Версии ---
+    size_t getVersionCount() const { return versions.size(); }
+    const SsaVersion& getVersion(int version) const { return versions[version]; }
+    int getEntryVersion(size_t variable) const { return static_cast<int>(variable); } // Версии 0..N-1
+    const std::vector<SsaPhi>& getPhis(int block) const { return phis[block]; }
+    // Версия, которую читает LOAD_VAR, или определяемая STORE_VAR / READ_VAR (NO_VERSION для прочих)
+    int getInstructionVersion(int instruction) const { return instructionVersions[instruction]; }
+    // Корневая инструкция (или условие перехода блока), в дерево которой входит значение
+    int getOwner(int instruction) const { return owners[instruction]; }
+    bool isScalarVariable(size_t symbol) const { return symbol < scalar.size() && scalar[symbol]; }
+    size_t getSymbolCount() const { return scalar.size(); }
+
+private:
+    const IrFunction& function;
+    std::vector<std::vector<int>> successors;
+    std::vector<std::vector<int>> predecessors;
+    std::vector<bool> reachable;
+    std::vector<int> reversePostorder;
+    std::vector<int> immediateDominator;
+    std::vector<std::vector<int>> dominatorChildren;
+    std::vector<bool> protectedBlock;
+
+    std::vector<bool> scalar; // Символ - скалярная переменная
+    std::vector<SsaVersion> versions;
+    std::vector<std::vector<SsaPhi>> phis;
+    std::vector<int> instructionVersions;
+    std::vector<int> owners;
+
+    void buildGraph();
+    void computeDominators();
+    void markProtectedBlocks();
+    void placePhis();
+    void renameVariables();
+    void assignOwner(int root, int value);
+};
+
+// --- Обход дерева доминаторов с текущими версиями переменных ---
+// Операторы (корневые инструкции и условие перехода в конце блока) перечисляются в порядке выполнения;
+// currentVersion(x) - версия x перед выполнением текущего оператора. Обход не зависит от
+// изменений деревьев значений во время обхода (корни и переходы менять нельзя).
+class SsaWalker {
+public:
+    explicit SsaWalker(const SsaForm& ssa, const IrFunction& function);
+    virtual ~SsaWalker() = default;
+
+    void run();
+
+protected:
+    const SsaForm& ssa;
+    const IrFunction& function;
+
+    int currentVersion(size_t variable) const { return current[variable]; }
+
+    virtual void enterBlock(int /*block*/) {}
+    virtual void leaveBlock(int /*block*/) {}
+    // root - корневая инструкция или условие перехода блока (инструкция-значение)
+    virtual void visitStatement(int block, int root) = 0;
+
+private:
+    std::vector<int> current;
+    std::vector<std::pair<size_t, int>> undoLog; // (переменная, прежняя версия)
+
+    void define(int version);
+};
+
+#endif // SSA_H
@@ -1,65 +1,108 @@
 // symbol_table.cpp
 #include "symbol_table.h"
+#include <limits> // Для std::numeric_limits (размер отображенного массива)
+#include <algorithm> // Для std::find
 
 SymbolTable::SymbolTable(ErrorHandler& errHandler) : errorHandler(errHandler) {
-    //    
-    keywordMap["int"] = TokenType::T_KW_INT;
-    keywordMap["float"] = TokenType::T_KW_FLOAT;
-    keywordMap["arr"] = TokenType::T_KW_ARR;
-    keywordMap["if"] = TokenType::T_KW_IF;
-    keywordMap["else"] = TokenType::T_KW_ELSE;
-    keywordMap["while"] = TokenType::T_KW_WHILE;
-    keywordMap["begin"] = TokenType::T_KW_BEGIN;
-    keywordMap["end"] = TokenType::T_KW_END;
-    keywordMap["cin"] = TokenType::T_KW_CIN;
-    keywordMap["cout"] = TokenType::T_KW_COUT;
+    // Контекстные слова получают номера 0..CONTEXTUAL_WORD_COUNT-1 (порядок - как в enum ContextualWord)
+    for (const char* word : { "sparse", "dense", "readonly", "cow", "min", "max", "sum", "parallel", "reduce" }) {
+        internIdentifier(word);
+    }
 }
 
-std::optional<TokenType> SymbolTable::getKeywordType(const std::string& name) const {
-    auto it = keywordMap.find(name);
-    if (it != keywordMap.end()) {
-        return it->second;
+std::optional<TokenType> SymbolTable::getKeywordType(std::string_view name) {
+    // Ключевых слов мало, поэтому длина и первая буква почти всегда однозначно определяют
+    // единственного кандидата, и остается одно сравнение
+    switch (name.size()) {
+    case 2:
+        if (name == "if") return TokenType::T_KW_IF;
+        break;
+    case 3:
+        switch (name[0]) {
+        case 'i': if (name == "int") return TokenType::T_KW_INT; break;
+        case 'a': if (name == "arr") return TokenType::T_KW_ARR; break;
+        case 'e': if (name == "end") return TokenType::T_KW_END; break;
+        case 'c': if (name == "cin") return TokenType::T_KW_CIN; break;
+        }
+        break;
+    case 4:
+        if (name == "else") return TokenType::T_KW_ELSE;
+        if (name == "cout") return TokenType::T_KW_COUT;
+        break;
+    case 5:
+        switch (name[0]) {
+        case 'f': if (name == "float") return TokenType::T_KW_FLOAT; break;
+        case 'w': if (name == "while") return TokenType::T_KW_WHILE; break;
+        case 'b': if (name == "begin") return TokenType::T_KW_BEGIN; break;
+        }
+        break;
     }
     return std::nullopt;
 }
 
-std::optional<size_t> SymbolTable::findSymbol(const std::string& name) const {
-    auto it = nameToIndexMap.find(name);
-    if (it != nameToIndexMap.end()) {
+size_t SymbolTable::internIdentifier(std::string_view name) {
+    auto it = identifierIds.find(name);
+    if (it != identifierIds.end()) {
         return it->second;
     }
+    size_t newId = identifierNames.size();
+    identifierNames.emplace_back(name);
+    identifierIds.emplace(identifierNames.back(), newId);
+    identifierSymbols.push_back(NO_SYMBOL);
+    return newId;
+}
+
+const std::string& SymbolTable::getIdentifierName(size_t identifierId) const {
+    return identifierNames[identifierId];
+}
+
+std::optional<size_t> SymbolTable::findSymbol(size_t identifierId) const {
+    if (identifierId >= identifierSymbols.size() || identifierSymbols[identifierId] == NO_SYMBOL) {
+        return std::nullopt;
+    }
+    return identifierSymbols[identifierId];
+}
+
+std::optional<size_t> SymbolTable::findSymbol(const std::string& name) const {
+    auto it = identifierIds.find(name);
+    if (it != identifierIds.end()) {
+        return findSymbol(it->second);
+    }
     return std::nullopt;
 }
 
-std::optional<size_t> SymbolTable::addVariable(const std::string& name, SymbolType type, int declarationLine) {
-    if (getKeywordType(name).has_value()) {
-        errorHandler.logSemanticError("Identifier '" + name + "' is a reserved keyword.", declarationLine);
+// Проверяет, что идентификатор еще не объявлен, и закрепляет за ним индекс следующего символа
+std::optional<size_t> SymbolTable::registerSymbol(size_t identifierId, const char* kind, int declarationLine) {
+    if (identifierSymbols[identifierId] != NO_SYMBOL) {
+        errorHandler.logSemanticError(std::string(kind) + " '" + identifierNames[identifierId] + "' already declared.", declarationLine);
         return std::nullopt;
     }
-    if (findSymbol(name).has_value()) {
-        errorHandler.logSemanticError("Variable '" + name + "' already declared.", declarationLine);
+    return symbols.size();
+}
+
+std::optional<size_t> SymbolTable::addVariable(size_t identifierId, SymbolType type, int declarationLine) {
+    const std::string& name = identifierNames[identifierId];
+    std::optional<size_t> newIndex = registerSymbol(identifierId, "Variable", declarationLine);
+    if (!newIndex) {
         return std::nullopt;
     }
 
     if (type != SymbolType::VARIABLE_INT && type != SymbolType::VARIABLE_FLOAT) {
-        //      ,     
+        // Эта проверка больше для внутренней консистентности, парсер должен передавать корректный тип
         errorHandler.logSemanticError("Internal: Invalid type for variable '" + name + "'.", declarationLine);
         return std::nullopt;
     }
 
-    size_t newIndex = symbols.size();
     symbols.emplace_back(name, type, declarationLine);
-    nameToIndexMap[name] = newIndex;
+    identifierSymbols[identifierId] = newIndex.value();
     return newIndex;
 }
 
-std::optional<size_t> SymbolTable::addArray(const std::string& name, SymbolType type, int declarationLine, size_t size) {
-    if (getKeywordType(name).has_value()) {
-        errorHandler.logSemanticError("Identifier '" + name + "' is a reserved keyword.", declarationLine);
-        return std::nullopt;
-    }
-    if (findSymbol(name).has_value()) {
-        errorHandler.logSemanticError("Array '" + name + "' already declared.", declarationLine);
+std::optional<size_t> SymbolTable::addArray(size_t identifierId, SymbolType type, int declarationLine, size_t size,
+    ArrayStorageHint hint) {
+    const std::string& name = identifierNames[identifierId];
+    std::optional<size_t> newIndex = registerSymbol(identifierId, "Array", declarationLine);
+    if (!newIndex) {
         return std::nullopt;
     }
 
@@ -72,16 +115,77 @@ std::optional<size_t> SymbolTable::addArray(const std::string& name, SymbolType
         return std::nullopt;
     }
 
-    size_t newIndex = symbols.size();
-    symbols.emplace_back(name, type, declarationLine, size); //   SymbolInfo  
-    nameToIndexMap[name] = newIndex;
+    const size_t bytes = size * sizeof(int); // int и float - по 4 байта
+    if (hint == ArrayStorageHint::SPARSE || bytes >= LAZY_ARRAY_MIN_BYTES) {
+        SymbolInfo info(name, type, declarationLine); // Без выделения памяти под элементы
+        info.arrayDeclaredSize = size;
+        info.storageHint = hint;
+        if (hint != ArrayStorageHint::SPARSE) {
+            auto memory = std::make_shared<MappedFile>();
+            std::string error;
+            if (memory->allocateAnonymous(bytes, error)) {
+                info.mappedFile = std::move(memory);
+            }
+            else if (hint == ArrayStorageHint::DENSE) {
+                errorHandler.logSemanticError("Cannot allocate array '" + name + "': " + error + ".", declarationLine);
+                return std::nullopt;
+            }
+        }
+        if (!info.mappedFile) {
+            info.sparseStore = std::make_shared<SparseArrayStore>(size); // Подсказка sparse или нехватка адресного пространства
+        }
+        symbols.push_back(std::move(info));
+    }
+    else {
+        symbols.emplace_back(name, type, declarationLine, size); // Используем конструктор SymbolInfo для массивов
+        symbols.back().storageHint = hint;
+    }
+    identifierSymbols[identifierId] = newIndex.value();
+    return newIndex;
+}
+
+std::optional<size_t> SymbolTable::addMappedArray(size_t identifierId, SymbolType type, int declarationLine,
+    const std::string& path, MappingMode mode) {
+    const std::string& name = identifierNames[identifierId];
+    std::optional<size_t> newIndex = registerSymbol(identifierId, "Array", declarationLine);
+    if (!newIndex) {
+        return std::nullopt;
+    }
+    if (type != SymbolType::ARRAY_INT && type != SymbolType::ARRAY_FLOAT) {
+        errorHandler.logSemanticError("Internal: Invalid type for array '" + name + "'.", declarationLine);
+        return std::nullopt;
+    }
+
+    auto mapping = std::make_shared<MappedFile>();
+    std::string error;
+    if (!mapping->open(path, mode, error)) {
+        errorHandler.logSemanticError("Cannot map file '" + path + "' for array '" + name + "': " + error + ".", declarationLine);
+        return std::nullopt;
+    }
+    const size_t elementSize = (type == SymbolType::ARRAY_INT) ? sizeof(int) : sizeof(float);
+    if (mapping->size() % elementSize != 0) {
+        errorHandler.logSemanticError("Size of file '" + path + "' (" + std::to_string(mapping->size()) +
+            " bytes) is not a multiple of the element size of array '" + name + "'.", declarationLine);
+        return std::nullopt;
+    }
+    // Индексы во время выполнения - int
+    const size_t elementCount = mapping->size() / elementSize;
+    if (elementCount > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        errorHandler.logSemanticError("File '" + path + "' is too large for array '" + name + "'.", declarationLine);
+        return std::nullopt;
+    }
+
+    symbols.emplace_back(name, type, declarationLine); // Без выделения памяти под элементы
+    symbols.back().arrayDeclaredSize = elementCount;
+    symbols.back().mappedFile = std::move(mapping);
+    identifierSymbols[identifierId] = newIndex.value();
     return newIndex;
 }
 
 const SymbolInfo* SymbolTable::getSymbolInfo(size_t index) const {
     if (index >= symbols.size()) {
-        //         /
-        //    
+        // Эта ошибка не должна возникать при корректной работе парсера/интерпретатора
+        // но оставим для отладки
         // errorHandler.logRuntimeError("Internal: Symbol index " + std::to_string(index) + " out of bounds.");
         return nullptr;
     }
@@ -101,17 +205,17 @@ SymbolType SymbolTable::getSymbolType(size_t index) const {
     if (info) {
         return info->type;
     }
-    //   ""   /  ,   
-    //  , ,     findSymbol
-    //  ,     ,     findSymbol  addVariable/addArray.
-    return SymbolType::VARIABLE_INT; // ,    .     optional.
+    // Возвращаем некий "невалидный" тип или парсер/интерпретатор должны убедиться, что индекс валиден
+    // Для простоты, предполагаем, что вызывающий код проверил findSymbol
+    // В идеале, такая ситуация не должна происходить, если индекс получен из findSymbol или addVariable/addArray.
+    return SymbolType::VARIABLE_INT; // Заглушка, чтобы компилятор не ругался. Лучше бы это было optional.
 }
 
 const std::string& SymbolTable::getSymbolName(size_t index) const {
     const SymbolInfo* info = getSymbolInfo(index);
-    // ,   ,    getSymbolType
-    //  info  nullptr,     .
-    //       ,     .
+    // Предполагаем, что индекс валиден, как и в getSymbolType
+    // Если info будет nullptr, это приведет к неопределенному поведению.
+    // Для учебного проекта это может быть приемлемо, если мы гарантируем корректность индекса.
     static const std::string empty_string = "";
     if (info) return info->name;
     return empty_string;
@@ -124,26 +228,27 @@ int SymbolTable::getSymbolDeclarationLine(size_t index) const {
 }
 
 
-bool SymbolTable::setVariableValue(size_t index, const StoredValue& valueToSet) {
+bool SymbolTable::setVariableValue(size_t index, const StoredValue& valueToSet, ErrorHandler* errorSink) {
+    ErrorHandler& errors = errorSink ? *errorSink : errorHandler;
     SymbolInfo* info = getSymbolInfo(index);
     if (!info) return false;
 
     if (info->type != SymbolType::VARIABLE_INT && info->type != SymbolType::VARIABLE_FLOAT) {
-        errorHandler.logRuntimeError("Attempt to set value for non-variable symbol '" + info->name + "'.");
+        errors.logRuntimeError("Attempt to set value for non-variable symbol '" + info->name + "'.");
         return false;
     }
 
-    //       
+    // Проверка и возможное преобразование типов при присваивании
     if (info->type == SymbolType::VARIABLE_INT) {
         if (std::holds_alternative<int>(valueToSet)) {
             info->value = valueToSet;
         }
         else if (std::holds_alternative<float>(valueToSet)) {
-            errorHandler.logRuntimeError("Warning: Implicit conversion from float to int for variable '" + info->name + "'. Value truncated.");
-            info->value = static_cast<int>(std::get<float>(valueToSet)); // 
+            errors.logRuntimeError("Warning: Implicit conversion from float to int for variable '" + info->name + "'. Value truncated.");
+            info->value = static_cast<int>(std::get<float>(valueToSet)); // Усечение
         }
         else {
-            errorHandler.logRuntimeError("Invalid value type for int variable '" + info->name + "'.");
+            errors.logRuntimeError("Invalid value type for int variable '" + info->name + "'.");
             return false;
         }
     }
@@ -152,30 +257,31 @@ bool SymbolTable::setVariableValue(size_t index, const StoredValue& valueToSet)
             info->value = valueToSet;
         }
         else if (std::holds_alternative<int>(valueToSet)) {
-            info->value = static_cast<float>(std::get<int>(valueToSet)); //  int  float
+            info->value = static_cast<float>(std::get<int>(valueToSet)); // Преобразование int в float
         }
         else {
-            errorHandler.logRuntimeError("Invalid value type for float variable '" + info->name + "'.");
+            errors.logRuntimeError("Invalid value type for float variable '" + info->name + "'.");
             return false;
         }
     }
     return true;
 }
 
-std::optional<StoredValue> SymbolTable::getVariableValue(size_t index) const {
+std::optional<StoredValue> SymbolTable::getVariableValue(size_t index, ErrorHandler* errorSink) const {
+    ErrorHandler& errors = errorSink ? *errorSink : errorHandler;
     const SymbolInfo* info = getSymbolInfo(index);
     if (!info) return std::nullopt;
 
     if (info->type != SymbolType::VARIABLE_INT && info->type != SymbolType::VARIABLE_FLOAT) {
         // errorHandler.logRuntimeError("Attempt to get value from non-variable symbol '" + info->name + "'.");
-        //        ,  .
-        //      .
+        // Эта ошибка скорее семантическая на этапе проверки парсером, чем рантайм.
+        // Интерпретатор должен получать уже валидные адреса.
         return std::nullopt;
     }
     if (std::holds_alternative<std::monostate>(info->value)) {
-        errorHandler.logRuntimeError("Variable '" + info->name + "' used before initialization.");
-        //     ,   0/0.0f    .
-        //    monostate,   .
+        errors.logRuntimeError("Variable '" + info->name + "' used before initialization.");
+        // В зависимости от семантики языка, можно возвращать 0/0.0f или это фатальная ошибка.
+        // Для простоты вернем monostate, а интерпретатор решит.
     }
     return info->value;
 }
@@ -190,51 +296,84 @@ std::optional<size_t> SymbolTable::getArrayDeclaredSize(size_t index) const {
     return info->arrayDeclaredSize;
 }
 
-bool SymbolTable::setArrayElementValue(size_t arrayIndex, size_t elementIndex, const StoredValue& valueToSet) {
+bool SymbolTable::setArrayElementValue(size_t arrayIndex, size_t elementIndex, const StoredValue& valueToSet, ErrorHandler* errorSink) {
+    ErrorHandler& errors = errorSink ? *errorSink : errorHandler;
     SymbolInfo* info = getSymbolInfo(arrayIndex);
     if (!info) return false;
 
     if (info->type != SymbolType::ARRAY_INT && info->type != SymbolType::ARRAY_FLOAT) {
-        errorHandler.logRuntimeError("Attempt to set element for non-array symbol '" + info->name + "'.");
+        errors.logRuntimeError("Attempt to set element for non-array symbol '" + info->name + "'.");
         return false;
     }
     if (elementIndex >= info->arrayDeclaredSize) {
-        errorHandler.logRuntimeError("Array index " + std::to_string(elementIndex) +
+        errors.logRuntimeError("Array index " + std::to_string(elementIndex) +
             " out of bounds for array '" + info->name +
             "' (size: " + std::to_string(info->arrayDeclaredSize) + ").");
         return false;
     }
+    if (info->isReadOnly()) {
+        errors.logRuntimeError("Array '" + info->name + "' is mapped read-only.");
+        return false;
+    }
+    if (info->sparseStore) {
+        if (info->type == SymbolType::ARRAY_INT) {
+            if (std::holds_alternative<float>(valueToSet)) {
+                errors.logRuntimeError("Warning: Implicit conversion from float to int for array element '" +
+                    info->name + "[" + std::to_string(elementIndex) + "]'. Value truncated.");
+                info->sparseStore->store<int>(elementIndex, static_cast<int>(std::get<float>(valueToSet)));
+            }
+            else if (std::holds_alternative<int>(valueToSet)) {
+                info->sparseStore->store<int>(elementIndex, std::get<int>(valueToSet));
+            }
+            else {
+                errors.logRuntimeError("Invalid value type for int array element '" + info->name + "[" + std::to_string(elementIndex) + "]'.");
+                return false;
+            }
+        }
+        else if (std::holds_alternative<float>(valueToSet)) {
+            info->sparseStore->store<float>(elementIndex, std::get<float>(valueToSet));
+        }
+        else if (std::holds_alternative<int>(valueToSet)) {
+            info->sparseStore->store<float>(elementIndex, static_cast<float>(std::get<int>(valueToSet)));
+        }
+        else {
+            errors.logRuntimeError("Invalid value type for float array element '" + info->name + "[" + std::to_string(elementIndex) + "]'.");
+            return false;
+        }
+        return true;
+    }
 
     if (info->type == SymbolType::ARRAY_INT) {
         if (std::holds_alternative<int>(valueToSet)) {
-            info->arrayData[elementIndex] = valueToSet;
+            info->intElements()[elementIndex] = std::get<int>(valueToSet);
         }
         else if (std::holds_alternative<float>(valueToSet)) {
-            errorHandler.logRuntimeError("Warning: Implicit conversion from float to int for array element '" +
+            errors.logRuntimeError("Warning: Implicit conversion from float to int for array element '" +
                 info->name + "[" + std::to_string(elementIndex) + "]'. Value truncated.");
-            info->arrayData[elementIndex] = static_cast<int>(std::get<float>(valueToSet));
+            info->intElements()[elementIndex] = static_cast<int>(std::get<float>(valueToSet));
         }
         else {
-            errorHandler.logRuntimeError("Invalid value type for int array element '" + info->name + "[" + std::to_string(elementIndex) + "]'.");
+            errors.logRuntimeError("Invalid value type for int array element '" + info->name + "[" + std::to_string(elementIndex) + "]'.");
             return false;
         }
     }
     else if (info->type == SymbolType::ARRAY_FLOAT) {
         if (std::holds_alternative<float>(valueToSet)) {
-            info->arrayData[elementIndex] = valueToSet;
+            info->floatElements()[elementIndex] = std::get<float>(valueToSet);
         }
         else if (std::holds_alternative<int>(valueToSet)) {
-            info->arrayData[elementIndex] = static_cast<float>(std::get<int>(valueToSet));
+            info->floatElements()[elementIndex] = static_cast<float>(std::get<int>(valueToSet));
         }
         else {
-            errorHandler.logRuntimeError("Invalid value type for float array element '" + info->name + "[" + std::to_string(elementIndex) + "]'.");
+            errors.logRuntimeError("Invalid value type for float array element '" + info->name + "[" + std::to_string(elementIndex) + "]'.");
             return false;
         }
     }
     return true;
 }
 
-std::optional<StoredValue> SymbolTable::getArrayElementValue(size_t arrayIndex, size_t elementIndex) const {
+std::optional<StoredValue> SymbolTable::getArrayElementValue(size_t arrayIndex, size_t elementIndex, ErrorHandler* errorSink) const {
+    ErrorHandler& errors = errorSink ? *errorSink : errorHandler;
     const SymbolInfo* info = getSymbolInfo(arrayIndex);
     if (!info) return std::nullopt;
 
@@ -243,16 +382,90 @@ std::optional<StoredValue> SymbolTable::getArrayElementValue(size_t arrayIndex,
         return std::nullopt;
     }
     if (elementIndex >= info->arrayDeclaredSize) {
-        errorHandler.logRuntimeError("Array index " + std::to_string(elementIndex) +
+        errors.logRuntimeError("Array index " + std::to_string(elementIndex) +
             " out of bounds for array '" + info->name +
             "' (size: " + std::to_string(info->arrayDeclaredSize) + ").");
-        return std::nullopt; //   nullopt,     
+        return std::nullopt; // Важно вернуть nullopt, чтобы интерпретатор мог это обработать
+    }
+    // Элементы массивов всегда инициализированы (нулями при объявлении), поэтому monostate здесь невозможен
+    if (info->sparseStore) {
+        if (info->type == SymbolType::ARRAY_INT) return StoredValue(info->sparseStore->load<int>(elementIndex));
+        return StoredValue(info->sparseStore->load<float>(elementIndex));
+    }
+    if (info->type == SymbolType::ARRAY_INT) {
+        return StoredValue(info->intElements()[elementIndex]);
+    }
+    return StoredValue(info->floatElements()[elementIndex]);
+}
+
+int* SymbolTable::getArrayIntData(size_t index) {
+    SymbolInfo* info = getSymbolInfo(index);
+    if (!info || info->type != SymbolType::ARRAY_INT) return nullptr;
+    return info->intElements();
+}
+
+float* SymbolTable::getArrayFloatData(size_t index) {
+    SymbolInfo* info = getSymbolInfo(index);
+    if (!info || info->type != SymbolType::ARRAY_FLOAT) return nullptr;
+    return info->floatElements();
+}
+
+const int* SymbolTable::getArrayIntData(size_t index) const {
+    const SymbolInfo* info = getSymbolInfo(index);
+    if (!info || info->type != SymbolType::ARRAY_INT) return nullptr;
+    return info->intElements();
+}
+
+const float* SymbolTable::getArrayFloatData(size_t index) const {
+    const SymbolInfo* info = getSymbolInfo(index);
+    if (!info || info->type != SymbolType::ARRAY_FLOAT) return nullptr;
+    return info->floatElements();
+}
+
+bool SymbolTable::isArrayReadOnly(size_t index) const {
+    const SymbolInfo* info = getSymbolInfo(index);
+    return info && info->isReadOnly();
+}
+
+bool SymbolTable::isArraySparse(size_t index) const {
+    const SymbolInfo* info = getSymbolInfo(index);
+    return info && info->sparseStore != nullptr;
+}
+
+void SymbolTable::applySparseHeuristic(const std::vector<size_t>& wholeArrayOperands) {
+    for (size_t index = 0; index < symbols.size(); ++index) {
+        SymbolInfo& info = symbols[index];
+        // Только еще не использованные анонимные массивы: их содержимое - нули, переносить нечего
+        if (info.storageHint != ArrayStorageHint::AUTO || !info.mappedFile || !info.mappedFile->isAnonymous() ||
+            info.arrayDeclaredSize * sizeof(int) < SPARSE_AUTO_MIN_BYTES) {
+            continue;
+        }
+        if (std::find(wholeArrayOperands.begin(), wholeArrayOperands.end(), index) != wholeArrayOperands.end()) {
+            continue;
+        }
+        info.mappedFile.reset();
+        info.sparseStore = std::make_shared<SparseArrayStore>(info.arrayDeclaredSize);
+    }
+}
+
+std::optional<ArrayMemoryStats> SymbolTable::getArrayMemoryStats(size_t index) const {
+    const SymbolInfo* info = getSymbolInfo(index);
+    if (!info || (info->type != SymbolType::ARRAY_INT && info->type != SymbolType::ARRAY_FLOAT)) return std::nullopt;
+    ArrayMemoryStats stats;
+    stats.declaredBytes = info->arrayDeclaredSize * sizeof(int);
+    if (info->sparseStore) {
+        stats.storage = "sparse";
+        stats.residentBytes = info->sparseStore->getResidentBytes();
+    }
+    else if (info->mappedFile) {
+        stats.storage = info->mappedFile->isAnonymous() ? "lazy" : "mapped";
+        stats.residentBytes = info->mappedFile->getResidentBytes();
+    }
+    else {
+        stats.storage = "dense";
+        stats.residentBytes = stats.declaredBytes;
     }
-    //     (     )
-    // if (std::holds_alternative<std::monostate>(info->arrayData[elementIndex])) {
-    //     errorHandler.logRuntimeError("Array element '" + info->name + "[" + std::to_string(elementIndex) + "]' used before initialization.");
-    // }
-    return info->arrayData[elementIndex];
+    return stats;
 }
 
 size_t SymbolTable::getTableSize() const {
@@ -260,7 +473,7 @@ size_t SymbolTable::getTableSize() const {
 }
 
 /*
-//  ,  
+// Для отладки, если понадобится
 void SymbolTable::print() const {
     std::cout << "--- Symbol Table ---" << std::endl;
     if (symbols.empty()) {
@@ -275,7 +488,7 @@ void SymbolTable::print() const {
             case SymbolType::ARRAY_INT:      std::cout << "ARRAY_INT (Size: " << sym.arrayDeclaredSize << ")"; break;
             case SymbolType::ARRAY_FLOAT:    std::cout << "ARRAY_FLOAT (Size: " << sym.arrayDeclaredSize << ")"; break;
         }
-        //    ,   
+        // Можно добавить вывод значения, если оно есть
         if (sym.type == SymbolType::VARIABLE_INT && std::holds_alternative<int>(sym.value)) {
             std::cout << ", Value: " << std::get<int>(sym.value);
         } else if (sym.type == SymbolType::VARIABLE_FLOAT && std::holds_alternative<float>(sym.value)) {
@@ -7,95 +7,191 @@
 #include <optional>
 #include <variant>
 #include <unordered_map>
-#include <utility> //  std::move
+#include <deque>       // Хранилище имен идентификаторов (адреса строк не меняются при добавлении)
+#include <string_view>
+#include <utility> // Для std::move
+#include <memory>  // Для std::shared_ptr (отображенные файлы)
+
+#include "definitions.h" // Нужны SymbolType, TokenType
+#include "error_handler.h" // Для сообщений об ошибках
+#include "mapped_file.h"   // Массивы, отображенные на файлы
+#include "sparse_array.h"  // Разреженные массивы
+
+// Значение, хранимое для символа (переменной или элемента массива)
+// Используем std::monostate для неинициализированных значений или когда значение еще не присвоено
+using StoredValue = std::variant<std::monostate, int, float>;
 
-#include "definitions.h" //  SymbolType, TokenType
-#include "error_handler.h" //    
+// Подсказка о способе хранения массива в объявлении: arr int h[100000000 sparse]
+enum class ArrayStorageHint {
+    AUTO,   // Выбор по размеру (см. SymbolTable::applySparseHeuristic)
+    DENSE,  // Непрерывная память (большие массивы - анонимное отображение с ленивым выделением страниц)
+    SPARSE  // Страничное разреженное хранилище
+};
 
-// ,    (   )
-//  std::monostate         
-using StoredValue = std::variant<std::monostate, int, float>;
+// Статистика памяти массива (для --memory-stats)
+struct ArrayMemoryStats {
+    std::string storage;  // "dense", "lazy", "sparse", "mapped"
+    size_t declaredBytes; // Размер массива * размер элемента
+    size_t residentBytes; // Фактически занятая память (для отображений - страницы в памяти)
+};
 
-//     
+// Информация о символе в таблице
 struct SymbolInfo {
     std::string name;
     SymbolType type;
-    int declarationLine; // ,    
+    int declarationLine; // Строка, где символ был объявлен
 
-    //  
+    // Для переменных
     StoredValue value;
 
-    //  
-    std::vector<StoredValue> arrayData;
-    size_t arrayDeclaredSize; // ,    ()
-
-    //   
+    // Для массивов
+    // Элементы хранятся непрерывно в "родном" типе (а не как StoredValue),
+    // чтобы векторные операции могли обрабатывать их SIMD-ядрами напрямую.
+    std::vector<int> arrayIntData;     // Для ARRAY_INT
+    std::vector<float> arrayFloatData; // Для ARRAY_FLOAT
+    size_t arrayDeclaredSize; // Размер, указанный при объявлении (статический)
+    // Массив, отображенный на файл (arr int a["data.bin"]): элементы - байты файла,
+    // arrayIntData/arrayFloatData пусты, размер определяется длиной файла
+    std::shared_ptr<MappedFile> mappedFile;
+    // Большие массивы: mappedFile с анонимной памятью (страницы выделяются при первой записи)
+    // или разреженное хранилище; в обоих случаях векторы элементов пусты
+    std::shared_ptr<SparseArrayStore> sparseStore;
+    ArrayStorageHint storageHint = ArrayStorageHint::AUTO;
+
+    // Конструктор для переменных
     SymbolInfo(std::string n, SymbolType t, int line)
         : name(std::move(n)), type(t), declarationLine(line),
         value(std::monostate{}), arrayDeclaredSize(0) {
     }
 
-    //    (  )
+    // Конструктор для массивов (размер задается отдельно)
     SymbolInfo(std::string n, SymbolType t, int line, size_t declaredSize)
         : name(std::move(n)), type(t), declarationLine(line),
         value(std::monostate{}), arrayDeclaredSize(declaredSize) {
-        //      
+        // Инициализация элементов массива значениями по умолчанию
         if (type == SymbolType::ARRAY_INT) {
-            arrayData.resize(declaredSize, StoredValue(0)); //  int  
+            arrayIntData.resize(declaredSize, 0); // Массивы int инициализируются нулями
         }
         else if (type == SymbolType::ARRAY_FLOAT) {
-            arrayData.resize(declaredSize, StoredValue(0.0f)); //  float  0.0f
+            arrayFloatData.resize(declaredSize, 0.0f); // Массивы float инициализируются 0.0f
         }
     }
+
+    // Непрерывные элементы массива (из вектора или из отображения); у разреженного массива их нет - nullptr
+    int* intElements() { return mappedFile ? static_cast<int*>(mappedFile->data()) : (sparseStore ? nullptr : arrayIntData.data()); }
+    float* floatElements() { return mappedFile ? static_cast<float*>(mappedFile->data()) : (sparseStore ? nullptr : arrayFloatData.data()); }
+    const int* intElements() const { return mappedFile ? static_cast<const int*>(mappedFile->data()) : (sparseStore ? nullptr : arrayIntData.data()); }
+    const float* floatElements() const { return mappedFile ? static_cast<const float*>(mappedFile->data()) : (sparseStore ? nullptr : arrayFloatData.data()); }
+    bool isReadOnly() const { return mappedFile && mappedFile->getMode() == MappingMode::READ_ONLY; }
+};
+
+// Контекстные слова: не зарезервированы (могут быть именами переменных), но имеют особый смысл
+// в отдельных местах грамматики. Интернируются конструктором таблицы первыми, поэтому их номера
+// идентификаторов известны заранее и парсер сравнивает номера, а не строки.
+enum ContextualWord : size_t {
+    WORD_SPARSE,   // arr int h[k sparse]
+    WORD_DENSE,    // arr int a[k dense]
+    WORD_READONLY, // arr int a["файл" readonly]
+    WORD_COW,      // arr int a["файл" cow]
+    WORD_MIN,      // reduce(min m)
+    WORD_MAX,      // reduce(max m)
+    WORD_SUM,      // sum(G) - только перед '(', иначе обычный идентификатор
+    WORD_PARALLEL, // parallel while / parallel reduce - только в начале оператора
+    WORD_REDUCE,   // parallel reduce(+ s) - только после parallel
+    CONTEXTUAL_WORD_COUNT
 };
 
-//   
+// Класс Таблицы Символов
 class SymbolTable {
 private:
     std::vector<SymbolInfo> symbols;
-    std::unordered_map<std::string, size_t> nameToIndexMap;
-    std::unordered_map<std::string, TokenType> keywordMap;
-    ErrorHandler& errorHandler; //    
+    // Интернированные идентификаторы: номер идентификатора -> имя и индекс символа (NO_SYMBOL - не объявлен).
+    // Лексер хеширует текст идентификатора один раз; дальше парсер работает только с номерами.
+    std::deque<std::string> identifierNames;
+    std::unordered_map<std::string_view, size_t> identifierIds; // Ключи ссылаются на строки identifierNames
+    std::vector<size_t> identifierSymbols;
+    ErrorHandler& errorHandler; // Ссылка на обработчик ошибок
+
+    std::optional<size_t> registerSymbol(size_t identifierId, const char* kind, int declarationLine);
 
 public:
+    static constexpr size_t NO_SYMBOL = static_cast<size_t>(-1);
+
     SymbolTable(ErrorHandler& errHandler);
+    SymbolTable(const SymbolTable&) = delete; // identifierIds ссылается на собственные строки
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    // --- Работа с ключевыми словами ---
+    // Ключевые слова распознаются разбором по длине и первой букве (без хеширования)
+    static std::optional<TokenType> getKeywordType(std::string_view name);
 
-    // ---     ---
-    std::optional<TokenType> getKeywordType(const std::string& name) const;
+    // --- Идентификаторы ---
+    // Возвращает номер идентификатора (плотная нумерация с 0), добавляя его при первой встрече
+    size_t internIdentifier(std::string_view name);
+    const std::string& getIdentifierName(size_t identifierId) const;
 
-    // ---     ---
+    // --- Поиск и добавление символов ---
+    std::optional<size_t> findSymbol(size_t identifierId) const; // По номеру идентификатора из токена
     std::optional<size_t> findSymbol(const std::string& name) const;
 
-    //   (int  float)
-    //    std::nullopt  
-    std::optional<size_t> addVariable(const std::string& name, SymbolType type, int declarationLine);
+    // Добавление переменной (int или float)
+    // Возвращает индекс или std::nullopt при ошибке
+    std::optional<size_t> addVariable(size_t identifierId, SymbolType type, int declarationLine);
 
-    //   (int  float)
-    // size -  ,   
-    //    std::nullopt  
-    std::optional<size_t> addArray(const std::string& name, SymbolType type, int declarationLine, size_t size);
+    // Массивы от LAZY_ARRAY_MIN_BYTES размещаются в анонимной памяти (нулевые страницы выделяются ОС
+    // при первой записи), а не в std::vector, который заполняет нулями весь массив сразу
+    static const size_t LAZY_ARRAY_MIN_BYTES = 1 << 20;
+    // Массивы без подсказки от SPARSE_AUTO_MIN_BYTES, не участвующие в операциях над целыми массивами,
+    // становятся разреженными: такие массивы (гистограммы, таблицы по ключу) обычно заполнены слабо
+    static const size_t SPARSE_AUTO_MIN_BYTES = 256u << 20;
 
-    // ---      ---
-    const SymbolInfo* getSymbolInfo(size_t index) const; //  ,     nullptr
-    SymbolInfo* getSymbolInfo(size_t index);             //  
+    // Добавление массива (int или float)
+    // size - размер массива, указанный при объявлении
+    // Возвращает индекс или std::nullopt при ошибке
+    std::optional<size_t> addArray(size_t identifierId, SymbolType type, int declarationLine, size_t size,
+        ArrayStorageHint hint = ArrayStorageHint::AUTO);
+
+    // Добавление массива, отображенного на двоичный файл (элементы int32/float32 в порядке байтов машины).
+    // Размер массива - длина файла, деленная на размер элемента.
+    std::optional<size_t> addMappedArray(size_t identifierId, SymbolType type, int declarationLine,
+        const std::string& path, MappingMode mode);
+
+    // --- Доступ к информации о символах ---
+    const SymbolInfo* getSymbolInfo(size_t index) const; // Возвращает указатель, чтобы можно было вернуть nullptr
+    SymbolInfo* getSymbolInfo(size_t index);             // Неконстантная версия
 
     SymbolType getSymbolType(size_t index) const;
     const std::string& getSymbolName(size_t index) const;
     int getSymbolDeclarationLine(size_t index) const;
 
-    // ---     ---
-    bool setVariableValue(size_t index, const StoredValue& valueToSet);
-    std::optional<StoredValue> getVariableValue(size_t index) const;
+    // --- Работа со значениями переменных ---
+    // errorSink - куда сообщать об ошибках (по умолчанию - общий обработчик таблицы).
+    // Рабочие потоки параллельного цикла передают собственные обработчики.
+    bool setVariableValue(size_t index, const StoredValue& valueToSet, ErrorHandler* errorSink = nullptr);
+    std::optional<StoredValue> getVariableValue(size_t index, ErrorHandler* errorSink = nullptr) const;
 
-    // ---    ---
-    //       (addArray)
+    // --- Работа с массивами ---
+    // Размер массива теперь устанавливается при добавлении (addArray)
     std::optional<size_t> getArrayDeclaredSize(size_t index) const;
-    bool setArrayElementValue(size_t arrayIndex, size_t elementIndex, const StoredValue& valueToSet);
-    std::optional<StoredValue> getArrayElementValue(size_t arrayIndex, size_t elementIndex) const;
-
-    // ---  ---
+    bool isArrayReadOnly(size_t index) const; // Массив отображен на файл только для чтения
+    bool isArraySparse(size_t index) const;   // Разреженный массив (нет непрерывных данных)
+    // Выбор разреженного хранения для больших массивов без подсказки (вызывается после разбора).
+    // wholeArrayOperands - массивы, используемые в операциях над целыми массивами: им нужна непрерывная память.
+    void applySparseHeuristic(const std::vector<size_t>& wholeArrayOperands);
+    std::optional<ArrayMemoryStats> getArrayMemoryStats(size_t index) const;
+    bool setArrayElementValue(size_t arrayIndex, size_t elementIndex, const StoredValue& valueToSet, ErrorHandler* errorSink = nullptr);
+    std::optional<StoredValue> getArrayElementValue(size_t arrayIndex, size_t elementIndex, ErrorHandler* errorSink = nullptr) const;
+
+    // Прямой доступ к непрерывным данным массива (для векторных операций).
+    // Возвращают nullptr, если символ не является массивом соответствующего типа или массив разреженный.
+    int* getArrayIntData(size_t index);
+    float* getArrayFloatData(size_t index);
+    const int* getArrayIntData(size_t index) const;
+    const float* getArrayFloatData(size_t index) const;
+
+    // --- Вспомогательное ---
     size_t getTableSize() const;
-    // void print() const; //  
+    // void print() const; // Для отладки
 };
 
 #endif // SYMBOL_TABLE_H
\ No newline at end of file
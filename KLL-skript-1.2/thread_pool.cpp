@@ -0,0 +1,107 @@
+// thread_pool.cpp
+#include "thread_pool.h"
+
+WorkStealingPool::WorkStealingPool(size_t threadCount)
+    : currentTask(nullptr), jobGeneration(0), busyWorkers(0), stopping(false) {
+    if (threadCount == 0) threadCount = 1;
+    for (size_t i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        stopping = true;
+    }
+    jobStarted.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+size_t WorkStealingPool::getThreadCount() const {
+    return queues.size();
+}
+
+void WorkStealingPool::run(size_t chunkCount, const ChunkTask& task) {
+    if (chunkCount == 0) return;
+
+    // Непрерывные диапазоны кусков по очередям: соседние итерации обрабатывает один поток
+    size_t workers = queues.size();
+    for (size_t w = 0; w < workers; ++w) {
+        size_t from = chunkCount * w / workers;
+        size_t to = chunkCount * (w + 1) / workers;
+        std::lock_guard<std::mutex> lock(queues[w]->mutex);
+        for (size_t chunk = from; chunk < to; ++chunk) {
+            queues[w]->chunks.push_back(chunk);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        currentTask = &task;
+        busyWorkers = threads.size();
+        ++jobGeneration;
+    }
+    jobStarted.notify_all();
+
+    drainQueues(0);
+
+    std::unique_lock<std::mutex> lock(jobMutex);
+    jobFinished.wait(lock, [this] { return busyWorkers == 0; });
+    currentTask = nullptr;
+}
+
+void WorkStealingPool::workerLoop(size_t workerIndex) {
+    size_t seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobStarted.wait(lock, [&] { return stopping || jobGeneration != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = jobGeneration;
+        }
+
+        drainQueues(workerIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            --busyWorkers;
+        }
+        jobFinished.notify_one();
+    }
+}
+
+void WorkStealingPool::drainQueues(size_t workerIndex) {
+    size_t chunk;
+    while (popLocal(workerIndex, chunk) || steal(workerIndex, chunk)) {
+        (*currentTask)(chunk, workerIndex);
+    }
+}
+
+bool WorkStealingPool::popLocal(size_t workerIndex, size_t& chunk) {
+    WorkerQueue& queue = *queues[workerIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.chunks.empty()) return false;
+    chunk = queue.chunks.back();
+    queue.chunks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(size_t thiefIndex, size_t& chunk) {
+    size_t workers = queues.size();
+    for (size_t offset = 1; offset < workers; ++offset) {
+        WorkerQueue& victim = *queues[(thiefIndex + offset) % workers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.chunks.empty()) {
+            chunk = victim.chunks.front();
+            victim.chunks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,58 @@
+// thread_pool.h
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+
+// --- Пул потоков с перехватом работы (work stealing) ---
+// Используется для выполнения параллельных циклов. Задание делится на куски (chunks);
+// каждый рабочий поток сначала берет куски из своей очереди (с конца), а опустев,
+// "крадет" их из начала очередей других потоков. Вызывающий поток участвует в работе
+// как рабочий с номером 0, поэтому пул из одного потока не создает дополнительных потоков.
+
+class WorkStealingPool {
+public:
+    using ChunkTask = std::function<void(size_t chunkIndex, size_t workerIndex)>;
+
+    explicit WorkStealingPool(size_t threadCount);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    size_t getThreadCount() const;
+
+    // Выполняет task для всех кусков 0..chunkCount-1 и возвращает управление после завершения всех.
+    // Исключения из task должны перехватываться внутри task.
+    void run(size_t chunkCount, const ChunkTask& task);
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<size_t> chunks;
+    };
+
+    std::vector<std::thread> threads;                 // Фоновые рабочие 1..N-1
+    std::vector<std::unique_ptr<WorkerQueue>> queues; // По очереди на каждого рабочего (включая вызывающий поток)
+
+    std::mutex jobMutex;
+    std::condition_variable jobStarted;
+    std::condition_variable jobFinished;
+    const ChunkTask* currentTask;
+    size_t jobGeneration;
+    size_t busyWorkers;
+    bool stopping;
+
+    void workerLoop(size_t workerIndex);
+    void drainQueues(size_t workerIndex); // Выполняет свои куски, затем крадет чужие
+    bool popLocal(size_t workerIndex, size_t& chunk);
+    bool steal(size_t thiefIndex, size_t& chunk);
+};
+
+#endif // THREAD_POOL_H
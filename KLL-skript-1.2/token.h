@@ -2,65 +2,65 @@
 #ifndef TOKEN_H
 #define TOKEN_H
 
-#include <string>
+#include <string_view>
 #include <variant>
-#include <utility> //  std::move
+#include <type_traits> // Для проверки тривиального копирования
 
 #include "definitions.h"
 
-//     ()
+// Структура для представления Токена (Лексемы)
+// Токен не владеет текстом: text указывает в исходный код (или на строковый литерал для EOF),
+// поэтому токен тривиально копируется, а исходный код должен жить, пока используются токены.
 struct Token {
     TokenType type;
-    std::string text; //    ( , ,  ..)
+    std::string_view text; // Текстовое представление токена (для идентификаторов, ошибок, и т.д.)
 
-    //  ,   .
-    //  std::variant    int,  float.
-    //    (std::monostate),    .
+    // Значение токена, если это число.
+    // Используем std::variant для хранения либо int, либо float.
+    // Может быть пустым (std::monostate), если токен не числовой.
     std::variant<std::monostate, int, float> value;
 
-    int line;     //  ,   
-    int column;   //  ,   
+    int line;     // Номер строки, где токен начинается
+    int column;   // Номер столбца, где токен начинается
 
-    //    (  ""   )
-    Token() : type(TokenType::T_UNKNOWN), text(""), value(std::monostate{}), line(0), column(0) {}
+    // Номер интернированного идентификатора (SymbolTable::internIdentifier) для T_IDENTIFIER,
+    // NO_IDENTIFIER - для остальных токенов
+    static constexpr size_t NO_IDENTIFIER = static_cast<size_t>(-1);
+    size_t identifierId = NO_IDENTIFIER;
 
-    //      ,    (, ,  )
-    Token(TokenType t, std::string txt, int l, int c)
-        : type(t), text(std::move(txt)), value(std::monostate{}), line(l), column(c) {
+    // Конструктор по умолчанию (для создания "пустых" или неинициализированных токенов)
+    Token() : type(TokenType::T_UNKNOWN), text(), value(std::monostate{}), line(0), column(0) {}
+
+    // Конструктор для токенов без специфического значения, но с текстом (например, операторы, ключевые слова)
+    Token(TokenType t, std::string_view txt, int l, int c)
+        : type(t), text(txt), value(std::monostate{}), line(l), column(c) {
     }
 
-    //        (, T_EOF, T_SEMICOLON  ASCII)
+    // Конструктор для токенов без текста и значения (например, T_EOF, T_SEMICOLON из ASCII)
     Token(TokenType t, int l, int c)
-        : type(t), text(""), value(std::monostate{}), line(l), column(c) {
+        : type(t), text(), value(std::monostate{}), line(l), column(c) {
     }
 
-    //    
-    Token(TokenType t, int val, int l, int c, std::string txt = "")
-        : type(t), text(std::move(txt)), value(val), line(l), column(c) {
-        if (text.empty()) { //    ,    
-            this->text = std::to_string(val);
-        }
+    // Конструктор для целочисленных токенов (txt - запись числа в исходном коде)
+    Token(TokenType t, int val, int l, int c, std::string_view txt)
+        : type(t), text(txt), value(val), line(l), column(c) {
     }
 
-    //    
-    Token(TokenType t, float val, int l, int c, std::string txt = "")
-        : type(t), text(std::move(txt)), value(val), line(l), column(c) {
-        if (text.empty()) { //    ,    
-            //  to_string,      
-            this->text = std::to_string(val);
-        }
+    // Конструктор для вещественных токенов
+    Token(TokenType t, float val, int l, int c, std::string_view txt)
+        : type(t), text(txt), value(val), line(l), column(c) {
     }
 
-    //      (  )
+    // Вспомогательные методы для получения значения (с проверкой типа)
     int getIntValue() const {
         if (std::holds_alternative<int>(value)) {
             return std::get<int>(value);
         }
-        //        /
-        //    ,      
-        //     cerr  exit.
+        // Можно бросить исключение или вернуть значение по умолчанию/ошибку
+        // Для простоты учебного проекта, можно положиться на корректное создание токена
+        // или добавить вывод в cerr и exit.
         // std::cerr << "Error: Attempted to get int value from a non-int token." << std::endl;
-        return 0; //  0     
+        return 0; // Возвращаем 0 или другое значение по умолчанию
     }
 
     float getFloatValue() const {
@@ -68,7 +68,7 @@ struct Token {
             return std::get<float>(value);
         }
         // std::cerr << "Error: Attempted to get float value from a non-float token." << std::endl;
-        return 0.0f; //  0.0f     
+        return 0.0f; // Возвращаем 0.0f или другое значение по умолчанию
     }
 
     bool isNumber() const {
@@ -76,4 +76,6 @@ struct Token {
     }
 };
 
+static_assert(std::is_trivially_copyable<Token>::value, "Token must stay cheap to copy");
+
 #endif // TOKEN_H
\ No newline at end of file
@@ -0,0 +1,74 @@
+// token_buffer.cpp
+#include "token_buffer.h"
+#include <cstring> // Для std::memcpy
+
+TokenBuffer TokenBuffer::tokenize(Lexer& lexer, std::string_view source) {
+    TokenBuffer buffer;
+    buffer.source = source;
+    // Типичный токен занимает 4-8 байт исходного кода
+    const size_t expectedTokens = source.size() / 5 + 16;
+    buffer.types.reserve(expectedTokens);
+    buffer.offsets.reserve(expectedTokens);
+    buffer.lengths.reserve(expectedTokens);
+    buffer.lines.reserve(expectedTokens);
+    buffer.columns.reserve(expectedTokens);
+    buffer.valueBits.reserve(expectedTokens);
+    buffer.identifierIds.reserve(expectedTokens);
+    while (true) {
+        Token token = lexer.getNextToken();
+        if (token.type == TokenType::T_ERROR) continue;
+        buffer.append(token);
+        if (token.type == TokenType::T_EOF) break;
+    }
+    return buffer;
+}
+
+void TokenBuffer::append(const Token& token) {
+    types.push_back(token.type);
+    // Текст всех токенов, кроме T_EOF, - срез source
+    if (token.type != TokenType::T_EOF && !token.text.empty()) {
+        offsets.push_back(static_cast<uint32_t>(token.text.data() - source.data()));
+        lengths.push_back(static_cast<uint32_t>(token.text.size()));
+    }
+    else {
+        offsets.push_back(0);
+        lengths.push_back(0);
+    }
+    lines.push_back(token.line);
+    columns.push_back(token.column);
+    uint32_t bits = 0;
+    if (std::holds_alternative<int>(token.value)) {
+        std::memcpy(&bits, &std::get<int>(token.value), sizeof(bits));
+    }
+    else if (std::holds_alternative<float>(token.value)) {
+        std::memcpy(&bits, &std::get<float>(token.value), sizeof(bits));
+    }
+    valueBits.push_back(bits);
+    identifierIds.push_back(token.identifierId == Token::NO_IDENTIFIER ? NO_IDENTIFIER_ID : static_cast<uint32_t>(token.identifierId));
+}
+
+Token TokenBuffer::get(size_t index) const {
+    if (index >= types.size()) {
+        index = types.size() - 1; // Завершающий T_EOF
+    }
+    const TokenType type = types[index];
+    if (type == TokenType::T_EOF) {
+        return Token(type, "EOF", lines[index], columns[index]);
+    }
+    std::string_view text = source.substr(offsets[index], lengths[index]);
+    Token token(type, text, lines[index], columns[index]);
+    if (type == TokenType::T_NUMBER_INT) {
+        int value;
+        std::memcpy(&value, &valueBits[index], sizeof(value));
+        token.value = value;
+    }
+    else if (type == TokenType::T_NUMBER_FLOAT) {
+        float value;
+        std::memcpy(&value, &valueBits[index], sizeof(value));
+        token.value = value;
+    }
+    if (identifierIds[index] != NO_IDENTIFIER_ID) {
+        token.identifierId = identifierIds[index];
+    }
+    return token;
+}
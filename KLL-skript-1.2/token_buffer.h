@@ -0,0 +1,44 @@
+// token_buffer.h
+#ifndef TOKEN_BUFFER_H
+#define TOKEN_BUFFER_H
+
+#include <vector>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+#include "definitions.h"
+#include "token.h"
+#include "lexer.h"
+
+// --- Буфер токенов в виде структуры массивов ---
+// Исходный код лексируется целиком до начала разбора; каждое поле токена хранится в своем
+// массиве (типы, смещения, длины, строки, столбцы, значения). Парсер читает токены по индексу,
+// поэтому ему доступен просмотр на любое число токенов вперед, а лексер и парсер не вытесняют
+// данные друг друга из кэша. Токены T_ERROR в буфер не попадают (ошибки уже переданы в ErrorHandler).
+class TokenBuffer {
+public:
+    // Лексирует весь источник. source - тот же буфер, на который ссылается lexer.
+    static TokenBuffer tokenize(Lexer& lexer, std::string_view source);
+
+    size_t size() const { return types.size(); } // Включая завершающий T_EOF
+    TokenType typeAt(size_t index) const { return types[index]; }
+    // Восстанавливает токен; индексы за концом буфера дают завершающий T_EOF
+    Token get(size_t index) const;
+
+private:
+    std::string_view source;
+    std::vector<TokenType> types;
+    std::vector<uint32_t> offsets;       // Смещение текста токена в source
+    std::vector<uint32_t> lengths;       // Длина текста (0 - нет текста или T_EOF)
+    std::vector<int32_t> lines;
+    std::vector<int32_t> columns;
+    std::vector<uint32_t> valueBits;     // int или float (по типу токена), побитово
+    std::vector<uint32_t> identifierIds; // NO_IDENTIFIER_ID - не идентификатор
+
+    static constexpr uint32_t NO_IDENTIFIER_ID = UINT32_MAX;
+
+    void append(const Token& token);
+};
+
+#endif // TOKEN_BUFFER_H
@@ -0,0 +1,520 @@
+// vector_kernels.cpp
+#include "vector_kernels.h"
+#include <algorithm> // Для std::fill
+#include <cmath>     // Для std::floor, std::abs
+#include <cstring>   // Для std::memcpy
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define KLL_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define KLL_X86 0
+#endif
+
+// MSVC позволяет использовать любые интринсики без флагов компиляции,
+// GCC/Clang требуют явно разрешить набор инструкций для каждой функции.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define KLL_TARGET_SSE2
+#define KLL_TARGET_AVX2
+#else
+#define KLL_TARGET_SSE2 __attribute__((target("sse2")))
+#define KLL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace {
+
+    // Порог "нуля" для вещественного делителя: |x| < 1e-9 (double) эквивалентно |x| <= 1e-9f,
+    // т.к. 1e-9f - ближайшее снизу к 1e-9 значение float.
+    const float NEAR_ZERO_FLOAT = 1e-9f;
+
+    InstructionSet detectInstructionSet() {
+#if KLL_X86
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+        __cpuid(info, 1);
+        bool sse2 = (info[3] & (1 << 26)) != 0;
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        bool avx2 = false;
+        // AVX2 можно использовать, только если ОС сохраняет YMM-регистры (XCR0 биты 1 и 2)
+        if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+        if (avx2) return InstructionSet::AVX2;
+        return sse2 ? InstructionSet::SSE2 : InstructionSet::SCALAR;
+#else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return InstructionSet::AVX2;
+        if (__builtin_cpu_supports("sse2")) return InstructionSet::SSE2;
+        return InstructionSet::SCALAR;
+#endif
+#else
+        return InstructionSet::SCALAR;
+#endif
+    }
+
+    InstructionSet& detectedInstructionSet() {
+        static InstructionSet detected = detectInstructionSet();
+        return detected;
+    }
+
+    InstructionSet& activeInstructionSet() {
+        static InstructionSet active = detectedInstructionSet();
+        return active;
+    }
+
+    // --- Скалярные реализации (используются и для "хвостов" векторных циклов) ---
+
+    // Целочисленные операции выполняются через unsigned, чтобы переполнение
+    // давало тот же результат, что и SIMD-инструкции (по модулю 2^32)
+    inline int applyInt(VectorKernelOp op, int x, int y) {
+        switch (op) {
+        case VectorKernelOp::ADD: return static_cast<int>(static_cast<unsigned>(x) + static_cast<unsigned>(y));
+        case VectorKernelOp::SUB: return static_cast<int>(static_cast<unsigned>(x) - static_cast<unsigned>(y));
+        case VectorKernelOp::MUL: return static_cast<int>(static_cast<unsigned>(x) * static_cast<unsigned>(y));
+        case VectorKernelOp::DIV: return x / y;
+        }
+        return 0;
+    }
+
+    inline float applyFloat(VectorKernelOp op, float x, float y) {
+        switch (op) {
+        case VectorKernelOp::ADD: return x + y;
+        case VectorKernelOp::SUB: return x - y;
+        case VectorKernelOp::MUL: return x * y;
+        case VectorKernelOp::DIV: return x / y;
+        }
+        return 0.0f;
+    }
+
+    void binaryIntScalar(VectorKernelOp op, int* dst, const int* a, int aScalar, const int* b, int bScalar, size_t from, size_t n) {
+        for (size_t i = from; i < n; ++i) {
+            dst[i] = applyInt(op, a ? a[i] : aScalar, b ? b[i] : bScalar);
+        }
+    }
+
+    void binaryFloatScalar(VectorKernelOp op, float* dst, const float* a, float aScalar, const float* b, float bScalar, size_t from, size_t n) {
+        for (size_t i = from; i < n; ++i) {
+            dst[i] = applyFloat(op, a ? a[i] : aScalar, b ? b[i] : bScalar);
+        }
+    }
+
+    inline bool isInCharClass(CharClass cls, char c) {
+        switch (cls) {
+        case CharClass::SPACE: return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        case CharClass::DIGIT: return c >= '0' && c <= '9';
+        case CharClass::ALNUM: return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        }
+        return false;
+    }
+
+    void convertFloatToIntScalar(int* dst, const float* src, size_t from, size_t n) {
+        for (size_t i = from; i < n; ++i) {
+            dst[i] = static_cast<int>(std::floor(src[i]));
+        }
+    }
+
+#if KLL_X86
+    // --- SSE2 (4 элемента за итерацию) ---
+
+    // В SSE2 нет _mm_mullo_epi32 (появилась в SSE4.1), эмулируем через два 32x32->64 умножения
+    KLL_TARGET_SSE2 inline __m128i mulloEpi32Sse2(__m128i a, __m128i b) {
+        __m128i even = _mm_mul_epu32(a, b);
+        __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+
+    KLL_TARGET_SSE2 size_t binaryIntSse2(VectorKernelOp op, int* dst, const int* a, int aScalar, const int* b, int bScalar, size_t n) {
+        if (op == VectorKernelOp::DIV) return 0; // Целочисленного SIMD-деления нет, все делает скалярный код
+        const __m128i aBroadcast = _mm_set1_epi32(aScalar);
+        const __m128i bBroadcast = _mm_set1_epi32(bScalar);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i x = a ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)) : aBroadcast;
+            __m128i y = b ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)) : bBroadcast;
+            __m128i r;
+            if (op == VectorKernelOp::ADD) r = _mm_add_epi32(x, y);
+            else if (op == VectorKernelOp::SUB) r = _mm_sub_epi32(x, y);
+            else r = mulloEpi32Sse2(x, y);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), r);
+        }
+        return i;
+    }
+
+    KLL_TARGET_SSE2 size_t binaryFloatSse2(VectorKernelOp op, float* dst, const float* a, float aScalar, const float* b, float bScalar, size_t n) {
+        const __m128 aBroadcast = _mm_set1_ps(aScalar);
+        const __m128 bBroadcast = _mm_set1_ps(bScalar);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128 x = a ? _mm_loadu_ps(a + i) : aBroadcast;
+            __m128 y = b ? _mm_loadu_ps(b + i) : bBroadcast;
+            __m128 r;
+            switch (op) {
+            case VectorKernelOp::ADD: r = _mm_add_ps(x, y); break;
+            case VectorKernelOp::SUB: r = _mm_sub_ps(x, y); break;
+            case VectorKernelOp::MUL: r = _mm_mul_ps(x, y); break;
+            default:                  r = _mm_div_ps(x, y); break;
+            }
+            _mm_storeu_ps(dst + i, r);
+        }
+        return i;
+    }
+
+    KLL_TARGET_SSE2 size_t sumIntSse2(const int* a, size_t n, int& result) {
+        __m128i acc = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            acc = _mm_add_epi32(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+        }
+        alignas(16) int lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        result = applyInt(VectorKernelOp::ADD, applyInt(VectorKernelOp::ADD, lanes[0], lanes[1]),
+            applyInt(VectorKernelOp::ADD, lanes[2], lanes[3]));
+        return i;
+    }
+
+    KLL_TARGET_SSE2 size_t sumFloatSse2(const float* a, size_t n, float& result) {
+        __m128 acc = _mm_setzero_ps();
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            acc = _mm_add_ps(acc, _mm_loadu_ps(a + i));
+        }
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, acc);
+        result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        return i;
+    }
+
+    KLL_TARGET_SSE2 size_t convertIntToFloatSse2(float* dst, const int* src, size_t n) {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_ps(dst + i, _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+        }
+        return i;
+    }
+
+    KLL_TARGET_SSE2 size_t findZeroIntSse2(const int* a, size_t n) {
+        const __m128i zero = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), zero)));
+            if (mask != 0) return i; // Точную позицию внутри блока найдет скалярный код
+        }
+        return i;
+    }
+
+    KLL_TARGET_SSE2 size_t findZeroFloatSse2(const float* a, size_t n) {
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        const __m128 threshold = _mm_set1_ps(NEAR_ZERO_FLOAT);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128 absValue = _mm_and_ps(_mm_loadu_ps(a + i), absMask);
+            if (_mm_movemask_ps(_mm_cmple_ps(absValue, threshold)) != 0) return i;
+        }
+        return i;
+    }
+
+    // Номер младшего единичного бита (mask != 0)
+    inline unsigned countTrailingZeros(unsigned mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+
+    // Проверка "first <= c < first + count" для беззнаковых байтов: SSE2 сравнивает байты только со знаком,
+    // поэтому разность сдвигается на 0x80 и сравнивается с -128 + count
+    KLL_TARGET_SSE2 inline __m128i byteRangeSse2(__m128i c, char first, char count) {
+        __m128i shifted = _mm_xor_si128(_mm_sub_epi8(c, _mm_set1_epi8(first)), _mm_set1_epi8(static_cast<char>(0x80)));
+        return _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + count)));
+    }
+
+    KLL_TARGET_SSE2 inline __m128i charClassMaskSse2(CharClass cls, __m128i c) {
+        switch (cls) {
+        case CharClass::SPACE:
+            return _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(c, _mm_set1_epi8('\t'))),
+                _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(c, _mm_set1_epi8('\n'))));
+        case CharClass::DIGIT:
+            return byteRangeSse2(c, '0', 10);
+        case CharClass::ALNUM: // c | 0x20 переводит заглавные буквы в строчные
+            return _mm_or_si128(byteRangeSse2(c, '0', 10), byteRangeSse2(_mm_or_si128(c, _mm_set1_epi8(0x20)), 'a', 26));
+        }
+        return _mm_setzero_si128();
+    }
+
+    // 16 символов за итерацию; позиция первого символа другого класса - младший нулевой бит маски
+    KLL_TARGET_SSE2 size_t spanCharClassSse2(CharClass cls, const char* text, size_t n) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+            unsigned outside = ~static_cast<unsigned>(_mm_movemask_epi8(charClassMaskSse2(cls, block))) & 0xFFFFu;
+            if (outside != 0) return i + countTrailingZeros(outside);
+        }
+        return i;
+    }
+
+    // --- AVX2 (8 элементов за итерацию) ---
+
+    KLL_TARGET_AVX2 size_t binaryIntAvx2(VectorKernelOp op, int* dst, const int* a, int aScalar, const int* b, int bScalar, size_t n) {
+        if (op == VectorKernelOp::DIV) return 0;
+        const __m256i aBroadcast = _mm256_set1_epi32(aScalar);
+        const __m256i bBroadcast = _mm256_set1_epi32(bScalar);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i x = a ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)) : aBroadcast;
+            __m256i y = b ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)) : bBroadcast;
+            __m256i r;
+            if (op == VectorKernelOp::ADD) r = _mm256_add_epi32(x, y);
+            else if (op == VectorKernelOp::SUB) r = _mm256_sub_epi32(x, y);
+            else r = _mm256_mullo_epi32(x, y);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+        }
+        return i;
+    }
+
+    KLL_TARGET_AVX2 size_t binaryFloatAvx2(VectorKernelOp op, float* dst, const float* a, float aScalar, const float* b, float bScalar, size_t n) {
+        const __m256 aBroadcast = _mm256_set1_ps(aScalar);
+        const __m256 bBroadcast = _mm256_set1_ps(bScalar);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 x = a ? _mm256_loadu_ps(a + i) : aBroadcast;
+            __m256 y = b ? _mm256_loadu_ps(b + i) : bBroadcast;
+            __m256 r;
+            switch (op) {
+            case VectorKernelOp::ADD: r = _mm256_add_ps(x, y); break;
+            case VectorKernelOp::SUB: r = _mm256_sub_ps(x, y); break;
+            case VectorKernelOp::MUL: r = _mm256_mul_ps(x, y); break;
+            default:                  r = _mm256_div_ps(x, y); break;
+            }
+            _mm256_storeu_ps(dst + i, r);
+        }
+        return i;
+    }
+
+    KLL_TARGET_AVX2 size_t sumIntAvx2(const int* a, size_t n, int& result) {
+        __m256i acc = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            acc = _mm256_add_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+        }
+        alignas(32) int lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        int total = 0;
+        for (int lane : lanes) total = applyInt(VectorKernelOp::ADD, total, lane);
+        result = total;
+        return i;
+    }
+
+    KLL_TARGET_AVX2 size_t sumFloatAvx2(const float* a, size_t n, float& result) {
+        __m256 acc = _mm256_setzero_ps();
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            acc = _mm256_add_ps(acc, _mm256_loadu_ps(a + i));
+        }
+        alignas(32) float lanes[8];
+        _mm256_store_ps(lanes, acc);
+        result = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+        return i;
+    }
+
+    KLL_TARGET_AVX2 size_t convertIntToFloatAvx2(float* dst, const int* src, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_ps(dst + i, _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i))));
+        }
+        return i;
+    }
+
+    KLL_TARGET_AVX2 size_t convertFloatToIntAvx2(int* dst, const float* src, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 floored = _mm256_floor_ps(_mm256_loadu_ps(src + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_cvttps_epi32(floored));
+        }
+        return i;
+    }
+
+    KLL_TARGET_AVX2 size_t findZeroIntAvx2(const int* a, size_t n) {
+        const __m256i zero = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)), zero);
+            if (_mm256_movemask_epi8(eq) != 0) return i;
+        }
+        return i;
+    }
+
+    KLL_TARGET_AVX2 size_t findZeroFloatAvx2(const float* a, size_t n) {
+        const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+        const __m256 threshold = _mm256_set1_ps(NEAR_ZERO_FLOAT);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 absValue = _mm256_and_ps(_mm256_loadu_ps(a + i), absMask);
+            if (_mm256_movemask_ps(_mm256_cmp_ps(absValue, threshold, _CMP_LE_OQ)) != 0) return i;
+        }
+        return i;
+    }
+#endif // KLL_X86
+
+} // namespace
+
+namespace VectorKernels {
+
+    InstructionSet getInstructionSet() {
+        return activeInstructionSet();
+    }
+
+    void setInstructionSet(InstructionSet requested) {
+        InstructionSet detected = detectedInstructionSet();
+        activeInstructionSet() = (static_cast<int>(requested) < static_cast<int>(detected)) ? requested : detected;
+    }
+
+    const char* getInstructionSetName(InstructionSet set) {
+        switch (set) {
+        case InstructionSet::SCALAR: return "scalar";
+        case InstructionSet::SSE2:   return "SSE2";
+        case InstructionSet::AVX2:   return "AVX2";
+        }
+        return "unknown";
+    }
+
+    void binaryInt(VectorKernelOp op, int* dst, const int* a, int aScalar, const int* b, int bScalar, size_t n) {
+        size_t done = 0;
+#if KLL_X86
+        switch (activeInstructionSet()) {
+        case InstructionSet::AVX2: done = binaryIntAvx2(op, dst, a, aScalar, b, bScalar, n); break;
+        case InstructionSet::SSE2: done = binaryIntSse2(op, dst, a, aScalar, b, bScalar, n); break;
+        default: break;
+        }
+#endif
+        binaryIntScalar(op, dst, a, aScalar, b, bScalar, done, n);
+    }
+
+    void binaryFloat(VectorKernelOp op, float* dst, const float* a, float aScalar, const float* b, float bScalar, size_t n) {
+        size_t done = 0;
+#if KLL_X86
+        switch (activeInstructionSet()) {
+        case InstructionSet::AVX2: done = binaryFloatAvx2(op, dst, a, aScalar, b, bScalar, n); break;
+        case InstructionSet::SSE2: done = binaryFloatSse2(op, dst, a, aScalar, b, bScalar, n); break;
+        default: break;
+        }
+#endif
+        binaryFloatScalar(op, dst, a, aScalar, b, bScalar, done, n);
+    }
+
+    int sumInt(const int* a, size_t n) {
+        int total = 0;
+        size_t done = 0;
+#if KLL_X86
+        switch (activeInstructionSet()) {
+        case InstructionSet::AVX2: done = sumIntAvx2(a, n, total); break;
+        case InstructionSet::SSE2: done = sumIntSse2(a, n, total); break;
+        default: break;
+        }
+#endif
+        for (size_t i = done; i < n; ++i) {
+            total = applyInt(VectorKernelOp::ADD, total, a[i]);
+        }
+        return total;
+    }
+
+    float sumFloat(const float* a, size_t n) {
+        float total = 0.0f;
+        size_t done = 0;
+#if KLL_X86
+        switch (activeInstructionSet()) {
+        case InstructionSet::AVX2: done = sumFloatAvx2(a, n, total); break;
+        case InstructionSet::SSE2: done = sumFloatSse2(a, n, total); break;
+        default: break;
+        }
+#endif
+        for (size_t i = done; i < n; ++i) {
+            total += a[i];
+        }
+        return total;
+    }
+
+    void convertIntToFloat(float* dst, const int* src, size_t n) {
+        size_t done = 0;
+#if KLL_X86
+        switch (activeInstructionSet()) {
+        case InstructionSet::AVX2: done = convertIntToFloatAvx2(dst, src, n); break;
+        case InstructionSet::SSE2: done = convertIntToFloatSse2(dst, src, n); break;
+        default: break;
+        }
+#endif
+        for (size_t i = done; i < n; ++i) {
+            dst[i] = static_cast<float>(src[i]);
+        }
+    }
+
+    void convertFloatToInt(int* dst, const float* src, size_t n) {
+        size_t done = 0;
+#if KLL_X86
+        // В SSE2 нет округления вниз (roundps появилась в SSE4.1), поэтому там работает скалярный код
+        if (activeInstructionSet() == InstructionSet::AVX2) {
+            done = convertFloatToIntAvx2(dst, src, n);
+        }
+#endif
+        convertFloatToIntScalar(dst, src, done, n);
+    }
+
+    void fillInt(int* dst, int value, size_t n) {
+        std::fill(dst, dst + n, value);
+    }
+
+    void fillFloat(float* dst, float value, size_t n) {
+        std::fill(dst, dst + n, value);
+    }
+
+    size_t findZeroInt(const int* a, size_t n) {
+        size_t i = 0;
+#if KLL_X86
+        switch (activeInstructionSet()) {
+        case InstructionSet::AVX2: i = findZeroIntAvx2(a, n); break;
+        case InstructionSet::SSE2: i = findZeroIntSse2(a, n); break;
+        default: break;
+        }
+#endif
+        for (; i < n; ++i) {
+            if (a[i] == 0) return i;
+        }
+        return n;
+    }
+
+    size_t findZeroFloat(const float* a, size_t n) {
+        size_t i = 0;
+#if KLL_X86
+        switch (activeInstructionSet()) {
+        case InstructionSet::AVX2: i = findZeroFloatAvx2(a, n); break;
+        case InstructionSet::SSE2: i = findZeroFloatSse2(a, n); break;
+        default: break;
+        }
+#endif
+        for (; i < n; ++i) {
+            if (std::abs(a[i]) < 1e-9) return i;
+        }
+        return n;
+    }
+
+    size_t spanCharClass(CharClass cls, const char* text, size_t n) {
+        size_t i = 0;
+#if KLL_X86
+        // Для AVX2 тоже SSE2: участки в исходном тексте обычно короче 32 символов, и 32-байтовое ядро
+        // проигрывает (бенчмарк лексера: 239 МБ/с SSE2 против 228 МБ/с AVX2 по медиане)
+        if (activeInstructionSet() != InstructionSet::SCALAR) i = spanCharClassSse2(cls, text, n);
+#endif
+        while (i < n && isInCharClass(cls, text[i])) ++i;
+        return i;
+    }
+}
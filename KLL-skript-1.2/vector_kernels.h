@@ -0,0 +1,70 @@
+// vector_kernels.h
+#ifndef VECTOR_KERNELS_H
+#define VECTOR_KERNELS_H
+
+#include <cstddef>
+
+// --- Векторные (SIMD) ядра для поэлементных операций над массивами ---
+// Используются векторными операциями ОПС (VEC_ADD, VEC_SUM, ...) и лексером (spanCharClass).
+// Реализация (скалярная, SSE2 или AVX2) выбирается один раз во время выполнения
+// по возможностям процессора; на не-x86 платформах всегда используется скалярная.
+
+enum class VectorKernelOp {
+    ADD,
+    SUB,
+    MUL,
+    DIV
+};
+
+// Классы символов для пропуска однородных участков исходного кода (совпадают с категориями лексера)
+enum class CharClass {
+    SPACE,  // ' ', \t, \r, \n
+    ALNUM,  // 'a'-'z', 'A'-'Z', '0'-'9' (продолжение идентификатора)
+    DIGIT   // '0'-'9'
+};
+
+enum class InstructionSet {
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+namespace VectorKernels {
+
+    // Текущий используемый набор инструкций
+    InstructionSet getInstructionSet();
+    // Ограничение набора инструкций (для отладки и сравнения производительности).
+    // Запрошенный набор понижается до фактически поддерживаемого процессором.
+    void setInstructionSet(InstructionSet requested);
+    const char* getInstructionSetName(InstructionSet set);
+
+    // dst[i] = a[i] op b[i].
+    // Если a (или b) равен nullptr, вместо него во всех позициях используется скаляр aScalar (bScalar).
+    // dst может совпадать с a или b (обработка строго поэлементная).
+    // Для целочисленного DIV делитель должен быть заранее проверен на нули (findZeroInt).
+    void binaryInt(VectorKernelOp op, int* dst, const int* a, int aScalar, const int* b, int bScalar, size_t n);
+    void binaryFloat(VectorKernelOp op, float* dst, const float* a, float aScalar, const float* b, float bScalar, size_t n);
+
+    // Свертки. Целочисленная сумма считается по модулю 2^32 (как при переполнении int в цикле).
+    // Вещественная сумма накапливается в нескольких дорожках, поэтому порядок сложения
+    // (и последний бит результата) может отличаться от последовательного цикла.
+    int sumInt(const int* a, size_t n);
+    float sumFloat(const float* a, size_t n);
+
+    // Преобразования типов (float -> int с округлением вниз, как CONVERT_TO_INT)
+    void convertIntToFloat(float* dst, const int* src, size_t n);
+    void convertFloatToInt(int* dst, const float* src, size_t n);
+
+    void fillInt(int* dst, int value, size_t n);
+    void fillFloat(float* dst, float value, size_t n);
+
+    // Индекс первого "нулевого" делителя (для float: |x| < 1e-9, как в DIV) или n, если таких нет
+    size_t findZeroInt(const int* a, size_t n);
+    size_t findZeroFloat(const float* a, size_t n);
+
+    // Длина начального участка text[0..n), все символы которого относятся к классу cls
+    // (ядро SSE2 и при активном AVX2 - на коротких участках оно быстрее)
+    size_t spanCharClass(CharClass cls, const char* text, size_t n);
+}
+
+#endif // VECTOR_KERNELS_H